@@ -0,0 +1,167 @@
+#include "ActivationRegion.hpp"
+
+#include "units/Unit.hpp"
+#include "components/Influence.hpp"
+#include "components/Projectile.hpp"
+#include "scenes/LevelScene.hpp"
+
+#include "cocos2d.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace {
+
+    // units have bottom-middle anchor
+    cocos2d::Rect GetBoundingBox(const cocos2d::Node * unit) noexcept {
+        const auto size { unit->getContentSize() };
+        return cocos2d::Rect {
+            unit->getPosition() - cocos2d::Vec2{ size.width / 2.f, 0.f },
+            size
+        };
+    }
+
+} // namespace {
+
+ActivationRegion::ActivationRegion(float margin)
+    : m_margin { margin }
+{
+    m_entities.reserve(128U);
+}
+
+uint32_t ActivationRegion::Add(cocos2d::Node * node, Kind kind) {
+    assert(node);
+    uint32_t index { 0U };
+    if (!m_free.empty()) {
+        index = m_free.back();
+        m_free.pop_back();
+    }
+    else {
+        index = static_cast<uint32_t>(m_entities.size());
+        m_entities.emplace_back();
+    }
+    auto& entity { m_entities[index] };
+    entity.node = node;
+    entity.kind = kind;
+    entity.isSleeping = false;
+    m_size++;
+    return index;
+}
+
+void ActivationRegion::Remove(uint32_t index) noexcept {
+    if (index >= m_entities.size() || !m_entities[index].node) {
+        return;
+    }
+    auto& entity { m_entities[index] };
+    if (entity.isSleeping) {
+        this->WakeUp(entity);
+    }
+    entity = Entity{};
+    m_free.push_back(index);
+    m_size--;
+}
+
+void ActivationRegion::Update(const Unit * player) {
+    if (!m_hasCamera) {
+        return;
+    }
+    const cocos2d::Rect region {
+        m_camera.origin - cocos2d::Vec2{ m_margin, m_margin },
+        m_camera.size + cocos2d::Size{ 2.f * m_margin, 2.f * m_margin }
+    };
+    const bool hasPlayer { player && !player->IsDead() };
+    const auto playerBox { hasPlayer? ::GetBoundingBox(player): cocos2d::Rect{} };
+
+    // units and props first: the projectiles need the zones of the units kept awake by the player
+    m_keptZones.clear();
+    for (auto& entity: m_entities) {
+        if (!entity.node || entity.node == player || entity.kind == Kind::PROJECTILE) continue;
+
+        const bool isInside { region.containsPoint(entity.node->getPosition()) };
+        switch (entity.kind) {
+            case Kind::UNIT: {
+                bool isNeeded { isInside };
+                if (!isNeeded && hasPlayer) {
+                    // the unit must react to the player intruding into its zone
+                    const auto influence { static_cast<const Influence*>(entity.node->getComponent("Influence")) };
+                    isNeeded = influence && influence->GetZone().intersectsRect(playerBox);
+                    if (isNeeded) {
+                        const auto& zone { influence->GetZone() };
+                        m_keptZones.emplace_back(zone.origin - cocos2d::Vec2{ m_margin, m_margin }
+                            , zone.size + cocos2d::Size{ 2.f * m_margin, 2.f * m_margin });
+                    }
+                }
+                if (isNeeded && entity.isSleeping) {
+                    this->WakeUp(entity);
+                }
+                else if (!isNeeded && !entity.isSleeping) {
+                    this->Sleep(entity);
+                }
+            } break;
+            case Kind::PROP: {
+                if (isInside && entity.isSleeping) {
+                    this->WakeUp(entity);
+                }
+                else if (!isInside && !entity.isSleeping) {
+                    this->Sleep(entity);
+                }
+            } break;
+            default: assert(false && "Unreachable"); break;
+        }
+    }
+
+    for (auto& entity: m_entities) {
+        if (!entity.node || entity.kind != Kind::PROJECTILE) continue;
+
+        const auto position { entity.node->getPosition() };
+        if (region.containsPoint(position)) continue;
+
+        // shots of the units out of the camera which fight the player fly the same margin
+        const bool isKept { std::any_of(m_keptZones.cbegin(), m_keptZones.cend(), [&position](const cocos2d::Rect& zone) {
+            return zone.containsPoint(position);
+        }) };
+        if (!isKept) {
+            static_cast<Projectile*>(entity.node)->Retire();
+        }
+    }
+}
+
+void ActivationRegion::Restore() {
+    for (auto& entity: m_entities) {
+        if (entity.node && entity.isSleeping) {
+            entity.node->pause();
+        }
+    }
+}
+
+void ActivationRegion::Sleep(Entity& entity) {
+    entity.isSleeping = true;
+    m_sleeping++;
+    entity.node->pause();
+    if (const auto body = entity.node->getPhysicsBody(); body) {
+        entity.isBodyEnabled = body->isEnabled();
+        body->setEnabled(false);
+    }
+    else {
+        entity.isBodyEnabled = false;
+    }
+}
+
+void ActivationRegion::WakeUp(Entity& entity) {
+    entity.isSleeping = false;
+    m_sleeping--;
+    entity.node->resume();
+    // the body could be removed while sleeping, e.g. on death
+    if (const auto body = entity.node->getPhysicsBody(); body && entity.isBodyEnabled) {
+        body->setEnabled(true);
+    }
+}
+
+ActivationRegion* ActivationRegion::Find(const cocos2d::Node * node) noexcept {
+    for (auto parent = node; parent; parent = parent->getParent()) {
+        if (const auto level = dynamic_cast<const LevelScene*>(parent); level) {
+            return level->GetActivationRegion();
+        }
+    }
+    return nullptr;
+}
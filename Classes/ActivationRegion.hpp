@@ -0,0 +1,120 @@
+#ifndef ACTIVATION_REGION_HPP
+#define ACTIVATION_REGION_HPP
+
+#include "math/CCGeometry.h" // cocos2d::Rect
+
+#include <cstdint>
+#include <vector>
+
+namespace cocos2d {
+    class Node;
+}
+class Unit;
+
+/**
+ * Level-owned set of the entities which are updated only near the camera.
+ *
+ * The camera rectangle is provided by the SmoothFollower. Entities which
+ * are out of the camera extended by the margin are put to sleep:
+ * the node is paused (update, actions and animation clock) and its physics
+ * body is disabled. They wake up on returning into the region or,
+ * for units, when their influence zone intersects the player.
+ *
+ * Projectiles don't sleep: they are retired on leaving the region,
+ * unless they are within the margin of the influence zone of a unit
+ * kept awake by the player, so such units' shots still reach the player.
+ */
+class ActivationRegion final {
+public:
+    enum class Kind : uint8_t {
+        UNIT,
+        PROP,
+        PROJECTILE
+    };
+
+    static constexpr uint32_t INVALID_ENTITY { UINT32_MAX };
+
+    static constexpr float DEFAULT_MARGIN { 256.f };
+
+    explicit ActivationRegion(float margin = DEFAULT_MARGIN);
+
+    uint32_t Add(cocos2d::Node * node, Kind kind);
+
+    /**
+     * Stop tracking the entity. The entity is woken up if it's sleeping.
+     */
+    void Remove(uint32_t entity) noexcept;
+
+    /**
+     * @param camera visible part of the map in map's coordinates
+     */
+    void SetCamera(const cocos2d::Rect& camera) noexcept {
+        m_camera = camera;
+        m_hasCamera = true;
+    }
+
+    void SetMargin(float margin) noexcept {
+        m_margin = margin;
+    }
+
+    float GetMargin() const noexcept {
+        return m_margin;
+    }
+
+    /**
+     * Put to sleep or wake up entities according to the last camera position.
+     *
+     * @param player the player is never put to sleep; may be nullptr
+     */
+    void Update(const Unit * player);
+
+    /**
+     * Pause the sleeping entities again, e.g. after the whole level was resumed.
+     */
+    void Restore();
+
+    size_t GetActiveCount() const noexcept {
+        return m_size - m_sleeping;
+    }
+
+    size_t GetSleepingCount() const noexcept {
+        return m_sleeping;
+    }
+
+    /**
+     * Find the region of the level the node belongs to.
+     */
+    static ActivationRegion* Find(const cocos2d::Node * node) noexcept;
+
+private:
+    struct Entity final {
+        cocos2d::Node * node { nullptr };
+        Kind kind { Kind::UNIT };
+        bool isSleeping { false };
+        // state of the physics body before it was disabled
+        bool isBodyEnabled { false };
+    };
+
+    void Sleep(Entity& entity);
+
+    void WakeUp(Entity& entity);
+
+    std::vector<Entity> m_entities;
+
+    std::vector<uint32_t> m_free;
+
+    // influence zones extended by the margin of the units kept awake by the player on the last update
+    std::vector<cocos2d::Rect> m_keptZones;
+
+    size_t m_size { 0U };
+
+    size_t m_sleeping { 0U };
+
+    cocos2d::Rect m_camera {};
+
+    bool m_hasCamera { false };
+
+    float m_margin { DEFAULT_MARGIN };
+};
+
+#endif // ACTIVATION_REGION_HPP
@@ -26,6 +26,9 @@
 
 #include "scenes/LevelScene.hpp"
 #include "scenes/BossFightScene.hpp"
+#include "Profiler.hpp"
+
+#include "dragonBones/cocos2dx/CCDragonBonesHeaders.h"
 
 // #define USE_AUDIO_ENGINE 1
 // #define USE_SIMPLE_AUDIO_ENGINE 1
@@ -129,6 +132,23 @@ bool AppDelegate::applicationDidFinishLaunching() {
 
     register_all_packages();
 
+#if defined(PLATFORMER_PROFILER)
+    // record from the start, so F12 dumps the last seconds of the game
+    bench::Profiler::GetInstance().Enable(true);
+    dragonBones::WorldClock::advanceObserver = [](bool isBegin) {
+        auto& profiler = bench::Profiler::GetInstance();
+        if (!profiler.IsEnabled()) {
+            return;
+        }
+        if (isBegin) {
+            profiler.BeginZone("WorldClock::advanceTime");
+        }
+        else {
+            profiler.EndZone();
+        }
+    };
+#endif
+
     // create a scene. it's an autorelease object
     constexpr auto id  { 4 };
     // const auto scene = BossFightScene::createRootScene(id);
@@ -0,0 +1,74 @@
+#ifndef ASSET_PATHS_HPP
+#define ASSET_PATHS_HPP
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <cstddef>
+
+/**
+ * Paths of the assets shared by their owners and the AssetPreloader,
+ * so the preloaded files are exactly the ones the owners load.
+ * Names of the units' armatures are the `dragonbones` fields of units.json.
+ */
+namespace assets {
+
+    /**
+     * DragonBones files `<prefix>_ske.json` (or `.dbbin`), `<prefix>_tex.json`, `<prefix>_tex.png`
+     * and the armature cache name.
+     */
+    struct Skeleton final {
+        std::string prefix;
+        std::string name;
+    };
+
+    // parallax background layers, from the farthest one
+    constexpr std::array<const char*, 5U> BACKGROUND_LAYERS {
+          "Map/back/sky.png"
+        , "Map/back/sky-0.png"  // clouds
+        , "Map/back/2.png"      // mountains
+        , "Map/back/sky-1.png"  // cloud
+        , "Map/back/1.png"      // trees
+    };
+
+    // looks of the stalactite, one is chosen randomly on creation
+    constexpr size_t STALACTITE_LOOKS { 4U };
+
+    inline Skeleton GetUnitSkeleton(std::string_view name) {
+        return { std::string(name), std::string(name) };
+    }
+
+    /**
+     * Player and boss keep their files in own directory
+     */
+    inline Skeleton GetNestedSkeleton(std::string_view name) {
+        return { std::string(name) + "/" + std::string(name), std::string(name) };
+    }
+
+    inline Skeleton GetFireCloudSkeleton(std::string_view name) {
+        return { "boss/boss_cloud", std::string(name) };
+    }
+
+    /**
+     * @param look in range [1, STALACTITE_LOOKS]
+     */
+    inline Skeleton GetStalactiteSkeleton(std::string_view name, size_t look) {
+        const auto lookName { std::string(name) + "_" + std::to_string(look) };
+        return { "stalactites/" + lookName + "/" + lookName, lookName };
+    }
+
+    /**
+     * The part falling from the stalactite
+     */
+    inline Skeleton GetStalactitePartSkeleton(std::string_view name, size_t look) {
+        const auto lookName { std::string(name) + "_" + std::to_string(look) };
+        return { "stalactites/" + lookName + "/" + lookName + "_projectile", lookName + "_projectile" };
+    }
+
+    inline Skeleton GetPropSkeleton(std::string_view name) {
+        return { "Map/props/" + std::string(name), std::string(name) };
+    }
+
+} // namespace assets
+
+#endif // ASSET_PATHS_HPP
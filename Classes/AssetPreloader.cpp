@@ -0,0 +1,323 @@
+#include "AssetPreloader.hpp"
+
+#include "TileMapParser.hpp"
+#include "SkeletonConverter.hpp"
+#include "components/Props.hpp"
+#include "components/ProjectilePool.hpp"
+#include "configs/JsonUnits.hpp"
+
+#include "cocos2d.h"
+#include "dragonBones/DragonBonesHeaders.h"
+#include "dragonBones/cocos2dx/CCDragonBonesHeaders.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+
+namespace {
+
+    // same as the conversion done by `dragonBones::CCFactory` for the atlases it loads
+    cocos2d::backend::PixelFormat GetPixelFormat(dragonBones::TextureFormat format
+        , cocos2d::backend::PixelFormat defaultFormat
+    ) noexcept {
+        using dragonBones::TextureFormat;
+        using cocos2d::backend::PixelFormat;
+        switch (format) {
+            case TextureFormat::RGBA8888: return PixelFormat::RGBA8888;
+            case TextureFormat::BGRA8888: return PixelFormat::BGRA8888;
+            case TextureFormat::RGBA4444: return PixelFormat::RGBA4444;
+            case TextureFormat::RGB888: return PixelFormat::RGB888;
+            case TextureFormat::RGB565: return PixelFormat::RGB565;
+            case TextureFormat::RGBA5551: return PixelFormat::RGB5A1;
+            default: break;
+        }
+        return defaultFormat;
+    }
+
+    cocos2d::Image* Decode(const std::string& path) {
+        const auto data { cocos2d::FileUtils::getInstance()->getDataFromFile(path) };
+        if (data.isNull()) {
+            return nullptr;
+        }
+        auto image = new (std::nothrow) cocos2d::Image();
+        if (image && !image->initWithImageData(data.getBytes(), data.getSize())) {
+            image->release();
+            image = nullptr;
+        }
+        return image;
+    }
+
+    void AddProjectile(AssetPreloader::Manifest& manifest, ProjectilePool::Archetype archetype) {
+        const auto& visual { ProjectilePool::GetVisual(archetype) };
+        if (visual.image) {
+            manifest.AddImage(visual.image);
+        }
+        else if (visual.prefix) {
+            manifest.AddSkeleton(assets::Skeleton{ visual.prefix, visual.name });
+        }
+    }
+
+} // namespace {
+
+void AssetPreloader::Manifest::AddSkeleton(assets::Skeleton skeleton, size_t instances) {
+    const auto it = std::find_if(skeletons.begin(), skeletons.end(), [&skeleton](const Skeleton& added) {
+        return added.name == skeleton.name;
+    });
+    if (it == skeletons.end()) {
+        skeletons.push_back(Skeleton{ std::move(skeleton.prefix), std::move(skeleton.name), instances });
+    }
+    else {
+        it->instances += instances;
+    }
+}
+
+void AssetPreloader::Manifest::AddImage(std::string path) {
+    if (std::find(images.cbegin(), images.cend(), path) == images.cend()) {
+        images.push_back(std::move(path));
+    }
+}
+
+AssetPreloader::Manifest AssetPreloader::Collect(const TileMapParser& parser, const json_models::Units& units) {
+    using core::CategoryName;
+    using core::EnemyClass;
+    using Archetype = ProjectilePool::Archetype;
+
+    Manifest manifest;
+    for (auto path: assets::BACKGROUND_LAYERS) {
+        manifest.AddImage(path);
+    }
+
+    if (!parser.Peek(CategoryName::PLAYER).empty()) {
+        manifest.AddSkeleton(assets::GetNestedSkeleton(units.player.dragonbones), 1U);
+        ::AddProjectile(manifest, Archetype::PLAYER_FIREBALL);
+        ::AddProjectile(manifest, Archetype::PLAYER_SPECIAL);
+    }
+
+    for (const auto& form: parser.Peek(CategoryName::PROPS)) {
+        const auto name { props::GetPropName(Utils::EnumCast<props::Name>(form.m_subType)) };
+        manifest.AddSkeleton(assets::GetPropSkeleton(name), 1U);
+    }
+
+    for (const auto& form: parser.Peek(CategoryName::ENEMY)) {
+        switch (Utils::EnumCast<EnemyClass>(form.m_subType)) {
+            case EnemyClass::WARRIOR: manifest.AddSkeleton(assets::GetUnitSkeleton(units.axWarrior.dragonbones), 1U); break;
+            case EnemyClass::SPEARMAN: manifest.AddSkeleton(assets::GetUnitSkeleton(units.spearman.dragonbones), 1U); break;
+            case EnemyClass::WOLF: manifest.AddSkeleton(assets::GetUnitSkeleton(units.wolf.dragonbones), 1U); break;
+            case EnemyClass::WASP: manifest.AddSkeleton(assets::GetUnitSkeleton(units.wasp.dragonbones), 1U); break;
+            case EnemyClass::SPIDER: manifest.AddSkeleton(assets::GetUnitSkeleton(units.spider.dragonbones), 1U); break;
+            case EnemyClass::SLIME: {
+                manifest.AddSkeleton(assets::GetUnitSkeleton(units.slime.dragonbones), 1U);
+                ::AddProjectile(manifest, Archetype::SLIME_SHOT);
+            } break;
+            case EnemyClass::ARCHER: {
+                manifest.AddSkeleton(assets::GetUnitSkeleton(units.archer.dragonbones), 1U);
+                ::AddProjectile(manifest, Archetype::ARROW);
+            } break;
+            case EnemyClass::CANNON: {
+                manifest.AddSkeleton(assets::GetUnitSkeleton(units.cannon.dragonbones), 1U);
+                ::AddProjectile(manifest, Archetype::STAKE);
+            } break;
+            case EnemyClass::BOULDER_PUSHER: {
+                manifest.AddSkeleton(assets::GetUnitSkeleton(units.boulderPusher.dragonbones), 1U);
+                ::AddProjectile(manifest, Archetype::STONE);
+            } break;
+            case EnemyClass::STALACTITE: {
+                // the look is chosen randomly on creation
+                for (size_t look = 1U; look <= assets::STALACTITE_LOOKS; look++) {
+                    manifest.AddSkeleton(assets::GetStalactiteSkeleton(units.stalactite.dragonbones, look));
+                    manifest.AddSkeleton(assets::GetStalactitePartSkeleton(units.stalactite.dragonbones, look));
+                }
+            } break;
+            case EnemyClass::BOSS: {
+                manifest.AddSkeleton(assets::GetNestedSkeleton(units.banditBoss.dragonbones), 1U);
+                manifest.AddSkeleton(assets::GetFireCloudSkeleton(units.firecloud.dragonbones));
+                ::AddProjectile(manifest, Archetype::BOSS_FIREBALL);
+                ::AddProjectile(manifest, Archetype::CLOUD_FIREBALL);
+            } break;
+            default: break;
+        }
+    }
+    return manifest;
+}
+
+AssetPreloader::AssetPreloader(const Manifest& manifest, size_t uploadBudget)
+    : m_uploadBudget { uploadBudget }
+{
+    const auto fileUtils { cocos2d::FileUtils::getInstance() };
+    const auto factory { dragonBones::CCFactory::getFactory() };
+    const auto textureCache { cocos2d::Director::getInstance()->getTextureCache() };
+
+    // paths are resolved here: the FileUtils' cache of full paths isn't thread-safe
+    const auto addJob = [this, fileUtils](JobKind kind, const std::string& path) {
+        auto fullPath { fileUtils->fullPathForFilename(path) };
+        if (!fullPath.empty()) {
+            m_jobs.push_back(Job{ kind, std::move(fullPath) });
+        }
+    };
+
+    m_jobs.reserve(2U * manifest.skeletons.size() + manifest.images.size());
+    for (const auto& [prefix, name]: manifest.skeletons) {
+        const auto path { prefix + "/" + name };
+        if (!factory->getDragonBonesData(name)) {
+            // the binary is skipped if the JSON was edited after the conversion
+            const auto binary { path + SkeletonConverter::BINARY_SUFFIX };
+            const auto json { path + SkeletonConverter::JSON_SUFFIX };
+            const auto binaryPath { fileUtils->fullPathForFilename(binary) };
+            const bool isBinary { !binaryPath.empty()
+                && SkeletonConverter::IsUpToDate(binaryPath, fileUtils->fullPathForFilename(json)) };
+            addJob(JobKind::SKELETON, isBinary? binary: json);
+        }
+        if (!factory->getTextureAtlasData(name)) {
+            addJob(JobKind::ATLAS, path + "_tex.json");
+        }
+    }
+    for (const auto& image: manifest.images) {
+        if (!textureCache->getTextureForKey(image)) {
+            addJob(JobKind::IMAGE, image);
+        }
+    }
+
+    m_loaded.reserve(m_jobs.size());
+    const size_t hardwareThreads { std::max(1U, std::thread::hardware_concurrency()) };
+    // leave a core to the GL thread
+    const auto workers { std::min(std::max<size_t>(1U, hardwareThreads - 1U), m_jobs.size()) };
+    m_workers.reserve(workers);
+    for (size_t i = 0; i < workers; i++) {
+        m_workers.emplace_back(&AssetPreloader::Run, this);
+    }
+}
+
+AssetPreloader::~AssetPreloader() {
+    m_isCancelled = true;
+    for (auto& worker: m_workers) {
+        worker.join();
+    }
+    // nothing is resident from the jobs which are not registered
+    for (auto& job: m_jobs) {
+        this->Release(job);
+    }
+}
+
+bool AssetPreloader::Update() {
+    {
+        std::lock_guard<std::mutex> lock { m_mutex };
+        m_ready.insert(m_ready.end(), m_loaded.cbegin(), m_loaded.cend());
+        m_loaded.clear();
+    }
+    // at least one job is registered per frame
+    size_t uploaded { 0U };
+    while (!m_ready.empty() && uploaded < m_uploadBudget) {
+        uploaded += this->Register(m_jobs[m_ready.front()]);
+        m_ready.pop_front();
+        m_registered++;
+    }
+    return m_registered == m_jobs.size();
+}
+
+void AssetPreloader::Run() {
+    for (auto index = m_next++; index < m_jobs.size() && !m_isCancelled; index = m_next++) {
+        this->Load(m_jobs[index]);
+        std::lock_guard<std::mutex> lock { m_mutex };
+        m_loaded.push_back(index);
+    }
+}
+
+void AssetPreloader::Load(Job& job) const {
+    const auto fileUtils { cocos2d::FileUtils::getInstance() };
+    switch (job.kind) {
+        case JobKind::SKELETON: {
+            // parsers keep the state of the data being parsed, so each job has its own
+            if (job.path.find(SkeletonConverter::BINARY_SUFFIX) != std::string::npos) {
+                auto data { fileUtils->getDataFromFile(job.path) };
+                // the parsed data refers to the arrays in the buffer and frees it on clear
+                ssize_t size { 0 };
+                const auto binary { data.takeBuffer(&size) };
+                if (binary) {
+                    dragonBones::BinaryDataParser parser;
+                    job.skeleton = parser.parseDragonBonesData(reinterpret_cast<const char*>(binary));
+                    if (!job.skeleton) {
+                        free(binary);
+                    }
+                }
+            }
+            else {
+                const auto json { fileUtils->getStringFromFile(job.path) };
+                if (!json.empty()) {
+                    dragonBones::JSONDataParser parser;
+                    job.skeleton = parser.parseDragonBonesData(json.c_str());
+                }
+            }
+        } break;
+        case JobKind::ATLAS: {
+            const auto json { fileUtils->getStringFromFile(job.path) };
+            if (json.empty()) {
+                break;
+            }
+            const auto atlas { dragonBones::BaseObject::borrowObject<dragonBones::CCTextureAtlasData>() };
+            dragonBones::JSONDataParser parser;
+            parser.parseTextureAtlasData(json.c_str(), *atlas);
+            // the image lies next to the atlas
+            atlas->imagePath = job.path.substr(0U, job.path.find_last_of('/') + 1U) + atlas->imagePath;
+            job.atlas = atlas;
+            job.image = ::Decode(atlas->imagePath);
+        } break;
+        case JobKind::IMAGE: {
+            job.image = ::Decode(job.path);
+        } break;
+        default: assert(false && "Unreachable"); break;
+    }
+}
+
+size_t AssetPreloader::Register(Job& job) {
+    const auto factory { dragonBones::CCFactory::getFactory() };
+    const auto textureCache { cocos2d::Director::getInstance()->getTextureCache() };
+    size_t uploaded { 0U };
+    switch (job.kind) {
+        case JobKind::SKELETON: {
+            if (job.skeleton) {
+                factory->addDragonBonesData(job.skeleton);
+                job.skeleton = nullptr;
+            }
+        } break;
+        case JobKind::ATLAS: {
+            // the atlas without a texture is left to the Animator
+            if (!job.atlas || !job.image) {
+                break;
+            }
+            const auto atlas { static_cast<dragonBones::CCTextureAtlasData*>(job.atlas) };
+            const auto defaultFormat { cocos2d::Texture2D::getDefaultAlphaPixelFormat() };
+            cocos2d::Texture2D::setDefaultAlphaPixelFormat(::GetPixelFormat(atlas->format, defaultFormat));
+            const auto texture { textureCache->addImage(job.image, atlas->imagePath) };
+            cocos2d::Texture2D::setDefaultAlphaPixelFormat(defaultFormat);
+            if (texture) {
+                uploaded = static_cast<size_t>(job.image->getDataLen());
+                atlas->setRenderTexture(texture);
+                factory->addTextureAtlasData(atlas);
+                job.atlas = nullptr;
+            }
+        } break;
+        case JobKind::IMAGE: {
+            if (job.image && textureCache->addImage(job.image, job.path)) {
+                uploaded = static_cast<size_t>(job.image->getDataLen());
+            }
+        } break;
+        default: assert(false && "Unreachable"); break;
+    }
+    this->Release(job);
+    return uploaded;
+}
+
+void AssetPreloader::Release(Job& job) {
+    if (job.skeleton) {
+        job.skeleton->returnToPool();
+        job.skeleton = nullptr;
+    }
+    if (job.atlas) {
+        job.atlas->returnToPool();
+        job.atlas = nullptr;
+    }
+    if (job.image) {
+        job.image->release();
+        job.image = nullptr;
+    }
+}
@@ -0,0 +1,151 @@
+#ifndef ASSET_PRELOADER_HPP
+#define ASSET_PRELOADER_HPP
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <cstddef>
+
+#include "AssetPaths.hpp"
+
+class TileMapParser;
+
+namespace json_autogenerated_classes {
+    struct Units;
+} // namespace json_autogenerated_classes
+namespace json_models = json_autogenerated_classes;
+
+namespace cocos2d {
+    class Image;
+}
+
+namespace dragonBones {
+    class DragonBonesData;
+    class TextureAtlasData;
+}
+
+/**
+ * Load the assets of the level before the level is populated.
+ *
+ * Files are read, images decoded and skeletons parsed on worker threads.
+ * The results are handed to the GL thread which uploads textures
+ * in slices limited by the budget of decoded bytes per frame
+ * and registers the data in the DragonBones factory and the texture cache.
+ * So the units created later find everything resident and don't hitch.
+ *
+ * Assets which are already loaded or missing are skipped: the latter
+ * are left to the synchronous loading by their owners.
+ */
+class AssetPreloader final {
+public:
+    // decoded pixels uploaded per frame, bytes
+    static constexpr size_t UPLOAD_BUDGET { 4U * 1024U * 1024U };
+
+    struct Skeleton final {
+        // directory of the `<name>_ske` and `<name>_tex` files
+        std::string prefix;
+        // armature cache name
+        std::string name;
+        // armatures built in advance by `ArmaturePool::Prewarm`: one per unit or prop of the level
+        size_t instances { 0U };
+    };
+
+    struct Manifest final {
+        std::vector<Skeleton> skeletons;
+        std::vector<std::string> images;
+
+        /**
+         * @param instances number of the armatures added to the level from the start
+         */
+        void AddSkeleton(assets::Skeleton skeleton, size_t instances = 0U);
+
+        void AddImage(std::string path);
+    };
+
+    /**
+     * Collect assets used by the units and props of the parsed level.
+     * Armature names come from the units' `dragonbones` fields,
+     * paths are built by the same helpers their owners use (see AssetPaths.hpp, ProjectilePool).
+     */
+    static Manifest Collect(const TileMapParser& parser, const json_models::Units& units);
+
+    explicit AssetPreloader(const Manifest& manifest, size_t uploadBudget = UPLOAD_BUDGET);
+
+    ~AssetPreloader();
+
+    AssetPreloader(const AssetPreloader&) = delete;
+    AssetPreloader& operator=(const AssetPreloader&) = delete;
+    AssetPreloader(AssetPreloader&&) = delete;
+    AssetPreloader& operator=(AssetPreloader&&) = delete;
+
+    /**
+     * Register loaded assets and upload their textures within the budget.
+     * Must be called from the GL thread once per frame.
+     *
+     * @return true when all assets are resident
+     */
+    bool Update();
+
+    [[nodiscard]] float GetProgress() const noexcept {
+        return m_jobs.empty()? 1.f: static_cast<float>(m_registered) / m_jobs.size();
+    }
+
+private:
+    enum class JobKind {
+        SKELETON,
+        ATLAS,
+        IMAGE
+    };
+
+    struct Job final {
+        JobKind kind { JobKind::IMAGE };
+        // full path of the file
+        std::string path;
+        dragonBones::DragonBonesData * skeleton { nullptr };
+        dragonBones::TextureAtlasData * atlas { nullptr };
+        cocos2d::Image * image { nullptr };
+    };
+
+    /**
+     * Worker's loop: take jobs until there are none left.
+     */
+    void Run();
+
+    /**
+     * Read and decode the job's files. Runs on worker threads.
+     */
+    void Load(Job& job) const;
+
+    /**
+     * Hand the loaded job to the factory or the texture cache.
+     * @return uploaded bytes
+     */
+    size_t Register(Job& job);
+
+    void Release(Job& job);
+
+    const size_t m_uploadBudget { UPLOAD_BUDGET };
+
+    // filled before the workers start and never resized
+    std::vector<Job> m_jobs;
+
+    std::atomic<size_t> m_next { 0U };
+
+    std::atomic<bool> m_isCancelled { false };
+
+    // indices of the loaded jobs waiting for the GL thread
+    std::mutex m_mutex;
+    std::vector<size_t> m_loaded;
+
+    // touched by the GL thread only
+    std::deque<size_t> m_ready;
+
+    size_t m_registered { 0U };
+
+    std::vector<std::thread> m_workers;
+};
+
+#endif // ASSET_PRELOADER_HPP
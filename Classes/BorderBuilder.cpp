@@ -0,0 +1,355 @@
+#include "BorderBuilder.hpp"
+
+#include "TileMapHelper.hpp"
+#include "TileMapParser.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <thread>
+#include <unordered_map>
+
+namespace {
+
+    // don't spawn threads for small maps: the work is less than a thread start
+    constexpr size_t MIN_TILES_PER_THREAD { 64U * 1024U };
+
+    // Directions and sides of the tile, clockwise.
+    // Sides are walked keeping the tile on the right (the y axis goes down as in Tiled)
+    // so the side `face` is walked in the direction `face + 1`.
+    constexpr uint8_t NORTH { 0U };
+    constexpr uint8_t EAST { 1U };
+    constexpr uint8_t SOUTH { 2U };
+    constexpr uint8_t WEST { 3U };
+    constexpr uint8_t NO_WAY { 4U };
+
+    constexpr int64_t DX[4] = { 0, 1, 0, -1 };
+    constexpr int64_t DY[4] = { -1, 0, 1, 0 };
+
+    // shift from the corner to the tile which side leaves the corner in the direction
+    constexpr int64_t OUT_DX[4] = { 0, 0, -1, -1 };
+    constexpr int64_t OUT_DY[4] = { -1, 0, 0, -1 };
+
+    // shift from the corner to the tile which side enters the corner in the direction
+    constexpr int64_t IN_DX[4] = { 0, -1, -1, 0 };
+    constexpr int64_t IN_DY[4] = { 0, 0, -1, -1 };
+
+    constexpr uint8_t FaceOf(uint8_t direction) noexcept {
+        return (direction + 3U) % 4U;
+    }
+
+    constexpr uint8_t DirectionOf(uint8_t face) noexcept {
+        return (face + 1U) % 4U;
+    }
+
+    /**
+     * Drop the points lying on the line between their neighbours.
+     * The closed chain keeps the first point repeated at the end.
+     */
+    void Simplify(std::vector<uint32_t>& vertices, bool isClosed) {
+        if (isClosed) {
+            vertices.pop_back();
+        }
+        const auto count { vertices.size() };
+        if (count < 3U) {
+            if (isClosed && !vertices.empty()) {
+                vertices.push_back(vertices.front());
+            }
+            return;
+        }
+        const auto IsCorner = [&vertices](size_t prev, size_t curr, size_t next) {
+            const auto a { vertices[prev] }, b { vertices[curr] }, c { vertices[next] };
+            // sides are unit steps: collinear steps have the same vertex index delta
+            return static_cast<int64_t>(b) - a != static_cast<int64_t>(c) - b;
+        };
+
+        std::vector<uint32_t> corners;
+        corners.reserve(count / 2U + 2U);
+        for (size_t i = 0U; i < count; i++) {
+            const bool isEnd { !isClosed && (i == 0U || i + 1U == count) };
+            if (isEnd || IsCorner((i + count - 1U) % count, i, (i + 1U) % count)) {
+                corners.push_back(vertices[i]);
+            }
+        }
+        if (isClosed) {
+            corners.push_back(corners.front());
+        }
+        vertices.swap(corners);
+    }
+
+} // namespace {
+
+BorderBuilder::BorderBuilder(const TileMap::Cache * cache)
+    : m_cache { cache }
+    , m_width { cache? cache->mapWidth: 0U }
+    , m_height { cache? cache->mapHeight: 0U }
+    , m_cells ( m_width * m_height, 0U )
+    , m_visited ( m_width * m_height, 0U )
+{
+    assert(m_cache && "cache pointer can't be null");
+}
+
+std::vector<details::Form> BorderBuilder::Build() {
+    std::vector<details::Form> forms;
+    if (m_cells.empty()) {
+        return forms;
+    }
+
+    const size_t hardwareThreads { std::max(1U, std::thread::hardware_concurrency()) };
+    const size_t threadCount { std::clamp<size_t>(
+        m_cells.size() / MIN_TILES_PER_THREAD, 1U, std::min(hardwareThreads, m_height)
+    )};
+    // split map into bands of rows, the last band is processed by this thread
+    const size_t rowsPerBand { (m_height + threadCount - 1U) / threadCount };
+    std::vector<Band> bands;
+    bands.reserve(threadCount);
+    for (size_t first = 0U; first < m_height; first += rowsPerBand) {
+        bands.emplace_back();
+        bands.back().first = first;
+        bands.back().last = std::min(first + rowsPerBand, m_height);
+    }
+
+    const auto RunBands = [&bands](auto&& work) {
+        std::vector<std::thread> workers;
+        workers.reserve(bands.size() - 1U);
+        for (size_t i = 0U; i + 1U < bands.size(); i++) {
+            workers.emplace_back(work, std::ref(bands[i]));
+        }
+        work(bands.back());
+        for (auto& worker: workers) {
+            worker.join();
+        }
+    };
+    // tracing looks at the sides of the neighbouring bands so all of them must be found first,
+    // then every band marks only the sides of its own tiles as visited
+    RunBands([this](Band& band) { this->FillCells(band.first, band.last); });
+    RunBands([this](Band& band) { this->TraceBand(band); });
+
+    auto chains { this->Stitch(bands) };
+    forms.reserve(chains.size());
+    const auto stride { static_cast<uint32_t>(m_width + 1U) };
+    const auto& tileSize { m_cache->tileSize };
+    for (auto& chain: chains) {
+        ::Simplify(chain.vertices, chain.isClosed);
+        assert(chain.vertices.size() >= 2U && "Can't have a chain with 0 or 1 elements");
+
+        details::Form form;
+        form.m_type = core::CategoryName::BORDER;
+        form.m_points.reserve(chain.vertices.size());
+        for (const auto vertex: chain.vertices) {
+            // From corner coordinates in Tiled.exe to coordinates in game engine
+            const auto x { static_cast<float>(vertex % stride) };
+            const auto y { static_cast<float>(vertex / stride) };
+            form.m_points.emplace_back(
+                x * tileSize.width,
+                (static_cast<float>(m_height) - y) * tileSize.height
+            );
+        }
+        forms.emplace_back(std::move(form));
+    }
+    return forms;
+}
+
+void BorderBuilder::FillCells(size_t first, size_t last) noexcept {
+    using Property = TileMap::Property;
+
+    const auto& properties { m_cache->properties };
+    const auto IsFree = [&properties](size_t index) {
+        return !Utils::HasAny(properties[index], Property::BORDER, Property::SOLID);
+    };
+    for (size_t y = first; y < last; y++) {
+        for (size_t x = 0U; x < m_width; x++) {
+            const auto index { y * m_width + x };
+            uint8_t sides { 0U };
+            // sides facing the outside of the map aren't a part of the border
+            if (Utils::HasAny(properties[index], Property::BORDER)) {
+                if (y > 0U && IsFree(index - m_width))              sides |= 1U << NORTH;
+                if (x + 1U < m_width && IsFree(index + 1U))         sides |= 1U << EAST;
+                if (y + 1U < m_height && IsFree(index + m_width))   sides |= 1U << SOUTH;
+                if (x > 0U && IsFree(index - 1U))                   sides |= 1U << WEST;
+            }
+            m_cells[index] = sides;
+        }
+    }
+}
+
+bool BorderBuilder::HasSide(int64_t x, int64_t y, uint8_t face) const noexcept {
+    return x >= 0 && y >= 0
+        && x < static_cast<int64_t>(m_width)
+        && y < static_cast<int64_t>(m_height)
+        && (m_cells[y * m_width + x] & (1U << face));
+}
+
+uint8_t BorderBuilder::GetNextDirection(int64_t x, int64_t y, uint8_t direction) const noexcept {
+    // two ways out exist only for the tiles touching by the corner:
+    // turning right keeps walking around the same tile
+    const uint8_t ways[3] = {
+        static_cast<uint8_t>((direction + 1U) % 4U),
+        direction,
+        static_cast<uint8_t>((direction + 3U) % 4U)
+    };
+    for (const auto way: ways) {
+        if (this->HasSide(x + OUT_DX[way], y + OUT_DY[way], FaceOf(way))) {
+            return way;
+        }
+    }
+    return NO_WAY;
+}
+
+void BorderBuilder::TraceBand(Band& band) {
+    const auto IsVisited = [this](size_t x, size_t y, uint8_t face) {
+        return (m_visited[y * m_width + x] & (1U << face)) != 0U;
+    };
+    const auto HasPredecessor = [this, &band](int64_t x, int64_t y, uint8_t direction) {
+        for (uint8_t in = NORTH; in <= WEST; in++) {
+            const auto row { y + IN_DY[in] };
+            if (row < static_cast<int64_t>(band.first) || row >= static_cast<int64_t>(band.last)) {
+                continue;
+            }
+            if (this->HasSide(x + IN_DX[in], row, FaceOf(in))
+                && this->GetNextDirection(x, y, in) == direction
+            ) {
+                return true;
+            }
+        }
+        return false;
+    };
+    // corner where the side starts
+    const auto StartX = [](size_t x, uint8_t face) -> int64_t {
+        return static_cast<int64_t>(x) + (face == EAST || face == SOUTH? 1: 0);
+    };
+    const auto StartY = [](size_t y, uint8_t face) -> int64_t {
+        return static_cast<int64_t>(y) + (face == SOUTH || face == WEST? 1: 0);
+    };
+
+    // open chains start at the sides without predecessor
+    for (size_t y = band.first; y < band.last; y++) {
+        for (size_t x = 0U; x < m_width; x++) {
+            if (!m_cells[y * m_width + x]) continue;
+
+            for (uint8_t face = NORTH; face <= WEST; face++) {
+                if (IsVisited(x, y, face) || !this->HasSide(x, y, face)) continue;
+                if (HasPredecessor(StartX(x, face), StartY(y, face), DirectionOf(face))) continue;
+
+                band.fragments.emplace_back();
+                this->Trace(band, x, y, face, band.fragments.back());
+            }
+        }
+    }
+    // the rest are loops
+    for (size_t y = band.first; y < band.last; y++) {
+        for (size_t x = 0U; x < m_width; x++) {
+            if (!m_cells[y * m_width + x]) continue;
+
+            for (uint8_t face = NORTH; face <= WEST; face++) {
+                if (IsVisited(x, y, face) || !this->HasSide(x, y, face)) continue;
+
+                band.fragments.emplace_back();
+                this->Trace(band, x, y, face, band.fragments.back());
+            }
+        }
+    }
+}
+
+void BorderBuilder::Trace(const Band& band, size_t x, size_t y, uint8_t face, Fragment& fragment) {
+    const auto stride { static_cast<uint32_t>(m_width + 1U) };
+    const auto Corner = [stride](int64_t col, int64_t row) {
+        return static_cast<uint32_t>(row) * stride + static_cast<uint32_t>(col);
+    };
+    // corner where the walk along the side of the tile (col, row) ends
+    int64_t col { static_cast<int64_t>(x) + (face == NORTH || face == EAST? 1: 0) };
+    int64_t row { static_cast<int64_t>(y) + (face == EAST || face == SOUTH? 1: 0) };
+    const auto direction { DirectionOf(face) };
+    fragment.vertices.push_back(Corner(col - DX[direction], row - DY[direction]));
+
+    auto tileX { static_cast<int64_t>(x) };
+    auto tileY { static_cast<int64_t>(y) };
+    auto side { face };
+    for (;;) {
+        m_visited[tileY * m_width + tileX] |= (1U << side);
+        fragment.vertices.push_back(Corner(col, row));
+
+        const auto way { this->GetNextDirection(col, row, DirectionOf(side)) };
+        if (way == NO_WAY) {
+            break;
+        }
+        tileX = col + OUT_DX[way];
+        tileY = row + OUT_DY[way];
+        side = FaceOf(way);
+        if (tileY < static_cast<int64_t>(band.first) || tileY >= static_cast<int64_t>(band.last)) {
+            // the rest of the chain belongs to another band
+            break;
+        }
+        if (m_visited[tileY * m_width + tileX] & (1U << side)) {
+            // walked around
+            fragment.isClosed = true;
+            break;
+        }
+        col += DX[way];
+        row += DY[way];
+    }
+}
+
+std::vector<BorderBuilder::Fragment> BorderBuilder::Stitch(std::vector<Band>& bands) const {
+    std::vector<Fragment> chains;
+    std::vector<Fragment*> open;
+    for (auto& band: bands) {
+        for (auto& fragment: band.fragments) {
+            if (fragment.isClosed) {
+                chains.emplace_back(std::move(fragment));
+            }
+            else {
+                open.push_back(&fragment);
+            }
+        }
+    }
+    if (open.empty()) {
+        return chains;
+    }
+
+    // only one side can leave the corner where fragments are cut
+    std::unordered_map<uint32_t, size_t> startsAt;
+    startsAt.reserve(open.size());
+    for (size_t i = 0U; i < open.size(); i++) {
+        startsAt.emplace(open[i]->vertices.front(), i);
+    }
+    constexpr size_t NONE { static_cast<size_t>(-1) };
+    std::vector<size_t> next(open.size(), NONE);
+    std::vector<char> hasPrevious(open.size(), false);
+    for (size_t i = 0U; i < open.size(); i++) {
+        if (auto it = startsAt.find(open[i]->vertices.back()); it != startsAt.end() && it->second != i) {
+            next[i] = it->second;
+            hasPrevious[it->second] = true;
+        }
+    }
+
+    std::vector<char> isUsed(open.size(), false);
+    const auto Join = [&](size_t first) {
+        Fragment chain { std::move(open[first]->vertices), false };
+        isUsed[first] = true;
+        for (auto i = next[first]; i != NONE; i = next[i]) {
+            if (isUsed[i]) {
+                // came back to the first fragment
+                chain.isClosed = true;
+                break;
+            }
+            isUsed[i] = true;
+            const auto& vertices { open[i]->vertices };
+            // the first corner is the last corner of the previous fragment
+            chain.vertices.insert(chain.vertices.end(), std::next(vertices.begin()), vertices.end());
+        }
+        chains.emplace_back(std::move(chain));
+    };
+    for (size_t i = 0U; i < open.size(); i++) {
+        if (!hasPrevious[i]) {
+            Join(i);
+        }
+    }
+    // the rest are loops crossing the bands
+    for (size_t i = 0U; i < open.size(); i++) {
+        if (!isUsed[i]) {
+            Join(i);
+        }
+    }
+    return chains;
+}
@@ -0,0 +1,107 @@
+#ifndef BORDER_BUILDER_HPP
+#define BORDER_BUILDER_HPP
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace TileMap {
+    struct Cache;
+}
+
+namespace details {
+    struct Form;
+}
+
+/**
+ * Extract edge chains of the composite physics bodies from the border tiles.
+ *
+ * The chain runs along the sides of the border tiles which face free tiles
+ * (neither border nor solid) and is traced marching squares style over
+ * the corners of the tiles. Every border tile is walked clockwise,
+ * tiles touching only by a corner belong to different chains.
+ * Collinear points are dropped so a chain keeps only its corners.
+ *
+ * Chains are closed (the last point repeats the first one) when they
+ * surround a body and open when they end at the map's edge or a solid tile.
+ *
+ * Sides lying on the map's edge are never a part of the chain, unlike
+ * the former tile walk which emitted them: the outside of the map is
+ * unreachable, so a body cut by the edge gets an open chain running along
+ * its inner sides with both ends on the edge. A border tile whose only
+ * free neighbours are outside the map doesn't produce a chain at all.
+ * Run the headless runner with `--borders` to compare both on a level.
+ *
+ * Big maps are split into horizontal bands traced on worker threads,
+ * pieces of the chains crossing the bands are stitched afterwards.
+ */
+class BorderBuilder final {
+public:
+    explicit BorderBuilder(const TileMap::Cache * cache);
+
+    /**
+     * @return forms of `core::CategoryName::BORDER` type with points in map's coordinates
+     */
+    std::vector<details::Form> Build();
+
+private:
+    // part of the chain traced in one band
+    struct Fragment final {
+        std::vector<uint32_t> vertices;
+        bool isClosed { false };
+    };
+
+    struct Band final {
+        size_t first { 0U };
+        size_t last { 0U };
+        std::vector<Fragment> fragments;
+    };
+
+    /**
+     * Find the border sides of the tiles of the rows [first, last).
+     */
+    void FillCells(size_t first, size_t last) noexcept;
+
+    /**
+     * Trace sides of the band's tiles into fragments.
+     */
+    void TraceBand(Band& band);
+
+    /**
+     * Walk from the side `face` of the tile (x, y) until the chain ends
+     * or leaves the band.
+     */
+    void Trace(const Band& band, size_t x, size_t y, uint8_t face, Fragment& fragment);
+
+    /**
+     * @return whether the side `face` of the tile (x, y) is a part of the border
+     */
+    bool HasSide(int64_t x, int64_t y, uint8_t face) const noexcept;
+
+    /**
+     * Choose the way out of the corner (x, y) entered in `direction`.
+     * The touching tiles are separated by turning right.
+     *
+     * @return the direction or `NO_WAY`
+     */
+    uint8_t GetNextDirection(int64_t x, int64_t y, uint8_t direction) const noexcept;
+
+    /**
+     * Join the fragments ending and starting at the same corner.
+     */
+    std::vector<Fragment> Stitch(std::vector<Band>& bands) const;
+
+    const TileMap::Cache * const m_cache { nullptr };
+
+    const size_t m_width { 0U };
+
+    const size_t m_height { 0U };
+
+    // row-major flat mask of the tiles: bit `1 << face` is set for the border side
+    std::vector<uint8_t> m_cells;
+
+    // row-major flat mask of the sides already added to the chains
+    std::vector<uint8_t> m_visited;
+};
+
+#endif // BORDER_BUILDER_HPP
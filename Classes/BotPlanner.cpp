@@ -0,0 +1,121 @@
+#include "BotPlanner.hpp"
+
+#include "units/Bot.hpp"
+#include "scenes/LevelScene.hpp"
+#include "FrameSampler.hpp"
+#include "Profiler.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <thread>
+
+namespace Enemies {
+
+Snapshot Snapshot::Of(const Unit * target) noexcept {
+    Snapshot snapshot;
+    if (target) {
+        snapshot.hasTarget = true;
+        snapshot.isTargetDead = target->IsDead();
+        snapshot.targetPosition = target->getPosition();
+        snapshot.targetHitBox = target->GetHitBox();
+        snapshot.targetSize = target->getContentSize();
+    }
+    return snapshot;
+}
+
+} // namespace Enemies
+
+namespace {
+
+size_t GetWorkerCount() noexcept {
+    const size_t hardwareThreads { std::max(1U, std::thread::hardware_concurrency()) };
+    // the calling thread takes part in the loop
+    return hardwareThreads - 1U;
+}
+
+} // namespace {
+
+BotPlanner::BotPlanner()
+    : m_pool { ::GetWorkerCount() }
+{
+    m_bots.reserve(64U);
+    m_isActive.reserve(64U);
+    m_commands.reserve(64U);
+}
+
+uint32_t BotPlanner::Add(Enemies::Bot * bot) {
+    assert(bot);
+    uint32_t index { 0U };
+    if (!m_free.empty()) {
+        index = m_free.back();
+        m_free.pop_back();
+        m_bots[index] = bot;
+        m_isActive[index] = 1U;
+        m_commands[index] = Enemies::Command{};
+    }
+    else {
+        index = static_cast<uint32_t>(m_bots.size());
+        m_bots.push_back(bot);
+        m_isActive.push_back(1U);
+        m_commands.emplace_back();
+    }
+    m_size++;
+    return index;
+}
+
+void BotPlanner::Remove(uint32_t index) noexcept {
+    if (index >= m_bots.size() || !m_bots[index]) {
+        return;
+    }
+    m_bots[index] = nullptr;
+    m_commands[index] = Enemies::Command{};
+    m_free.push_back(index);
+    m_size--;
+}
+
+void BotPlanner::SetActive(uint32_t index, bool isActive) noexcept {
+    if (index >= m_bots.size() || !m_bots[index]) {
+        return;
+    }
+    m_isActive[index] = isActive? 1U: 0U;
+}
+
+void BotPlanner::Update(const Unit * target) {
+    const bench::ScopedSample sample { bench::Subsystem::UNITS };
+    const auto snapshot { Enemies::Snapshot::Of(target) };
+    const auto count { m_bots.size() };
+    if (m_size < MIN_PARALLEL_BOTS) {
+        this->Decide(snapshot, 0U, count);
+    }
+    else {
+        m_pool.ParallelFor(count, GRAIN, [this, &snapshot](size_t begin, size_t end) {
+            this->Decide(snapshot, begin, end);
+        });
+    }
+    // commands touch the physics bodies and nodes
+    for (size_t i = 0; i < count; i++) {
+        // the bot can be removed by the command of the previous one
+        if (m_bots[i] && m_commands[i]) {
+            m_bots[i]->Apply(m_commands[i]);
+        }
+    }
+}
+
+void BotPlanner::Decide(const Enemies::Snapshot& snapshot, size_t begin, size_t end) noexcept {
+    // recorded by the thread which took the chunk
+    PROFILE_ZONE("BotPlanner::Decide");
+    for (size_t i = begin; i < end; i++) {
+        const auto bot { m_bots[i] };
+        m_commands[i] = (bot && m_isActive[i] && !bot->IsDead())?
+            bot->Decide(snapshot): Enemies::Command{};
+    }
+}
+
+BotPlanner* BotPlanner::Find(const cocos2d::Node * node) noexcept {
+    for (auto parent = node; parent; parent = parent->getParent()) {
+        if (const auto level = dynamic_cast<const LevelScene*>(parent); level) {
+            return level->GetPlanner();
+        }
+    }
+    return nullptr;
+}
@@ -0,0 +1,144 @@
+#ifndef BOT_PLANNER_HPP
+#define BOT_PLANNER_HPP
+
+#include "WorkerPool.hpp"
+#include "components/Movement.hpp"
+
+#include "math/Vec2.h"
+#include "math/CCGeometry.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace cocos2d {
+    class Node;
+}
+class Unit;
+
+namespace Enemies {
+
+class Bot;
+
+/**
+ * State of the bots' target taken before the decision phase,
+ * so the bots don't touch the target's node from the worker threads.
+ */
+struct Snapshot final {
+    bool hasTarget { false };
+
+    bool isTargetDead { true };
+
+    // bottom middle of the target
+    cocos2d::Vec2 targetPosition {};
+
+    cocos2d::Size targetHitBox {};
+
+    cocos2d::Size targetSize {};
+
+    static Snapshot Of(const Unit * target) noexcept;
+};
+
+/**
+ * What the bot is going to do in this tick.
+ * It's decided on a worker thread and applied on the main one.
+ */
+struct Command final {
+    // applied in the order of declaration
+    enum Action : uint8_t {
+        // look at the point
+        TURN    = 1U << 0,
+        STOP    = 1U << 1,
+        // move along the direction
+        MOVE    = 1U << 2,
+        // navigate to the point
+        VISIT   = 1U << 3,
+        // launch the attack
+        ATTACK  = 1U << 4
+    };
+
+    uint8_t actions { 0U };
+
+    // bot-specific kind of the attack, e.g. one of the boss's weapons
+    uint8_t attack { 0U };
+
+    Movement::Direction direction { Movement::Direction::LEFT };
+
+    cocos2d::Vec2 point {};
+
+    explicit operator bool() const noexcept {
+        return actions != 0U;
+    }
+
+    bool Has(Action action) const noexcept {
+        return (actions & action) != 0U;
+    }
+};
+
+} // namespace Enemies
+
+/**
+ * Level-owned decision phase of the bots.
+ *
+ * Each tick the target is snapshotted, then the bots decide what to do
+ * in parallel on the worker pool and finally their commands are applied
+ * on the calling thread, because they touch the physics bodies and nodes.
+ * While the bots decide nothing else runs, so `Bot::Decide` may read
+ * the bot's own state (position, health, weapons) but must not modify
+ * anything or read other nodes.
+ */
+class BotPlanner final {
+public:
+    static constexpr uint32_t INVALID_BOT { UINT32_MAX };
+
+    // below it the bots decide on the calling thread: waking the workers costs more
+    static constexpr size_t MIN_PARALLEL_BOTS { 64U };
+
+    // bots decided by a worker at once
+    static constexpr size_t GRAIN { 16U };
+
+    BotPlanner();
+
+    uint32_t Add(Enemies::Bot * bot);
+
+    void Remove(uint32_t index) noexcept;
+
+    /**
+     * Inactive bots don't decide, e.g. while they're paused.
+     */
+    void SetActive(uint32_t index, bool isActive) noexcept;
+
+    /**
+     * Let the bots decide about the target and apply their commands.
+     *
+     * @param target the player or nullptr
+     */
+    void Update(const Unit * target);
+
+    size_t GetSize() const noexcept {
+        return m_size;
+    }
+
+    /**
+     * Find the planner of the level the node belongs to.
+     */
+    static BotPlanner* Find(const cocos2d::Node * node) noexcept;
+
+private:
+    void Decide(const Enemies::Snapshot& snapshot, size_t begin, size_t end) noexcept;
+
+    // nullptr for the removed bot
+    std::vector<Enemies::Bot*> m_bots;
+
+    std::vector<uint8_t> m_isActive;
+
+    // written by the workers, each to the bot's own slot
+    std::vector<Enemies::Command> m_commands;
+
+    std::vector<uint32_t> m_free;
+
+    size_t m_size { 0U };
+
+    WorkerPool m_pool;
+};
+
+#endif // BOT_PLANNER_HPP
@@ -2,6 +2,8 @@
 #include "Utils.hpp"
 #include "Core.hpp"
 #include "PhysicsHelper.hpp"
+#include "Profiler.hpp"
+#include "FlightRecorder.hpp"
 
 #include "components/Traps.hpp"
 #include "components/Props.hpp"
@@ -14,137 +16,189 @@
 
 #include "cocos2d.h"
 
+#include <array>
+#include <cassert>
+#include <cstdint>
+
 namespace contact {
 
-bool OnContactBegin(cocos2d::PhysicsContact& contact) {
-    enum { BODY_A, BODY_B };
+namespace {
 
-    cocos2d::PhysicsShape * const shapes[2] = { 
-        contact.getShapeA(),
-        contact.getShapeB() 
-    };
-    cocos2d::PhysicsBody * const bodies[2] = { 
-        shapes[BODY_A]->getBody(),
-        shapes[BODY_B]->getBody()
-    };
-    cocos2d::Node * const nodes[2] = { 
-        bodies[BODY_A]->getNode(),
-        bodies[BODY_B]->getNode() 
-    };
-    
-    if(!nodes[BODY_A] || !nodes[BODY_B]) {
-        return false;
+    using core::CategoryBits;
+
+    // number of the bits in core::CategoryBits
+    constexpr size_t CATEGORY_COUNT { 10U };
+    // index of the empty or multi-bit masks
+    constexpr size_t OTHER { CATEGORY_COUNT };
+    constexpr size_t INDEX_COUNT { CATEGORY_COUNT + 1U };
+
+    constexpr size_t Index(CategoryBits bit) noexcept {
+        size_t index { 0U };
+        for (auto mask = Utils::EnumCast(bit); mask > 1U; mask >>= 1U) {
+            index++;
+        }
+        return index;
     }
 
-    const bool isUnitSensor[2] = { 
-        shapes[BODY_A]->getCategoryBitmask() == Utils::CreateMask(core::CategoryBits::GROUND_SENSOR),
-        shapes[BODY_B]->getCategoryBitmask() == Utils::CreateMask(core::CategoryBits::GROUND_SENSOR)
+    static_assert(Index(CategoryBits::HITBOX_SENSOR) + 1U == CATEGORY_COUNT,
+        "Update CATEGORY_COUNT when a category is added");
+
+    /**
+     * Bit index of the category mask.
+     * A body belongs to one category: unlike the bitwise tests of the masks,
+     * the table can't match a body to several categories at once.
+     * Bodies without a category (e.g. fire cloud) are matched only by ANY.
+     */
+    inline size_t Index(std::uint32_t mask) noexcept {
+        assert((mask & (mask - 1U)) == 0U && "A body must belong to one category");
+        if (mask == 0U || (mask & (mask - 1U)) != 0U) {
+            return OTHER;
+        }
+        size_t index { 0U };
+        while ((mask & 1U) == 0U && index < CATEGORY_COUNT) {
+            mask >>= 1U;
+            index++;
+        }
+        return index;
+    }
+
+    /**
+     * Participants of the contact ordered as the matched rule expects:
+     * the side `0` satisfies the first mask of the rule.
+     */
+    struct Pair final {
+        cocos2d::PhysicsBody * bodies[2];
+        cocos2d::Node * nodes[2];
+        size_t categories[2];
     };
 
-    // There are nodes one of which is with unit sensor attached 
-    // i.e. basicaly it's unit and other collidable body
-    if (isUnitSensor[BODY_A] || isUnitSensor[BODY_B]) {
-        Unit * unit { static_cast<Unit*>(isUnitSensor[BODY_A]? nodes[BODY_A] : nodes[BODY_B]) };
-        unit->EnableContactWithGround();
+    using Handler = bool(*)(const Pair& pair);
 
-        return true;
-    } 
-    
-    /// Platform & Unit
-    const int bodyMasks[2] = {
-        bodies[BODY_A]->getCategoryBitmask(),
-        bodies[BODY_B]->getCategoryBitmask()
+    /**
+     * The contact of two sides is handled by the first rule
+     * which masks include categories of these sides (in any order).
+     */
+    struct Rule final {
+        size_t first;
+        size_t second;
+        Handler handler;
     };
 
-    const bool isPlatform[2] = {
-        bodyMasks[BODY_A] == Utils::CreateMask(core::CategoryBits::PLATFORM),
-        bodyMasks[BODY_B] == Utils::CreateMask(core::CategoryBits::PLATFORM)
+    struct Entry final {
+        Handler handler { nullptr };
+        // index of the matched rule, number of rules for the fallback
+        std::uint8_t rule { 0U };
+        // the participants must be swapped to match the rule
+        bool swap { false };
     };
 
-    const auto unitMask { 
-        Utils::CreateMask(core::CategoryBits::PLAYER, core::CategoryBits::ENEMY) 
-    };
-    const bool isUnit[2] = {
-        (bodyMasks[BODY_A] & unitMask) > 0,
-        (bodyMasks[BODY_B] & unitMask) > 0
-    };
+    using Table = std::array<std::array<Entry, INDEX_COUNT>, INDEX_COUNT>;
+
+    constexpr size_t ANY { ~size_t{ 0U } };
+
+    // bodies out of categories are matched only by ANY
+    constexpr bool Matches(size_t mask, size_t index) noexcept {
+        if (index >= CATEGORY_COUNT) {
+            return mask == ANY;
+        }
+        return (mask & (size_t{ 1U } << index)) > 0U;
+    }
+
+    template<size_t N>
+    constexpr Table BuildTable(const std::array<Rule, N>& rules, Handler fallback) noexcept {
+        Table table {};
+        for (size_t a = 0U; a < INDEX_COUNT; a++) {
+            for (size_t b = 0U; b < INDEX_COUNT; b++) {
+                table[a][b] = Entry { fallback, static_cast<std::uint8_t>(N), false };
+                for (size_t i = 0U; i < N; i++) {
+                    const auto& rule { rules[i] };
+                    if (Matches(rule.first, a) && Matches(rule.second, b)) {
+                        table[a][b] = Entry { rule.handler, static_cast<std::uint8_t>(i), false };
+                        break;
+                    }
+                    if (Matches(rule.first, b) && Matches(rule.second, a)) {
+                        table[a][b] = Entry { rule.handler, static_cast<std::uint8_t>(i), true };
+                        break;
+                    }
+                }
+            }
+        }
+        return table;
+    }
+
+    constexpr bool IsEnemy(const Pair& pair, size_t side) noexcept {
+        return pair.categories[side] == Index(CategoryBits::ENEMY);
+    }
 
-    if((isPlatform[BODY_A] || isPlatform[BODY_B]) && (isUnit[BODY_A] || isUnit[BODY_B])) {
-        const auto platformIndex { isPlatform[BODY_A]? BODY_A: BODY_B };
-        const auto moveUpwards { helper::IsGreater(bodies[platformIndex ^ 1]->getVelocity().y, 0.f, 0.000001f) };
+    constexpr size_t UNIT { Utils::CreateMask(CategoryBits::PLAYER, CategoryBits::ENEMY) };
+    constexpr size_t PROJECTILE { Utils::CreateMask(CategoryBits::PLAYER_PROJECTILE, CategoryBits::ENEMY_PROJECTILE) };
+
+    /// Contact begin
+
+    bool Proceed(const Pair&) {
+        return true;
+    }
+
+    // There are nodes one of which is with unit sensor attached
+    // i.e. basicaly it's unit and other collidable body
+    bool BeginSensor(const Pair& pair) {
+        const auto unit { static_cast<Unit*>(pair.nodes[0]) };
+        unit->EnableContactWithGround();
+        return true;
+    }
+
+    bool BeginPlatform(const Pair& pair) {
+        const auto platform { pair.nodes[0] };
+        const auto unit { pair.nodes[1] };
+        const auto moveUpwards { helper::IsGreater(pair.bodies[1]->getVelocity().y, 0.f, 0.000001f) };
 
         // Ordinates before collision:
-        const auto unitBottomOrdinate { nodes[platformIndex ^ 1]->getPosition().y };
-        const auto platformTopOrdinate { 
-            nodes[platformIndex]->getPosition().y + 
-            nodes[platformIndex]->getContentSize().height / 2.f
+        const auto unitBottomOrdinate { unit->getPosition().y };
+        const auto platformTopOrdinate {
+            platform->getPosition().y +
+            platform->getContentSize().height / 2.f
         };
         const auto canPassThrough { helper::IsLesser(unitBottomOrdinate, platformTopOrdinate, 0.00001f) };
-        
+
         return !(moveUpwards || canPassThrough);
     }
 
-    /// Spikes & Unit
-    const bool isTrap[2] = {
-        bodyMasks[BODY_A] == Utils::CreateMask(core::CategoryBits::TRAP),
-        bodyMasks[BODY_B] == Utils::CreateMask(core::CategoryBits::TRAP)
-    };
-    if(isTrap[BODY_A] || isTrap[BODY_B]) {
-        const auto trapIndex { isTrap[BODY_A]? BODY_A: BODY_B };
-
-        const auto unit { static_cast<Unit*>(nodes[trapIndex^1]) };
-        const auto trap { static_cast<traps::Trap*>(nodes[trapIndex]) };
-        
+    bool BeginTrap(const Pair& pair) {
+        const auto trap { static_cast<traps::Trap*>(pair.nodes[0]) };
+        const auto unit { static_cast<Unit*>(pair.nodes[1]) };
         trap->CurseTarget(unit);
-
         return false;
     }
 
-    /// Unit & Unit
-    if(isUnit[BODY_A] && isUnit[BODY_B]) {
-        const auto enemyMask { Utils::CreateMask(core::CategoryBits::ENEMY) };
-        const auto playerIndex { (bodyMasks[BODY_A] & enemyMask) ? BODY_B: BODY_A };
-        const auto enemiesCount { 
-            ((bodyMasks[BODY_A] & enemyMask) > 0) 
-            + ((bodyMasks[BODY_B] & enemyMask) > 0) 
-        };
-        if (enemiesCount == 1) {
-            const auto player { static_cast<Unit*>(nodes[playerIndex]) };
-            const auto enemy { static_cast<Enemies::Bot*>(nodes[playerIndex^1]) };
+    bool BeginUnits(const Pair& pair) {
+        if (IsEnemy(pair, 0) != IsEnemy(pair, 1)) {
+            const auto playerIndex { IsEnemy(pair, 0)? 1U: 0U };
+            const auto player { static_cast<Unit*>(pair.nodes[playerIndex]) };
+            const auto enemy { static_cast<Enemies::Bot*>(pair.nodes[playerIndex ^ 1U]) };
             player->AddCurse<curses::CurseClass::DPS>(enemy->GetId(), Player::DAMAGE_ON_CONTACT, curses::UNLIMITED);
         }
         return false;
     }
 
-    /// Projectile & (Unit or Barrel)
-    const auto projectileMask { 
-        Utils::CreateMask(core::CategoryBits::PLAYER_PROJECTILE, core::CategoryBits::ENEMY_PROJECTILE)
-    };
-    const bool isProjectile[2] = {
-        (bodyMasks[BODY_A] & projectileMask) > 0,
-        (bodyMasks[BODY_B] & projectileMask) > 0
-    };
-
-    if(isProjectile[BODY_A] && isProjectile[BODY_B]) {
-        const auto projA { static_cast<Projectile*>(nodes[BODY_A]) };
-        const auto projB { static_cast<Projectile*>(nodes[BODY_B]) };
-        projA->Collapse();
-        projB->Collapse();
+    bool BeginProjectiles(const Pair& pair) {
+        static_cast<Projectile*>(pair.nodes[0])->Collapse();
+        static_cast<Projectile*>(pair.nodes[1])->Collapse();
         return false;
     }
-    else if(isProjectile[BODY_A] || isProjectile[BODY_B]) {
-        const auto projectileIndex { isProjectile[BODY_A]? BODY_A: BODY_B };
-        const auto proj { static_cast<Projectile*>(nodes[projectileIndex]) };
+
+    // Projectile & (Unit or Barrel or anything else)
+    bool BeginProjectile(const Pair& pair) {
+        const auto proj { static_cast<Projectile*>(pair.nodes[0]) };
         proj->SetExplosionState(Projectile::State::HIT_GROUND);
-        
+
         // damage target if possible
-        if(isUnit[projectileIndex ^ 1]) {
-            const auto unit { static_cast<Unit*>(nodes[projectileIndex ^ 1]) };
+        if (Matches(UNIT, pair.categories[1])) {
+            const auto unit { static_cast<Unit*>(pair.nodes[1]) };
             unit->AddCurse<curses::CurseClass::INSTANT>(curses::CurseHub::ignored, proj->GetDamage());
             proj->SetExplosionState(Projectile::State::HIT_PLAYER);
-        } 
-        else if(bodyMasks[projectileIndex ^ 1] == Utils::CreateMask(core::CategoryBits::PROPS)) {
-            const auto prop { static_cast<props::Prop*>(nodes[projectileIndex^1]) };
+        }
+        else if (pair.categories[1] == Index(CategoryBits::PROPS)) {
+            const auto prop { static_cast<props::Prop*>(pair.nodes[1]) };
             prop->Explode();
         }
 
@@ -154,46 +208,11 @@ bool OnContactBegin(cocos2d::PhysicsContact& contact) {
         return false;
     }
 
-    return true;
-}
-
-bool OnContactSeparate(cocos2d::PhysicsContact& contact) {
-    enum { BODY_A, BODY_B };
+    /// Contact separate
 
-    cocos2d::PhysicsShape * const shapes[2] = { 
-        contact.getShapeA(),
-        contact.getShapeB() 
-    };
-    cocos2d::PhysicsBody * const bodies[2] = { 
-        shapes[BODY_A]->getBody(),
-        shapes[BODY_B]->getBody()
-    };
-    cocos2d::Node * const nodes[2] = { 
-        bodies[BODY_A]->getNode(),
-        bodies[BODY_B]->getNode() 
-    };
-
-    if( !nodes[BODY_A] || !nodes[BODY_B] ) {
-        return false;
-    }
-
-    const int bodyMasks[2] = {
-        bodies[BODY_A]->getCategoryBitmask(),
-        bodies[BODY_B]->getCategoryBitmask()
-    };
-
-    bool isUnitSensor[2] = { 
-        shapes[BODY_A]->getCategoryBitmask() == Utils::CreateMask(core::CategoryBits::GROUND_SENSOR),
-        shapes[BODY_B]->getCategoryBitmask() == Utils::CreateMask(core::CategoryBits::GROUND_SENSOR)
-    };
-
-    if (nodes[BODY_A] && nodes[BODY_B] && (isUnitSensor[BODY_A] || isUnitSensor[BODY_B]) ) {
-        const auto unit { static_cast<Unit*>(isUnitSensor[BODY_A]? nodes[BODY_A] : nodes[BODY_B]) };
-        bool onGround {
-            isUnitSensor[BODY_A]? 
-                helper::IsEqual(bodies[BODY_A]->getVelocity().y, 0.f, 0.000001f):
-                helper::IsEqual(bodies[BODY_B]->getVelocity().y, 0.f, 0.000001f)
-        };
+    bool SeparateSensor(const Pair& pair) {
+        const auto unit { static_cast<Unit*>(pair.nodes[0]) };
+        const bool onGround { helper::IsEqual(pair.bodies[0]->getVelocity().y, 0.f, 0.000001f) };
         if (onGround) {
             unit->EnableContactWithGround();
         }
@@ -203,45 +222,92 @@ bool OnContactSeparate(cocos2d::PhysicsContact& contact) {
         return true;
     }
 
-    // handle contact of spikes and unit
-    const bool isTrap[2] = {
-        bodyMasks[BODY_A] == Utils::CreateMask(core::CategoryBits::TRAP),
-        bodyMasks[BODY_B] == Utils::CreateMask(core::CategoryBits::TRAP)
-    };
-    if( isTrap[BODY_A] || isTrap[BODY_B] ) {
-        const auto trapIndex { isTrap[BODY_A]? BODY_A: BODY_B };
-
-        const auto unit { static_cast<Unit*>(nodes[trapIndex^1]) };
-        const auto trap { static_cast<traps::Trap*>(nodes[trapIndex]) };
-        
+    bool SeparateTrap(const Pair& pair) {
+        const auto trap { static_cast<traps::Trap*>(pair.nodes[0]) };
+        const auto unit { static_cast<Unit*>(pair.nodes[1]) };
         trap->RemoveCurse(unit);
-
         return false;
     }
 
-    /// Unit & Unit
-    const auto unitMask { Utils::CreateMask(core::CategoryBits::PLAYER, core::CategoryBits::ENEMY) };
-    const bool isUnit[2] = {
-        (bodyMasks[BODY_A] & unitMask) > 0,
-        (bodyMasks[BODY_B] & unitMask) > 0
-    };
-    if(isUnit[BODY_A] && isUnit[BODY_B]) {
-        const auto enemyMask { Utils::CreateMask(core::CategoryBits::ENEMY) };
-        const auto playerIndex { (bodyMasks[BODY_A] & enemyMask) > 0 ? BODY_B: BODY_A };
-        const auto enemiesCount { 
-            ((bodyMasks[BODY_A] & enemyMask) > 0) 
-            + ((bodyMasks[BODY_B] & enemyMask) > 0) 
-        };
-        if (enemiesCount == 1) {
-            const auto player { static_cast<Unit*>(nodes[playerIndex]) };
-            const auto enemy { static_cast<Enemies::Bot*>(nodes[playerIndex^1]) };
+    bool SeparateUnits(const Pair& pair) {
+        if (IsEnemy(pair, 0) != IsEnemy(pair, 1)) {
+            const auto playerIndex { IsEnemy(pair, 0)? 1U: 0U };
+            const auto player { static_cast<Unit*>(pair.nodes[playerIndex]) };
+            const auto enemy { static_cast<Enemies::Bot*>(pair.nodes[playerIndex ^ 1U]) };
             player->RemoveCurse(enemy->GetId());
         }
         return false;
     }
 
+    // Rules are ordered by priority.
+    // A new category only needs its rules here.
+    constexpr std::array<Rule, 6U> BEGIN_RULES {
+        Rule { Utils::CreateMask(CategoryBits::GROUND_SENSOR), ANY, &BeginSensor },
+        Rule { Utils::CreateMask(CategoryBits::PLATFORM), UNIT, &BeginPlatform },
+        Rule { Utils::CreateMask(CategoryBits::TRAP), ANY, &BeginTrap },
+        Rule { UNIT, UNIT, &BeginUnits },
+        Rule { PROJECTILE, PROJECTILE, &BeginProjectiles },
+        Rule { PROJECTILE, ANY, &BeginProjectile }
+    };
+
+    constexpr std::array<Rule, 3U> SEPARATE_RULES {
+        Rule { Utils::CreateMask(CategoryBits::GROUND_SENSOR), ANY, &SeparateSensor },
+        Rule { Utils::CreateMask(CategoryBits::TRAP), ANY, &SeparateTrap },
+        Rule { UNIT, UNIT, &SeparateUnits }
+    };
+
+    constexpr Table BEGIN_TABLE { BuildTable(BEGIN_RULES, &Proceed) };
+    constexpr Table SEPARATE_TABLE { BuildTable(SEPARATE_RULES, &Proceed) };
+
+    /**
+     * Classify the participants by the category of the body.
+     * The ground sensor is a shape of the unit's body so its shape category is used.
+     */
+    inline size_t Classify(std::uint32_t shapeMask, std::uint32_t bodyMask) noexcept {
+        const auto sensor { Utils::CreateMask(CategoryBits::GROUND_SENSOR) };
+        if (static_cast<size_t>(shapeMask) == sensor) {
+            return Index(CategoryBits::GROUND_SENSOR);
+        }
+        return Index(bodyMask);
+    }
+
+    bool Dispatch(const Table& table, cocos2d::PhysicsContact& contact) {
+        const auto shapeA { contact.getShapeA() };
+        const auto shapeB { contact.getShapeB() };
+        const auto bodyA { shapeA->getBody() };
+        const auto bodyB { shapeB->getBody() };
+        const auto nodeA { bodyA->getNode() };
+        const auto nodeB { bodyB->getNode() };
+        if (!nodeA || !nodeB) {
+            return false;
+        }
+        const auto categoryA { Classify(static_cast<std::uint32_t>(shapeA->getCategoryBitmask())
+            , static_cast<std::uint32_t>(bodyA->getCategoryBitmask())) };
+        const auto categoryB { Classify(static_cast<std::uint32_t>(shapeB->getCategoryBitmask())
+            , static_cast<std::uint32_t>(bodyB->getCategoryBitmask())) };
+        const auto& entry { table[categoryA][categoryB] };
+        const Pair pair = entry.swap?
+            Pair { { bodyB, bodyA }, { nodeB, nodeA }, { categoryB, categoryA } }:
+            Pair { { bodyA, bodyB }, { nodeA, nodeB }, { categoryA, categoryB } };
+        return entry.handler(pair);
+    }
+
+} // namespace {
+
+bool OnContactBegin(cocos2d::PhysicsContact& contact) {
+    PROFILE_ZONE("contact::OnContactBegin");
+    bench::FlightRecorder::GetInstance().CountContact();
+    return Dispatch(BEGIN_TABLE, contact);
+}
+
+bool OnContactSeparate(cocos2d::PhysicsContact& contact) {
+    return Dispatch(SEPARATE_TABLE, contact);
+}
 
-    return true;
+size_t MatchBeginRule(std::uint32_t shapeA, std::uint32_t bodyA
+    , std::uint32_t shapeB, std::uint32_t bodyB) noexcept
+{
+    return BEGIN_TABLE[Classify(shapeA, bodyA)][Classify(shapeB, bodyB)].rule;
 }
 
-} // namespace contact
\ No newline at end of file
+} // namespace contact
@@ -1,6 +1,9 @@
 #ifndef CONTACT_HANDLER_HPP
 #define CONTACT_HANDLER_HPP
 
+#include <cstddef>
+#include <cstdint>
+
 namespace cocos2d {
     class PhysicsContact;
 }
@@ -11,6 +14,15 @@ namespace contact {
 
     bool OnContactSeparate(cocos2d::PhysicsContact& contact);
 
+    /**
+     * Index of the rule handling the begin of the contact of two shapes
+     * given by the category masks of the shape and of its body;
+     * the number of rules if the contact just proceeds.
+     * Doesn't touch the participants, so the recorded contacts can be replayed.
+     */
+    size_t MatchBeginRule(std::uint32_t shapeA, std::uint32_t bodyA
+        , std::uint32_t shapeB, std::uint32_t bodyB) noexcept;
+
 } // namespace contact
 
 #endif // CONTACT_HANDLER_HPP
\ No newline at end of file
@@ -0,0 +1,151 @@
+#include "EntityRegistry.hpp"
+
+#include "units/Unit.hpp"
+#include "scenes/LevelScene.hpp"
+#include "Core.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace {
+
+    // units have bottom-middle anchor
+    cocos2d::Rect GetBoundingBox(const Unit * unit) noexcept {
+        const auto size { unit->getContentSize() };
+        return cocos2d::Rect {
+            unit->getPosition() - cocos2d::Vec2{ size.width / 2.f, 0.f },
+            size
+        };
+    }
+
+} // namespace {
+
+EntityRegistry::EntityRegistry(const cocos2d::Size& mapSize, float cellSize)
+    : m_cellSize { cellSize }
+    , m_columns { std::max(1, static_cast<int>(std::ceil(mapSize.width / cellSize))) }
+    , m_rows { std::max(1, static_cast<int>(std::ceil(mapSize.height / cellSize))) }
+    , m_cells(static_cast<size_t>(m_columns * m_rows))
+{
+    assert(cellSize > 0.f);
+    m_slots.reserve(64U);
+}
+
+EntityHandle EntityRegistry::Register(Unit * unit) {
+    assert(unit);
+    uint32_t index { 0U };
+    if (!m_freeSlots.empty()) {
+        index = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    }
+    else {
+        index = static_cast<uint32_t>(m_slots.size());
+        m_slots.emplace_back();
+    }
+    auto& slot { m_slots[index] };
+    slot.unit = unit;
+    slot.box = ::GetBoundingBox(unit);
+    slot.cells = this->GetCells(slot.box);
+    this->Insert(index, slot.cells);
+    m_size++;
+
+    if (unit->getName() == core::EntityNames::PLAYER) {
+        m_player = unit;
+    }
+    return { index, slot.generation };
+}
+
+void EntityRegistry::Unregister(EntityHandle handle) noexcept {
+    const auto unit { this->Get(handle) };
+    if (!unit) {
+        return;
+    }
+    if (unit == m_player) {
+        m_player = nullptr;
+    }
+    auto& slot { m_slots[handle.index] };
+    this->Erase(handle.index, slot.cells);
+    slot.unit = nullptr;
+    slot.cells = CellRange{};
+    slot.generation++;
+    m_freeSlots.push_back(handle.index);
+    m_size--;
+}
+
+Unit* EntityRegistry::Get(EntityHandle handle) const noexcept {
+    if (handle.index >= m_slots.size()) {
+        return nullptr;
+    }
+    const auto& slot { m_slots[handle.index] };
+    return slot.generation == handle.generation? slot.unit: nullptr;
+}
+
+void EntityRegistry::Update() {
+    for (size_t index = 0U; index < m_slots.size(); index++) {
+        auto& slot { m_slots[index] };
+        if (!slot.unit) continue;
+
+        slot.box = ::GetBoundingBox(slot.unit);
+        const auto cells { this->GetCells(slot.box) };
+        if (cells == slot.cells) continue;
+
+        this->Erase(static_cast<uint32_t>(index), slot.cells);
+        this->Insert(static_cast<uint32_t>(index), cells);
+        slot.cells = cells;
+    }
+}
+
+Unit* EntityRegistry::FindPlayer(const cocos2d::Rect& area) const noexcept {
+    Unit * found { nullptr };
+    if (m_player) {
+        this->Query(area, [this, &found](Unit * unit) {
+            if (unit == m_player) {
+                found = unit;
+            }
+        });
+    }
+    return found;
+}
+
+EntityRegistry::CellRange EntityRegistry::GetCells(const cocos2d::Rect& area) const noexcept {
+    // units outside of the map are kept in the border cells
+    const auto ToCell = [this](float coord, int cells) {
+        return std::clamp(static_cast<int>(std::floor(coord / m_cellSize)), 0, cells - 1);
+    };
+    CellRange range;
+    range.minX = ToCell(area.getMinX(), m_columns);
+    range.maxX = ToCell(area.getMaxX(), m_columns);
+    range.minY = ToCell(area.getMinY(), m_rows);
+    range.maxY = ToCell(area.getMaxY(), m_rows);
+    return range;
+}
+
+void EntityRegistry::Insert(uint32_t index, const CellRange& cells) {
+    for (int y = cells.minY; y <= cells.maxY; y++) {
+        for (int x = cells.minX; x <= cells.maxX; x++) {
+            m_cells[static_cast<size_t>(y * m_columns + x)].push_back(index);
+        }
+    }
+}
+
+void EntityRegistry::Erase(uint32_t index, const CellRange& cells) noexcept {
+    for (int y = cells.minY; y <= cells.maxY; y++) {
+        for (int x = cells.minX; x <= cells.maxX; x++) {
+            auto& cell { m_cells[static_cast<size_t>(y * m_columns + x)] };
+            if (const auto it = std::find(cell.begin(), cell.end(), index); it != cell.end()) {
+                // the order of the cell's slots doesn't matter
+                *it = cell.back();
+                cell.pop_back();
+            }
+        }
+    }
+}
+
+EntityRegistry* EntityRegistry::Find(const cocos2d::Node * node) noexcept {
+    for (auto parent = node; parent; parent = parent->getParent()) {
+        if (const auto level = dynamic_cast<const LevelScene*>(parent); level) {
+            return level->GetRegistry();
+        }
+    }
+    return nullptr;
+}
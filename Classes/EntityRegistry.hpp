@@ -0,0 +1,153 @@
+#ifndef ENTITY_REGISTRY_HPP
+#define ENTITY_REGISTRY_HPP
+
+#include "math/CCGeometry.h" // cocos2d::Rect, cocos2d::Size
+
+#include <cstdint>
+#include <vector>
+
+namespace cocos2d {
+    class Node;
+}
+class Unit;
+
+/**
+ * Stable reference to the registered unit.
+ * Becomes invalid once the unit is unregistered: the slot's generation changes.
+ */
+struct EntityHandle final {
+    uint32_t index { INVALID_INDEX };
+    uint32_t generation { 0U };
+
+    static constexpr uint32_t INVALID_INDEX { UINT32_MAX };
+
+    bool IsValid() const noexcept {
+        return index != INVALID_INDEX;
+    }
+};
+
+/**
+ * Level-owned registry of the units.
+ *
+ * Units register themselves on entering the level (see Unit::onEnter)
+ * and unregister on exit, so lookups of the player or units in some area
+ * don't scan children of the tile map.
+ *
+ * Area queries use a uniform grid kept up to date by `Update`: the grid isn't
+ * rebuilt, a unit is moved between the cells only when its bounding box
+ * crosses a cell's edge.
+ */
+class EntityRegistry final {
+public:
+    static constexpr float DEFAULT_CELL_SIZE { 256.f };
+
+    explicit EntityRegistry(const cocos2d::Size& mapSize, float cellSize = DEFAULT_CELL_SIZE);
+
+    EntityHandle Register(Unit * unit);
+
+    void Unregister(EntityHandle handle) noexcept;
+
+    /**
+     * @return nullptr if the handle is outdated
+     */
+    Unit* Get(EntityHandle handle) const noexcept;
+
+    Unit* GetPlayer() const noexcept {
+        return m_player;
+    }
+
+    size_t GetSize() const noexcept {
+        return m_size;
+    }
+
+    /**
+     * Take the current bounding boxes of the units and move the units
+     * which crossed the edge of their cells.
+     */
+    void Update();
+
+    /**
+     * Invoke `visitor(Unit*)` for every unit which bounding box intersects the area.
+     * Bounding boxes are taken from the last `Update`.
+     */
+    template<class Visitor>
+    void Query(const cocos2d::Rect& area, Visitor&& visitor) const;
+
+    /**
+     * @return the player if its bounding box intersects the area, nullptr otherwise
+     */
+    Unit* FindPlayer(const cocos2d::Rect& area) const noexcept;
+
+    /**
+     * Find the registry of the level the node belongs to.
+     */
+    static EntityRegistry* Find(const cocos2d::Node * node) noexcept;
+
+private:
+    struct CellRange final {
+        int minX { 0 };
+        int minY { 0 };
+        int maxX { -1 };
+        int maxY { -1 };
+
+        bool operator==(const CellRange& other) const noexcept {
+            return minX == other.minX && minY == other.minY
+                && maxX == other.maxX && maxY == other.maxY;
+        }
+    };
+
+    struct Slot final {
+        Unit * unit { nullptr };
+        uint32_t generation { 0U };
+        // bounding box on the last update
+        cocos2d::Rect box;
+        // cells the slot is listed in
+        CellRange cells;
+        // used to report a unit once when it occupies several cells
+        mutable uint32_t queryStamp { 0U };
+    };
+
+    CellRange GetCells(const cocos2d::Rect& area) const noexcept;
+
+    void Insert(uint32_t index, const CellRange& cells);
+
+    void Erase(uint32_t index, const CellRange& cells) noexcept;
+
+    std::vector<Slot> m_slots;
+
+    std::vector<uint32_t> m_freeSlots;
+
+    size_t m_size { 0U };
+
+    Unit * m_player { nullptr };
+
+    const float m_cellSize { DEFAULT_CELL_SIZE };
+
+    const int m_columns { 1 };
+
+    const int m_rows { 1 };
+
+    // row-major: slots listed in each cell
+    std::vector<std::vector<uint32_t>> m_cells;
+
+    mutable uint32_t m_queryStamp { 0U };
+};
+
+template<class Visitor>
+void EntityRegistry::Query(const cocos2d::Rect& area, Visitor&& visitor) const {
+    const auto cells { this->GetCells(area) };
+    const auto stamp { ++m_queryStamp };
+    for (int y = cells.minY; y <= cells.maxY; y++) {
+        for (int x = cells.minX; x <= cells.maxX; x++) {
+            for (const auto index: m_cells[static_cast<size_t>(y * m_columns + x)]) {
+                const auto& slot { m_slots[index] };
+                if (slot.queryStamp != stamp && slot.box.intersectsRect(area)) {
+                    slot.queryStamp = stamp;
+                    visitor(slot.unit);
+                }
+            }
+        }
+    }
+}
+
+#endif // ENTITY_REGISTRY_HPP
@@ -0,0 +1,86 @@
+#include "FlightRecorder.hpp"
+
+#include "cocos2d.h"
+
+#include <algorithm>
+#include <fstream>
+
+namespace {
+
+    size_t CountNodes(const cocos2d::Node * node) {
+        size_t count { 1U };
+        for (const auto child: node->getChildren()) {
+            count += ::CountNodes(child);
+        }
+        return count;
+    }
+
+} // namespace {
+
+namespace bench {
+
+void FlightRecorder::Reset() noexcept {
+    m_current = FrameRecord{};
+    m_head = 0U;
+    m_cooldown = 0U;
+}
+
+void FlightRecorder::AddPhysicsTime(Clock::duration duration) noexcept {
+    m_current.physicsTime += std::chrono::duration<float, std::milli>(duration).count();
+}
+
+void FlightRecorder::EndFrame(const cocos2d::Node * root) {
+    const bool isSpike {
+        m_budget > 0.f && (m_current.frameTime > m_budget || m_current.updateTime > m_budget)
+    };
+    m_frames[m_head % CAPACITY] = m_current;
+    m_head++;
+    m_current = FrameRecord{};
+
+    if (m_cooldown > 0U) {
+        m_cooldown--;
+    }
+    else if (isSpike && m_captures < MAX_CAPTURES) {
+        if (this->Capture(root)) {
+            m_captures++;
+        }
+        // the capture itself makes the next frame long
+        m_cooldown = CAPACITY;
+    }
+}
+
+bool FlightRecorder::Capture(const cocos2d::Node * root) const {
+    const auto path {
+        cocos2d::FileUtils::getInstance()->getWritablePath()
+        + cocos2d::StringUtils::format("spike-%zu.json", m_captures)
+    };
+    std::ofstream file { path };
+    if (!file) {
+        return false;
+    }
+    file << "{\"budget\":" << m_budget
+        << ",\"nodes\":" << (root? ::CountNodes(root): 0U)
+        << ",\"frames\":[\n";
+    const auto count { std::min<uint64_t>(m_head, CAPACITY) };
+    // from the oldest to the offending one
+    for (uint64_t i = m_head - count; i < m_head; i++) {
+        const auto& frame { m_frames[i % CAPACITY] };
+        file << (i + count == m_head? "": ",\n")
+            << "{\"frame\":" << frame.frameTime
+            << ",\"update\":" << frame.updateTime
+            << ",\"physics\":" << frame.physicsTime
+            << ",\"ticks\":" << static_cast<unsigned>(frame.ticks)
+            << ",\"contacts\":" << frame.contacts
+            << ",\"projectiles\":" << frame.projectiles
+            << ",\"units\":" << frame.units
+            << ",\"animators\":" << frame.animators
+            << ",\"dx\":" << static_cast<int>(frame.dx)
+            << ",\"buttons\":" << static_cast<unsigned>(frame.buttons)
+            << "}";
+    }
+    file << "\n]}\n";
+    cocos2d::log("Frame spike: %s", path.c_str());
+    return static_cast<bool>(file);
+}
+
+} // namespace bench
@@ -0,0 +1,139 @@
+#ifndef FLIGHT_RECORDER_HPP
+#define FLIGHT_RECORDER_HPP
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+namespace cocos2d {
+    class Node;
+}
+
+namespace bench {
+
+/**
+ * Summary of a single frame kept by the flight recorder.
+ */
+struct FrameRecord final {
+    // time between the frames (milliseconds)
+    float frameTime { 0.f };
+    // time spent by the level's update including the physics (milliseconds)
+    float updateTime { 0.f };
+    // time spent by the physics steps (milliseconds)
+    float physicsTime { 0.f };
+    // physics contacts which began during the frame
+    uint16_t contacts { 0U };
+    uint16_t projectiles { 0U };
+    uint16_t units { 0U };
+    uint16_t animators { 0U };
+    uint8_t ticks { 0U };
+    // player's input: direction and the pressed buttons (see `Button`)
+    int8_t dx { 0 };
+    uint8_t buttons { 0U };
+};
+
+/**
+ * Always-on recorder of the last frames' summaries in a fixed ring buffer.
+ * When a frame exceeds the budget the whole window is written
+ * to the writable path as `spike-<N>.json`, so a stutter can be
+ * investigated without reproducing it.
+ *
+ * Costs a few clock reads per frame and per tick, so it's left enabled in release builds.
+ * Used from the main thread only.
+ */
+class FlightRecorder final {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr size_t CAPACITY { 600U };
+
+    // 3 frames at 60 FPS
+    static constexpr float DEFAULT_BUDGET { 50.f };
+
+    // don't fill the disk when the game stutters all the time
+    static constexpr size_t MAX_CAPTURES { 16U };
+
+    enum Button : uint8_t {
+        JUMP            = 1U << 0,
+        DASH            = 1U << 1,
+        MELEE_ATTACK    = 1U << 2,
+        RANGE_ATTACK    = 1U << 3,
+        SPECIAL_ATTACK  = 1U << 4
+    };
+
+    ~FlightRecorder() = default;
+
+    FlightRecorder(const FlightRecorder&) = delete;
+    FlightRecorder& operator=(const FlightRecorder&) = delete;
+    FlightRecorder(FlightRecorder&&) = delete;
+    FlightRecorder& operator=(FlightRecorder&&) = delete;
+
+    static FlightRecorder& GetInstance() noexcept {
+        static FlightRecorder recorder{};
+        return recorder;
+    }
+
+    /**
+     * @param budget frame time (milliseconds) which triggers the capture, 0 disables the captures
+     */
+    void SetBudget(float budget) noexcept {
+        m_budget = budget;
+    }
+
+    float GetBudget() const noexcept {
+        return m_budget;
+    }
+
+    /**
+     * Forget the recorded frames, e.g. after the level is loaded:
+     * the loading hitch isn't a stutter.
+     */
+    void Reset() noexcept;
+
+    /**
+     * The frame being recorded, filled during the frame
+     */
+    FrameRecord& GetCurrent() noexcept {
+        return m_current;
+    }
+
+    void CountContact() noexcept {
+        m_current.contacts++;
+    }
+
+    void AddPhysicsTime(Clock::duration duration) noexcept;
+
+    /**
+     * Push the current frame into the ring and capture the window if it exceeds the budget.
+     *
+     * @param root the node tree which size is written with the capture
+     */
+    void EndFrame(const cocos2d::Node * root);
+
+    size_t GetCaptureCount() const noexcept {
+        return m_captures;
+    }
+
+private:
+    FlightRecorder() = default;
+
+    bool Capture(const cocos2d::Node * root) const;
+
+    std::array<FrameRecord, CAPACITY> m_frames {};
+
+    FrameRecord m_current {};
+
+    // total number of the recorded frames, the latest is at `(m_head - 1) % CAPACITY`
+    uint64_t m_head { 0U };
+
+    // frames left before the next capture, the window is refilled meanwhile
+    size_t m_cooldown { 0U };
+
+    size_t m_captures { 0U };
+
+    float m_budget { DEFAULT_BUDGET };
+};
+
+} // namespace bench
+
+#endif // FLIGHT_RECORDER_HPP
@@ -0,0 +1,102 @@
+#include "FrameSampler.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace {
+
+    double Percentile(std::vector<double>&& values, double percent) {
+        if (values.empty()) {
+            return 0.0;
+        }
+        assert(percent >= 0.0 && percent <= 100.0);
+        // nearest-rank method
+        const auto rank = static_cast<size_t>(std::ceil(percent / 100.0 * values.size()));
+        const auto index = std::clamp<size_t>(rank, 1U, values.size()) - 1U;
+        std::nth_element(values.begin(), values.begin() + index, values.end());
+        return values[index];
+    }
+
+    template<class Duration>
+    double AsMilliseconds(Duration duration) noexcept {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    }
+
+} // namespace {
+
+namespace bench {
+
+const char* GetSubsystemName(Subsystem subsystem) noexcept {
+    switch (subsystem) {
+        case Subsystem::PHYSICS:        return "physics";
+        case Subsystem::UNITS:          return "units";
+        case Subsystem::INFLUENCES:     return "influences";
+        case Subsystem::PROJECTILES:    return "projectiles";
+        case Subsystem::ANIMATIONS:     return "animations";
+        default: break;
+    }
+    return "undefined";
+}
+
+void FrameSampler::Enable(size_t expectedFrames) {
+    m_enabled = true;
+    m_frames.clear();
+    m_frames.reserve(expectedFrames);
+}
+
+void FrameSampler::BeginFrame() noexcept {
+    assert(!m_active && "Frame can't start inside of the sample");
+    m_current = FrameSample{};
+    m_frameStart = Clock::now();
+}
+
+void FrameSampler::EndFrame() {
+    assert(!m_active && "Frame can't end inside of the sample");
+    if (m_enabled) {
+        m_current.total = AsMilliseconds(Clock::now() - m_frameStart);
+        m_frames.push_back(m_current);
+    }
+}
+
+double FrameSampler::GetPercentile(Subsystem subsystem, double percent) const {
+    std::vector<double> values;
+    values.reserve(m_frames.size());
+    for (const auto& frame: m_frames) {
+        values.push_back(frame.subsystems[Utils::EnumCast(subsystem)]);
+    }
+    return ::Percentile(std::move(values), percent);
+}
+
+double FrameSampler::GetTotalPercentile(double percent) const {
+    std::vector<double> values;
+    values.reserve(m_frames.size());
+    for (const auto& frame: m_frames) {
+        values.push_back(frame.total);
+    }
+    return ::Percentile(std::move(values), percent);
+}
+
+ScopedSample::ScopedSample(Subsystem subsystem) noexcept
+    : m_sampler { FrameSampler::GetInstance().IsEnabled()? &FrameSampler::GetInstance(): nullptr }
+    , m_subsystem { subsystem }
+{
+    if (m_sampler) {
+        m_parent = m_sampler->m_active;
+        m_sampler->m_active = this;
+        m_start = FrameSampler::Clock::now();
+    }
+}
+
+ScopedSample::~ScopedSample() {
+    if (m_sampler) {
+        const auto elapsed { FrameSampler::Clock::now() - m_start };
+        m_sampler->m_current.subsystems[Utils::EnumCast(m_subsystem)] += ::AsMilliseconds(elapsed - m_nested);
+        if (m_parent) {
+            m_parent->m_nested += elapsed;
+        }
+        m_sampler->m_active = m_parent;
+    }
+}
+
+} // namespace bench
@@ -0,0 +1,141 @@
+#ifndef FRAME_SAMPLER_HPP
+#define FRAME_SAMPLER_HPP
+
+#include "Utils.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace bench {
+
+/**
+ * Subsystems which cost is measured separately by the headless runner.
+ */
+enum class Subsystem : std::uint8_t {
+    PHYSICS,
+    UNITS,
+    INFLUENCES,
+    PROJECTILES,
+    ANIMATIONS,
+
+    COUNT
+};
+
+const char* GetSubsystemName(Subsystem subsystem) noexcept;
+
+/**
+ * Time spent by each subsystem during a single frame (milliseconds).
+ */
+struct FrameSample final {
+    std::array<double, Utils::EnumSize<Subsystem>()> subsystems {};
+    double total { 0.0 };
+};
+
+class ScopedSample;
+
+/**
+ * Collect per-frame timings split by subsystem.
+ * Disabled by default: the game never pays more than a branch per sample.
+ *
+ * @code
+ *  auto& sampler = bench::FrameSampler::GetInstance();
+ *  sampler.Enable();
+ *  sampler.BeginFrame();
+ *  {
+ *      const bench::ScopedSample sample { bench::Subsystem::PHYSICS };
+ *      // ... do work
+ *  }
+ *  sampler.EndFrame();
+ * @endcode
+ */
+class FrameSampler final {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    ~FrameSampler() = default;
+
+    FrameSampler(const FrameSampler&) = delete;
+    FrameSampler& operator=(const FrameSampler&) = delete;
+    FrameSampler(FrameSampler&&) = delete;
+    FrameSampler& operator=(FrameSampler&&) = delete;
+
+    static FrameSampler& GetInstance() noexcept {
+        static FrameSampler sampler{};
+        return sampler;
+    }
+
+    bool IsEnabled() const noexcept {
+        return m_enabled;
+    }
+
+    void Enable(size_t expectedFrames = 0U);
+
+    void BeginFrame() noexcept;
+
+    void EndFrame();
+
+    const std::vector<FrameSample>& GetFrames() const noexcept {
+        return m_frames;
+    }
+
+    /**
+     * Nearest-rank percentile of the subsystem cost over all recorded frames.
+     * @param percent is in range [0, 100]
+     */
+    double GetPercentile(Subsystem subsystem, double percent) const;
+
+    /**
+     * Nearest-rank percentile of the whole frame cost over all recorded frames.
+     */
+    double GetTotalPercentile(double percent) const;
+
+private:
+    friend class ScopedSample;
+
+    FrameSampler() = default;
+
+    bool m_enabled { false };
+
+    // innermost sample which is currently running, used to exclude nested time
+    ScopedSample *m_active { nullptr };
+
+    FrameSample m_current {};
+
+    Clock::time_point m_frameStart {};
+
+    std::vector<FrameSample> m_frames;
+};
+
+/**
+ * Measure the exclusive time of the scope: time spent by nested samples
+ * is attributed to their own subsystem and not to the enclosing one,
+ * e.g. Influence::update is called from within Unit::update.
+ */
+class ScopedSample final {
+public:
+    explicit ScopedSample(Subsystem subsystem) noexcept;
+
+    ~ScopedSample();
+
+    ScopedSample(const ScopedSample&) = delete;
+    ScopedSample& operator=(const ScopedSample&) = delete;
+    ScopedSample(ScopedSample&&) = delete;
+    ScopedSample& operator=(ScopedSample&&) = delete;
+
+private:
+    FrameSampler * const m_sampler { nullptr };
+
+    ScopedSample * m_parent { nullptr };
+
+    const Subsystem m_subsystem { Subsystem::COUNT };
+
+    FrameSampler::Clock::time_point m_start {};
+
+    FrameSampler::Clock::duration m_nested { 0 };
+};
+
+} // namespace bench
+
+#endif // FRAME_SAMPLER_HPP
@@ -0,0 +1,374 @@
+#include "NavigationGraph.hpp"
+
+#include "TileMapHelper.hpp"
+#include "Utils.hpp"
+#include "scenes/LevelScene.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <thread>
+#include <utility>
+
+namespace {
+
+    using Property = TileMap::Property;
+
+    // jumps are slower and riskier than walking the same distance
+    constexpr float JUMP_PENALTY { 1.5f };
+
+    // free rows above the higher surface the body passes at the top of a jump
+    constexpr size_t JUMP_CLEARANCE_ROWS { 1U };
+
+    // don't spawn threads for small graphs: the work is less than a thread start
+    constexpr uint32_t MIN_SOURCES_PER_THREAD { 256U };
+
+    constexpr float INF { std::numeric_limits<float>::max() };
+
+    bool IsFree(TileMap::Mask mask) noexcept {
+        return Utils::HasAny(mask, Property::EMPTY);
+    }
+
+    bool IsGround(TileMap::Mask mask) noexcept {
+        return Utils::HasAny(mask, Property::BORDER, Property::SOLID, Property::PLATFORM);
+    }
+
+    // a body can pass the tile going up
+    bool IsPassable(TileMap::Mask mask) noexcept {
+        return Utils::HasAny(mask, Property::EMPTY, Property::PLATFORM);
+    }
+
+    struct Entry final {
+        float estimate;
+        float cost;
+        uint32_t node;
+
+        bool operator>(const Entry& other) const noexcept {
+            return estimate > other.estimate;
+        }
+    };
+
+    using OpenList = std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>>;
+
+} // namespace {
+
+NavigationGraph::NavigationGraph(const TileMap::Cache& cache, float jumpHeight)
+    : m_tileSize { cache.tileSize }
+    , m_width { cache.mapWidth }
+    , m_height { cache.mapHeight }
+    , m_nodeByTile(cache.mapWidth * cache.mapHeight, INVALID_NODE)
+{
+    this->BuildNodes(cache);
+    this->BuildLinks(cache, jumpHeight);
+    this->BuildRoutes();
+}
+
+uint32_t NavigationGraph::FindNode(const cocos2d::Vec2& position) const noexcept {
+    if (position.x < 0.f || position.y < 0.f || m_nodes.empty()) {
+        return INVALID_NODE;
+    }
+    const auto col { static_cast<size_t>(position.x / m_tileSize.width) };
+    // tolerate the body sinking into the ground a bit
+    const auto rowFromBottom { static_cast<size_t>((position.y + m_tileSize.height * 0.25f) / m_tileSize.height) };
+    if (col >= m_width || rowFromBottom >= m_height) {
+        return INVALID_NODE;
+    }
+    const auto row { m_height - rowFromBottom - 1U };
+    for (size_t r = row; r < m_height && r <= row + MAX_FALL_ROWS; r++) {
+        if (const auto node = m_nodeByTile[r * m_width + col]; node != INVALID_NODE) {
+            return node;
+        }
+    }
+    return INVALID_NODE;
+}
+
+bool NavigationGraph::Contains(uint32_t node, float x) const noexcept {
+    assert(node < m_nodes.size());
+    const auto& surface { m_nodes[node] };
+    return x >= surface.first * m_tileSize.width
+        && x < (surface.last + 1U) * m_tileSize.width;
+}
+
+float NavigationGraph::Clamp(uint32_t node, float x) const noexcept {
+    assert(node < m_nodes.size());
+    const auto& surface { m_nodes[node] };
+    // keep the middle of the body half a tile away from the edges
+    return std::clamp(x
+        , (surface.first + 0.5f) * m_tileSize.width
+        , (surface.last + 0.5f) * m_tileSize.width
+    );
+}
+
+const NavigationGraph::Link* NavigationGraph::FindNextLink(uint32_t from, uint32_t to) const {
+    if (from >= m_nodes.size() || to >= m_nodes.size() || from == to) {
+        return nullptr;
+    }
+    if (m_nextLink.empty()) {
+        const auto link { this->Search(from, to) };
+        return link != UINT32_MAX? &m_links[link]: nullptr;
+    }
+    const auto next { m_nextLink[from * m_nodes.size() + to] };
+    return next != NO_LINK? &m_links[m_firstLink[from] + next]: nullptr;
+}
+
+bool NavigationGraph::IsReachable(uint32_t from, uint32_t to) const {
+    return (from == to && from < m_nodes.size()) || this->FindNextLink(from, to) != nullptr;
+}
+
+NavigationGraph* NavigationGraph::Find(const cocos2d::Node * node) noexcept {
+    for (auto parent = node; parent; parent = parent->getParent()) {
+        if (const auto level = dynamic_cast<const LevelScene*>(parent); level) {
+            return level->GetNavigation();
+        }
+    }
+    return nullptr;
+}
+
+void NavigationGraph::BuildNodes(const TileMap::Cache& cache) {
+    const auto& properties { cache.properties };
+    const auto isStandable = [this, &properties](size_t row, size_t col) {
+        return ::IsFree(properties[row * m_width + col])
+            && ::IsGround(properties[(row + 1U) * m_width + col]);
+    };
+    // the lowest row has no ground below
+    for (size_t row = 0; row + 1U < m_height; row++) {
+        for (size_t col = 0; col < m_width; col++) {
+            if (!isStandable(row, col)) continue;
+
+            Surface surface { row, col, col };
+            while (surface.last + 1U < m_width && isStandable(row, surface.last + 1U)) {
+                surface.last++;
+            }
+            const auto node { static_cast<uint32_t>(m_nodes.size()) };
+            std::fill(m_nodeByTile.begin() + row * m_width + surface.first
+                , m_nodeByTile.begin() + row * m_width + surface.last + 1U
+                , node
+            );
+            m_nodes.push_back(surface);
+            col = surface.last;
+        }
+    }
+}
+
+void NavigationGraph::BuildLinks(const TileMap::Cache& cache, float jumpHeight) {
+    const auto& properties { cache.properties };
+    const auto maskAt = [this, &properties](size_t row, size_t col) {
+        return properties[row * m_width + col];
+    };
+    // whether the tiles [top, bottom] of the column can be passed going up
+    const auto isClear = [&maskAt](size_t col, size_t top, size_t bottom) {
+        for (size_t row = top; row <= bottom; row++) {
+            if (!::IsPassable(maskAt(row, col))) {
+                return false;
+            }
+        }
+        return true;
+    };
+    const size_t jumpRows { static_cast<size_t>(jumpHeight / m_tileSize.height) };
+
+    // nodes go row by row, so the nodes of the row `r` are [rowStart[r], rowStart[r + 1])
+    std::vector<uint32_t> rowStart(m_height + 1U, static_cast<uint32_t>(m_nodes.size()));
+    for (size_t i = m_nodes.size(); i-- > 0;) {
+        rowStart[m_nodes[i].row] = static_cast<uint32_t>(i);
+    }
+    for (size_t row = m_height; row-- > 0;) {
+        rowStart[row] = std::min(rowStart[row], rowStart[row + 1U]);
+    }
+
+    m_firstLink.reserve(m_nodes.size() + 1U);
+    m_links.reserve(m_nodes.size() * 4U);
+    for (uint32_t from = 0; from < m_nodes.size(); from++) {
+        m_firstLink.push_back(static_cast<uint32_t>(m_links.size()));
+        const auto& surface { m_nodes[from] };
+        const auto addLink = [this, from](uint32_t to, LinkKind kind
+            , const cocos2d::Vec2& takeoff
+            , const cocos2d::Vec2& landing
+        ) {
+            Link link;
+            link.to = to;
+            link.kind = kind;
+            // not less than the distance between the centers: the A* heuristic
+            link.cost = this->GetCenter(from).distance(this->GetCenter(to))
+                * (kind == LinkKind::JUMP? ::JUMP_PENALTY: 1.f);
+            link.takeoff = takeoff;
+            link.landing = landing;
+            m_links.push_back(link);
+        };
+
+        // drops: walk off the ends and fall down the column
+        const std::pair<bool, size_t> sides[2] = {
+            { surface.first > 0U, surface.first - 1U },
+            { surface.last + 1U < m_width, surface.last + 1U }
+        };
+        for (const auto& [exists, col]: sides) {
+            if (!exists || !::IsFree(maskAt(surface.row, col))) continue;
+
+            for (size_t row = surface.row + 1U; row < m_height && ::IsFree(maskAt(row, col)); row++) {
+                if (const auto to = m_nodeByTile[row * m_width + col]; to != INVALID_NODE) {
+                    addLink(to, LinkKind::DROP, this->GetFoot(surface.row, col), this->GetFoot(row, col));
+                    break;
+                }
+            }
+        }
+
+        // jumps: surfaces within the reach
+        const auto firstRow { surface.row > jumpRows? surface.row - jumpRows: 0U };
+        const auto lastRow { std::min(surface.row + jumpRows, m_height - 1U) };
+        for (auto to = rowStart[firstRow]; to < rowStart[lastRow + 1U]; to++) {
+            if (to == from) continue;
+
+            const auto& target { m_nodes[to] };
+            if (target.last < surface.first || target.first > surface.last) {
+                const bool isLeft { target.last < surface.first };
+                const size_t gap { isLeft? surface.first - target.last - 1U: target.first - surface.last - 1U };
+                // a step down is a drop
+                if (gap > jumpRows || (gap == 0U && target.row > surface.row)) continue;
+
+                const auto takeoff { isLeft? surface.first: surface.last };
+                const auto landing { isLeft? target.last: target.first };
+                // the arc goes above the higher surface: rise at the takeoff, cross the gap, fall at the landing
+                const auto higher { std::min(surface.row, target.row) };
+                const auto apex { higher > ::JUMP_CLEARANCE_ROWS? higher - ::JUMP_CLEARANCE_ROWS: 0U };
+                bool isArcClear { isClear(takeoff, apex, surface.row) && isClear(landing, apex, target.row) };
+                for (auto col = std::min(takeoff, landing) + 1U; col < std::max(takeoff, landing) && isArcClear; col++) {
+                    isArcClear = isClear(col, apex, higher);
+                }
+                if (!isArcClear) continue;
+
+                addLink(to, LinkKind::JUMP, this->GetFoot(surface.row, takeoff), this->GetFoot(target.row, landing));
+            }
+            else if (target.row < surface.row) {
+                // overlapping surface above: jump through a platform or around the ground's edge
+                const auto overlapFirst { std::max(surface.first, target.first) };
+                const auto overlapLast { std::min(surface.last, target.last) };
+                bool isLinked { false };
+                for (auto col = overlapFirst; col <= overlapLast && !isLinked; col++) {
+                    if (isClear(col, target.row + 1U, surface.row - 1U)) {
+                        addLink(to, LinkKind::JUMP, this->GetFoot(surface.row, col), this->GetFoot(target.row, col));
+                        isLinked = true;
+                    }
+                }
+                const std::pair<bool, size_t> edges[2] = {
+                    { target.first > surface.first, target.first - 1U },
+                    { target.last < surface.last, target.last + 1U }
+                };
+                for (const auto& [exists, col]: edges) {
+                    if (isLinked || !exists || !isClear(col, target.row, surface.row - 1U)) continue;
+
+                    const auto landing { col < target.first? target.first: target.last };
+                    addLink(to, LinkKind::JUMP, this->GetFoot(surface.row, col), this->GetFoot(target.row, landing));
+                    isLinked = true;
+                }
+            }
+        }
+    }
+    m_firstLink.push_back(static_cast<uint32_t>(m_links.size()));
+}
+
+void NavigationGraph::BuildRoutes() {
+    const auto nodes { static_cast<uint32_t>(m_nodes.size()) };
+    if (nodes == 0U || nodes > MAX_TABLE_NODES) {
+        return;
+    }
+    for (uint32_t node = 0; node < nodes; node++) {
+        assert(m_firstLink[node + 1U] - m_firstLink[node] < NO_LINK && "Too many links to index them in the table");
+    }
+    m_nextLink.assign(static_cast<size_t>(nodes) * nodes, NO_LINK);
+
+    const uint32_t hardwareThreads { std::max(1U, std::thread::hardware_concurrency()) };
+    const uint32_t threadCount { std::clamp<uint32_t>(nodes / ::MIN_SOURCES_PER_THREAD, 1U, hardwareThreads) };
+    // the last band of the sources is processed by this thread
+    const uint32_t sourcesPerBand { (nodes + threadCount - 1U) / threadCount };
+    std::vector<std::thread> workers;
+    workers.reserve(threadCount - 1U);
+    uint32_t first { 0U };
+    for (uint32_t i = 1U; i < threadCount && first + sourcesPerBand < nodes; i++) {
+        workers.emplace_back(&NavigationGraph::FillRoutes, this, first, first + sourcesPerBand);
+        first += sourcesPerBand;
+    }
+    this->FillRoutes(first, nodes);
+    for (auto& worker: workers) {
+        worker.join();
+    }
+}
+
+void NavigationGraph::FillRoutes(uint32_t first, uint32_t last) noexcept {
+    const auto nodes { m_nodes.size() };
+    std::vector<float> costs(nodes);
+    for (auto from = first; from < last; from++) {
+        std::fill(costs.begin(), costs.end(), INF);
+        // first link of the route to the node, inherited along the route
+        const auto nextLink { m_nextLink.begin() + from * nodes };
+        OpenList open;
+        costs[from] = 0.f;
+        open.push({ 0.f, 0.f, from });
+        while (!open.empty()) {
+            const auto [estimate, cost, node] = open.top();
+            open.pop();
+            // outdated entry: the node was reached cheaper later
+            if (cost > costs[node]) continue;
+
+            for (auto i = m_firstLink[node]; i < m_firstLink[node + 1U]; i++) {
+                const auto& link { m_links[i] };
+                const auto linkCost { cost + link.cost };
+                if (linkCost < costs[link.to]) {
+                    costs[link.to] = linkCost;
+                    nextLink[link.to] = node == from? static_cast<uint16_t>(i - m_firstLink[from]): nextLink[node];
+                    open.push({ linkCost, linkCost, link.to });
+                }
+            }
+        }
+    }
+}
+
+uint32_t NavigationGraph::Search(uint32_t from, uint32_t to) const {
+    const auto goal { this->GetCenter(to) };
+    const auto heuristic = [this, &goal](uint32_t node) {
+        return this->GetCenter(node).distance(goal);
+    };
+
+    std::vector<float> costs(m_nodes.size(), INF);
+    // first link of the route to the node, inherited along the route
+    std::vector<uint32_t> firstLink(m_nodes.size(), UINT32_MAX);
+    OpenList open;
+    costs[from] = 0.f;
+    open.push({ heuristic(from), 0.f, from });
+    while (!open.empty()) {
+        const auto [estimate, cost, node] = open.top();
+        open.pop();
+        if (node == to) {
+            break;
+        }
+        // outdated entry: the node was reached cheaper later
+        if (cost > costs[node]) continue;
+
+        for (auto i = m_firstLink[node]; i < m_firstLink[node + 1U]; i++) {
+            const auto& link { m_links[i] };
+            const auto linkCost { cost + link.cost };
+            if (linkCost < costs[link.to]) {
+                costs[link.to] = linkCost;
+                firstLink[link.to] = node == from? i: firstLink[node];
+                open.push({ linkCost + heuristic(link.to), linkCost, link.to });
+            }
+        }
+    }
+    return firstLink[to];
+}
+
+cocos2d::Vec2 NavigationGraph::GetCenter(uint32_t node) const noexcept {
+    const auto& surface { m_nodes[node] };
+    return cocos2d::Vec2 {
+        (surface.first + surface.last + 1U) * m_tileSize.width / 2.f,
+        (m_height - surface.row - 1U) * m_tileSize.height
+    };
+}
+
+cocos2d::Vec2 NavigationGraph::GetFoot(size_t row, size_t col) const noexcept {
+    return cocos2d::Vec2 {
+        (col + 0.5f) * m_tileSize.width,
+        (m_height - row - 1U) * m_tileSize.height
+    };
+}
@@ -0,0 +1,168 @@
+#ifndef NAVIGATION_GRAPH_HPP
+#define NAVIGATION_GRAPH_HPP
+
+#include "math/Vec2.h"
+#include "math/CCGeometry.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace cocos2d {
+    class Node;
+}
+namespace TileMap {
+    struct Cache;
+}
+
+/**
+ * Level-owned graph of the walkable surfaces, built once from the tile properties.
+ *
+ * A node is a maximal run of the standable tiles of a row: free tiles
+ * right above the ground (border, solid block or platform). Spikes are
+ * neither free nor ground. Nodes are linked by:
+ * - drops: walking off the end of the surface and falling to the one below;
+ * - jumps: reaching a surface at most `jumpHeight` above or below, with the same
+ *   horizontal reach. Solid ground can't be jumped through, platforms can.
+ *   The arc needs a free tile above the higher surface along the way.
+ * The first link of the cheapest route between every pair of nodes is found
+ * by the construction (Dijkstra from each node), so the pursuit and patrol
+ * queries are lookups into the table. The table is quadratic in nodes,
+ * graphs above MAX_TABLE_NODES run A* on each query instead.
+ *
+ * The graph is immutable after the construction. Queries don't lock
+ * and are safe from the planner's worker threads.
+ */
+class NavigationGraph final {
+public:
+    static constexpr uint32_t INVALID_NODE { UINT32_MAX };
+
+    // rows searched below a position for the surface the body stands on (or falls to)
+    static constexpr size_t MAX_FALL_ROWS { 2U };
+
+    // 8 MiB of the route table, filled in about half a second on one core
+    static constexpr size_t MAX_TABLE_NODES { 2048U };
+
+    enum class LinkKind : uint8_t {
+        DROP,
+        JUMP
+    };
+
+    /**
+     * Standable tiles [first, last] of the row
+     */
+    struct Surface final {
+        size_t row { 0U };
+        size_t first { 0U };
+        size_t last { 0U };
+    };
+
+    struct Link final {
+        uint32_t to { INVALID_NODE };
+        LinkKind kind { LinkKind::DROP };
+        float cost { 0.f };
+        // bottom middle of the body in map's coordinates
+        cocos2d::Vec2 takeoff {};
+        cocos2d::Vec2 landing {};
+    };
+
+    NavigationGraph(const TileMap::Cache& cache, float jumpHeight);
+
+    NavigationGraph(const NavigationGraph&) = delete;
+    NavigationGraph& operator=(const NavigationGraph&) = delete;
+
+    /**
+     * @param position bottom middle of the body in map's coordinates
+     * @return the node the body stands on or is about to land on, INVALID_NODE otherwise
+     */
+    uint32_t FindNode(const cocos2d::Vec2& position) const noexcept;
+
+    /**
+     * @return whether the body can stand at `x` on the node
+     */
+    bool Contains(uint32_t node, float x) const noexcept;
+
+    /**
+     * @return `x` moved inside the node
+     */
+    float Clamp(uint32_t node, float x) const noexcept;
+
+    /**
+     * @return the first link of the cheapest route between the nodes,
+     * nullptr if the goal is unreachable or it's the same node
+     */
+    const Link* FindNextLink(uint32_t from, uint32_t to) const;
+
+    /**
+     * @return whether the body can get from one node to another, e.g. the same one
+     */
+    bool IsReachable(uint32_t from, uint32_t to) const;
+
+    size_t GetNodeCount() const noexcept {
+        return m_nodes.size();
+    }
+
+    size_t GetLinkCount() const noexcept {
+        return m_links.size();
+    }
+
+    /**
+     * Memory taken by the precomputed routes
+     */
+    size_t GetRouteTableBytes() const noexcept {
+        return m_nextLink.size() * sizeof(m_nextLink.front());
+    }
+
+    /**
+     * Find the graph of the level the node belongs to.
+     */
+    static NavigationGraph* Find(const cocos2d::Node * node) noexcept;
+
+private:
+    void BuildNodes(const TileMap::Cache& cache);
+
+    void BuildLinks(const TileMap::Cache& cache, float jumpHeight);
+
+    /**
+     * Fill the first links of the routes from every node, split between the threads.
+     */
+    void BuildRoutes();
+
+    /**
+     * A* over the nodes, used when the graph is too big for the route table.
+     * @return index of the first link of the route, UINT32_MAX if the goal is unreachable
+     */
+    uint32_t Search(uint32_t from, uint32_t to) const;
+
+    /**
+     * Dijkstra from the sources [first, last) filling their rows of the route table.
+     */
+    void FillRoutes(uint32_t first, uint32_t last) noexcept;
+
+    cocos2d::Vec2 GetCenter(uint32_t node) const noexcept;
+
+    // bottom middle of the tile
+    cocos2d::Vec2 GetFoot(size_t row, size_t col) const noexcept;
+
+    cocos2d::Size m_tileSize {};
+
+    size_t m_width { 0U };
+
+    size_t m_height { 0U };
+
+    std::vector<Surface> m_nodes;
+
+    // links of the node `i` are [m_firstLink[i], m_firstLink[i + 1])
+    std::vector<uint32_t> m_firstLink;
+
+    std::vector<Link> m_links;
+
+    // row-major: node of the standable tile or INVALID_NODE
+    std::vector<uint32_t> m_nodeByTile;
+
+    // `from * nodes + to`: index of the first link to take among the links of `from`,
+    // i.e. the offset from `m_firstLink[from]`, or NO_LINK if `to` is unreachable
+    static constexpr uint16_t NO_LINK { UINT16_MAX };
+    std::vector<uint16_t> m_nextLink;
+};
+
+#endif // NAVIGATION_GRAPH_HPP
@@ -0,0 +1,153 @@
+#include "Profiler.hpp"
+
+#include "cocos2d.h"
+
+#include <algorithm>
+#include <fstream>
+
+namespace {
+
+    /**
+     * Release the buffer of the thread on its exit
+     */
+    struct BufferHolder final {
+        std::mutex * mutex { nullptr };
+        bool * isOwned { nullptr };
+
+        ~BufferHolder() {
+            if (mutex) {
+                std::lock_guard<std::mutex> lock { *mutex };
+                *isOwned = false;
+            }
+        }
+    };
+
+    // JSON string without escaping: names are identifiers of the code
+    void WriteName(std::ofstream& file, const char * name) {
+        file << '"';
+        for (auto c = name; *c; c++) {
+            file << ((*c == '"' || *c == '\\')? '_': *c);
+        }
+        file << '"';
+    }
+
+} // namespace {
+
+namespace bench {
+
+Profiler::Profiler()
+    : m_epoch { Clock::now() }
+{
+}
+
+void Profiler::BeginZone(const char * name) noexcept {
+    auto& buffer { this->GetThreadBuffer() };
+    if (buffer.depth < MAX_DEPTH) {
+        buffer.zones[buffer.depth] = OpenZone { name, this->Now() };
+    }
+    buffer.depth++;
+}
+
+void Profiler::EndZone() noexcept {
+    auto& buffer { this->GetThreadBuffer() };
+    if (buffer.depth == 0U) {
+        // the zone was opened before the profiler was enabled
+        return;
+    }
+    buffer.depth--;
+    if (buffer.depth < MAX_DEPTH) {
+        const auto& zone { buffer.zones[buffer.depth] };
+        Event event;
+        event.name = zone.name;
+        event.start = zone.start;
+        event.duration = this->Now() - zone.start;
+        event.phase = Phase::ZONE;
+        this->Push(buffer, event);
+    }
+}
+
+void Profiler::Count(const char * name, double value) noexcept {
+    auto& buffer { this->GetThreadBuffer() };
+    Event event;
+    event.name = name;
+    event.start = this->Now();
+    event.value = value;
+    event.phase = Phase::COUNTER;
+    this->Push(buffer, event);
+}
+
+bool Profiler::Dump(const std::string& path, float seconds) const {
+    std::ofstream file { path };
+    if (!file) {
+        return false;
+    }
+    const auto since { this->Now() - static_cast<int64_t>(seconds * 1e9) };
+
+    std::lock_guard<std::mutex> lock { m_mutex };
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool isFirst { true };
+    for (const auto& buffer: m_buffers) {
+        const auto count { std::min<uint64_t>(buffer->head, EVENTS_PER_THREAD) };
+        // from the oldest to the latest
+        for (uint64_t i = buffer->head - count; i < buffer->head; i++) {
+            const auto& event { buffer->events[i % EVENTS_PER_THREAD] };
+            if (event.start < since) continue;
+
+            file << (isFirst? "": ",\n");
+            isFirst = false;
+            file << "{\"name\":";
+            ::WriteName(file, event.name);
+            // microseconds
+            file << ",\"pid\":0,\"tid\":" << buffer->thread
+                << ",\"ts\":" << event.start / 1000.0;
+            if (event.phase == Phase::ZONE) {
+                file << ",\"ph\":\"X\",\"dur\":" << event.duration / 1000.0 << "}";
+            }
+            else {
+                file << ",\"ph\":\"C\",\"args\":{\"value\":" << event.value << "}}";
+            }
+        }
+    }
+    file << "\n]}\n";
+    m_dumps++;
+    return static_cast<bool>(file);
+}
+
+std::string Profiler::GetDumpPath() const {
+    std::lock_guard<std::mutex> lock { m_mutex };
+    return cocos2d::FileUtils::getInstance()->getWritablePath()
+        + cocos2d::StringUtils::format("trace-%zu.json", m_dumps);
+}
+
+Profiler::ThreadBuffer& Profiler::GetThreadBuffer() {
+    thread_local ThreadBuffer * cached { nullptr };
+    thread_local BufferHolder holder {};
+    if (cached) {
+        return *cached;
+    }
+
+    std::lock_guard<std::mutex> lock { m_mutex };
+    auto released = std::find_if(m_buffers.begin(), m_buffers.end(), [](const auto& buffer) {
+        return !buffer->isOwned;
+    });
+    if (released == m_buffers.end()) {
+        m_buffers.push_back(std::make_unique<ThreadBuffer>());
+        m_buffers.back()->events = std::make_unique<Event[]>(EVENTS_PER_THREAD);
+        released = std::prev(m_buffers.end());
+    }
+    cached = released->get();
+    cached->thread = m_nextThread++;
+    cached->head = 0U;
+    cached->depth = 0U;
+    cached->isOwned = true;
+    holder.mutex = &m_mutex;
+    holder.isOwned = &cached->isOwned;
+    return *cached;
+}
+
+void Profiler::Push(ThreadBuffer& buffer, const Event& event) noexcept {
+    buffer.events[buffer.head % EVENTS_PER_THREAD] = event;
+    buffer.head++;
+}
+
+} // namespace bench
@@ -0,0 +1,194 @@
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+/**
+ * Instrumentation of the game: named zones and counters recorded
+ * into a ring buffer per thread and exported as a Chrome `trace_event` JSON
+ * (open it by chrome://tracing or https://ui.perfetto.dev).
+ *
+ * The zones are compiled in only with `PLATFORMER_PROFILER` defined,
+ * otherwise the macros are empty. Compiled in and disabled at runtime
+ * a zone costs a relaxed atomic load.
+ *
+ * @code
+ *  void Unit::update(float dt) {
+ *      PROFILE_ZONE("Unit::update");
+ *      PROFILE_COUNTER("curses", m_curses.GetSize());
+ *      // ... do work
+ *  }
+ * @endcode
+ */
+class Profiler final {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // per thread, ~4 MB; at 60 FPS it keeps about 10 seconds of a crowded level
+    static constexpr size_t EVENTS_PER_THREAD { 1U << 17 };
+
+    // nesting deeper than this isn't recorded
+    static constexpr size_t MAX_DEPTH { 64U };
+
+    static constexpr float DEFAULT_DUMP_SECONDS { 5.f };
+
+    ~Profiler() = default;
+
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+    Profiler(Profiler&&) = delete;
+    Profiler& operator=(Profiler&&) = delete;
+
+    static Profiler& GetInstance() noexcept {
+        static Profiler profiler{};
+        return profiler;
+    }
+
+    bool IsEnabled() const noexcept {
+        return m_enabled.load(std::memory_order_relaxed);
+    }
+
+    void Enable(bool isEnabled) noexcept {
+        m_enabled.store(isEnabled, std::memory_order_relaxed);
+    }
+
+    /**
+     * @param name must outlive the profiler, e.g. a string literal
+     */
+    void BeginZone(const char * name) noexcept;
+
+    void EndZone() noexcept;
+
+    /**
+     * Record the value of the counter, e.g. number of running units.
+     * @param name must outlive the profiler, e.g. a string literal
+     */
+    void Count(const char * name, double value) noexcept;
+
+    /**
+     * Write the events of the last `seconds` of all threads as a Chrome trace.
+     * Call it from the main thread between the frames: the other threads record
+     * only inside of the frame (e.g. the bots' decisions).
+     */
+    bool Dump(const std::string& path, float seconds = DEFAULT_DUMP_SECONDS) const;
+
+    /**
+     * @return path of the next dump in the writable directory: `trace-<N>.json`
+     */
+    std::string GetDumpPath() const;
+
+private:
+    enum class Phase : uint8_t {
+        ZONE,
+        COUNTER
+    };
+
+    struct Event final {
+        const char * name { nullptr };
+        // nanoseconds since the profiler's creation
+        int64_t start { 0 };
+        // duration of the zone (nanoseconds) or value of the counter
+        union {
+            int64_t duration { 0 };
+            double value;
+        };
+        Phase phase { Phase::ZONE };
+    };
+
+    struct OpenZone final {
+        const char * name { nullptr };
+        int64_t start { 0 };
+    };
+
+    struct ThreadBuffer final {
+        uint32_t thread { 0U };
+        std::unique_ptr<Event[]> events;
+        // total number of the recorded events, the latest is at `(head - 1) % EVENTS_PER_THREAD`
+        uint64_t head { 0U };
+        OpenZone zones[MAX_DEPTH];
+        size_t depth { 0U };
+        // false after the thread exits, the buffer is reused by the next one
+        bool isOwned { false };
+    };
+
+    Profiler();
+
+    ThreadBuffer& GetThreadBuffer();
+
+    void Push(ThreadBuffer& buffer, const Event& event) noexcept;
+
+    int64_t Now() const noexcept {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - m_epoch).count();
+    }
+
+    std::atomic<bool> m_enabled { false };
+
+    const Clock::time_point m_epoch;
+
+    mutable std::mutex m_mutex;
+
+    /// Guarded by the mutex
+
+    std::vector<std::unique_ptr<ThreadBuffer>> m_buffers;
+
+    uint32_t m_nextThread { 0U };
+
+    mutable size_t m_dumps { 0U };
+};
+
+/**
+ * Record the scope as a zone if the profiler is enabled.
+ */
+class Zone final {
+public:
+    explicit Zone(const char * name) noexcept
+        : m_isRecorded { Profiler::GetInstance().IsEnabled() }
+    {
+        if (m_isRecorded) {
+            Profiler::GetInstance().BeginZone(name);
+        }
+    }
+
+    ~Zone() {
+        if (m_isRecorded) {
+            Profiler::GetInstance().EndZone();
+        }
+    }
+
+    Zone(const Zone&) = delete;
+    Zone& operator=(const Zone&) = delete;
+    Zone(Zone&&) = delete;
+    Zone& operator=(Zone&&) = delete;
+
+private:
+    // the profiler may be enabled while the zone is open
+    const bool m_isRecorded { false };
+};
+
+} // namespace bench
+
+#define PROFILE_CONCAT_IMPL(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_IMPL(a, b)
+
+#if defined(PLATFORMER_PROFILER)
+    #define PROFILE_ZONE(name) const bench::Zone PROFILE_CONCAT(profileZone, __LINE__) { name }
+    #define PROFILE_COUNTER(name, value) \
+        do { \
+            if (bench::Profiler::GetInstance().IsEnabled()) { \
+                bench::Profiler::GetInstance().Count(name, static_cast<double>(value)); \
+            } \
+        } while (false)
+#else
+    #define PROFILE_ZONE(name) do {} while (false)
+    #define PROFILE_COUNTER(name, value) do {} while (false)
+#endif
+
+#endif // PROFILER_HPP
@@ -54,6 +54,38 @@ private:
 
 };
 
+class Simulation final {
+public:
+    // ticks per second of the physics and gameplay, e.g. 60 or 30
+    static constexpr float DEFAULT_TICK_RATE { 60.f };
+
+    ~Simulation() = default;
+
+    Simulation(const Simulation&) = delete;
+    Simulation& operator=(const Simulation&) = delete;
+    Simulation(Simulation&&) = delete;
+    Simulation& operator=(Simulation&&) = delete;
+
+    float GetTickRate() const noexcept {
+        return m_tickRate;
+    }
+
+    void SetTickRate(float tickRate) noexcept {
+        m_tickRate = tickRate;
+    }
+
+    static Simulation& GetInstance() noexcept {
+        static Simulation simulation{};
+        return simulation;
+    }
+
+private:
+    float m_tickRate { DEFAULT_TICK_RATE };
+
+    Simulation() = default;
+
+};
+
 } // namespace settings
 
 #endif // SETTINGS_HPP_
\ No newline at end of file
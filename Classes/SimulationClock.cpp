@@ -0,0 +1,143 @@
+#include "SimulationClock.hpp"
+
+#include "scenes/LevelScene.hpp"
+
+#include "cocos2d.h"
+
+#include <cassert>
+
+SimulationClock::SimulationClock(float tickRate) {
+    this->SetTickRate(tickRate);
+    m_entities.reserve(128U);
+}
+
+void SimulationClock::SetTickRate(float tickRate) noexcept {
+    assert(tickRate > 0.f);
+    m_tickDuration = 1.f / tickRate;
+    m_accumulator = 0.f;
+}
+
+uint32_t SimulationClock::Advance(float dt) noexcept {
+    m_accumulator += dt;
+    uint32_t ticks { 0U };
+    while (m_accumulator >= m_tickDuration && ticks < MAX_TICKS_PER_FRAME) {
+        m_accumulator -= m_tickDuration;
+        ticks++;
+    }
+    if (ticks == MAX_TICKS_PER_FRAME && m_accumulator >= m_tickDuration) {
+        m_accumulator = 0.f;
+    }
+    return ticks;
+}
+
+uint32_t SimulationClock::Add(cocos2d::Node * node) {
+    assert(node);
+    uint32_t index { 0U };
+    if (!m_free.empty()) {
+        index = m_free.back();
+        m_free.pop_back();
+    }
+    else {
+        index = static_cast<uint32_t>(m_entities.size());
+        m_entities.emplace_back();
+    }
+    auto& entity { m_entities[index] };
+    entity.node = node;
+    entity.isActive = true;
+    entity.previous = entity.current = entity.rendered = node->getPosition();
+    entity.previousRotation = entity.currentRotation = node->getRotation();
+    m_size++;
+    return index;
+}
+
+void SimulationClock::Remove(uint32_t index) noexcept {
+    if (index >= m_entities.size() || !m_entities[index].node) {
+        return;
+    }
+    auto& entity { m_entities[index] };
+    // leave the node in its simulated state, e.g. to be recycled
+    if (entity.node->getPosition() == entity.rendered) {
+        entity.node->setPosition(entity.current.x, entity.current.y);
+        entity.node->setRotation(entity.currentRotation);
+    }
+    entity = Entity{};
+    m_free.push_back(index);
+    m_size--;
+}
+
+void SimulationClock::SetActive(uint32_t index, bool isActive) noexcept {
+    if (index >= m_entities.size() || !m_entities[index].node) {
+        return;
+    }
+    m_entities[index].isActive = isActive;
+}
+
+void SimulationClock::Restore() noexcept {
+    for (auto& entity: m_entities) {
+        if (!entity.node) continue;
+
+        if (entity.node->getPosition() != entity.rendered) {
+            // moved outside of the simulation, e.g. placed after being added
+            entity.previous = entity.current = entity.node->getPosition();
+            entity.previousRotation = entity.currentRotation = entity.node->getRotation();
+        }
+        else {
+            // bypass overridden `setPosition(const Vec2&)`, e.g. the player's one resets the camera
+            entity.node->setPosition(entity.current.x, entity.current.y);
+            entity.node->setRotation(entity.currentRotation);
+        }
+        entity.rendered = entity.current;
+    }
+}
+
+void SimulationClock::BeginTick() noexcept {
+    m_hasTicked = true;
+    for (auto& entity: m_entities) {
+        if (!entity.node) continue;
+
+        entity.previous = entity.node->getPosition();
+        entity.previousRotation = entity.node->getRotation();
+    }
+}
+
+void SimulationClock::UpdateEntities() {
+    // entities added by the updates wait for the next tick
+    const auto count { m_entities.size() };
+    for (size_t i = 0; i < count; i++) {
+        // the node can be removed by the update of the previous one
+        const auto node { m_entities[i].node };
+        if (node && m_entities[i].isActive) {
+            node->update(m_tickDuration);
+        }
+    }
+}
+
+void SimulationClock::Interpolate() noexcept {
+    const auto alpha { this->GetAlpha() };
+    for (auto& entity: m_entities) {
+        if (!entity.node) continue;
+
+        if (m_hasTicked) {
+            entity.current = entity.node->getPosition();
+            entity.currentRotation = entity.node->getRotation();
+        }
+        else if (entity.node->getPosition() != entity.rendered) {
+            entity.previous = entity.current = entity.node->getPosition();
+            entity.previousRotation = entity.currentRotation = entity.node->getRotation();
+        }
+        entity.rendered = entity.previous.lerp(entity.current, alpha);
+        entity.node->setPosition(entity.rendered.x, entity.rendered.y);
+        entity.node->setRotation(entity.previousRotation
+            + (entity.currentRotation - entity.previousRotation) * alpha);
+    }
+    m_hasTicked = false;
+}
+
+SimulationClock* SimulationClock::Find(const cocos2d::Node * node) noexcept {
+    for (auto parent = node; parent; parent = parent->getParent()) {
+        if (const auto level = dynamic_cast<const LevelScene*>(parent); level) {
+            return level->GetClock();
+        }
+    }
+    return nullptr;
+}
@@ -0,0 +1,130 @@
+#ifndef SIMULATION_CLOCK_HPP
+#define SIMULATION_CLOCK_HPP
+
+#include "math/Vec2.h" // cocos2d::Vec2
+
+#include <cstdint>
+#include <vector>
+
+namespace cocos2d {
+    class Node;
+}
+
+/**
+ * Level-owned clock of the fixed-step simulation.
+ *
+ * The frame time is accumulated and consumed by whole ticks, so physics and
+ * gameplay (units, projectiles, weapons, curses) advance by the same
+ * step whatever the render rate is.
+ *
+ * The simulated entities are tracked by the clock: they are updated
+ * on each tick instead of each frame. Between the ticks their position and
+ * rotation are interpolated from the last two ticks for rendering only:
+ * the simulated state is restored before the next tick.
+ */
+class SimulationClock final {
+public:
+    static constexpr uint32_t INVALID_ENTITY { UINT32_MAX };
+
+    static constexpr float DEFAULT_TICK_RATE { 60.f };
+
+    // the rest of a long frame is dropped instead of making the next frame even longer
+    static constexpr uint32_t MAX_TICKS_PER_FRAME { 4U };
+
+    explicit SimulationClock(float tickRate = DEFAULT_TICK_RATE);
+
+    /**
+     * @param tickRate ticks per second
+     */
+    void SetTickRate(float tickRate) noexcept;
+
+    float GetTickRate() const noexcept {
+        return 1.f / m_tickDuration;
+    }
+
+    float GetTickDuration() const noexcept {
+        return m_tickDuration;
+    }
+
+    /**
+     * Accumulate the frame time.
+     *
+     * @return number of ticks to simulate in this frame
+     */
+    uint32_t Advance(float dt) noexcept;
+
+    /**
+     * @return part of the tick elapsed since the last simulated one, [0, 1)
+     */
+    float GetAlpha() const noexcept {
+        return m_accumulator / m_tickDuration;
+    }
+
+    uint32_t Add(cocos2d::Node * node);
+
+    void Remove(uint32_t entity) noexcept;
+
+    /**
+     * Inactive entities aren't updated, e.g. while they're paused.
+     */
+    void SetActive(uint32_t entity, bool isActive) noexcept;
+
+    /**
+     * Put the entities back to their simulated state.
+     * Must be called before the first tick of the frame.
+     */
+    void Restore() noexcept;
+
+    /**
+     * Remember the state before the tick to interpolate from.
+     */
+    void BeginTick() noexcept;
+
+    /**
+     * Update the active entities with the tick duration.
+     */
+    void UpdateEntities();
+
+    /**
+     * Move the entities to the state between the last two ticks.
+     */
+    void Interpolate() noexcept;
+
+    size_t GetSize() const noexcept {
+        return m_size;
+    }
+
+    /**
+     * Find the clock of the level the node belongs to.
+     */
+    static SimulationClock* Find(const cocos2d::Node * node) noexcept;
+
+private:
+    struct Entity final {
+        cocos2d::Node * node { nullptr };
+        bool isActive { true };
+        // state after the tick before the last one
+        cocos2d::Vec2 previous {};
+        float previousRotation { 0.f };
+        // state after the last tick
+        cocos2d::Vec2 current {};
+        float currentRotation { 0.f };
+        // position set by the last interpolation
+        cocos2d::Vec2 rendered {};
+    };
+
+    std::vector<Entity> m_entities;
+
+    std::vector<uint32_t> m_free;
+
+    size_t m_size { 0U };
+
+    float m_tickDuration { 1.f / DEFAULT_TICK_RATE };
+
+    float m_accumulator { 0.f };
+
+    // whether any tick was simulated since the last interpolation
+    bool m_hasTicked { false };
+};
+
+#endif // SIMULATION_CLOCK_HPP
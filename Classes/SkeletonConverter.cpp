@@ -0,0 +1,375 @@
+#include "SkeletonConverter.hpp"
+
+#include "dragonBones/DragonBonesHeaders.h"
+
+#include "rapidjson/document.h"
+#include "rapidjson/stringbuffer.h"
+#include "rapidjson/writer.h"
+
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <utility>
+
+namespace {
+
+    /**
+     * JSON parser which remembers the parsed parts of the document
+     * to replace them with offsets into the arrays it has filled.
+     */
+    class BinaryWriter final : public dragonBones::JSONDataParser {
+    public:
+        /**
+         * Parse the document, rewrite it into the header and write the binary data.
+         * @return name of the parsed data or empty string on failure
+         */
+        std::string Write(rapidjson::Document& document, std::vector<char>& binary);
+
+    protected:
+        dragonBones::ArmatureData* _parseArmature(const rapidjson::Value& rawData, float scale) override;
+
+        void _parseMesh(const rapidjson::Value& rawData, dragonBones::MeshDisplayData& mesh) override;
+
+        dragonBones::AnimationData* _parseAnimation(const rapidjson::Value& rawData) override;
+
+    private:
+        // the JSON parser leaves these values of the int array unset
+        // while the binary parser reads them
+        struct Patch final {
+            size_t index { 0U };
+            int16_t value { 0 };
+        };
+
+        // the raw data is a part of the document owned by the writer, so it can be modified
+        void RewriteArmature(rapidjson::Value& rawData, const dragonBones::ArmatureData& armature);
+
+        void RewriteMesh(rapidjson::Value& rawData, const dragonBones::MeshDisplayData& mesh);
+
+        void RewriteAnimation(rapidjson::Value& rawData, const dragonBones::AnimationData& animation);
+
+        rapidjson::Value WriteTimelines(const std::map<std::string, std::vector<dragonBones::TimelineData*>>& timelines);
+
+        rapidjson::Document::AllocatorType * m_allocator { nullptr };
+
+        std::vector<std::pair<const rapidjson::Value*, const dragonBones::ArmatureData*>> m_armatures;
+
+        std::vector<std::pair<const rapidjson::Value*, const dragonBones::MeshDisplayData*>> m_meshes;
+
+        std::vector<std::pair<const rapidjson::Value*, const dragonBones::AnimationData*>> m_animations;
+
+        std::vector<Patch> m_patches;
+    };
+
+    template<class T>
+    void Append(std::vector<char>& buffer, const T * data, size_t count) {
+        const auto bytes { reinterpret_cast<const char*>(data) };
+        buffer.insert(buffer.end(), bytes, bytes + count * sizeof(T));
+    }
+
+    std::string BinaryWriter::Write(rapidjson::Document& document, std::vector<char>& binary) {
+        m_allocator = &document.GetAllocator();
+        const auto data { this->_parseDragonBonesData(document, 1.f) };
+        if (!data) {
+            return {};
+        }
+        if (!data->binary) {
+            // nothing to convert: no armatures
+            data->returnToPool();
+            return {};
+        }
+        const auto name { data->name };
+
+        for (const auto& [rawData, mesh]: m_meshes) {
+            this->RewriteMesh(const_cast<rapidjson::Value&>(*rawData), *mesh);
+        }
+        for (const auto& [rawData, animation]: m_animations) {
+            this->RewriteAnimation(const_cast<rapidjson::Value&>(*rawData), *animation);
+        }
+        for (const auto& [rawData, armature]: m_armatures) {
+            this->RewriteArmature(const_cast<rapidjson::Value&>(*rawData), *armature);
+        }
+        data->returnToPool();
+
+        auto intArray { _intArray };
+        for (const auto& patch: m_patches) {
+            intArray[patch.index] = patch.value;
+        }
+
+        // [offset, length] in bytes of each array from the end of the header
+        const size_t lengths[] = {
+            intArray.size() * sizeof(int16_t),
+            _floatArray.size() * sizeof(float),
+            _frameIntArray.size() * sizeof(int16_t),
+            _frameFloatArray.size() * sizeof(float),
+            _frameArray.size() * sizeof(int16_t),
+            _timelineArray.size() * sizeof(uint16_t)
+        };
+        rapidjson::Value offsets { rapidjson::kArrayType };
+        size_t offset { 0U };
+        for (const auto length: lengths) {
+            offsets.PushBack(static_cast<uint64_t>(offset), *m_allocator);
+            offsets.PushBack(static_cast<uint64_t>(length), *m_allocator);
+            offset += length;
+        }
+        document.RemoveMember(OFFSET);
+        document.AddMember(rapidjson::StringRef(OFFSET), offsets, *m_allocator);
+
+        rapidjson::StringBuffer buffer;
+        rapidjson::Writer<rapidjson::StringBuffer> writer { buffer };
+        document.Accept(writer);
+        std::string header { buffer.GetString(), buffer.GetSize() };
+
+        // magic, version (unused) and the header length precede the header
+        static constexpr size_t PREFIX_SIZE { 12U };
+        while ((PREFIX_SIZE + header.size()) % 4U != 0U) {
+            header.push_back(' ');
+        }
+        const uint32_t version { 0U };
+        const auto headerLength { static_cast<uint32_t>(header.size()) };
+
+        binary.clear();
+        binary.reserve(PREFIX_SIZE + header.size() + offset);
+        ::Append(binary, "DBDT", 4U);
+        ::Append(binary, &version, 1U);
+        ::Append(binary, &headerLength, 1U);
+        ::Append(binary, header.data(), header.size());
+        ::Append(binary, intArray.data(), intArray.size());
+        ::Append(binary, _floatArray.data(), _floatArray.size());
+        ::Append(binary, _frameIntArray.data(), _frameIntArray.size());
+        ::Append(binary, _frameFloatArray.data(), _frameFloatArray.size());
+        ::Append(binary, _frameArray.data(), _frameArray.size());
+        ::Append(binary, _timelineArray.data(), _timelineArray.size());
+        return name;
+    }
+
+    dragonBones::ArmatureData* BinaryWriter::_parseArmature(const rapidjson::Value& rawData, float scale) {
+        const auto armature { JSONDataParser::_parseArmature(rawData, scale) };
+        m_armatures.emplace_back(&rawData, armature);
+        return armature;
+    }
+
+    void BinaryWriter::_parseMesh(const rapidjson::Value& rawData, dragonBones::MeshDisplayData& mesh) {
+        JSONDataParser::_parseMesh(rawData, mesh);
+        m_meshes.emplace_back(&rawData, &mesh);
+
+        namespace db = dragonBones;
+        const auto weight { mesh.vertices.weight };
+        m_patches.push_back({ mesh.vertices.offset + static_cast<size_t>(db::BinaryOffset::MeshWeightOffset)
+            , weight? static_cast<int16_t>(weight->offset): int16_t{ -1 }
+        });
+        if (weight) {
+            const auto& bones { weight->bones };
+            m_patches.push_back({ weight->offset + static_cast<size_t>(db::BinaryOffset::WeigthBoneCount)
+                , static_cast<int16_t>(bones.size())
+            });
+            // the JSON parser stores indices of the sorted bones,
+            // the binary parser expects indices in the order of the raw data
+            for (size_t i = 0; i < bones.size(); i++) {
+                m_patches.push_back({ weight->offset + static_cast<size_t>(db::BinaryOffset::WeigthBoneIndices) + i
+                    , static_cast<int16_t>(db::indexOf(_rawBones, bones[i]))
+                });
+            }
+        }
+    }
+
+    dragonBones::AnimationData* BinaryWriter::_parseAnimation(const rapidjson::Value& rawData) {
+        const auto animation { JSONDataParser::_parseAnimation(rawData) };
+        m_animations.emplace_back(&rawData, animation);
+        return animation;
+    }
+
+    void BinaryWriter::RewriteArmature(rapidjson::Value& rawData, const dragonBones::ArmatureData& armature) {
+        // the actions of the animation frames are appended to the armature's actions
+        // and referenced by the frame array, so all of them are written
+        rawData.RemoveMember(ACTIONS);
+        if (armature.actions.empty()) {
+            return;
+        }
+        auto& allocator { *m_allocator };
+        rapidjson::Value actions { rapidjson::kArrayType };
+        for (const auto action: armature.actions) {
+            rapidjson::Value rawAction { rapidjson::kObjectType };
+            rawAction.AddMember(rapidjson::StringRef(TYPE), static_cast<int>(action->type), allocator);
+            rawAction.AddMember(rapidjson::StringRef(NAME), rapidjson::Value{ action->name.c_str(), allocator }, allocator);
+            if (action->bone) {
+                rawAction.AddMember(rapidjson::StringRef(BONE), rapidjson::Value{ action->bone->name.c_str(), allocator }, allocator);
+            }
+            if (action->slot) {
+                rawAction.AddMember(rapidjson::StringRef(SLOT), rapidjson::Value{ action->slot->name.c_str(), allocator }, allocator);
+            }
+            if (const auto userData = action->data; userData) {
+                rapidjson::Value ints { rapidjson::kArrayType };
+                for (const auto value: userData->ints) {
+                    ints.PushBack(value, allocator);
+                }
+                rapidjson::Value floats { rapidjson::kArrayType };
+                for (const auto value: userData->floats) {
+                    floats.PushBack(value, allocator);
+                }
+                rapidjson::Value strings { rapidjson::kArrayType };
+                for (const auto& value: userData->strings) {
+                    strings.PushBack(rapidjson::Value{ value.c_str(), allocator }, allocator);
+                }
+                rawAction.AddMember(rapidjson::StringRef(INTS), ints, allocator);
+                rawAction.AddMember(rapidjson::StringRef(FLOATS), floats, allocator);
+                rawAction.AddMember(rapidjson::StringRef(STRINGS), strings, allocator);
+            }
+            actions.PushBack(rawAction, allocator);
+        }
+        rawData.AddMember(rapidjson::StringRef(ACTIONS), actions, allocator);
+    }
+
+    void BinaryWriter::RewriteMesh(rapidjson::Value& rawData, const dragonBones::MeshDisplayData& mesh) {
+        // all of them are in the int and float arrays now
+        for (const auto key: { VERTICES, UVS, TRIANGLES, WEIGHTS, SLOT_POSE, BONE_POSE, "edges", "userEdges" }) {
+            rawData.RemoveMember(key);
+        }
+        rawData.RemoveMember(OFFSET);
+        rawData.AddMember(rapidjson::StringRef(OFFSET), mesh.vertices.offset, *m_allocator);
+    }
+
+    void BinaryWriter::RewriteAnimation(rapidjson::Value& rawData, const dragonBones::AnimationData& animation) {
+        auto& allocator { *m_allocator };
+        rapidjson::Value header { rapidjson::kObjectType };
+        header.AddMember(rapidjson::StringRef(NAME), rapidjson::Value{ animation.name.c_str(), allocator }, allocator);
+        header.AddMember(rapidjson::StringRef(DURATION), animation.frameCount, allocator);
+        header.AddMember(rapidjson::StringRef(PLAY_TIMES), animation.playTimes, allocator);
+        header.AddMember(rapidjson::StringRef(FADE_IN_TIME), animation.fadeInTime, allocator);
+        header.AddMember(rapidjson::StringRef(SCALE), animation.scale, allocator);
+
+        rapidjson::Value offsets { rapidjson::kArrayType };
+        offsets.PushBack(animation.frameIntOffset, allocator);
+        offsets.PushBack(animation.frameFloatOffset, allocator);
+        offsets.PushBack(animation.frameOffset, allocator);
+        header.AddMember(rapidjson::StringRef(OFFSET), offsets, allocator);
+
+        if (animation.actionTimeline) {
+            header.AddMember(rapidjson::StringRef(ACTION), animation.actionTimeline->offset, allocator);
+        }
+        if (animation.zOrderTimeline) {
+            header.AddMember(rapidjson::StringRef(Z_ORDER), animation.zOrderTimeline->offset, allocator);
+        }
+        header.AddMember(rapidjson::StringRef(BONE), this->WriteTimelines(animation.boneTimelines), allocator);
+        header.AddMember(rapidjson::StringRef(SLOT), this->WriteTimelines(animation.slotTimelines), allocator);
+        header.AddMember(rapidjson::StringRef(CONSTRAINT), this->WriteTimelines(animation.constraintTimelines), allocator);
+        // the frames were parsed into the arrays
+        rawData = header;
+    }
+
+    rapidjson::Value BinaryWriter::WriteTimelines(const std::map<std::string, std::vector<dragonBones::TimelineData*>>& timelines) {
+        auto& allocator { *m_allocator };
+        rapidjson::Value rawTimelines { rapidjson::kObjectType };
+        for (const auto& [name, list]: timelines) {
+            // [type, offset] pairs
+            rapidjson::Value rawList { rapidjson::kArrayType };
+            for (const auto timeline: list) {
+                rawList.PushBack(static_cast<int>(timeline->type), allocator);
+                rawList.PushBack(timeline->offset, allocator);
+            }
+            rawTimelines.AddMember(rapidjson::Value{ name.c_str(), allocator }, rawList, allocator);
+        }
+        return rawTimelines;
+    }
+
+    /**
+     * `parse(elapsed)` returns false when the data can't be parsed,
+     * then the measurement is stopped.
+     */
+    template<class Parse>
+    bool MeasureAverage(size_t runs, Parse&& parse, double& average) {
+        using Milliseconds = std::chrono::duration<double, std::milli>;
+        Milliseconds total { 0.0 };
+        for (size_t i = 0; i < runs; i++) {
+            std::chrono::steady_clock::duration elapsed {};
+            if (!parse(elapsed)) {
+                return false;
+            }
+            total += elapsed;
+        }
+        average = runs? total.count() / runs: 0.0;
+        return true;
+    }
+
+} // namespace {
+
+SkeletonConverter::SkeletonConverter(std::string json)
+    : m_json { std::move(json) }
+{
+}
+
+bool SkeletonConverter::IsUpToDate(const std::string& binaryPath, const std::string& jsonPath) {
+    if (jsonPath.empty()) {
+        return true;
+    }
+    std::error_code binaryError;
+    std::error_code jsonError;
+    const auto binaryTime { std::filesystem::last_write_time(binaryPath, binaryError) };
+    const auto jsonTime { std::filesystem::last_write_time(jsonPath, jsonError) };
+    return binaryError || jsonError || binaryTime >= jsonTime;
+}
+
+bool SkeletonConverter::Convert() {
+    rapidjson::Document document;
+    document.Parse(m_json.c_str());
+    if (document.HasParseError() || !document.IsObject()) {
+        return false;
+    }
+    BinaryWriter writer;
+    m_name = writer.Write(document, m_binary);
+    return !m_name.empty();
+}
+
+bool SkeletonConverter::Save(const std::string& path) const {
+    std::ofstream file { path, std::ios::binary };
+    file.write(m_binary.data(), static_cast<std::streamsize>(m_binary.size()));
+    return static_cast<bool>(file);
+}
+
+bool SkeletonConverter::Measure(size_t runs, Report& report) const {
+    using Clock = std::chrono::steady_clock;
+    assert(!m_binary.empty() && "Convert the skeleton first");
+
+    report.name = m_name;
+    report.jsonSize = m_json.size();
+    report.binarySize = m_binary.size();
+
+    dragonBones::JSONDataParser jsonParser;
+    const bool isJsonParsed { ::MeasureAverage(runs, [&](Clock::duration& elapsed) {
+        const auto start { Clock::now() };
+        const auto data { jsonParser.parseDragonBonesData(m_json.c_str()) };
+        elapsed = Clock::now() - start;
+        if (!data) {
+            return false;
+        }
+        data->returnToPool();
+        return true;
+    }, report.jsonParseTime) };
+    if (!isJsonParsed) {
+        return false;
+    }
+
+    dragonBones::BinaryDataParser binaryParser;
+    return ::MeasureAverage(runs, [&](Clock::duration& elapsed) {
+        // the data owns the buffer like the one loaded by the factory
+        const auto buffer { static_cast<char*>(std::malloc(m_binary.size())) };
+        if (!buffer) {
+            return false;
+        }
+        std::memcpy(buffer, m_binary.data(), m_binary.size());
+        const auto start { Clock::now() };
+        const auto data { binaryParser.parseDragonBonesData(buffer) };
+        elapsed = Clock::now() - start;
+        if (!data) {
+            // the buffer is owned only by the parsed data
+            std::free(buffer);
+            return false;
+        }
+        data->returnToPool();
+        return true;
+    }, report.binaryParseTime);
+}
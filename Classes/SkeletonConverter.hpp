@@ -0,0 +1,77 @@
+#ifndef SKELETON_CONVERTER_HPP
+#define SKELETON_CONVERTER_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * Convert the DragonBones skeleton `<name>_ske.json` to the DragonBones
+ * binary format `<name>_ske.dbbin` which is loaded by the Animator instead.
+ *
+ * The JSON is parsed once by the JSONDataParser. The arrays it fills
+ * (vertices, weights, frames and timelines) are written as is after
+ * the JSON header, and the parts of the header they were parsed from
+ * are replaced by offsets into the arrays. So the BinaryDataParser only
+ * walks what remains: bones, slots, skins and the list of timelines.
+ *
+ * Layout (little-endian):
+ * ["DBDT"][uint32 0][uint32 header length][JSON header][int16...][float...][int16...][float...][int16...][uint16...]
+ * The header is padded with spaces to keep the arrays aligned to 4 bytes.
+ */
+class SkeletonConverter final {
+public:
+    static constexpr const char * JSON_SUFFIX { "_ske.json" };
+
+    static constexpr const char * BINARY_SUFFIX { "_ske.dbbin" };
+
+    /**
+     * Tell whether the converted skeleton can be loaded instead of the JSON:
+     * it's not older than the JSON. Files whose time is unknown (e.g. android assets)
+     * are shipped together, so the binary is trusted then.
+     * @param binaryPath full path to the `_ske.dbbin` file
+     * @param jsonPath full path to the `_ske.json` file, may be empty if it's not shipped
+     */
+    static bool IsUpToDate(const std::string& binaryPath, const std::string& jsonPath);
+
+    struct Report final {
+        std::string name;
+        size_t jsonSize { 0U };
+        size_t binarySize { 0U };
+        // average parse time, ms
+        double jsonParseTime { 0.0 };
+        double binaryParseTime { 0.0 };
+    };
+
+    /**
+     * @param json content of the `_ske.json` file
+     */
+    explicit SkeletonConverter(std::string json);
+
+    /**
+     * @return false if the JSON isn't a supported DragonBones skeleton
+     */
+    bool Convert();
+
+    bool Save(const std::string& path) const;
+
+    /**
+     * Parse both the JSON and the converted data `runs` times.
+     * Must be called after successful conversion.
+     * @return false if either data can't be parsed or the buffer for the binary one can't be allocated
+     */
+    bool Measure(size_t runs, Report& report) const;
+
+    const std::vector<char>& GetBinary() const noexcept {
+        return m_binary;
+    }
+
+private:
+    std::string m_json;
+
+    std::string m_name;
+
+    std::vector<char> m_binary;
+};
+
+#endif // SKELETON_CONVERTER_HPP
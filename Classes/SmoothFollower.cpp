@@ -1,6 +1,7 @@
 #include "SmoothFollower.hpp"
 #include "PhysicsHelper.hpp"
 #include "units/Unit.hpp"
+#include "ActivationRegion.hpp"
 
 #include "cocos2d.h"
 
@@ -68,6 +69,11 @@ void SmoothFollower::UpdateMapPosition(const float dt) {
     }
 
     tileMap->setPosition(newPosition);
+
+    m_camera = cocos2d::Rect { origin - newPosition, visible };
+    if (const auto activation = ActivationRegion::Find(tileMap); activation) {
+        activation->SetCamera(m_camera);
+    }
 }
 
 void SmoothFollower::Reset() {
@@ -18,6 +18,13 @@ public:
      * Called when Player::setPosition() is beeing called to update unit's start position! 
      */
     void Reset();
+
+    /**
+     * @return visible part of the map in map's coordinates
+     */
+    const cocos2d::Rect& GetCamera() const noexcept {
+        return m_camera;
+    }
     
     /**
      * Input: TileMap: { width, height }
@@ -34,6 +41,8 @@ private:
     Unit * const m_unit { nullptr };
 
     cocos2d::Vec2 m_delta { 0.f, 0.f };
+
+    cocos2d::Rect m_camera {};
     //float m_speed { 0.f };
     /**
      * This is maximum velocity allowed for player follower.   
@@ -0,0 +1,331 @@
+#include "TileMapBlob.hpp"
+
+#include "cocos2d.h"
+
+#include <cassert>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <type_traits>
+
+#if CC_TARGET_PLATFORM == CC_PLATFORM_WIN32
+    #include <windows.h>
+    #define PLATFORMER_BLOB_MMAP_WIN32
+#elif CC_TARGET_PLATFORM == CC_PLATFORM_LINUX || CC_TARGET_PLATFORM == CC_PLATFORM_MAC || CC_TARGET_PLATFORM == CC_PLATFORM_IOS
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+    #define PLATFORMER_BLOB_MMAP_POSIX
+#endif
+
+namespace {
+
+    constexpr size_t SECTION_ALIGNMENT { 8U };
+
+    size_t Align(size_t offset) noexcept {
+        return (offset + SECTION_ALIGNMENT - 1U) & ~(SECTION_ALIGNMENT - 1U);
+    }
+
+    template<class T>
+    void Append(std::vector<char>& buffer, TileMap::blob::Section& section, const T * data, size_t count) {
+        static_assert(std::is_trivially_copyable_v<T>, "Blob records must be trivially copyable");
+        buffer.resize(::Align(buffer.size()), 0);
+        section.offset = static_cast<uint32_t>(buffer.size());
+        section.count = static_cast<uint32_t>(count);
+        const auto bytes { reinterpret_cast<const char*>(data) };
+        buffer.insert(buffer.end(), bytes, bytes + count * sizeof(T));
+    }
+
+    template<class T>
+    bool Resolve(const char * base
+        , size_t size
+        , const TileMap::blob::Section& section
+        , TileMap::blob::View<T>& view) noexcept
+    {
+        if(section.offset % alignof(T) != 0U
+            || section.offset > size
+            || (size - section.offset) / sizeof(T) < section.count)
+        {
+            return false;
+        }
+        view.data = reinterpret_cast<const T*>(base + section.offset);
+        view.size = section.count;
+        return true;
+    }
+
+} // namespace {
+
+namespace TileMap {
+
+namespace blob {
+
+bool Stat(const std::string& path, Source& source) {
+    const auto fileUtils { cocos2d::FileUtils::getInstance() };
+    // works for the android assets too, unlike the file system
+    const auto size { fileUtils->getFileSize(path) };
+    if(size < 0) {
+        return false;
+    }
+    source.size = static_cast<uint64_t>(size);
+    source.time = 0;
+
+    std::error_code error;
+    const auto time { std::filesystem::last_write_time(fileUtils->fullPathForFilename(path), error) };
+    if(!error) {
+        source.time = std::chrono::duration_cast<std::chrono::seconds>(time.time_since_epoch()).count();
+    }
+    return true;
+}
+
+uint64_t Hash(const void * data, size_t size) noexcept {
+    constexpr uint64_t FNV_OFFSET_BASIS { 14695981039346656037ULL };
+    constexpr uint64_t FNV_PRIME { 1099511628211ULL };
+
+    uint64_t hash { FNV_OFFSET_BASIS };
+    const auto bytes { static_cast<const uint8_t*>(data) };
+    for(size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+} // namespace blob
+
+/**
+ * Owns the memory of the blob: a read-only mapping of the file
+ * or, where files can't be mapped (e.g. android assets), a plain copy.
+ */
+struct Blob::Storage final {
+    const char * data { nullptr };
+    size_t size { 0U };
+
+    cocos2d::Data copy;
+
+#if defined(PLATFORMER_BLOB_MMAP_WIN32)
+    HANDLE file { INVALID_HANDLE_VALUE };
+    HANDLE mapping { nullptr };
+#elif defined(PLATFORMER_BLOB_MMAP_POSIX)
+    void * mapped { nullptr };
+#endif
+
+    ~Storage() {
+#if defined(PLATFORMER_BLOB_MMAP_WIN32)
+        if(mapping) {
+            UnmapViewOfFile(data);
+            CloseHandle(mapping);
+        }
+        if(file != INVALID_HANDLE_VALUE) {
+            CloseHandle(file);
+        }
+#elif defined(PLATFORMER_BLOB_MMAP_POSIX)
+        if(mapped) {
+            munmap(mapped, size);
+        }
+#endif
+    }
+
+    bool Map(const std::string& fullPath) noexcept {
+#if defined(PLATFORMER_BLOB_MMAP_WIN32)
+        file = CreateFileA(fullPath.c_str(), GENERIC_READ, FILE_SHARE_READ
+            , nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if(file == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+        LARGE_INTEGER fileSize;
+        if(!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+            return false;
+        }
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if(!mapping) {
+            return false;
+        }
+        data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        size = static_cast<size_t>(fileSize.QuadPart);
+        return data != nullptr;
+#elif defined(PLATFORMER_BLOB_MMAP_POSIX)
+        const int fd { open(fullPath.c_str(), O_RDONLY) };
+        if(fd < 0) {
+            return false;
+        }
+        struct stat info;
+        if(fstat(fd, &info) != 0 || info.st_size <= 0) {
+            close(fd);
+            return false;
+        }
+        void * address { mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0) };
+        close(fd);
+        if(address == MAP_FAILED) {
+            return false;
+        }
+        mapped = address;
+        data = static_cast<const char*>(address);
+        size = static_cast<size_t>(info.st_size);
+        return true;
+#else
+        (void) fullPath;
+        return false;
+#endif
+    }
+
+    bool Read(const std::string& fullPath) {
+        copy = cocos2d::FileUtils::getInstance()->getDataFromFile(fullPath);
+        data = reinterpret_cast<const char*>(copy.getBytes());
+        size = static_cast<size_t>(copy.getSize());
+        return !copy.isNull();
+    }
+};
+
+std::unique_ptr<Blob> Blob::Open(const std::string& path, const std::string& tmxFile) {
+    const auto fileUtils { cocos2d::FileUtils::getInstance() };
+    const auto fullPath { fileUtils->fullPathForFilename(path) };
+    if(fullPath.empty()) {
+        return nullptr;
+    }
+    blob::Source source;
+    if(!blob::Stat(tmxFile, source)) {
+        return nullptr;
+    }
+
+    auto storage { std::make_unique<Storage>() };
+    if(!storage->Map(fullPath) && !storage->Read(fullPath)) {
+        return nullptr;
+    }
+
+    std::unique_ptr<Blob> blob { new Blob{ std::move(storage) } };
+    if(!blob->FixUp()) {
+        cocos2d::log("Level blob %s is malformed or has unsupported version", path.c_str());
+        return nullptr;
+    }
+    const auto& header { blob->GetHeader() };
+    bool isFresh { header.sourceSize == source.size };
+    if(isFresh && (source.time == 0 || header.sourceTime != source.time)) {
+        // the TMX is touched (e.g. checked out again) or its time is unknown:
+        // edits which keep the size are caught by the content
+        const auto data { fileUtils->getDataFromFile(tmxFile) };
+        isFresh = !data.isNull()
+            && blob::Hash(data.getBytes(), static_cast<size_t>(data.getSize())) == header.sourceHash;
+    }
+    if(!isFresh) {
+        cocos2d::log("Level blob %s is out of date", path.c_str());
+        return nullptr;
+    }
+    return blob;
+}
+
+Blob::Blob(std::unique_ptr<Storage>&& storage)
+    : m_storage { std::move(storage) }
+{
+}
+
+Blob::~Blob() = default;
+
+bool Blob::FixUp() noexcept {
+    const char * base { m_storage->data };
+    const size_t size { m_storage->size };
+    if(!base || size < sizeof(blob::Header)) {
+        return false;
+    }
+    m_header = reinterpret_cast<const blob::Header*>(base);
+    if(m_header->magic != blob::MAGIC || m_header->version != blob::VERSION) {
+        return false;
+    }
+    const bool resolved { ::Resolve(base, size, m_header->forms, m_forms)
+        && ::Resolve(base, size, m_header->points, m_points)
+        && ::Resolve(base, size, m_header->tileSets, m_tileSets)
+        && ::Resolve(base, size, m_header->properties, m_properties)
+        && ::Resolve(base, size, m_header->strings, m_strings)
+        && ::Resolve(base, size, m_header->masks, m_masks)
+    };
+    if(!resolved) {
+        return false;
+    }
+    if(static_cast<size_t>(m_header->mapWidth) * m_header->mapHeight != m_masks.size) {
+        return false;
+    }
+    // validate references between sections once, so views can be used without checks
+    for(const auto& form: m_forms) {
+        if(form.points.offset > m_points.size || m_points.size - form.points.offset < form.points.count) {
+            return false;
+        }
+    }
+    const auto IsValid = [this](blob::StringRef ref) {
+        return ref.offset <= m_strings.size && m_strings.size - ref.offset >= ref.size;
+    };
+    for(const auto& tileSet: m_tileSets) {
+        if(!IsValid(tileSet.name)
+            || tileSet.properties.offset > m_properties.size
+            || m_properties.size - tileSet.properties.offset < tileSet.properties.count)
+        {
+            return false;
+        }
+    }
+    for(const auto& property: m_properties) {
+        if(!IsValid(property.field) || !IsValid(property.value)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+BlobBuilder::BlobBuilder(uint64_t sourceHash, const blob::Source& source, uint32_t mapWidth, uint32_t mapHeight) {
+    m_header.sourceHash = sourceHash;
+    m_header.sourceSize = source.size;
+    m_header.sourceTime = source.time;
+    m_header.mapWidth = mapWidth;
+    m_header.mapHeight = mapHeight;
+}
+
+uint32_t BlobBuilder::AddPoints(const float * xy, size_t count) {
+    const auto first { static_cast<uint32_t>(m_points.size()) };
+    for(size_t i = 0; i < count; i++) {
+        m_points.push_back({ xy[2 * i], xy[2 * i + 1] });
+    }
+    return first;
+}
+
+void BlobBuilder::AddForm(const blob::FormRecord& form) {
+    m_forms.push_back(form);
+}
+
+uint32_t BlobBuilder::AddProperty(std::string_view field, std::string_view value) {
+    const auto index { static_cast<uint32_t>(m_properties.size()) };
+    m_properties.push_back({ this->AddString(field), this->AddString(value) });
+    return index;
+}
+
+void BlobBuilder::AddTileSet(const blob::TileSetRecord& tileSet) {
+    m_tileSets.push_back(tileSet);
+}
+
+blob::StringRef BlobBuilder::AddString(std::string_view str) {
+    blob::StringRef ref;
+    ref.offset = static_cast<uint32_t>(m_strings.size());
+    ref.size = static_cast<uint32_t>(str.size());
+    m_strings.append(str);
+    return ref;
+}
+
+void BlobBuilder::SetMasks(const uint8_t * masks, size_t count) {
+    m_masks.assign(masks, masks + count);
+}
+
+bool BlobBuilder::Save(const std::string& path) const {
+    auto header { m_header };
+    std::vector<char> buffer(sizeof(blob::Header), 0);
+    ::Append(buffer, header.forms, m_forms.data(), m_forms.size());
+    ::Append(buffer, header.points, m_points.data(), m_points.size());
+    ::Append(buffer, header.tileSets, m_tileSets.data(), m_tileSets.size());
+    ::Append(buffer, header.properties, m_properties.data(), m_properties.size());
+    ::Append(buffer, header.strings, m_strings.data(), m_strings.size());
+    ::Append(buffer, header.masks, m_masks.data(), m_masks.size());
+    std::memcpy(buffer.data(), &header, sizeof(header));
+
+    std::ofstream file { path, std::ios::binary | std::ios::trunc };
+    file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    return static_cast<bool>(file);
+}
+
+} // namespace TileMap
@@ -0,0 +1,245 @@
+#ifndef TILE_MAP_BLOB_HPP
+#define TILE_MAP_BLOB_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace TileMap {
+
+/**
+ * Binary layout of the baked level: `Map/level_<id>.lvl`.
+ * Everything the TileMapParser extracts from the TMX file is stored
+ * in plain arrays of POD records, so loading is a memory map of the file
+ * and a fix-up of section offsets to pointers.
+ *
+ * Layout (little-endian, sections are aligned to 8 bytes):
+ * [Header][FormRecord...][PointRecord...][TileSetRecord...][PropertyRecord...][chars...][Mask...]
+ */
+namespace blob {
+
+	constexpr uint32_t MAGIC { 0x4C564C50 }; // "PLVL"
+	// increase on any change of the records below or of the parsed forms
+	constexpr uint32_t VERSION { 6U };
+
+	struct Section final {
+		uint32_t offset { 0U }; // from the beginning of the blob
+		uint32_t count { 0U };	// number of records
+	};
+
+	struct StringRef final {
+		uint32_t offset { 0U }; // from the beginning of the string section
+		uint32_t size { 0U };
+	};
+
+	struct Header final {
+		uint32_t magic { MAGIC };
+		uint32_t version { VERSION };
+		// hash of the TMX file the blob was baked from,
+		// checked when the file's modification time differs
+		uint64_t sourceHash { 0U };
+		// size and modification time of the TMX file, checked on loading:
+		// they're known without reading the file
+		uint64_t sourceSize { 0U };
+		int64_t sourceTime { 0 };
+		uint32_t mapWidth { 0U };
+		uint32_t mapHeight { 0U };
+		Section forms;
+		Section points;
+		Section tileSets;
+		Section properties;
+		Section strings;
+		Section masks;
+	};
+
+	struct PointRecord final {
+		float x { 0.f };
+		float y { 0.f };
+	};
+
+	/**
+	 * Mirror of the details::Form
+	 */
+	struct FormRecord final {
+		uint32_t type { 0U };
+		uint32_t subType { 0U };
+		uint32_t id { 0U };
+		uint32_t pathId { 0U };
+		uint32_t ownerId { 0U };
+		float scale { 0.f };
+		uint32_t flipX { 0U };
+		Section points; // offset is an index of the first point
+		float x { 0.f };
+		float y { 0.f };
+		float width { 0.f };
+		float height { 0.f };
+	};
+
+	struct PropertyRecord final {
+		StringRef field;
+		StringRef value;
+	};
+
+	/**
+	 * Mirror of the details::TileSet
+	 */
+	struct TileSetRecord final {
+		StringRef name;
+		uint32_t firstgid { 0U };
+		uint16_t tilewidth { 0U };
+		uint16_t tileheight { 0U };
+		Section properties; // offset is an index of the first property
+	};
+
+	/**
+	 * Read-only view of the contiguous records.
+	 */
+	template<class T>
+	struct View final {
+		const T * data { nullptr };
+		size_t size { 0U };
+
+		const T* begin() const noexcept { return data; }
+		const T* end() const noexcept { return data + size; }
+		const T& operator[](size_t i) const noexcept { return data[i]; }
+	};
+
+	/**
+	 * Size and modification time of the source TMX file
+	 */
+	struct Source final {
+		uint64_t size { 0U };
+		// seconds since the file clock's epoch, 0 if unknown (e.g. android assets)
+		int64_t time { 0 };
+	};
+
+	/**
+	 * @param path is a path to the file relative to the resource search paths
+	 * @return false if the file doesn't exist
+	 */
+	bool Stat(const std::string& path, Source& source);
+
+	/**
+	 * FNV-1a hash of the source file content, used to skip baking of unchanged levels.
+	 */
+	uint64_t Hash(const void * data, size_t size) noexcept;
+
+} // namespace blob
+
+/**
+ * Baked level mapped into memory.
+ * All views point directly into the mapped file and are valid
+ * while the blob is alive.
+ */
+class Blob final {
+public:
+	/**
+	 * Map the baked level into memory and validate it.
+	 * @param path is a path to the blob relative to the resource search paths
+	 * @param tmxFile is a path to the TMX file the blob was baked from.
+	 * Its size and modification time are compared with the baked ones,
+	 * the content is hashed only when the size matches but the time doesn't.
+	 * @return nullptr if the blob is absent, corrupted or out of date
+	 */
+	static std::unique_ptr<Blob> Open(const std::string& path, const std::string& tmxFile);
+
+	~Blob();
+
+	Blob(const Blob&) = delete;
+	Blob& operator=(const Blob&) = delete;
+	Blob(Blob&&) = delete;
+	Blob& operator=(Blob&&) = delete;
+
+	const blob::Header& GetHeader() const noexcept {
+		return *m_header;
+	}
+
+	blob::View<blob::FormRecord> GetForms() const noexcept {
+		return m_forms;
+	}
+
+	blob::View<blob::PointRecord> GetPoints() const noexcept {
+		return m_points;
+	}
+
+	blob::View<blob::TileSetRecord> GetTileSets() const noexcept {
+		return m_tileSets;
+	}
+
+	blob::View<blob::PropertyRecord> GetProperties() const noexcept {
+		return m_properties;
+	}
+
+	/**
+	 * Row-major tile masks of the collision layer, see TileMap::Cache
+	 */
+	blob::View<uint8_t> GetMasks() const noexcept {
+		return m_masks;
+	}
+
+	std::string_view GetString(blob::StringRef ref) const noexcept {
+		return { m_strings.data + ref.offset, ref.size };
+	}
+
+private:
+	struct Storage;
+
+	explicit Blob(std::unique_ptr<Storage>&& storage);
+
+	// resolve section offsets into pointers, return false on malformed blob
+	bool FixUp() noexcept;
+
+	std::unique_ptr<Storage> m_storage;
+
+	const blob::Header * m_header { nullptr };
+	blob::View<blob::FormRecord> m_forms;
+	blob::View<blob::PointRecord> m_points;
+	blob::View<blob::TileSetRecord> m_tileSets;
+	blob::View<blob::PropertyRecord> m_properties;
+	blob::View<char> m_strings;
+	blob::View<uint8_t> m_masks;
+};
+
+/**
+ * Accumulate records and write them as a blob.
+ */
+class BlobBuilder final {
+public:
+	BlobBuilder(uint64_t sourceHash, const blob::Source& source, uint32_t mapWidth, uint32_t mapHeight);
+
+	/**
+	 * @return index of the first added point
+	 */
+	uint32_t AddPoints(const float * xy, size_t count);
+
+	void AddForm(const blob::FormRecord& form);
+
+	/**
+	 * @return index of the first added property
+	 */
+	uint32_t AddProperty(std::string_view field, std::string_view value);
+
+	void AddTileSet(const blob::TileSetRecord& tileSet);
+
+	blob::StringRef AddString(std::string_view str);
+
+	void SetMasks(const uint8_t * masks, size_t count);
+
+	bool Save(const std::string& path) const;
+
+private:
+	blob::Header m_header;
+	std::vector<blob::FormRecord> m_forms;
+	std::vector<blob::PointRecord> m_points;
+	std::vector<blob::TileSetRecord> m_tileSets;
+	std::vector<blob::PropertyRecord> m_properties;
+	std::string m_strings;
+	std::vector<uint8_t> m_masks;
+};
+
+} // namespace TileMap
+
+#endif // TILE_MAP_BLOB_HPP
@@ -2,59 +2,119 @@
 
 #include "cocos2d.h"
 #include <cassert>
+#include <algorithm>
+#include <thread>
+
+namespace {
+
+	// don't spawn threads for small maps: the work is less than a thread start
+	constexpr size_t MIN_TILES_PER_THREAD { 64U * 1024U };
+
+	TileMap::Mask MaskFromCategory(const std::string& name) noexcept {
+		using TileMap::Mask;
+		using TileMap::Property;
+
+		if(name == "border") {
+			return static_cast<Mask>(Property::BORDER);
+		}
+		else if(name == "solid") {
+			return static_cast<Mask>(Property::SOLID);
+		}
+		else if(name == "spikes") {
+			return static_cast<Mask>(Property::SPIKE);
+		}
+		else if(name == "platform") {
+			return static_cast<Mask>(Property::PLATFORM);
+		}
+		return static_cast<Mask>(Property::UNDEFINED);
+	}
+
+	uint32_t ExtractGid(uint32_t tile) noexcept {
+		// tiles keep flip flags in the upper bits
+		return tile & cocos2d::kTMXFlippedMask;
+	}
+
+} // namespace {
 
 namespace TileMap {
 
-Cache::Cache(const cocos2d::FastTMXTiledMap * tilemap) 
+Cache::Cache(const cocos2d::FastTMXTiledMap * tilemap)
     : tileMap{ tilemap }
     , blocksLayer { tilemap->getLayer(COLLISION_LAYER_NAME) }
     , tileSize{ blocksLayer->getMapTileSize() }
     , mapWidth { static_cast<size_t>(blocksLayer->getLayerSize().width) }
     , mapHeight { static_cast<size_t>(blocksLayer->getLayerSize().height) }
-    , properties { mapHeight, std::vector<Mask>(mapWidth, 0U) }
+    , properties ( mapWidth * mapHeight, 0U )
 {
-    // TODO: heavy calculations
-    for(size_t row = 0; row < mapHeight; ++row) {
-        for(size_t col = 0; col < mapWidth; ++col) {
-            properties[row][col] = this->FindProperties({
-                static_cast<float>(col), 
-                static_cast<float>(row)
-            });
-        }
+    const uint32_t * tiles { blocksLayer->getTiles() };
+    if(!tiles || properties.empty()) {
+        return;
     }
-}
+    const auto lookup { this->BuildLookupTable(tiles) };
 
-Mask Cache::FindProperties(const cocos2d::Vec2& pos) const noexcept {
-    Mask mask { 0U };
-   
-    const auto tileGid = blocksLayer->getTileGIDAt(pos);
-    if(!tileGid) {
-        mask = static_cast<Mask>(Property::EMPTY);
-        return mask;
+    const size_t hardwareThreads { std::max(1U, std::thread::hardware_concurrency()) };
+    const size_t threadCount { std::clamp<size_t>(
+        properties.size() / MIN_TILES_PER_THREAD, 1U, std::min(hardwareThreads, mapHeight)
+    )};
+    // split map into bands of rows, the last band is processed by this thread
+    const size_t rowsPerBand { (mapHeight + threadCount - 1U) / threadCount };
+    std::vector<std::thread> workers;
+    workers.reserve(threadCount - 1U);
+    size_t first { 0U };
+    for(size_t i = 1U; i < threadCount && first + rowsPerBand < mapHeight; i++) {
+        workers.emplace_back(&Cache::FillRows, this, tiles, std::cref(lookup), first, first + rowsPerBand);
+        first += rowsPerBand;
+    }
+    this->FillRows(tiles, lookup, first, mapHeight);
+    for(auto& worker: workers) {
+        worker.join();
     }
-    const auto tileProp { tileMap->getPropertiesForGID(tileGid) };
-    const auto& properties { tileProp.asValueMap() };
-    const auto categoryNameIter { properties.find("category-name") };
+}
 
-    assert(categoryNameIter != properties.end() && "Can't find property: <category-name>" );
+Cache::Cache(const cocos2d::FastTMXTiledMap * tilemap, const Mask * masks, size_t count)
+    : tileMap{ tilemap }
+    , blocksLayer { tilemap->getLayer(COLLISION_LAYER_NAME) }
+    , tileSize{ blocksLayer->getMapTileSize() }
+    , mapWidth { static_cast<size_t>(blocksLayer->getLayerSize().width) }
+    , mapHeight { static_cast<size_t>(blocksLayer->getLayerSize().height) }
+    , properties ( masks, masks + count )
+{
+    assert(properties.size() == mapWidth * mapHeight && "Masks don't match the collision layer");
+}
 
-    auto name = categoryNameIter->second.asString();
-    if(name == "border") {
-        mask = static_cast<Mask>(Property::BORDER); 
+std::vector<Mask> Cache::BuildLookupTable(const uint32_t * tiles) const {
+    uint32_t maxGid { 0U };
+    for(size_t i = 0; i < properties.size(); i++) {
+        maxGid = std::max(maxGid, ::ExtractGid(tiles[i]));
     }
-    else if(name == "solid") {
-        mask = static_cast<Mask>(Property::SOLID);
-    }
-    else if(name == "spikes") {
-        mask = static_cast<Mask>(Property::SPIKE);
-    }
-    else if(name == "platform") {
-        mask = static_cast<Mask>(Property::PLATFORM);
+
+    std::vector<Mask> lookup(static_cast<size_t>(maxGid) + 1U, 0U);
+    lookup[0] = static_cast<Mask>(Property::EMPTY);
+    for(uint32_t gid = 1U; gid <= maxGid; gid++) {
+        const auto tileProp { tileMap->getPropertiesForGID(static_cast<int>(gid)) };
+        if(tileProp.getType() != cocos2d::Value::Type::MAP) {
+            // the tile isn't used by the layer or has no properties
+            continue;
+        }
+        const auto& tileProperties { tileProp.asValueMap() };
+        const auto categoryNameIter { tileProperties.find("category-name") };
+        if(categoryNameIter != tileProperties.end()) {
+            lookup[gid] = ::MaskFromCategory(categoryNameIter->second.asString());
+        }
     }
-    else {
-        mask = static_cast<Mask>(Property::UNDEFINED);
+    return lookup;
+}
+
+void Cache::FillRows(const uint32_t * tiles
+    , const std::vector<Mask>& lookup
+    , size_t first
+    , size_t last) noexcept
+{
+    for(size_t i = first * mapWidth; i < last * mapWidth; i++) {
+        const auto mask { lookup[::ExtractGid(tiles[i])] };
+        assert(mask && "Can't find property: <category-name>");
+        properties[i] = mask;
     }
-    return mask;
 }
 
-}
\ No newline at end of file
+}
@@ -33,9 +33,17 @@ namespace TileMap {
 		const cocos2d::Size tileSize { 0.f, 0.f }; // it's square
 		const size_t mapWidth { 0U };
 		const size_t mapHeight { 0U };
-		std::vector<std::vector<Mask>> properties;
+		// row-major: mask of the tile (col, row) is at `row * mapWidth + col`
+		std::vector<Mask> properties;
 
 		Cache(const cocos2d::FastTMXTiledMap * tilemap);
+
+		/**
+		 * Take the masks baked with the level (see TileMap::Blob::GetMasks)
+		 * instead of resolving the tiles of the collision layer.
+		 * The number of masks must match the size of the layer.
+		 */
+		Cache(const cocos2d::FastTMXTiledMap * tilemap, const Mask * masks, size_t count);
 		
 		bool IsInMap(const cocos2d::Vec2& pos) const noexcept {
 			return pos.x >= 0.f 
@@ -48,18 +56,30 @@ namespace TileMap {
             if(!this->IsInMap(pos)) {
                 return static_cast<Mask>(Property::OUTSIDE_MAP);
             }
-			return properties[static_cast<size_t>(pos.y)][static_cast<size_t>(pos.x)];
+			return properties[static_cast<size_t>(pos.y) * mapWidth + static_cast<size_t>(pos.x)];
 		}
 
 		Mask GetProperties(int row, int col) const noexcept {
             if(!this->IsInMap({ static_cast<float>(col), static_cast<float>(row) })) {
                 return static_cast<Mask>(Property::OUTSIDE_MAP);
             }
-			return properties[row][col];
+			return properties[static_cast<size_t>(row) * mapWidth + static_cast<size_t>(col)];
 		}
 
 	private:
-		Mask FindProperties(const cocos2d::Vec2& pos) const noexcept;
+		/**
+		 * Resolve the `category-name` of every GID used by the collision layer once.
+		 * @return lookup table GID -> Mask, 0 means the GID has no category
+		 */
+		std::vector<Mask> BuildLookupTable(const uint32_t * tiles) const;
+
+		/**
+		 * Fill the rows [first, last) of the mask buffer from the lookup table.
+		 */
+		void FillRows(const uint32_t * tiles
+			, const std::vector<Mask>& lookup
+			, size_t first
+			, size_t last) noexcept;
 	};
 }
 
@@ -2,15 +2,14 @@
 
 #include "Utils.hpp"
 #include "TileMapHelper.hpp"
-#include "PhysicsHelper.hpp"
+#include "TileMapBlob.hpp"
+#include "BorderBuilder.hpp"
+#include "Profiler.hpp"
 #include "components/Props.hpp"
 
 #include <string_view>
 #include <charconv> // std::from_chars
 #include <algorithm>
-#include <list>
-#include <optional>
-#include <functional>
 #include <iterator>
 #include <cassert>
 #include <cstdint>
@@ -56,294 +55,9 @@ namespace {
 	} 
 }
 
-// simulate behaviour
-class Move {
-public:
-	Move(cocos2d::Vec2 start, int w, int h) : 
-		m_position { start },
-		m_width { w }, 
-		m_height { h } 
-	{}
-
-	void TurnRight() noexcept {
-		m_shiftIndex = (m_shiftIndex + 1) % 4;
-	}
-	
-	bool CanMoveForward() const noexcept {
-		return this->WithinBounds(m_position + m_shift[m_shiftIndex]);
-	}
-
-	void MakeMoveForward() noexcept {
-		m_position += m_shift[m_shiftIndex];
-	}
-
-	void MakeMoveBackwards() noexcept {
-		m_position -= m_shift[m_shiftIndex];
-	}
-
-	cocos2d::Vec2 GetPosition() const noexcept {
-		return m_position;
-	}
-
-	void Reset(const cocos2d::Vec2& pos) noexcept {
-		m_position = pos;
-		m_shiftIndex = 0;
-	}
-
-	cocos2d::Vec2 PeekNext() const noexcept {
-		return m_position + m_shift[m_shiftIndex];
-	}
-
-private:
-	bool WithinBounds(const cocos2d::Vec2 & pos) const noexcept {
-		return pos.x >= 0.f 
-			&& pos.y >= 0.f 
-			&& pos.x < static_cast<float>(m_width) 
-			&& pos.y < static_cast<float>(m_height); 
-	}
-
-	inline static const cocos2d::Vec2 m_shift[4] = { 
-		{ 1.f, 0.f }, 
-		{ 0.f, 1.f }, 
-		{ -1.f, 0.f }, 
-		{ 0.f, -1.f } 
-	};
-	
-	cocos2d::Vec2 m_position {};
-	
-	size_t m_shiftIndex { 0 };
-
-	const int m_width { 0 };
-	const int m_height { 0 };
-};
-
-class BorderBuilder {
-public:
-	using Property = TileMap::Property;
-
-	BorderBuilder(const TileMap::Cache * cache)
-		: m_cache { cache }
-	{
-		assert(m_cache && "cache pointer can't be null");
-		assert(m_cache->blocksLayer && "can't find the layer with blocks");
-	}
-
-	std::vector<std::list<cocos2d::Vec2>> BuildBorder() const {
-		// BUILD BORDERS FOR COMPOSITE PHYSICS BODIES:
-		int components { 0 };
-		std::vector<std::vector<char>> isVisited (
-			m_cache->mapHeight, 
-			std::vector<char>(m_cache->mapWidth, false)
-		);
-		std::vector<std::list<cocos2d::Vec2>> tiles;
-		for(size_t y = 0; y < m_cache->mapHeight; y++) {
-			for(size_t x = 0; x < m_cache->mapWidth; x++) {
-				if(isVisited[y][x]) continue;
-				// always top-left tile
-				cocos2d::Vec2 point { static_cast<float>(x), static_cast<float>(y) };
-				auto mask = m_cache->GetProperties(point);
-
-				// skip not a border
-				if(!Utils::HasAny(mask, Property::BORDER)) continue;
-				
-				components++;
-				tiles.emplace_back();
-				tiles.back().emplace_back(point);
-
-				// go in one direction from the found border tile
-				this->Visit(point, [&tiles = tiles.back()](const cocos2d::Vec2& tile) {
-					tiles.push_back(tile);
-				}, isVisited);
-				// reset start m_position
-				point = cocos2d::Vec2{ static_cast<float>(x), static_cast<float>(y) };
-				// try to go in another direction from the found border tile
-				this->Visit(point, [&tiles = tiles.back()](const cocos2d::Vec2& tile) {
-					tiles.push_front(tile);
-				}, isVisited);
-			}
-		}
-		
-		return tiles;
-	}
-
-	std::vector<details::Form> GetChainedLines(const std::vector<std::list<cocos2d::Vec2>>& tilesBorder) const {
-		std::vector<details::Form> forms;
-		forms.reserve(tilesBorder.size());
-
-		for(auto&& chain: tilesBorder) {
-			details::Form form;
-			form.m_type = core::CategoryName::BORDER;
-			form.m_points.reserve(chain.size() >> 1U);
-			for(auto& point: chain) {
-				auto result = this->AddPoint(point);
-				if(result.has_value()) {
-					form.m_points.emplace_back(*result);
-				}
-			}
-			assert(chain.size() >= 2 && "Can't have a chain with 0 or 1 elements");
-			// if distance between front and back tiles is short enough => connect them
-			float dx = chain.front().x - chain.back().x;
-			float dy = chain.front().y - chain.back().y;
-			auto distance = fabs(dx) + fabs(dy);
-			bool isSameLine = helper::IsEqual(dx, 0.f, 0.1f) || helper::IsEqual(dy, 0.f, 0.1f);
-			if(distance <= 10.f && isSameLine) {
-				form.m_points.emplace_back(form.m_points.front());
-			}
-			forms.emplace_back(form);
-		}
-
-		return forms;
-	}
-
-private:
-
-	std::optional<cocos2d::Vec2> AddPoint(const cocos2d::Vec2& point) const {
-		// check for { empty tiles | map boundary | (not solid && not border ) } around the point
-		cocos2d::Vec2 shiftsToFree[4] = {};
-		cocos2d::Vec2 shiftsToBorder[4] = {};
-		int borderTileCount { 0 };
-		// tiles that aren't occupied by border (but include out of map bounds points)
-		int freeTileCount { 0 };
-		int countOutsideMap { 0 };
-
-		for(size_t i = 0; i < 4; ++i) {
-			const auto neighbor = point + m_horizontalDelta[i];
-			const auto mask = m_cache->GetProperties(neighbor);
-			if(Utils::HasAny(mask, Property::OUTSIDE_MAP)) {
-				shiftsToFree[freeTileCount] = m_horizontalDelta[i];
-				++freeTileCount;
-				++countOutsideMap;
-			}
-			else if(!Utils::HasAny(mask, Property::BORDER, Property::SOLID)) {
-				shiftsToFree[freeTileCount] = m_horizontalDelta[i];
-				++freeTileCount;
-			} 
-			else if(Utils::HasAny(mask, Property::BORDER)) {
-				shiftsToBorder[borderTileCount] = m_horizontalDelta[i];
-				++borderTileCount;
-			}
-		}
-		assert(freeTileCount >= 0 && freeTileCount <= 2 && "Can't have more than 2 neighbours");
-		cocos2d::Vec2 freeSum { 
-			shiftsToFree[0].x + shiftsToFree[1].x, 
-			shiftsToFree[0].y + shiftsToFree[1].y 
-		};
-		cocos2d::Vec2 borderSum { 
-			shiftsToBorder[0].x + shiftsToBorder[1].x, 
-			shiftsToBorder[0].y + shiftsToBorder[1].y 
-		};
-
-		// One of cardinal sequence: N->E; E->S; S->W; W->N is a pair of neighbours
-		bool hasFreeTilesCardinalContinuation = helper::IsEqual(fabs(freeSum.x) + fabs(freeSum.y), 2.f, 0.01f);
-		bool hasFreeTilesInMap = freeTileCount != countOutsideMap;
-		bool hasBorderTilesCardinalContinuation = !helper::IsEqual(fabs(borderSum.x) + fabs(borderSum.y), 0.f, 0.1f);
-
-		if(freeTileCount == 2 && hasFreeTilesCardinalContinuation) {
-			// From tile coordinates in Tiled.exe to coordinates in game engine
-			cocos2d::Vec2 tileMiddle { 
-				point.x * m_cache->tileSize.width + m_cache->tileSize.width / 2.f, 
-				(m_cache->mapHeight - point.y - 1.f) * m_cache->tileSize.height + m_cache->tileSize.height / 2.f
-			};
-			tileMiddle.x +=  freeSum.x * m_cache->tileSize.width  / 2.f;
-			tileMiddle.y += -freeSum.y * m_cache->tileSize.height / 2.f;
-			return { tileMiddle };
-		}
-		else if(!hasFreeTilesInMap && hasBorderTilesCardinalContinuation) { 
-			// this is a case for some corner tiles (they indicates a concave polygons)
-			// or tiles on the map's border.
-			// From tile coordinates in Tiled.exe to coordinates in game engine
-			cocos2d::Vec2 tileMiddle { 
-				point.x * m_cache->tileSize.width + m_cache->tileSize.width / 2.f, 
-				(m_cache->mapHeight - point.y - 1.f) * m_cache->tileSize.height + m_cache->tileSize.height / 2.f
-			};
-		
-			for(int i = 0; i < 4; ++i) {
-				const auto neighbor = point + m_diagonalDelta[i];
-				const auto mask = m_cache->GetProperties(neighbor);
-				if (!Utils::HasAny(mask, Property::OUTSIDE_MAP, Property::BORDER, Property::SOLID)) {
-					tileMiddle.x +=  m_diagonalDelta[i].x * m_cache->tileSize.width  / 2.f;
-					tileMiddle.y += -m_diagonalDelta[i].y * m_cache->tileSize.height / 2.f;
-					break;
-				}
-			}
-			return { tileMiddle };
-		}
-		else {
-			return std::nullopt;
-		}
-	}
-
-	/**
-	 * Go from the start through the first met neighbour to extract a border of physics object
-	 * 
-	 * @param start is a m_position of the tile on tile map from which the algo starts
-	 * @param tiles is a container for the border tiles
-	 * @param adder is a functional object which define where the tile will be added
-	 * @param isVisited is a 2d map of visited tiles
-	 */
-	void Visit(
-		const cocos2d::Vec2& start
-		, std::function<void(const cocos2d::Vec2&)> && add
-		, std::vector<std::vector<char>>& isVisited
-	) const {
-		Move move { start, 
-			static_cast<int>(m_cache->mapWidth), 
-			static_cast<int>(m_cache->mapHeight)
-		};
-		isVisited[static_cast<size_t>(start.y)][static_cast<size_t>(start.x)] = true;
-		
-		auto point = start;
-
-		for(size_t turns = 0, skips = 0; ; turns++) {
-			size_t steps { 0 };
-			// trying to move
-			while(move.CanMoveForward()) {
-				// move 1 tile forward
-				move.MakeMoveForward();
-				// update m_position
-				point = move.GetPosition();
-				// get tile gid
-				size_t mask = m_cache->GetProperties(point);
-				const auto x = static_cast<size_t>(point.x);
-				const auto y = static_cast<size_t>(point.y);
-				// add tile if it's not visited yet and is border tile
-				if(!isVisited[y][x] && Utils::HasAny(mask, Property::BORDER)) {
-					// mark
-					isVisited[y][x] = true;
-					add(point);
-					steps++;
-				}
-				else {
-					// restore m_position
-					move.MakeMoveBackwards();
-					break;
-				}
-			}
-			
-			skips = steps? 0: skips + 1;
-			if(skips >= 4) break;
-			move.TurnRight();
-		}
-	}
-
-private:
-	// Info about the map that need to be extracted only once
-	// to speed up and make things easier accessable 
-	const TileMap::Cache * m_cache { nullptr };
-
-	static inline const cocos2d::Vec2 m_horizontalDelta[] = {
-		{-1.f, 0.f}, {1.f, 0.f}, {0.f, 1.f}, {0.f, -1.f}
-	};
-
-	static inline const cocos2d::Vec2 m_diagonalDelta[4] = {
-		{-1.f, -1.f}, {-1.f, 1.f}, {1.f, 1.f}, {1.f, -1.f}
-	};
-};
-
 TileMapParser::TileMapParser(const cocos2d::FastTMXTiledMap * tileMap, const std::string& tmxFile)
 	: m_tileMap{ tileMap }
 	, m_tmxFile{ tmxFile }
-	, m_tileMapCache{ std::make_unique<TileMap::Cache>(m_tileMap) }
 {
     this->Get<CategoryName::PLATFORM>().reserve(20);
 	this->Get<CategoryName::BORDER>().reserve(100);
@@ -357,6 +71,8 @@ TileMapParser::TileMapParser(const cocos2d::FastTMXTiledMap * tileMap, const std
 TileMapParser::~TileMapParser() = default;
 
 void TileMapParser::Parse() {
+	PROFILE_ZONE("TileMapParser::Parse");
+	m_tileMapCache = std::make_unique<TileMap::Cache>(m_tileMap);
 	this->ParseTileSets();
     this->ParseUnits();
     this->ParseProps();
@@ -365,63 +81,85 @@ void TileMapParser::Parse() {
 
 	// parse borders:
 	BorderBuilder builder{ m_tileMapCache.get() };
-	auto tilesBorder = builder.BuildBorder();
-	this->Get<CategoryName::BORDER>() = builder.GetChainedLines(tilesBorder);
-
-    const auto obstaclesLayer = m_tileMap->getLayer(TileMap::COLLISION_LAYER_NAME);
-	if (obstaclesLayer) {
-		const auto tileSize { obstaclesLayer->getMapTileSize() };
-		const auto mapSize { obstaclesLayer->getLayerSize() };
-		const auto width { static_cast<int>(mapSize.width) };
-		const auto height { static_cast<int>(mapSize.height) };
-
-		// check whether the tile was already visited
-		// for now I don't need it.
-    	std::vector<std::vector<char>> isVisited (height, std::vector<char>(width, false));
-		
-		auto GetTileInfo = [this](int tileGid) {
-			const auto tileProp { m_tileMap->getPropertiesForGID(tileGid) };
-			const auto& properties { tileProp.asValueMap() };
-			const auto categoryNameIter { properties.find("category-name") };
-			
-			assert(categoryNameIter != properties.end() && "Can't find body type or category");
-			return categoryNameIter->second.asString();
-		};
-		
-		// merge tiles with similar properties
-		using Property = TileMap::Property;
-		for(int y = 0; y < height; y++) {
-			for(int x = 0; x < width; x++) {
-				auto originProperty = m_tileMapCache->GetProperties(y, x);
-				
-				if(Utils::HasAny(originProperty, Property::EMPTY, Property::BORDER) || isVisited[y][x]) continue;
-
-				isVisited[y][x] = true;
-				// Some bodies can consist from several tiles so
-				// they should be combined into one physics body.
-				// merge all horizontal neighbors:
-				auto col { x + 1 };
-				while(col < width && !isVisited[y][col]) {
-					// if they have same property then merge them
-					auto neighbourProperty = m_tileMapCache->GetProperties(y, col);
-					if(neighbourProperty != originProperty) {
-						break;
-					}
-
-					isVisited[y][col] = true;
-					col++;
+	this->Get<CategoryName::BORDER>() = builder.Build();
+
+	this->MergeTiles();
+}
+
+void TileMapParser::MergeTiles() {
+	using Property = TileMap::Property;
+
+	const auto& cache { *m_tileMapCache };
+	const auto tileSize { cache.tileSize };
+	const auto width { cache.mapWidth };
+	const auto height { cache.mapHeight };
+	m_mergeStats = MergeStats{};
+
+	const auto isMergeable = [](TileMap::Mask mask) {
+		return !Utils::HasAny(mask, Property::EMPTY, Property::BORDER);
+	};
+	// number of bodies if the tiles were merged only along the rows
+	for(size_t y = 0; y < height; y++) {
+		TileMap::Mask previous { static_cast<TileMap::Mask>(Property::EMPTY) };
+		for(size_t x = 0; x < width; x++) {
+			const auto mask { cache.properties[y * width + x] };
+			if(isMergeable(mask)) {
+				m_mergeStats.tiles++;
+				m_mergeStats.rows += (mask != previous)? 1U: 0U;
+			}
+			previous = mask;
+		}
+	}
+
+	// Some bodies can consist from several tiles so they should be combined into one physics body.
+	// Greedy meshing: grow the run of the tiles with the same property along the row,
+	// then grow it down while the whole run below has the same property.
+	// Platforms stay one row high: units land only on the top of their bodies (see BeginPlatform),
+	// so each row of the stacked platforms must have its own top.
+	std::vector<char> isVisited(width * height, false);
+	for(size_t y = 0; y < height; y++) {
+		for(size_t x = 0; x < width; x++) {
+			const auto origin { y * width + x };
+			const auto originProperty { cache.properties[origin] };
+			if(!isMergeable(originProperty) || isVisited[origin]) continue;
+
+			size_t col { x + 1U };
+			while(col < width 
+				&& !isVisited[y * width + col] 
+				&& cache.properties[y * width + col] == originProperty
+			) {
+				col++;
+			}
+			const bool canGrowDown { originProperty != static_cast<TileMap::Mask>(Property::PLATFORM) };
+			size_t row { y + 1U };
+			for(; canGrowDown && row < height; row++) {
+				const auto first { row * width + x };
+				const auto last { row * width + col };
+				const bool isSame = std::all_of(cache.properties.cbegin() + first
+					, cache.properties.cbegin() + last
+					, [originProperty](TileMap::Mask mask) { return mask == originProperty; }
+				) && std::none_of(isVisited.cbegin() + first, isVisited.cbegin() + last
+					, [](char visited) { return visited; }
+				);
+				if(!isSame) {
+					break;
 				}
+			}
+			for(size_t r = y; r < row; r++) {
+				std::fill(isVisited.begin() + r * width + x, isVisited.begin() + r * width + col, true);
+			}
 
-				details::Form form;
-				form.m_rect = cocos2d::Rect{
-					cocos2d::Vec2{ x * tileSize.width, (height - y - 1) * tileSize.height }, 
-					cocos2d::Size{ tileSize.width * (col - x), tileSize.height }
-				};
-				form.m_type = CategoryFromProperty(originProperty);
-				this->Get(form.m_type).emplace_back(form);
-			}	// for
+			details::Form form;
+			// rows go from the top of the map, bodies' origin is bottom-left
+			form.m_rect = cocos2d::Rect{
+				cocos2d::Vec2{ x * tileSize.width, (height - row) * tileSize.height }, 
+				cocos2d::Size{ tileSize.width * (col - x), tileSize.height * (row - y) }
+			};
+			form.m_type = CategoryFromProperty(originProperty);
+			this->Get(form.m_type).emplace_back(form);
+			m_mergeStats.rectangles++;
 		}	// for
-	}
+	}	// for
 }
 
 void TileMapParser::ParseUnits() {
@@ -623,3 +361,139 @@ void TileMapParser::ParseInfluences() {
 		}
 	}
 }
+
+bool TileMapParser::Load() {
+	PROFILE_ZONE("TileMapParser::Load");
+	// the TMX is read only when its modification time differs from the baked one
+	const auto level { TileMap::Blob::Open(GetBakedPath(m_tmxFile), m_tmxFile) };
+	if(!level) {
+		return false;
+	}
+	const auto& header { level->GetHeader() };
+	const auto layerSize { m_tileMap->getLayer(TileMap::COLLISION_LAYER_NAME)->getLayerSize() };
+	if(header.mapWidth != static_cast<uint32_t>(layerSize.width)
+		|| header.mapHeight != static_cast<uint32_t>(layerSize.height)
+	) {
+		cocos2d::log("Level blob of %s doesn't match the collision layer", m_tmxFile.c_str());
+		return false;
+	}
+	const auto masks { level->GetMasks() };
+	m_tileMapCache = std::make_unique<TileMap::Cache>(m_tileMap, masks.data, masks.size);
+
+	const auto points { level->GetPoints() };
+	for(const auto& record: level->GetForms()) {
+		if(record.type >= Utils::EnumSize<CategoryName>()) {
+			assert(false && "Unexpected category of the baked form");
+			continue;
+		}
+		const auto category { Utils::EnumCast<CategoryName>(record.type) };
+		details::Form form;
+		form.m_type = category;
+		form.m_subType = record.subType;
+		form.m_id = record.id;
+		form.m_pathId = record.pathId;
+		form.m_ownerId = record.ownerId;
+		form.m_scale = record.scale;
+		form.m_flipX = record.flipX != 0U;
+		form.m_rect = cocos2d::Rect{ record.x, record.y, record.width, record.height };
+		form.m_points.reserve(record.points.count);
+		for(uint32_t i = 0; i < record.points.count; i++) {
+			const auto& point { points[record.points.offset + i] };
+			form.m_points.emplace_back(point.x, point.y);
+		}
+		this->Get(category).emplace_back(std::move(form));
+	}
+
+	const auto properties { level->GetProperties() };
+	for(const auto& record: level->GetTileSets()) {
+		details::TileSet tileset{};
+		tileset.name = level->GetString(record.name);
+		tileset.firstgid = record.firstgid;
+		tileset.tilewidth = record.tilewidth;
+		tileset.tileheight = record.tileheight;
+		tileset.properties.reserve(record.properties.count);
+		for(uint32_t i = 0; i < record.properties.count; i++) {
+			const auto& property { properties[record.properties.offset + i] };
+			tileset.properties.emplace_back(
+				level->GetString(property.field)
+				, level->GetString(property.value)
+			);
+		}
+		m_tileSets.emplace(tileset.name, std::move(tileset));
+	}
+	return true;
+}
+
+bool TileMapParser::Bake(const std::string& path) const {
+	assert(m_tileMapCache && "The map must be parsed before baking");
+
+	const auto data { cocos2d::FileUtils::getInstance()->getDataFromFile(m_tmxFile) };
+	TileMap::blob::Source source;
+	if(data.isNull() || !TileMap::blob::Stat(m_tmxFile, source)) {
+		return false;
+	}
+	const auto sourceHash { TileMap::blob::Hash(data.getBytes(), static_cast<size_t>(data.getSize())) };
+	if(const auto baked { TileMap::Blob::Open(path, m_tmxFile) };
+		baked && baked->GetHeader().sourceHash == sourceHash && baked->GetHeader().sourceTime == source.time
+	) {
+		// keep the file untouched, so the unchanged level isn't copied again with the resources;
+		// the touched one is rebaked with the new time, so loading doesn't hash the TMX
+		return true;
+	}
+	TileMap::BlobBuilder builder {
+		sourceHash
+		, source
+		, static_cast<uint32_t>(m_tileMapCache->mapWidth)
+		, static_cast<uint32_t>(m_tileMapCache->mapHeight)
+	};
+
+	for(const auto& forms: m_parsed) {
+		for(const auto& form: forms) {
+			TileMap::blob::FormRecord record;
+			record.type = static_cast<uint32_t>(Utils::EnumCast(form.m_type));
+			record.subType = static_cast<uint32_t>(form.m_subType);
+			record.id = static_cast<uint32_t>(form.m_id);
+			record.pathId = static_cast<uint32_t>(form.m_pathId);
+			record.ownerId = static_cast<uint32_t>(form.m_ownerId);
+			record.scale = form.m_scale;
+			record.flipX = form.m_flipX? 1U: 0U;
+			record.points.count = static_cast<uint32_t>(form.m_points.size());
+			// cocos2d::Vec2 is a pair of floats
+			static_assert(sizeof(cocos2d::Vec2) == 2 * sizeof(float));
+			record.points.offset = builder.AddPoints(
+				reinterpret_cast<const float*>(form.m_points.data())
+				, form.m_points.size()
+			);
+			record.x = form.m_rect.origin.x;
+			record.y = form.m_rect.origin.y;
+			record.width = form.m_rect.size.width;
+			record.height = form.m_rect.size.height;
+			builder.AddForm(record);
+		}
+	}
+
+	for(const auto& [name, tileset]: m_tileSets) {
+		TileMap::blob::TileSetRecord record;
+		record.name = builder.AddString(tileset.name);
+		record.firstgid = static_cast<uint32_t>(tileset.firstgid);
+		record.tilewidth = tileset.tilewidth;
+		record.tileheight = tileset.tileheight;
+		record.properties.count = static_cast<uint32_t>(tileset.properties.size());
+		for(size_t i = 0; i < tileset.properties.size(); i++) {
+			const auto& [field, value] = tileset.properties[i];
+			const auto index { builder.AddProperty(field, value) };
+			if(i == 0) {
+				record.properties.offset = index;
+			}
+		}
+		builder.AddTileSet(record);
+	}
+
+	builder.SetMasks(m_tileMapCache->properties.data(), m_tileMapCache->properties.size());
+	return builder.Save(path);
+}
+
+std::string TileMapParser::GetBakedPath(const std::string& tmxFile) {
+	const auto extension { tmxFile.rfind('.') };
+	return tmxFile.substr(0, extension) + ".lvl";
+}
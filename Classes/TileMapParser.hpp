@@ -6,6 +6,7 @@
 #include <array>
 #include <memory>
 #include <unordered_map>
+#include <cassert>
 
 #include "math/CCGeometry.h" // cocos2d::Rect, cocos2d::Vec2
 
@@ -65,6 +66,23 @@ public:
 
     void Parse();
 
+    /**
+     * Fill the parser from the baked level (see TileMap::Blob) instead of parsing.
+     * @return false if there is no baked level or it's out of date
+     */
+    bool Load();
+
+    /**
+     * Write parsed data as a baked level. Must be called after `Parse`.
+     * The blob baked from the same TMX content is left as is.
+     */
+    bool Bake(const std::string& path) const;
+
+    /**
+     * Path to the baked level: `Map/level_1.tmx` -> `Map/level_1.lvl`
+     */
+    static std::string GetBakedPath(const std::string& tmxFile);
+
     template <CategoryName category>
     [[nodiscard]] auto&& Acquire() noexcept {
         return std::move(m_parsed[core::EnumCast(category)]);
@@ -77,6 +95,32 @@ public:
     [[nodiscard]] const auto& Peek(CategoryName category) const noexcept {
         return m_parsed[Utils::EnumCast(category)];
     }
+
+    /**
+     * Masks of the collision layer: resolved by `Parse` or taken from the baked level by `Load`.
+     */
+    [[nodiscard]] const TileMap::Cache& GetTileMapCache() const noexcept {
+        assert(m_tileMapCache && "The map must be parsed or loaded");
+        return *m_tileMapCache;
+    }
+
+    /**
+     * How well the collision layer's tiles were merged into the static bodies
+     * (platforms, spikes, solid blocks).
+     */
+    struct MergeStats final {
+        size_t tiles { 0U };
+        // bodies if the tiles were merged only along the rows
+        size_t rows { 0U };
+        size_t rectangles { 0U };
+    };
+
+    /**
+     * Available after `Parse`
+     */
+    [[nodiscard]] const MergeStats& GetMergeStats() const noexcept {
+        return m_mergeStats;
+    }
     
 private:
 
@@ -90,6 +134,13 @@ private:
     
     void ParseInfluences();
 
+    /**
+     * Merge the tiles with the same properties into maximal rectangles:
+     * along the row first, then down while the whole run below matches.
+     * Platforms are merged only along the rows.
+     */
+    void MergeTiles();
+
     template <CategoryName category>
     [[nodiscard]] auto& Get() noexcept {
         return m_parsed[Utils::EnumCast(category)];
@@ -111,6 +162,8 @@ private:
     >  m_parsed;
 
 	std::unordered_map<std::string, details::TileSet> m_tileSets;
+
+    MergeStats m_mergeStats {};
 };
 
 #endif // TILE_MAP_PARSER_HPP
\ No newline at end of file
@@ -29,15 +29,7 @@ public:
      * Force to release all buttons.
      */
     void Reset();
-private:
-    // callbacks 
-    void OnKeyPressed(WinKeyCode keyCode, cocos2d::Event* event);
-    
-    void OnKeyRelease(WinKeyCode keyCode, cocos2d::Event* event);
 
-private:
-    static constexpr int MAX_JUMP_COUNT { 2 };
-    
     /** @brief
      * Used to keep track of user's last input
     */
@@ -62,6 +54,19 @@ private:
         void Merge(const Input&) noexcept;
     };
 
+    const Input& GetInput() const noexcept {
+        return m_lastInput;
+    }
+
+private:
+    // callbacks 
+    void OnKeyPressed(WinKeyCode keyCode, cocos2d::Event* event);
+    
+    void OnKeyRelease(WinKeyCode keyCode, cocos2d::Event* event);
+
+private:
+    static constexpr int MAX_JUMP_COUNT { 2 };
+    
     Input m_lastInput {};
     Player * const m_player { nullptr };
     std::array<WinKeyCode, 11U> m_validKeys;
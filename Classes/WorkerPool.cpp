@@ -0,0 +1,99 @@
+#include "WorkerPool.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+WorkerPool::WorkerPool(size_t workers)
+    : m_slices { std::make_unique<Slice[]>(workers + 1U) }
+{
+    m_workers.reserve(workers);
+    for (size_t i = 0; i < workers; i++) {
+        // the calling thread is the participant 0
+        m_workers.emplace_back(&WorkerPool::Run, this, i + 1U);
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock { m_mutex };
+        m_isStopped = true;
+    }
+    m_wake.notify_all();
+    for (auto& worker: m_workers) {
+        worker.join();
+    }
+}
+
+void WorkerPool::ParallelFor(size_t count
+    , size_t grain
+    , const std::function<void(size_t, size_t)>& job
+) {
+    assert(grain > 0U);
+    if (count == 0U) {
+        return;
+    }
+    const size_t participants { this->GetConcurrency() };
+    if (participants == 1U || count <= grain) {
+        std::invoke(job, 0U, count);
+        return;
+    }
+    const size_t perSlice { (count + participants - 1U) / participants };
+    for (size_t i = 0; i < participants; i++) {
+        m_slices[i].next.store(std::min(i * perSlice, count), std::memory_order_relaxed);
+        m_slices[i].end = std::min((i + 1U) * perSlice, count);
+    }
+    {
+        std::lock_guard<std::mutex> lock { m_mutex };
+        m_job = &job;
+        m_grain = grain;
+        m_busy = m_workers.size();
+        m_generation++;
+    }
+    m_wake.notify_all();
+
+    this->Work(0U);
+
+    std::unique_lock<std::mutex> lock { m_mutex };
+    m_done.wait(lock, [this]() { return m_busy == 0U; });
+    m_job = nullptr;
+}
+
+void WorkerPool::Run(size_t participant) {
+    uint64_t generation { 0U };
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock { m_mutex };
+            m_wake.wait(lock, [this, generation]() {
+                return m_isStopped || m_generation != generation;
+            });
+            if (m_isStopped) {
+                return;
+            }
+            generation = m_generation;
+        }
+
+        this->Work(participant);
+
+        std::lock_guard<std::mutex> lock { m_mutex };
+        if (--m_busy == 0U) {
+            m_done.notify_one();
+        }
+    }
+}
+
+void WorkerPool::Work(size_t participant) {
+    // published under the mutex before the workers were woken
+    const auto& job { *m_job };
+    const size_t grain { m_grain };
+    const size_t participants { this->GetConcurrency() };
+    for (size_t i = 0; i < participants; i++) {
+        // start from the own slice, then go over the others
+        auto& slice { m_slices[(participant + i) % participants] };
+        for (size_t begin = slice.next.fetch_add(grain, std::memory_order_relaxed);
+            begin < slice.end;
+            begin = slice.next.fetch_add(grain, std::memory_order_relaxed)
+        ) {
+            std::invoke(job, begin, std::min(begin + grain, slice.end));
+        }
+    }
+}
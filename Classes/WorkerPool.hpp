@@ -0,0 +1,92 @@
+#ifndef WORKER_POOL_HPP
+#define WORKER_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Persistent worker threads running parallel loops.
+ *
+ * The range of the loop is split into a slice per participant (the workers and
+ * the calling thread). Each participant takes chunks from its own slice and,
+ * once it's exhausted, steals chunks from the slices of the others,
+ * so a participant which got cheap items helps the ones which got expensive.
+ * Workers sleep between the loops.
+ */
+class WorkerPool final {
+public:
+    /**
+     * @param workers number of threads besides the calling one
+     */
+    explicit WorkerPool(size_t workers);
+
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+    WorkerPool(WorkerPool&&) = delete;
+    WorkerPool& operator=(WorkerPool&&) = delete;
+
+    /**
+     * @return number of threads running the loop including the calling one
+     */
+    size_t GetConcurrency() const noexcept {
+        return m_workers.size() + 1U;
+    }
+
+    /**
+     * Run `job(begin, end)` over chunks of [0, count) of at most `grain` items.
+     * The calling thread takes part in the loop and returns when all chunks are done.
+     * Must be called from a single thread at a time.
+     */
+    void ParallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& job);
+
+private:
+    // own cache line: the cursor is hammered by the owner and the thieves
+    struct alignas(64) Slice final {
+        std::atomic<size_t> next { 0U };
+        size_t end { 0U };
+    };
+
+    /**
+     * Worker's loop: wait for the next loop and take part in it.
+     */
+    void Run(size_t participant);
+
+    /**
+     * Take chunks of the own slice, then steal from the others.
+     */
+    void Work(size_t participant);
+
+    std::vector<std::thread> m_workers;
+
+    std::unique_ptr<Slice[]> m_slices;
+
+    std::mutex m_mutex;
+
+    std::condition_variable m_wake;
+
+    std::condition_variable m_done;
+
+    /// Guarded by the mutex
+
+    const std::function<void(size_t, size_t)> * m_job { nullptr };
+
+    size_t m_grain { 1U };
+
+    // incremented by each loop, workers wait for it to change
+    uint64_t m_generation { 0U };
+
+    // workers which haven't finished the current loop yet
+    size_t m_busy { 0U };
+
+    bool m_isStopped { false };
+};
+
+#endif // WORKER_POOL_HPP
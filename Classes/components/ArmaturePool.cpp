@@ -0,0 +1,152 @@
+#include "ArmaturePool.hpp"
+#include "SkeletonConverter.hpp"
+#include "Profiler.hpp"
+
+#include "cocos2d.h"
+#include "dragonBones/DragonBonesHeaders.h"
+#include "dragonBones/cocos2dx/CCDragonBonesHeaders.h"
+
+#include <algorithm>
+#include <cassert>
+
+void ArmaturePool::Prewarm(const AssetPreloader::Manifest& manifest) {
+    if (!m_isEnabled) {
+        return;
+    }
+    PROFILE_ZONE("ArmaturePool::Prewarm");
+    std::vector<std::string> keys;
+    keys.reserve(manifest.skeletons.size());
+    for (const auto& skeleton: manifest.skeletons) {
+        keys.push_back(MakeKey(skeleton.name, ARMATURE_NAME));
+    }
+    for (auto it = m_free.begin(); it != m_free.end();) {
+        if (std::find(keys.cbegin(), keys.cend(), it->first) == keys.cend()) {
+            for (auto display: it->second) {
+                display->dispose();
+            }
+            it = m_free.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+    for (const auto& skeleton: manifest.skeletons) {
+        auto& free { m_free[MakeKey(skeleton.name, ARMATURE_NAME)] };
+        free.reserve(skeleton.instances);
+        while (free.size() < skeleton.instances) {
+            const auto display { Build(skeleton.prefix, skeleton.name, ARMATURE_NAME) };
+            if (!display) {
+                break;
+            }
+            Reset(display);
+            free.push_back(display);
+        }
+    }
+}
+
+dragonBones::CCArmatureDisplay* ArmaturePool::Acquire(const std::string& prefix
+    , const std::string& dragonBonesName
+    , const std::string& armatureName
+) {
+    dragonBones::CCArmatureDisplay * display { nullptr };
+    const auto it = m_isEnabled? m_free.find(MakeKey(dragonBonesName, armatureName)): m_free.end();
+    if (it == m_free.end() || it->second.empty()) {
+        PROFILE_ZONE("ArmaturePool::Build");
+        m_misses++;
+        display = Build(prefix, dragonBonesName, armatureName);
+    }
+    else {
+        m_hits++;
+        display = it->second.back();
+        it->second.pop_back();
+        display->getArmature()->setClock(dragonBones::CCFactory::getClock());
+    }
+    return display;
+}
+
+void ArmaturePool::Release(dragonBones::CCArmatureDisplay * display) {
+    assert(display && display->getArmature());
+    const auto data { display->getArmature()->getArmatureData() };
+    Reset(display);
+    if (m_isEnabled) {
+        m_free[MakeKey(data->parent->name, data->name)].push_back(display);
+    }
+    else {
+        display->dispose();
+    }
+}
+
+void ArmaturePool::Clear() {
+    for (auto& [key, free]: m_free) {
+        for (auto display: free) {
+            display->dispose();
+        }
+    }
+    m_free.clear();
+}
+
+void ArmaturePool::SetEnabled(bool isEnabled) {
+    m_isEnabled = isEnabled;
+    if (!m_isEnabled) {
+        this->Clear();
+    }
+}
+
+size_t ArmaturePool::GetFree() const noexcept {
+    size_t count { 0U };
+    for (const auto& [key, free]: m_free) {
+        count += free.size();
+    }
+    return count;
+}
+
+std::string ArmaturePool::MakeKey(const std::string& dragonBonesName, const std::string& armatureName) {
+    return dragonBonesName + "/" + armatureName;
+}
+
+dragonBones::CCArmatureDisplay* ArmaturePool::Build(const std::string& prefix
+    , const std::string& dragonBonesName
+    , const std::string& armatureName
+) {
+    const auto factory = dragonBones::CCFactory::getFactory();
+    std::string path = prefix.empty()? "" : prefix + "/";
+    if(const auto bonesData = factory->getDragonBonesData(dragonBonesName); bonesData == nullptr) {
+        // prefer the binary skeleton converted at build time (`convert-skeletons` target):
+        // it's parsed in place without walking the JSON, unless the JSON was edited since
+        const auto fileUtils { cocos2d::FileUtils::getInstance() };
+        const auto skeleton { path + "/" + dragonBonesName };
+        const auto binary { fileUtils->fullPathForFilename(skeleton + SkeletonConverter::BINARY_SUFFIX) };
+        if(!binary.empty() && SkeletonConverter::IsUpToDate(binary
+            , fileUtils->fullPathForFilename(skeleton + SkeletonConverter::JSON_SUFFIX)))
+        {
+            factory->loadDragonBonesData(skeleton + SkeletonConverter::BINARY_SUFFIX);
+        }
+        else {
+            factory->loadDragonBonesData(skeleton + SkeletonConverter::JSON_SUFFIX);
+        }
+    }
+    if(const auto texture = factory->getTextureAtlasData(dragonBonesName); texture == nullptr) {
+        factory->loadTextureAtlasData( path + "/" + dragonBonesName + "_tex.json");
+    }
+    return factory->buildArmatureDisplay(armatureName, dragonBonesName);
+}
+
+void ArmaturePool::Reset(dragonBones::CCArmatureDisplay * display) {
+    display->removeFromParentAndCleanup(true);
+    // listeners capture their animators
+    const auto dispatcher { display->getEventDispatcher() };
+    dispatcher->removeAllEventListeners();
+    dispatcher->setEnabled(false);
+    display->setPosition(cocos2d::Vec2::ZERO);
+    display->setScale(1.f);
+    display->setRotation(0.f);
+    display->setVisible(true);
+    display->setOpacity(255);
+    display->setColor(cocos2d::Color3B::WHITE);
+
+    const auto armature { display->getArmature() };
+    armature->getAnimation()->reset();
+    armature->setFlipX(false);
+    armature->setFlipY(false);
+    armature->setClock(nullptr);
+}
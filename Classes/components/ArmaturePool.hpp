@@ -0,0 +1,130 @@
+#ifndef ARMATURE_POOL_HPP
+#define ARMATURE_POOL_HPP
+
+#include "AssetPreloader.hpp"
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstddef>
+
+namespace dragonBones {
+    class CCArmatureDisplay;
+}
+
+/**
+ * Storage of the armatures whose animators are destroyed.
+ * Building an armature walks its data (bones, slots, displays, constraints)
+ * and allocates all of them, so the displays of the same armature are recycled instead:
+ * a unit or a prop removed on death or on restart gives its armature back
+ * and the next one created with the same armature takes it.
+ *
+ * Free armatures are detached from the scene and from the factory's clock,
+ * so they cost nothing but memory. Their pose is restored by the first played
+ * animation (`AnimationConfig::resetToPose`).
+ *
+ * The pool outlives the levels: `Prewarm` drops the armatures which the next level doesn't use.
+ */
+class ArmaturePool final {
+public:
+    static constexpr const char * ARMATURE_NAME { "Armature" };
+
+    ~ArmaturePool() = default;
+
+    ArmaturePool(const ArmaturePool&) = delete;
+    ArmaturePool& operator=(const ArmaturePool&) = delete;
+    ArmaturePool(ArmaturePool&&) = delete;
+    ArmaturePool& operator=(ArmaturePool&&) = delete;
+
+    static ArmaturePool& GetInstance() noexcept {
+        static ArmaturePool pool{};
+        return pool;
+    }
+
+    /**
+     * Build in advance the armatures of the level's units and props,
+     * see `AssetPreloader::Skeleton::instances`, and dispose the free armatures
+     * of the skeletons which the level doesn't use.
+     * The skeletons and the atlases are expected to be loaded.
+     */
+    void Prewarm(const AssetPreloader::Manifest& manifest);
+
+    /**
+     * Take a free armature or build a new one, loading its skeleton and atlas if needed.
+     *
+     * @param prefix directory of the `<name>_ske` and `<name>_tex` files
+     * @param dragonBonesName armature cache name
+     * @return the display which isn't attached to a parent and is advanced by the factory's clock
+     */
+    [[nodiscard]] dragonBones::CCArmatureDisplay* Acquire(const std::string& prefix
+        , const std::string& dragonBonesName
+        , const std::string& armatureName = ARMATURE_NAME
+    );
+
+    /**
+     * Detach the display from its parent, reset it and keep it for the reuse.
+     */
+    void Release(dragonBones::CCArmatureDisplay * display);
+
+    /**
+     * Dispose all free armatures.
+     */
+    void Clear();
+
+    /**
+     * Disable to build and dispose the armatures each time, e.g. to compare both paths.
+     * The free armatures are disposed.
+     */
+    void SetEnabled(bool isEnabled);
+
+    bool IsEnabled() const noexcept {
+        return m_isEnabled;
+    }
+
+    /**
+     * Number of acquisitions served by the recycled armatures
+     */
+    size_t GetHits() const noexcept {
+        return m_hits;
+    }
+
+    /**
+     * Number of acquisitions which needed a new armature
+     */
+    size_t GetMisses() const noexcept {
+        return m_misses;
+    }
+
+    /**
+     * Number of the armatures ready to be acquired
+     */
+    size_t GetFree() const noexcept;
+
+private:
+    ArmaturePool() = default;
+
+    /**
+     * `<dragonBonesName>/<armatureName>`
+     */
+    static std::string MakeKey(const std::string& dragonBonesName, const std::string& armatureName);
+
+    static dragonBones::CCArmatureDisplay* Build(const std::string& prefix
+        , const std::string& dragonBonesName
+        , const std::string& armatureName
+    );
+
+    /**
+     * Restore the state of the freshly built armature which isn't advanced by the clock.
+     */
+    static void Reset(dragonBones::CCArmatureDisplay * display);
+
+    std::unordered_map<std::string, std::vector<dragonBones::CCArmatureDisplay*>> m_free;
+
+    bool m_isEnabled { true };
+
+    size_t m_hits { 0U };
+
+    size_t m_misses { 0U };
+};
+
+#endif // ARMATURE_POOL_HPP
@@ -1,4 +1,5 @@
 #include "CurseHub.hpp"
+#include "units/Unit.hpp"
 #include <cassert>
 
 namespace curses {
@@ -10,20 +11,61 @@ CurseHub::CurseHub(Unit * const unit):
 }
 
 void CurseHub::Update(const float dt) {
-    for (auto& curse: m_curses) {
-        if (curse) {
-            // update cooldown and duration
-            curse->Update(dt);
-            // apply curse damage
-            if (curse->CanEffect()) { 
-                curse->EffectUnit(m_unit);
-            }
-            // remove expired
-            if (curse->IsExpired()) { 
-                curse.reset();
-            }
+    for (size_t i = 0; i < m_size;) {
+        auto& duration { m_duration[i] };
+        auto& cooldown { m_cooldown[i] };
+        // update cooldown and duration
+        if (duration > 0.f || duration == UNLIMITED) {
+            if (duration != UNLIMITED) 
+                duration -= dt;
+            if (cooldown > 0.f)
+                cooldown -= dt;
+        }
+        const bool isExpired { duration != UNLIMITED && duration <= 0.f };
+        // apply curse damage
+        if (cooldown <= 0.f && !isExpired) {
+            cooldown = COOLDOWN;
+            m_unit->RecieveDamage(static_cast<int>(m_damage[i]));
+        }
+        // remove expired, the last curse takes its place
+        if (isExpired) {
+            this->Remove(i);
+        }
+        else {
+            i++;
         }
     }
 }
 
-} // namespace curses
\ No newline at end of file
+void CurseHub::RemoveCurse(size_t id) noexcept {
+    for (size_t i = 0; i < m_size;) {
+        if (m_ids[i] == id) {
+            this->Remove(i);
+        }
+        else {
+            i++;
+        }
+    }
+}
+
+void CurseHub::Add(size_t id, const Params& params) noexcept {
+    if (m_size == MAX_SIZE) {
+        return;
+    }
+    m_ids[m_size] = id;
+    m_damage[m_size] = params.damage;
+    m_duration[m_size] = params.duration;
+    m_cooldown[m_size] = 0.f;
+    m_size++;
+}
+
+void CurseHub::Remove(size_t index) noexcept {
+    assert(index < m_size);
+    m_size--;
+    m_ids[index] = m_ids[m_size];
+    m_damage[index] = m_damage[m_size];
+    m_duration[index] = m_duration[m_size];
+    m_cooldown[index] = m_cooldown[m_size];
+}
+
+} // namespace curses
@@ -2,16 +2,22 @@
 #define CURSE_HUB_HPP
 
 #include "Curses.hpp"
-#include "Utils.hpp"
-#include <memory>
 #include <array>
 #include <limits>
+#include <cstddef>
+#include <utility>
+
+class Unit;
 
 namespace curses {
     /**
      * The curses manager which belongs to unit. 
      * Help to manage curses applied to the unit.
      * 
+     * Curses are stored by value: their fields lie in the parallel arrays
+     * packed at the front, so adding a curse doesn't allocate and
+     * the update is one pass without virtual calls.
+     * 
      * @note
      * Unit can have only one type of curse at one time. 
      * Adding new one of the same type (if it's already exist) will break a logic.
@@ -23,44 +29,53 @@ namespace curses {
          */
         static constexpr size_t ignored { std::numeric_limits<size_t>::max() };
 
-        using CursePointer = std::unique_ptr<Curse>;
-
         CurseHub(Unit * const);
 
         void Update(const float dt);
 
         /**
-         * Linear complexity: perform a search for the first free space 
-         * in the curse holder array
+         * Constant complexity: the curse is appended to the packed ones.
+         * It's dropped when the hub is full.
          */
         template<CurseClass type, class ...Args>
-        void AddCurse(size_t trapId, Args&&... args) {
+        void AddCurse(size_t trapId, Args&&... args) noexcept {
             using identity = typename get_curse<type>::identity;
-            
-            for (auto& curse: m_curses) {
-                if (!curse) {
-                    curse = std::make_unique<identity>(trapId, std::forward<Args>(args)...);
-                    break;
-                }
-            }
+            this->Add(trapId, identity::Make(std::forward<Args>(args)...));
         }
 
-        void RemoveCurse(size_t id) noexcept {
-            for (auto& curse: m_curses) {
-                if (curse && curse->GetId() == id) {
-                    curse.reset();
-                }
-            }
+        void RemoveCurse(size_t id) noexcept;
+
+        [[nodiscard]] size_t GetSize() const noexcept {
+            return m_size;
         }
 
     private:
+        void Add(size_t id, const Params& params) noexcept;
+
+        /**
+         * Move the last curse in place of the removed one.
+         */
+        void Remove(size_t index) noexcept;
+
         static constexpr size_t MAX_SIZE { 16 };
 
+        // time between two damage dealt by the same curse
+        static constexpr float COOLDOWN { 1.f };
+
         Unit * const m_unit { nullptr };
 
-        std::array<CursePointer, MAX_SIZE> m_curses;
+        // number of curses, they occupy [0, m_size) of the arrays
+        size_t m_size { 0 };
+
+        std::array<size_t, MAX_SIZE> m_ids {};
+
+        std::array<float, MAX_SIZE> m_damage {};
+
+        std::array<float, MAX_SIZE> m_duration {};
+
+        std::array<float, MAX_SIZE> m_cooldown {};
     };
 
 }
 
-#endif // CURSE_HUB_HPP
\ No newline at end of file
+#endif // CURSE_HUB_HPP
@@ -1,8 +1,6 @@
 #ifndef CURSES_HPP
 #define CURSES_HPP
 
-class Unit;
-
 namespace curses {
 
     static constexpr float UNLIMITED { -100.f };
@@ -14,69 +12,30 @@ namespace curses {
         COUNT
     };
 
-    class Curse {
-    public:
-        Curse(size_t trapId): 
-            m_trapId { trapId } 
-        {}
-
-        virtual bool CanEffect() const noexcept = 0;
-
-        virtual bool IsExpired() const noexcept = 0;
-
-        virtual void Update(const float dt) noexcept = 0;
-
-        virtual void EffectUnit(Unit * const) noexcept = 0;
-
-        size_t GetId() const noexcept {
-            return m_trapId;
-        }
-
-        bool operator== (const Curse& curse) const noexcept {
-            return curse.m_trapId == m_trapId;
-        }
-
-    private:
-        const size_t m_trapId { 0 };
+    /**
+     * Values the curse is stored with in the CurseHub.
+     */
+    struct Params final {
+        float damage { 0.f };
+        float duration { UNLIMITED };
     };
 
-    class DPS : public Curse {
-    public:
-
-        DPS(size_t id, float damagePerSecond, float duration);
-
-        void Update(const float dt) noexcept override;
-
-        void EffectUnit(Unit * const unit) noexcept override;
-
-        [[nodiscard]] bool CanEffect() const noexcept override {
-            return m_cooldown <= 0.f && !IsExpired();
-        }
-
-        [[nodiscard]] bool IsExpired() const noexcept override {
-            return m_duration != UNLIMITED && m_duration <= 0.f;
+    struct DPS final {
+        static constexpr Params Make(float damagePerSecond, float duration) noexcept {
+            return Params { damagePerSecond, duration };
         }
-
-    protected:
-
-        const float m_damage { 0.f };
-        
-        float m_duration { UNLIMITED };
-        float m_cooldown { UNLIMITED };
     };
-    
-    class Instant final : public DPS {
-    public:
+
+    struct Instant final {
         /**
          * Duration big enough for curse to deal some damage once
          * and expire before coldown turns 0
          */
         static constexpr float DURATION { 0.5f };
 
-        Instant(size_t id, float damage) : 
-            DPS{ id, damage, DURATION }
-        {};
-
+        static constexpr Params Make(float damage) noexcept {
+            return Params { damage, DURATION };
+        }
     };
 
     /**
@@ -98,4 +57,4 @@ namespace curses {
 
 }; // namespace curses 
 
-#endif // CURSES_HPP
\ No newline at end of file
+#endif // CURSES_HPP
@@ -2,8 +2,11 @@
 #include "dragonBones/cocos2dx/CCDragonBonesHeaders.h"
 
 #include "DragonBonesAnimator.hpp"
+#include "ArmaturePool.hpp"
 #include "Utils.hpp"
 
+#include <cassert>
+
 namespace dragonBones {
 
     Animator * Animator::create(std::string&& prefix, std::string&& armatureCacheName) {
@@ -22,30 +25,50 @@ namespace dragonBones {
         if(!cocos2d::Node::init()) {
             return false;
         }
-        this->scheduleUpdate();
-        m_armatureDisplay = BuildArmatureDisplay(); 
+        m_armatureDisplay = ArmaturePool::GetInstance().Acquire(m_prefix, m_armatureName);
+        if(!m_armatureDisplay) {
+            return false;
+        }
         this->addChild(m_armatureDisplay);
+        // the display's own dispatcher delivers only the events it has listeners for
+        m_armatureDisplay->getEventDispatcher()->setEnabled(true);
+        m_armatureDisplay->addDBEventListener(EventObject::COMPLETE, [this](EventObject * event) {
+            // the states replaced by `Play` don't complete the current one
+            if(event->animationState == m_lastAnimationState) {
+                this->OnComplete();
+            }
+        });
         return true;
     }
 
-    void Animator::update(float [[maybe_unused]] dt) {
-        if(m_lastAnimationState && 
-            m_lastAnimationState->isCompleted() &&
-            m_completionHandler
-        ) {
+    void Animator::OnComplete() {
+        if(m_completionHandler) {
             m_completionHandler();
         }
     }
 
+    void Animator::onEnter() {
+        cocos2d::Node::onEnter();
+        m_runningCount++;
+    }
+
+    void Animator::onExit() {
+        m_runningCount--;
+        cocos2d::Node::onExit();
+    }
+
     void Animator::pause() {
         cocos2d::Node::pause();
         if(m_lastAnimationState && m_lastAnimationState->isPlaying()) {
             m_lastAnimationState->stop();
         }
+        // the paused armature isn't advanced by the factory's clock at all
+        m_armatureDisplay->getArmature()->setClock(nullptr);
     }
 
     void Animator::resume() {
         cocos2d::Node::resume();
+        m_armatureDisplay->getArmature()->setClock(CCFactory::getClock());
         if(m_lastAnimationState && !m_lastAnimationState->isPlaying()) {
             m_lastAnimationState->play();
         }
@@ -60,38 +83,68 @@ namespace dragonBones {
     }
 
     float Animator::GetDuration(std::size_t type) const noexcept {
-        const auto& name = m_animations.at(type);
-        const auto& animations = m_armatureDisplay->getAnimation()->getAnimations();
-        const auto data = animations.at(name);
+        const auto data = type < m_animations.size()? m_animations[type]: nullptr;
         return (data? data->duration : 0.f);
     }
 
     void Animator::FlipX() {
+        if (m_isFrameCached) {
+            m_armatureDisplay->setScaleX(-m_armatureDisplay->getScaleX());
+            return;
+        }
         const auto armature = m_armatureDisplay->getArmature();
         armature->setFlipX(!armature->getFlipX());
     }
 
+    void Animator::EnableFrameCache(unsigned frameRate) {
+        if (m_isFrameCached || frameRate == 0U) {
+            return;
+        }
+        const auto armature = m_armatureDisplay->getArmature();
+        armature->setCacheFrameRate(frameRate);
+        m_isFrameCached = true;
+        if (armature->getFlipX()) {
+            armature->setFlipX(false);
+            m_armatureDisplay->setScaleX(-m_armatureDisplay->getScaleX());
+        }
+    }
+
     Animator& Animator::Play(std::size_t id, int times) {
+        assert(id < m_animations.size() && m_animations[id] && "The animation isn't registered");
         m_lastAnimationId = id;
-        m_lastAnimationState = m_armatureDisplay->getAnimation()->play(m_animations.at(id), times);
+        m_lastAnimationState = m_armatureDisplay->getAnimation()->play(m_animations[id], times);
         return *this;
     }
 
     void Animator::EndWith(std::function<void()>&& handler) {
         m_completionHandler = std::move(handler);
+        if(m_completionHandler && m_lastAnimationState && m_lastAnimationState->isCompleted()) {
+            // the event has already been dispatched: complete on the next frame
+            this->scheduleOnce([this](float) {
+                this->OnComplete();
+            }, 0.f, "complete");
+        }
     }
 
     void Animator::InitializeAnimations(std::initializer_list<std::pair<std::size_t, std::string>> animations) {
-        m_animations.reserve(std::size(animations));
-        for(auto&& value: animations) {
-            m_animations.emplace(std::move(value));
+        for(const auto& [id, name]: animations) {
+            this->Register(id, name);
         }
     }
 
     void Animator::AddAnimation(std::pair<std::size_t, std::string> && animation) {
-        m_animations.emplace(std::move(animation));
+        this->Register(animation.first, animation.second);
     }
 
+    void Animator::Register(std::size_t id, const std::string& name) {
+        const auto& data = m_armatureDisplay->getAnimation()->getAnimations();
+        const auto it = data.find(name);
+        assert(it != data.end() && "The armature doesn't have the animation");
+        if(id >= m_animations.size()) {
+            m_animations.resize(id + 1U, nullptr);
+        }
+        m_animations[id] = (it != data.end()? it->second: nullptr);
+    }
 
     Animator::Animator(std::string&& prefix, std::string&& armatureCacheName) noexcept 
         : m_armatureName { std::move(armatureCacheName) }
@@ -99,16 +152,11 @@ namespace dragonBones {
     {
     }
 
-    CCArmatureDisplay* Animator::BuildArmatureDisplay() const {
-        const auto factory = CCFactory::getFactory();
-        std::string path = m_prefix.empty()? "" : m_prefix + "/";
-        if(const auto bonesData = factory->getDragonBonesData(m_armatureName); bonesData == nullptr) {    
-            factory->loadDragonBonesData( path + "/" + m_armatureName + "_ske.json");
-        }
-        if(const auto texture = factory->getTextureAtlasData(m_armatureName); texture == nullptr) {
-            factory->loadTextureAtlasData( path + "/" + m_armatureName + "_tex.json");
+    Animator::~Animator() {
+        // units and props removed on death or on restart give their armatures back
+        if(m_armatureDisplay) {
+            ArmaturePool::GetInstance().Release(m_armatureDisplay);
         }
-        return factory->buildArmatureDisplay("Armature", m_armatureName);
     }
 
 }
\ No newline at end of file
@@ -1,7 +1,7 @@
 #ifndef DRAGON_BONES_ANIMATOR_HPP
 #define DRAGON_BONES_ANIMATOR_HPP
 
-#include <unordered_map>
+#include <vector>
 #include <string>
 #include <initializer_list>
 #include <functional>
@@ -12,10 +12,12 @@
 namespace dragonBones {
     class CCArmatureDisplay;
     class AnimationState;
+    class AnimationData;
 }
 
 /** 
  * - [x] build or get from the cache CCArmatureDisplay object on construction
+ * - [x] give the CCArmatureDisplay back to the `ArmaturePool` on destruction
  * - [x] have cocos2d::Node interface
  * - [x] define a size which will be later used constructing physics body
  * - [x] switch between states: animator.play(State::idle)
@@ -30,9 +32,13 @@ namespace dragonBones {
 
         static Animator * create(std::string&& armatureCacheName, std::string&& prefix);
 
+        ~Animator();
+
         bool init() override;
 
-        void update(float [[maybe_unused]] dt) override;
+        void onEnter() override;
+
+        void onExit() override;
 
         void pause() override;
 
@@ -42,8 +48,17 @@ namespace dragonBones {
 
         Animator& Play(std::size_t state, int times);
 
+        /**
+         * Invoke the handler once the last played animation completes.
+         * Driven by the armature's `EventObject::COMPLETE`, so the animator
+         * doesn't do any work between the completions.
+         */
         void EndWith(std::function<void()>&& handler);
 
+        /**
+         * Register the states. The names are resolved to the armature's animations here,
+         * `Play` and `GetDuration` index them by the state.
+         */
         void InitializeAnimations(std::initializer_list<std::pair<std::size_t, std::string>> animations);
 
         void AddAnimation(std::pair<std::size_t, std::string> && animation);
@@ -54,15 +69,35 @@ namespace dragonBones {
 
         float GetDuration(std::size_t type) const noexcept;
 
+        /**
+         * Bake bone and slot transforms of the armature's animations with the given frame rate.
+         * The baked frames are stored in the shared armature data, so all animators
+         * of the same armature evaluate a frame once and then only look it up.
+         * 
+         * @note once enabled the cache is used by every instance of the armature
+         */
+        void EnableFrameCache(unsigned frameRate);
+
+        /**
+         * Number of the animators in the running scenes
+         */
+        static std::size_t GetRunningCount() noexcept {
+            return m_runningCount;
+        }
+
     private:
 
         Animator(std::string&& armatureCacheName, std::string&& prefix) noexcept;
 
-        CCArmatureDisplay* BuildArmatureDisplay() const;
+        void Register(std::size_t id, const std::string& name);
+
+        void OnComplete();
 
     private:
         static constexpr std::size_t NONE { std::numeric_limits<std::size_t>::max() };
 
+        static inline std::size_t m_runningCount { 0U };
+
         CCArmatureDisplay *m_armatureDisplay { nullptr };
         AnimationState *m_lastAnimationState { nullptr };
         std::size_t m_lastAnimationId { NONE };
@@ -70,7 +105,10 @@ namespace dragonBones {
 
         std::string m_armatureName;
         std::string m_prefix;
-        std::unordered_map<std::size_t, std::string> m_animations {};
+        // indexed by the state, nullptr for the unregistered ones
+        std::vector<AnimationData*> m_animations {};
+        // baked frames ignore the armature's flip, so the display node is mirrored instead
+        bool m_isFrameCached { false };
     };
 }
 
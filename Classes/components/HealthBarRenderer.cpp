@@ -0,0 +1,293 @@
+#include "HealthBarRenderer.hpp"
+
+#include "units/Unit.hpp"
+#include "scenes/LevelScene.hpp"
+
+#include "renderer/backend/Device.h"
+#include "renderer/backend/Program.h"
+#include "renderer/backend/ProgramState.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+
+namespace {
+
+    // origins are packed by two into `u_origins`: its size is BARS_PER_BATCH / 2
+    constexpr const char * VERTEX_SHADER { R"(
+attribute vec2 a_position;
+attribute vec4 a_color;
+attribute float a_slot;
+
+uniform mat4 u_MVPMatrix;
+uniform vec4 u_origins[32];
+
+#ifdef GL_ES
+varying lowp vec4 v_fragmentColor;
+#else
+varying vec4 v_fragmentColor;
+#endif
+
+void main()
+{
+    vec4 origins = u_origins[int(a_slot * 0.5)];
+    vec2 origin = mod(a_slot, 2.0) < 0.5? origins.xy: origins.zw;
+    gl_Position = u_MVPMatrix * vec4(a_position + origin, 0.0, 1.0);
+    v_fragmentColor = a_color;
+}
+)" };
+
+    constexpr const char * FRAGMENT_SHADER { R"(
+#ifdef GL_ES
+precision lowp float;
+#endif
+
+varying vec4 v_fragmentColor;
+uniform float u_alpha;
+
+void main()
+{
+    gl_FragColor = v_fragmentColor * u_alpha;
+}
+)" };
+
+    /**
+     * Write 2 triangles of the rectangle starting from `vertices`.
+     */
+    template<class Vertex>
+    void WriteQuad(Vertex * vertices
+        , const cocos2d::Vec2& leftBottom
+        , const cocos2d::Vec2& rightTop
+        , const cocos2d::Color4B& color
+        , float slot
+    ) noexcept {
+        const cocos2d::Vec2 corners[6] = {
+            leftBottom, { rightTop.x, leftBottom.y }, rightTop,
+            leftBottom, rightTop, { leftBottom.x, rightTop.y }
+        };
+        for (size_t i = 0; i < 6U; i++) {
+            vertices[i] = { corners[i], color, slot };
+        }
+    }
+
+} // namespace {
+
+static_assert(HealthBarRenderer::BARS_PER_BATCH == 64U, "Update the size of `u_origins` in the vertex shader");
+
+HealthBarRenderer* HealthBarRenderer::create() {
+    auto pRet = new (std::nothrow) HealthBarRenderer();
+    if (pRet && pRet->init()) {
+        pRet->autorelease();
+    }
+    else {
+        delete pRet;
+        pRet = nullptr;
+    }
+    return pRet;
+}
+
+HealthBarRenderer::~HealthBarRenderer() {
+    for (auto& batch: m_batches) {
+        CC_SAFE_RELEASE_NULL(batch->command.getPipelineDescriptor().programState);
+    }
+    CC_SAFE_RELEASE_NULL(m_program);
+}
+
+bool HealthBarRenderer::init() {
+    if (!cocos2d::Node::init()) {
+        return false;
+    }
+    this->scheduleUpdate();
+
+    m_program = cocos2d::backend::Device::getInstance()->newProgram(::VERTEX_SHADER, ::FRAGMENT_SHADER);
+    if (!m_program) {
+        return false;
+    }
+    m_mvpLocation = m_program->getUniformLocation("u_MVPMatrix");
+    m_alphaLocation = m_program->getUniformLocation("u_alpha");
+    m_originsLocation = m_program->getUniformLocation("u_origins");
+
+    m_bars.reserve(BARS_PER_BATCH);
+    return true;
+}
+
+bool HealthBarRenderer::AddBatch() {
+    namespace backend = cocos2d::backend;
+
+    auto batch { std::make_unique<Batch>() };
+    auto& command { batch->command };
+    command.setDrawType(cocos2d::CustomCommand::DrawType::ARRAY);
+    command.setPrimitiveType(cocos2d::CustomCommand::PrimitiveType::TRIANGLE);
+    auto& pipeline { command.getPipelineDescriptor() };
+    pipeline.programState = new (std::nothrow) backend::ProgramState(m_program);
+    if (!pipeline.programState) {
+        return false;
+    }
+    pipeline.blendDescriptor.blendEnabled = false;
+
+    const auto layout { pipeline.programState->getVertexLayout() };
+    const auto& attributes { m_program->getActiveAttributes() };
+    if (auto it = attributes.find("a_position"); it != attributes.end()) {
+        layout->setAttribute("a_position", it->second.location, backend::VertexFormat::FLOAT2
+            , offsetof(Vertex, position), false);
+    }
+    if (auto it = attributes.find("a_color"); it != attributes.end()) {
+        layout->setAttribute("a_color", it->second.location, backend::VertexFormat::UBYTE4
+            , offsetof(Vertex, color), true);
+    }
+    if (auto it = attributes.find("a_slot"); it != attributes.end()) {
+        layout->setAttribute("a_slot", it->second.location, backend::VertexFormat::FLOAT
+            , offsetof(Vertex, slot), false);
+    }
+    layout->setLayout(sizeof(Vertex));
+    // the batch's buffer is never recreated: it holds all bars of the batch
+    command.createVertexBuffer(sizeof(Vertex), VERTICES_PER_BATCH, cocos2d::CustomCommand::BufferUsage::DYNAMIC);
+    this->MarkDirty(*batch, 0U, VERTICES_PER_BATCH);
+    m_batches.push_back(std::move(batch));
+    return true;
+}
+
+uint32_t HealthBarRenderer::Add(const Unit * unit, int maxHealth) {
+    assert(unit);
+    uint32_t index { 0U };
+    if (!m_free.empty()) {
+        index = m_free.back();
+        m_free.pop_back();
+    }
+    else {
+        index = static_cast<uint32_t>(m_bars.size());
+        if (index / BARS_PER_BATCH >= m_batches.size() && !this->AddBatch()) {
+            return INVALID_BAR;
+        }
+        m_bars.emplace_back();
+    }
+    auto& bar { m_bars[index] };
+    bar.unit = unit;
+    bar.maxHealth = std::max(maxHealth, 1);
+    bar.isDirty = true;
+    return index;
+}
+
+void HealthBarRenderer::Remove(uint32_t index) noexcept {
+    if (index >= m_bars.size() || !m_bars[index].unit) {
+        return;
+    }
+    m_bars[index] = Bar{};
+    m_free.push_back(index);
+    // collapse to degenerate triangles
+    auto& batch { *m_batches[index / BARS_PER_BATCH] };
+    const auto first { (index % BARS_PER_BATCH) * VERTICES_PER_BAR };
+    std::fill_n(batch.vertices.begin() + first, VERTICES_PER_BAR, Vertex{});
+    this->MarkDirty(batch, first, VERTICES_PER_BAR);
+}
+
+void HealthBarRenderer::Invalidate(uint32_t index) noexcept {
+    if (index < m_bars.size()) {
+        m_bars[index].isDirty = true;
+    }
+}
+
+void HealthBarRenderer::update(float dt) {
+    cocos2d::Node::update(dt);
+    for (uint32_t index = 0U; index < m_bars.size(); index++) {
+        auto& bar { m_bars[index] };
+        if (!bar.unit) continue;
+
+        const auto size { bar.unit->getContentSize() };
+        // units have bottom-middle anchor
+        const auto origin { bar.unit->getPosition() + cocos2d::Vec2{ -size.width / 2.f, size.height + SHIFT } };
+        const auto slot { index % BARS_PER_BATCH };
+        auto& origins { m_batches[index / BARS_PER_BATCH]->origins[slot / 2U] };
+        if (slot % 2U == 0U) {
+            origins.x = origin.x;
+            origins.y = origin.y;
+        }
+        else {
+            origins.z = origin.x;
+            origins.w = origin.y;
+        }
+        if (bar.isDirty || bar.width != size.width) {
+            bar.width = size.width;
+            bar.isDirty = false;
+            this->WriteVertices(index);
+        }
+    }
+
+    const auto stride { sizeof(Vertex) };
+    for (size_t i = 0; i < m_batches.size(); i++) {
+        auto& batch { *m_batches[i] };
+        const auto bars { std::min(BARS_PER_BATCH, m_bars.size() - std::min(m_bars.size(), i * BARS_PER_BATCH)) };
+        batch.command.setVertexDrawInfo(0U, bars * VERTICES_PER_BAR);
+        if (batch.dirtyBegin >= batch.dirtyEnd) continue;
+
+        batch.command.updateVertexBuffer(batch.vertices.data() + batch.dirtyBegin
+            , static_cast<unsigned int>(batch.dirtyBegin * stride)
+            , static_cast<unsigned int>((batch.dirtyEnd - batch.dirtyBegin) * stride)
+        );
+        batch.dirtyBegin = batch.dirtyEnd = 0U;
+    }
+}
+
+void HealthBarRenderer::draw(cocos2d::Renderer *renderer, const cocos2d::Mat4& transform, uint32_t flags) {
+    if (m_bars.empty()) {
+        return;
+    }
+    const auto& projection { _director->getMatrix(cocos2d::MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION) };
+    const cocos2d::Mat4 mvp { projection * transform };
+    const float alpha { _displayedOpacity / 255.f };
+    for (auto& batch: m_batches) {
+        const auto programState { batch->command.getPipelineDescriptor().programState };
+        programState->setUniform(m_mvpLocation, mvp.m, sizeof(mvp.m));
+        programState->setUniform(m_alphaLocation, &alpha, sizeof(alpha));
+        programState->setUniform(m_originsLocation, batch->origins.data(), sizeof(batch->origins));
+
+        batch->command.init(_globalZOrder, transform, flags);
+        renderer->addCommand(&batch->command);
+    }
+}
+
+void HealthBarRenderer::WriteVertices(uint32_t index) noexcept {
+    const auto& bar { m_bars[index] };
+    const auto health { std::clamp(bar.unit->GetHealth(), 0, bar.maxHealth) };
+    const auto healthWidth { health * bar.width / bar.maxHealth };
+    // the border is as thick as the former 2px outline
+    static constexpr float BORDER { 1.f };
+
+    auto& batch { *m_batches[index / BARS_PER_BATCH] };
+    const auto slot { index % BARS_PER_BATCH };
+    const auto first { slot * VERTICES_PER_BAR };
+    const auto vertices { batch.vertices.data() + first };
+    ::WriteQuad(vertices
+        , cocos2d::Vec2{ -BORDER, -BORDER }
+        , cocos2d::Vec2{ bar.width + BORDER, HEIGHT + BORDER }
+        , cocos2d::Color4B::BLACK
+        , static_cast<float>(slot)
+    );
+    ::WriteQuad(vertices + 6U
+        , cocos2d::Vec2::ZERO
+        , cocos2d::Vec2{ healthWidth, HEIGHT }
+        , cocos2d::Color4B::RED
+        , static_cast<float>(slot)
+    );
+    this->MarkDirty(batch, first, VERTICES_PER_BAR);
+}
+
+void HealthBarRenderer::MarkDirty(Batch& batch, size_t firstVertex, size_t count) noexcept {
+    if (batch.dirtyBegin >= batch.dirtyEnd) {
+        batch.dirtyBegin = firstVertex;
+        batch.dirtyEnd = firstVertex + count;
+    }
+    else {
+        batch.dirtyBegin = std::min(batch.dirtyBegin, firstVertex);
+        batch.dirtyEnd = std::max(batch.dirtyEnd, firstVertex + count);
+    }
+}
+
+HealthBarRenderer* HealthBarRenderer::Find(const cocos2d::Node * node) noexcept {
+    for (auto parent = node; parent; parent = parent->getParent()) {
+        if (const auto level = dynamic_cast<const LevelScene*>(parent); level) {
+            return level->GetHealthBars();
+        }
+    }
+    return nullptr;
+}
@@ -0,0 +1,124 @@
+#ifndef HEALTH_BAR_RENDERER_HPP
+#define HEALTH_BAR_RENDERER_HPP
+
+#include "cocos2d.h"
+#include "renderer/CCCustomCommand.h"
+
+#include <array>
+#include <memory>
+#include <vector>
+#include <cstdint>
+
+class Unit;
+
+/**
+ * Health bars of all units of the level.
+ *
+ * Bars are drawn in batches of BARS_PER_BATCH, one draw call per batch.
+ * Vertices of the bar are relative to its origin and rewritten only when
+ * the unit's health changed (see `Invalidate`). Origins are passed to the shader
+ * as a uniform array each frame, so moving units don't touch the vertex buffers.
+ *
+ * The renderer must share the parent with the units (the tile map)
+ * so their positions are in the same space.
+ */
+class HealthBarRenderer final : public cocos2d::Node {
+public:
+    static constexpr uint32_t INVALID_BAR { UINT32_MAX };
+
+    static constexpr float HEIGHT { 10.f };
+
+    // distance between the unit's head and the bar
+    static constexpr float SHIFT { 5.f };
+
+    // draw bars above units and projectiles
+    static constexpr int Z_ORDER { 200 };
+
+    // origins of the batch fit the minimal number of uniform vectors of GLES 2.0 vertex shader (128)
+    static constexpr size_t BARS_PER_BATCH { 64U };
+
+    static HealthBarRenderer* create();
+
+    ~HealthBarRenderer();
+
+    [[nodiscard]] bool init() override;
+
+    void update(float dt) override;
+
+    void draw(cocos2d::Renderer *renderer, const cocos2d::Mat4& transform, uint32_t flags) override;
+
+    /**
+     * Start drawing the unit's health bar.
+     * The bar is as wide as the unit and full when the health is `maxHealth`.
+     *
+     * @return bar's id used to update or remove the bar
+     */
+    uint32_t Add(const Unit * unit, int maxHealth);
+
+    void Remove(uint32_t bar) noexcept;
+
+    /**
+     * Mark the bar's health as changed: the bar is updated on the next frame.
+     */
+    void Invalidate(uint32_t bar) noexcept;
+
+    /**
+     * Find the renderer of the level the node belongs to.
+     */
+    static HealthBarRenderer* Find(const cocos2d::Node * node) noexcept;
+
+private:
+    HealthBarRenderer() = default;
+
+    // black border and red health
+    static constexpr size_t QUADS_PER_BAR { 2U };
+    static constexpr size_t VERTICES_PER_BAR { QUADS_PER_BAR * 6U };
+    static constexpr size_t VERTICES_PER_BATCH { BARS_PER_BATCH * VERTICES_PER_BAR };
+
+    struct Vertex final {
+        // relative to the bar's origin
+        cocos2d::Vec2 position {};
+        cocos2d::Color4B color {};
+        // index of the bar's origin in the batch
+        float slot { 0.f };
+    };
+
+    struct Bar final {
+        const Unit * unit { nullptr };
+        float width { 0.f };
+        int maxHealth { 0 };
+        bool isDirty { false };
+    };
+
+    struct Batch final {
+        cocos2d::CustomCommand command;
+        // two origins per vector
+        std::array<cocos2d::Vec4, BARS_PER_BATCH / 2U> origins {};
+        std::array<Vertex, VERTICES_PER_BATCH> vertices {};
+        // range of vertices changed since the last upload
+        size_t dirtyBegin { 0U };
+        size_t dirtyEnd { 0U };
+    };
+
+    [[nodiscard]] bool AddBatch();
+
+    void WriteVertices(uint32_t index) noexcept;
+
+    void MarkDirty(Batch& batch, size_t firstVertex, size_t count) noexcept;
+
+    std::vector<Bar> m_bars;
+
+    std::vector<uint32_t> m_free;
+
+    std::vector<std::unique_ptr<Batch>> m_batches;
+
+    cocos2d::backend::Program * m_program { nullptr };
+
+    cocos2d::backend::UniformLocation m_mvpLocation;
+
+    cocos2d::backend::UniformLocation m_alphaLocation;
+
+    cocos2d::backend::UniformLocation m_originsLocation;
+};
+
+#endif // HEALTH_BAR_RENDERER_HPP
@@ -1,8 +1,11 @@
 #include "Influence.hpp"
 #include "Core.hpp"
+#include "FrameSampler.hpp"
+#include "Profiler.hpp"
 
 #include "units/Bot.hpp"
 #include "units/Player.hpp"
+#include "EntityRegistry.hpp"
 
 Influence* Influence::create(
     Enemies::Bot* bot, 
@@ -47,15 +50,12 @@ void Influence::OnLeave() {
 }
 
 void Influence::update(float dt) {
+    const bench::ScopedSample sample { bench::Subsystem::INFLUENCES };
+    PROFILE_ZONE("Influence::update");
     if( m_bot && !m_bot->IsDead() ) {
-        const auto target = m_bot->getParent()->getChildByName(core::EntityNames::PLAYER);
-        if( target ) { // exist, is alive and kicking
-            const auto targetSize { target->getContentSize() };
-            const cocos2d::Rect boundingBox { 
-                target->getPosition() - cocos2d::Vec2{ targetSize.width / 2.f, 0.f }, // left-bottom corner
-                targetSize
-            };
-            const auto isInside { m_zone.intersectsRect(boundingBox) };
+        const auto registry = m_bot->GetRegistry();
+        if( registry && registry->GetPlayer() ) { // exist, is alive and kicking
+            const auto isInside { registry->FindPlayer(m_zone) != nullptr };
             if( !m_detected && isInside) {
                 this->OnIntrusion();
             } 
@@ -20,6 +20,10 @@ public:
 
     bool ContainsX(float x) const noexcept;
 
+    const cocos2d::Rect& GetZone() const noexcept {
+        return m_zone;
+    }
+
 private:
 
     Influence(
@@ -37,9 +37,8 @@ public:
     ~Movement();
 
     /**
-     * TODO: add delta time to prevent different movement speed for differenrt FPS
-     * 
-     * Each frame applies forces or impulses which are scheduled by Push/Move
+     * Each simulation tick applies forces or impulses which are scheduled by Push/Move.
+     * The tick has a fixed duration, so the movement doesn't depend on FPS.
      */
     void Update() noexcept;
     
@@ -21,9 +21,10 @@ namespace {
     }
 } // namespace 
 
-Navigator::Navigator(Enemies::Bot * owner, Path&& path) :
+Navigator::Navigator(Enemies::Bot * owner, Path&& path, NavigationGraph * graph) :
     m_owner { owner },
-    m_path { std::move(path) }
+    m_path { std::move(path) },
+    m_graph { graph }
 {
     m_choosenWaypointIndex = this->FindClosestPathPoint(m_owner->getPosition());
     assert(m_choosenWaypointIndex != failure && "The path doesn't exist!");
@@ -38,7 +39,12 @@ void Navigator::Update(float dt) {
         }
         target = m_path.m_waypoints[m_choosenWaypointIndex];
     }
-    MoveTo(target);
+    if (m_graph) {
+        Walk(target);
+    }
+    else {
+        MoveTo(target);
+    }
 }
 
 void Navigator::VisitCustomPoint(const cocos2d::Vec2& destination) {
@@ -75,6 +81,77 @@ void Navigator::MoveTo(const cocos2d::Vec2& destination) {
     }
 }
 
+void Navigator::Walk(const cocos2d::Vec2& destination) {
+    if (!m_owner || m_owner->IsDead()) {
+        return;
+    }
+    const auto position { m_owner->getPosition() };
+    const bool isOnGround { m_owner->IsOnGround() };
+    // finish the jump or the drop before choosing the next step
+    if (m_isTraversing) {
+        m_hasLeftGround = m_hasLeftGround || !isOnGround;
+        if (!m_hasLeftGround || !isOnGround) {
+            MoveAlongX(m_link.landing.x);
+            return;
+        }
+        m_isTraversing = false;
+    }
+
+    const auto from { m_graph->FindNode(position) };
+    if (from == NavigationGraph::INVALID_NODE) {
+        // falling: keep moving towards the destination
+        MoveAlongX(destination.x);
+        return;
+    }
+    const auto to { m_graph->FindNode(destination) };
+    const auto next { to != NavigationGraph::INVALID_NODE? m_graph->FindNextLink(from, to): nullptr };
+    if (!next) {
+        // the destination is on this surface or unreachable: don't walk off the ledge
+        MoveAlongX(m_graph->Clamp(from, destination.x));
+        return;
+    }
+
+    const auto& link { *next };
+    if (fabs(link.takeoff.x - position.x) > m_checkPrecision) {
+        MoveAlongX(link.takeoff.x);
+        return;
+    }
+    if (link.kind == NavigationGraph::LinkKind::JUMP) {
+        if (!isOnGround) {
+            // wait for landing to jump
+            return;
+        }
+        m_owner->MoveAlong(Movement::Direction::UP);
+    }
+    m_link = link;
+    m_isTraversing = true;
+    m_hasLeftGround = false;
+    MoveAlongX(m_link.landing.x);
+}
+
+void Navigator::MoveAlongX(float x) {
+    const auto dx { x - m_owner->getPositionX() };
+    if (fabs(dx) <= m_checkPrecision) {
+        m_owner->Stop(Movement::Axis::X);
+    }
+    else {
+        m_owner->LookAt({ x, m_owner->getPositionY() });
+        m_owner->MoveAlong(GetHorizontalDirection(dx));
+    }
+}
+
+bool Navigator::IsReachable(const cocos2d::Vec2& point) const {
+    if (!m_graph) {
+        return true;
+    }
+    const auto from { m_graph->FindNode(m_owner->getPosition()) };
+    const auto to { m_graph->FindNode(point) };
+    if (from == NavigationGraph::INVALID_NODE || to == NavigationGraph::INVALID_NODE) {
+        return false;
+    }
+    return m_graph->IsReachable(from, to);
+}
+
 size_t Navigator::FindDestination(size_t from) {
     // TODO: add some clever decision making algorithm.
     // but for now any path consist onlyu from 2 points so it doesn't matter
@@ -84,7 +161,10 @@ size_t Navigator::FindDestination(size_t from) {
 std::pair<bool, bool> Navigator::ReachedDestination() const noexcept {
     cocos2d::Vec2 destination = m_isFollowingPath? m_path.m_waypoints[m_choosenWaypointIndex]: m_customTarget;
     const auto reachedX = fabs(destination.x - m_owner->getPosition().x) <= m_checkPrecision;
-    const auto reachedY = fabs(destination.y - m_owner->getPosition().y) <= m_checkPrecision;
+    // walkers reach the height of the destination by standing on its surface
+    const auto reachedY = m_graph? 
+        m_graph->FindNode(m_owner->getPosition()) == m_graph->FindNode(destination)
+        : fabs(destination.y - m_owner->getPosition().y) <= m_checkPrecision;
     return { reachedX, reachedY };
 }
 
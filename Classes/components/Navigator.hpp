@@ -5,6 +5,7 @@
 
 #include "cocos2d.h"
 #include "Path.hpp"
+#include "NavigationGraph.hpp"
 
 namespace Enemies {
     class Bot;
@@ -13,7 +14,13 @@ namespace Enemies {
 class Navigator {
 public:
 
-    Navigator(Enemies::Bot * owner, Path&& path);
+    /**
+     * @param graph walkable surfaces of the level. When it's provided the owner
+     * walks along the surfaces, jumps and drops by the graph's routes and never
+     * walks off a ledge otherwise. Without it the owner moves straight to the target
+     * along both axes (flying units, spiders).
+     */
+    Navigator(Enemies::Bot * owner, Path&& path, NavigationGraph * graph = nullptr);
 
     void Update(float dt);
 
@@ -23,11 +30,24 @@ public:
 
     void SetPrecision(float precision) noexcept;
 
+    /**
+     * @return whether the owner can walk to the point by the graph
+     * @note safe from the planner's worker threads
+     */
+    [[nodiscard]] bool IsReachable(const cocos2d::Vec2& point) const;
+
     /// helper methods
 private:
    
     void MoveTo(const cocos2d::Vec2& destination);
 
+    /**
+     * Take the next step of the graph's route to the destination.
+     */
+    void Walk(const cocos2d::Vec2& destination);
+
+    void MoveAlongX(float x);
+
     size_t FindClosestPathPoint(const cocos2d::Vec2& p) const;
 
     // get your destination if possible
@@ -41,12 +61,18 @@ private:
     Enemies::Bot * const    m_owner { nullptr };
     cocos2d::Vec2           m_customTarget {0.f, 0.f};
     const Path              m_path;
+    NavigationGraph * const m_graph { nullptr };
 
     /// internal data
     size_t                  m_choosenWaypointIndex { 0 };
     bool                    m_isFollowingPath { true };
     float                   m_checkPrecision { 4.f };
 
+    /// jump or drop in progress
+    NavigationGraph::Link   m_link {};
+    bool                    m_isTraversing { false };
+    bool                    m_hasLeftGround { false };
+
     static constexpr size_t failure { std::numeric_limits<size_t>::max() };
 };
 
@@ -1,4 +1,5 @@
 #include "ParallaxBackground.hpp"
+#include "AssetPaths.hpp"
 
 #include <array>
 #include <cmath>
@@ -36,11 +37,11 @@ bool Background::init() {
     };
 
     const std::array<ParallaxLayer, 5U> layers = {
-          ParallaxLayer{ 1.f, "Map/back/sky.png",   0, {0.f, 0.f},      {0.f, 300.f} }
-        , ParallaxLayer{ 1.f, "Map/back/sky-0.png", 1, {0.1f, 0.15f},   {0.f, 610.f} }  // clouds
-        , ParallaxLayer{ 1.f, "Map/back/2.png",     2, {0.4f, 0.1f},    {0.f, -100.f} } // mountains
-        , ParallaxLayer{ 1.f, "Map/back/sky-1.png", 3, {0.25f, 0.1f},   {0.f, 590.f} }  // cloud
-        , ParallaxLayer{ 1.f, "Map/back/1.png",     4, {0.3f, 0.2f},    {0.f, -100.f} } // trees
+          ParallaxLayer{ 1.f, assets::BACKGROUND_LAYERS[0], 0, {0.f, 0.f},      {0.f, 300.f} }
+        , ParallaxLayer{ 1.f, assets::BACKGROUND_LAYERS[1], 1, {0.1f, 0.15f},   {0.f, 610.f} }  // clouds
+        , ParallaxLayer{ 1.f, assets::BACKGROUND_LAYERS[2], 2, {0.4f, 0.1f},    {0.f, -100.f} } // mountains
+        , ParallaxLayer{ 1.f, assets::BACKGROUND_LAYERS[3], 3, {0.25f, 0.1f},   {0.f, 590.f} }  // cloud
+        , ParallaxLayer{ 1.f, assets::BACKGROUND_LAYERS[4], 4, {0.3f, 0.2f},    {0.f, -100.f} } // trees
     };
 
     for(auto& layer: layers) {
@@ -2,7 +2,11 @@
 
 #include "Utils.hpp"
 #include "Core.hpp"
+#include "FrameSampler.hpp"
 #include "DragonBonesAnimator.hpp"
+#include "ProjectilePool.hpp"
+#include "ActivationRegion.hpp"
+#include "SimulationClock.hpp"
 
 Projectile * Projectile::create(float damage) {
     auto pRet = new (std::nothrow) Projectile(damage);
@@ -20,12 +24,12 @@ bool Projectile::init() {
     if (!cocos2d::Node::init() ) {
         return false;
     }
-    this->scheduleUpdate();
-
+    // updated by the level's simulation clock on each tick
     return true;
 };
 
 void Projectile::update(float dt) {
+    const bench::ScopedSample sample { bench::Subsystem::PROJECTILES };
     cocos2d::Node::update(dt);
     this->UpdateLifetime(dt);
     this->UpdateState(dt);
@@ -35,11 +39,40 @@ void Projectile::update(float dt) {
     this->UpdatePhysicsBody();
 }
 
+void Projectile::onEnter() {
+    cocos2d::Node::onEnter();
+    m_activation = ActivationRegion::Find(this);
+    if (m_activation) {
+        m_activationId = m_activation->Add(this, ActivationRegion::Kind::PROJECTILE);
+    }
+    m_clock = SimulationClock::Find(this);
+    if (m_clock) {
+        m_clockId = m_clock->Add(this);
+    }
+}
+
+void Projectile::onExit() {
+    if (m_activation) {
+        m_activation->Remove(m_activationId);
+        m_activation = nullptr;
+        m_activationId = ActivationRegion::INVALID_ENTITY;
+    }
+    if (m_clock) {
+        m_clock->Remove(m_clockId);
+        m_clock = nullptr;
+        m_clockId = SimulationClock::INVALID_ENTITY;
+    }
+    cocos2d::Node::onExit();
+}
+
 void Projectile::pause() {
     cocos2d::Node::pause();
     if (m_animator) {
         m_animator->pause();
     }
+    if (m_clock) {
+        m_clock->SetActive(m_clockId, false);
+    }
 }
     
 void Projectile::resume() {
@@ -47,13 +80,19 @@ void Projectile::resume() {
     if (m_animator) {
         m_animator->resume();
     }
+    if (m_clock) {
+        m_clock->SetActive(m_clockId, true);
+    }
 }
 
 void Projectile::UpdatePhysicsBody() noexcept {
     if (m_currentState != m_previousState 
         && (m_currentState == State::HIT_PLAYER || m_currentState == State::HIT_GROUND)
     ) {
-        this->removeComponent(this->getPhysicsBody());
+        // keep the body for recycling but remove it from the world
+        if (const auto body = this->getPhysicsBody(); body) {
+            body->setEnabled(false);
+        }
     }
 }
 
@@ -69,7 +108,7 @@ void Projectile::UpdateState(const float dt) noexcept {
     if (m_lifeTime <= 0.f) {
         m_currentState = m_explosionAnimation;
         if (!m_animator) {
-            this->runAction(cocos2d::RemoveSelf::create(true));
+            this->Dispose();
         }
     }
     else {
@@ -77,7 +116,41 @@ void Projectile::UpdateState(const float dt) noexcept {
     }
 }
 
+void Projectile::Reset(float damage) {
+    m_damage = damage;
+    m_lifeTime = DEFAULT_LIFETIME;
+    m_previousState = State::UNDEFINED;
+    m_currentState = State::UNDEFINED;
+    m_explosionAnimation = State::HIT_PLAYER;
+    m_isDisposed = false;
+    if (m_isFlipped) {
+        this->FlipX();
+    }
+    if (m_animator) {
+        m_animator->EndWith({});
+    }
+}
+
+void Projectile::Dispose() {
+    // the removal is deferred, so it may be requested again meanwhile
+    if (m_isDisposed) {
+        return;
+    }
+    m_isDisposed = true;
+    if (m_pool) {
+        // removal is deferred to the next frame like RemoveSelf does
+        const auto pool { m_pool };
+        this->runAction(cocos2d::CallFunc::create([this, pool]() {
+            pool->Release(this);
+        }));
+    }
+    else {
+        this->runAction(cocos2d::RemoveSelf::create(true));
+    }
+}
+
 void Projectile::FlipX() noexcept {
+    m_isFlipped = !m_isFlipped;
     if (m_animator) {
         m_animator->FlipX();
     }
@@ -93,7 +166,7 @@ void Projectile::UpdateAnimation() {
         (void) m_animator->Play(Utils::EnumCast(m_currentState), repeatTimes);
         if(!this->IsAlive()) {
             m_animator->EndWith([this]() { 
-                this->runAction(cocos2d::RemoveSelf::create(true));
+                this->Dispose();
             });
         }
     }
@@ -111,7 +184,7 @@ void Projectile::AddAnimator(std::string chachedArmatureName, std::string prefix
 }
 
 Projectile::Projectile(float damage) :
-    m_lifeTime { 0.15f },
+    m_lifeTime { DEFAULT_LIFETIME },
     m_damage { damage }
 {   
 }
@@ -9,6 +9,9 @@
 namespace dragonBones {
     class Animator;
 }
+class ProjectilePool;
+class ActivationRegion;
+class SimulationClock;
 
 class Projectile : public cocos2d::Node {
 public:
@@ -20,6 +23,8 @@ public:
         COUNT
     };
     
+    static constexpr float DEFAULT_LIFETIME { 0.15f };
+
     static Projectile * create(float damage);
 
     [[nodiscard]] bool init() override;
@@ -30,6 +35,10 @@ public:
      */
     void update(float dt) override;
 
+    void onEnter() override;
+
+    void onExit() override;
+
     void pause() override;
     
     void resume() override;
@@ -45,6 +54,14 @@ public:
         m_explosionAnimation = state;
     }
 
+    /**
+     * Remove the projectile at once, without explosion,
+     * e.g. when it flew too far from the camera.
+     */
+    void Retire() noexcept {
+        this->Dispose();
+    }
+
     /**
      * This function tells whether this prjectile still exist or not.
      * @return 
@@ -102,9 +119,22 @@ public:
     void InitializeAnimations(std::initializer_list<std::pair<std::size_t, std::string>> animations);
 
 private:
-    
+    friend class ProjectilePool;
+
     Projectile(float damage);
 
+    /**
+     * Restore the initial state of the recycled projectile:
+     * lifetime, state, orientation and animation.
+     */
+    void Reset(float damage);
+
+    /**
+     * End of the projectile's life: return it to the pool
+     * it was taken from or remove it.
+     */
+    void Dispose();
+
     void OnExplosion();
 
     void UpdateLifetime(const float dt) noexcept;
@@ -126,7 +156,7 @@ private:
      */
     float m_lifeTime { 0.f };
 
-    const float m_damage { 0 };
+    float m_damage { 0 };
 
     State m_previousState { State::UNDEFINED };
     
@@ -138,6 +168,29 @@ private:
 
     cocos2d::Sprite * m_image { nullptr };
 
+    // pool which owns the projectile, nullptr if it isn't pooled
+    ProjectilePool * m_pool { nullptr };
+
+    // ProjectilePool::Archetype of the pooled projectile
+    std::uint8_t m_archetype { 0U };
+
+    // size the physics body was created with
+    cocos2d::Size m_bodySize {};
+
+    bool m_isFlipped { false };
+
+    bool m_isDisposed { false };
+
+    // level's activation region, available while the projectile is running
+    ActivationRegion * m_activation { nullptr };
+
+    uint32_t m_activationId { UINT32_MAX };
+
+    // level's simulation clock, available while the projectile is running
+    SimulationClock * m_clock { nullptr };
+
+    uint32_t m_clockId { UINT32_MAX };
+
     // cocos2d::Size m_contentSize { 60.f, 135.f };
 };
 #endif // PROJECTILE_HPP
\ No newline at end of file
@@ -0,0 +1,206 @@
+#include "ProjectilePool.hpp"
+#include "DragonBonesAnimator.hpp"
+
+#include <array>
+#include <cassert>
+#include <vector>
+
+namespace {
+
+    using Archetype = ProjectilePool::Archetype;
+    using State = Projectile::State;
+
+    constexpr std::array<ProjectilePool::Visual, Utils::EnumSize<Archetype>()> VISUALS {
+          ProjectilePool::Visual{}   // MELEE
+        , ProjectilePool::Visual{ "archer/library/arrow.png", nullptr, nullptr, 0.2f }
+        , ProjectilePool::Visual{ "cannon/library/Asset 4.png", nullptr, nullptr, 0.2f }
+        , ProjectilePool::Visual{ "old_man/library/stone.png", nullptr, nullptr, 0.15f }
+        , ProjectilePool::Visual{ nullptr, "mc/mc_fireball", "mc_fireball", 0.2f }
+        , ProjectilePool::Visual{ nullptr, "mc/mc_special", "mc_special", 0.17f }
+        , ProjectilePool::Visual{ nullptr, "boss/boss_fireball", "fireball", 0.15f }
+        , ProjectilePool::Visual{ nullptr, "boss/boss_attack", "fire", 0.2f }
+        , ProjectilePool::Visual{ nullptr, "slime_attack", "slime_attack", 0.2f }
+    };
+
+    /**
+     * Map the animations to the projectile's states
+     */
+    void InitializeAnimations(Projectile * projectile, Archetype archetype) {
+        // sorry the illustrator is a little bit of an idiot: animation names don't match states
+        switch (archetype) {
+            case Archetype::PLAYER_FIREBALL:
+            case Archetype::BOSS_FIREBALL: {
+                projectile->InitializeAnimations({
+                    std::make_pair(Utils::EnumCast(State::IDLE), "walk"),
+                    std::make_pair(Utils::EnumCast(State::HIT_PLAYER), "attack_1"),
+                    std::make_pair(Utils::EnumCast(State::HIT_GROUND), "attack_2")
+                });
+            } break;
+            case Archetype::PLAYER_SPECIAL:
+            case Archetype::SLIME_SHOT: {
+                projectile->InitializeAnimations({
+                    std::make_pair(Utils::EnumCast(State::IDLE), "walk"),
+                    std::make_pair(Utils::EnumCast(State::HIT_PLAYER), "attack"),
+                    std::make_pair(Utils::EnumCast(State::HIT_GROUND), "attack")
+                });
+            } break;
+            case Archetype::CLOUD_FIREBALL: {
+                projectile->InitializeAnimations({
+                    std::make_pair(Utils::EnumCast(State::IDLE), "walk"),
+                    std::make_pair(Utils::EnumCast(State::HIT_PLAYER), "attack_2"),
+                    std::make_pair(Utils::EnumCast(State::HIT_GROUND), "attack_1")
+                });
+            } break;
+            default: assert(false && "Unreachable"); break;
+        }
+    }
+
+    /**
+     * Create visuals of the projectile once: they are kept on recycling.
+     */
+    void AddVisuals(Projectile * projectile, Archetype archetype) {
+        const auto& visual { ProjectilePool::GetVisual(archetype) };
+        if (visual.image) {
+            const auto sprite = projectile->AddImage(visual.image);
+            sprite->setAnchorPoint({0.0f, 0.0f});
+            sprite->setScale(visual.scale);
+        }
+        else if (visual.prefix) {
+            projectile->AddAnimator(visual.name, visual.prefix);
+            ::InitializeAnimations(projectile, archetype);
+            projectile->setScale(visual.scale);
+        }
+    }
+
+    /**
+     * Restore the defaults of the new physics body
+     */
+    void ResetBody(cocos2d::PhysicsBody * body) {
+        body->setEnabled(true);
+        body->resetForces();
+        body->setVelocity(cocos2d::Vec2::ZERO);
+        body->setAngularVelocity(0.f);
+        body->setCategoryBitmask(UINT_MAX);
+        body->setCollisionBitmask(UINT_MAX);
+        body->setContactTestBitmask(0);
+    }
+
+} // namespace {
+
+const ProjectilePool::Visual& ProjectilePool::GetVisual(Archetype archetype) noexcept {
+    assert(archetype < Archetype::COUNT);
+    return VISUALS[Utils::EnumCast(archetype)];
+}
+
+void ProjectilePool::Prewarm(Archetype archetype, size_t count) {
+    auto& free { m_free[Utils::EnumCast(archetype)] };
+    free.reserve(count);
+    while (free.size() < count) {
+        free.pushBack(this->Create(archetype));
+    }
+}
+
+Projectile* ProjectilePool::Acquire(Archetype archetype, float damage, const cocos2d::Size& bodySize) {
+    auto& free { m_free[Utils::EnumCast(archetype)] };
+    Projectile * projectile { nullptr };
+    if (free.empty()) {
+        m_misses++;
+        projectile = this->Create(archetype);
+    }
+    else {
+        m_hits++;
+        projectile = free.back();
+        // keep it alive until it is added to the map
+        projectile->retain();
+        projectile->autorelease();
+        free.popBack();
+    }
+    m_live++;
+    projectile->Reset(damage);
+    projectile->setRotation(0.f);
+
+    auto body { projectile->getPhysicsBody() };
+    if (body && projectile->m_bodySize.equals(bodySize)) {
+        ::ResetBody(body);
+    }
+    else {
+        if (body) {
+            projectile->removeComponent(body);
+        }
+        body = CreateBody(archetype, bodySize);
+        projectile->addComponent(body);
+        projectile->m_bodySize = bodySize;
+    }
+    return projectile;
+}
+
+void ProjectilePool::Release(Projectile * projectile) {
+    assert(projectile && projectile->m_pool == this);
+    assert(m_live > 0U);
+    m_live--;
+    m_free[projectile->m_archetype].pushBack(projectile);
+    // don't cleanup: the projectile leaves the level's clock while it's detached
+    // and is tracked again when it's added back
+    projectile->removeFromParentAndCleanup(false);
+}
+
+void ProjectilePool::ReleaseChildren(cocos2d::Node * parent) {
+    // releasing removes the child, so collect them first
+    std::vector<Projectile*> owned;
+    for (const auto child: parent->getChildren()) {
+        if (const auto projectile = dynamic_cast<Projectile*>(child); projectile && projectile->m_pool == this) {
+            owned.push_back(projectile);
+        }
+    }
+    for (const auto projectile: owned) {
+        // drop the deferred release of the disposed projectile: it would run when reused
+        projectile->stopAllActions();
+        this->Release(projectile);
+    }
+}
+
+Projectile* ProjectilePool::Create(Archetype archetype) {
+    const auto projectile { Projectile::create(0.f) };
+    projectile->m_pool = this;
+    projectile->m_archetype = static_cast<std::uint8_t>(archetype);
+    ::AddVisuals(projectile, archetype);
+    return projectile;
+}
+
+cocos2d::PhysicsBody* ProjectilePool::CreateBody(Archetype archetype, const cocos2d::Size& size) {
+    cocos2d::PhysicsBody * body { nullptr };
+    const cocos2d::PhysicsMaterial material { 1.f, 0.0f, 0.0f };
+    switch (archetype) {
+        case Archetype::MELEE: [[fallthrough]];
+        case Archetype::ARROW: [[fallthrough]];
+        case Archetype::STAKE: {
+            body = cocos2d::PhysicsBody::createBox(size);
+        } break;
+        case Archetype::STONE: {
+            body = cocos2d::PhysicsBody::createCircle(
+                size.width / 2.f
+                , cocos2d::PhysicsMaterial{ 0.1f, 0.2f, 0.7f }
+            );
+        } break;
+        case Archetype::PLAYER_FIREBALL: [[fallthrough]];
+        case Archetype::BOSS_FIREBALL: [[fallthrough]];
+        case Archetype::CLOUD_FIREBALL: {
+            body = cocos2d::PhysicsBody::createBox(size, material, { -size.width / 2.f, 0.f });
+        } break;
+        case Archetype::PLAYER_SPECIAL: {
+            body = cocos2d::PhysicsBody::createBox(size, material, { -size.width / 2.f, size.height * 0.2f });
+        } break;
+        case Archetype::SLIME_SHOT: {
+            body = cocos2d::PhysicsBody::createBox(size, material, { -size.width / 2.f, size.height });
+        } break;
+        default: assert(false && "Unreachable"); break;
+    }
+    // only stones fall and roll
+    const bool isStone { archetype == Archetype::STONE };
+    body->setDynamic(true);
+    body->setGravityEnable(isStone);
+    if (isStone) {
+        body->setRotationEnable(true);
+    }
+    return body;
+}
@@ -0,0 +1,117 @@
+#ifndef PROJECTILE_POOL_HPP
+#define PROJECTILE_POOL_HPP
+
+#include "Projectile.hpp"
+#include "Utils.hpp"
+
+#include "cocos2d.h"
+
+#include <array>
+#include <cstdint>
+
+/**
+ * Per-level storage of the projectiles which finished their lifetime.
+ * Projectiles of the same archetype share visuals (sprite or armature)
+ * and physics body shape, so they are recycled instead of being recreated:
+ * the node, its visuals and the body (when the size matches) are reused.
+ */
+class ProjectilePool final {
+public:
+    enum class Archetype : std::uint8_t {
+        MELEE,              // invisible sword, axe, chain... swing
+        ARROW,
+        STAKE,
+        STONE,
+        PLAYER_FIREBALL,
+        PLAYER_SPECIAL,
+        BOSS_FIREBALL,
+        CLOUD_FIREBALL,
+        SLIME_SHOT,
+
+        COUNT
+    };
+
+    /**
+     * Files of the archetype's visuals: either the image or the armature.
+     * Shared with the AssetPreloader.
+     */
+    struct Visual final {
+        const char * image { nullptr };
+        // DragonBones files prefix and the armature cache name
+        const char * prefix { nullptr };
+        const char * name { nullptr };
+        float scale { 1.f };
+    };
+
+    [[nodiscard]] static const Visual& GetVisual(Archetype archetype) noexcept;
+
+    ProjectilePool() = default;
+    ~ProjectilePool() = default;
+
+    ProjectilePool(const ProjectilePool&) = delete;
+    ProjectilePool& operator=(const ProjectilePool&) = delete;
+    ProjectilePool(ProjectilePool&&) = delete;
+    ProjectilePool& operator=(ProjectilePool&&) = delete;
+
+    /**
+     * Make sure at least `count` projectiles of the archetype are ready to use.
+     */
+    void Prewarm(Archetype archetype, size_t count);
+
+    /**
+     * Take a projectile from the pool or create a new one.
+     *
+     * @param bodySize size of the physics body; the body is reused if it has the same size
+     * @return reset projectile with enabled physics body (zero velocity, default masks)
+     *  which is ready to be added to the map
+     */
+    [[nodiscard]] Projectile* Acquire(Archetype archetype, float damage, const cocos2d::Size& bodySize);
+
+    /**
+     * Remove the projectile from the parent and keep it for the reuse.
+     */
+    void Release(Projectile * projectile);
+
+    /**
+     * Release the projectiles of this pool which are children of the node,
+     * including the disposed ones waiting for the deferred release,
+     * e.g. when the level restarts.
+     */
+    void ReleaseChildren(cocos2d::Node * parent);
+
+    /**
+     * Number of acquisitions served by the recycled projectiles
+     */
+    size_t GetHits() const noexcept {
+        return m_hits;
+    }
+
+    /**
+     * Number of acquisitions which needed a new projectile
+     */
+    size_t GetMisses() const noexcept {
+        return m_misses;
+    }
+
+    /**
+     * Number of the acquired projectiles which aren't released yet
+     */
+    size_t GetLive() const noexcept {
+        return m_live;
+    }
+
+private:
+    Projectile* Create(Archetype archetype);
+
+    static cocos2d::PhysicsBody* CreateBody(Archetype archetype, const cocos2d::Size& size);
+
+    std::array<cocos2d::Vector<Projectile*>, Utils::EnumSize<Archetype>()> m_free;
+
+    size_t m_hits { 0U };
+
+    size_t m_misses { 0U };
+
+    size_t m_live { 0U };
+};
+
+#endif // PROJECTILE_POOL_HPP
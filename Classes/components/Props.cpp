@@ -1,6 +1,8 @@
 #include "Props.hpp"
 #include "DragonBonesAnimator.hpp"
 #include "Core.hpp"
+#include "AssetPaths.hpp"
+#include "ActivationRegion.hpp"
 
 #include <array>
 #include <cassert>
@@ -76,6 +78,23 @@ bool Prop::init() {
     return true;
 }
 
+void Prop::onEnter() {
+    cocos2d::Node::onEnter();
+    m_activation = ActivationRegion::Find(this);
+    if (m_activation) {
+        m_activationId = m_activation->Add(this, ActivationRegion::Kind::PROP);
+    }
+}
+
+void Prop::onExit() {
+    if (m_activation) {
+        m_activation->Remove(m_activationId);
+        m_activation = nullptr;
+        m_activationId = ActivationRegion::INVALID_ENTITY;
+    }
+    cocos2d::Node::onExit();
+}
+
 void Prop::pause() {
     cocos2d::Node::pause(); 
     m_animator->pause();
@@ -132,8 +151,7 @@ void Prop::AddPhysicsBody() {
 }
  
 void Prop::AddAnimator() {
-    std::string name(GetPropName(m_name));
-    std::string prefix = "Map/props/"s + name;
+    auto [prefix, name] = assets::GetPropSkeleton(GetPropName(m_name));
     m_animator = dragonBones::Animator::create(std::move(prefix), std::move(name));
     m_animator->InitializeAnimations({
         std::make_pair(Utils::EnumCast(State::IDLE), "idle"),
@@ -10,6 +10,7 @@
 namespace dragonBones {
     class Animator;
 }
+class ActivationRegion;
 
 namespace props {
 
@@ -34,6 +35,10 @@ public:
     static Prop * create(Name name, const cocos2d::Size& size, float scale) noexcept;
 
     [[nodiscard]] bool init() override;
+
+    void onEnter() override;
+
+    void onExit() override;
    
     void pause() override;
     
@@ -60,6 +65,9 @@ private:
     dragonBones::Animator * m_animator { nullptr };
     cocos2d::Size m_originContentSize {};
     float m_scale {0.f};
+    // level's activation region, available while the prop is running
+    ActivationRegion * m_activation { nullptr };
+    uint32_t m_activationId { UINT32_MAX };
 };
 
 
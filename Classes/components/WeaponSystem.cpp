@@ -0,0 +1,400 @@
+#include "WeaponSystem.hpp"
+#include "Core.hpp"
+#include "FrameSampler.hpp"
+#include "Profiler.hpp"
+#include "Projectile.hpp"
+#include "ProjectilePool.hpp"
+
+#include "units/Player.hpp"
+#include "units/AxWarrior.hpp"
+#include "units/Spearman.hpp"
+#include "units/Wolf.hpp"
+#include "units/Wasp.hpp"
+#include "units/Slime.hpp"
+#include "units/Archer.hpp"
+#include "units/Cannon.hpp"
+#include "units/BoulderPusher.hpp"
+#include "units/Stalactite.hpp"
+#include "units/FireCloud.hpp"
+#include "units/BanditBoss.hpp"
+
+#include "scenes/LevelScene.hpp"
+
+#include "cocos2d.h"
+
+#include <cassert>
+
+namespace {
+
+    using Kind = WeaponSystem::Kind;
+    using State = WeaponSystem::State;
+    using Archetype = ProjectilePool::Archetype;
+
+    /**
+     * Type of the unit owning the weapon of the kind
+     */
+    template<Kind kind>
+    struct Owner;
+
+    template<> struct Owner<Kind::SWORD> { using type = Player; };
+    template<> struct Owner<Kind::PLAYER_FIREBALL> { using type = Player; };
+    template<> struct Owner<Kind::PLAYER_SPECIAL> { using type = Player; };
+    template<> struct Owner<Kind::AXE> { using type = Enemies::AxWarrior; };
+    template<> struct Owner<Kind::SPEAR> { using type = Enemies::Spearman; };
+    template<> struct Owner<Kind::MAW> { using type = Enemies::Wolf; };
+    template<> struct Owner<Kind::STING> { using type = Enemies::Wasp; };
+    template<> struct Owner<Kind::SLIME_SHOT> { using type = Enemies::Slime; };
+    template<> struct Owner<Kind::BOW> { using type = Enemies::Archer; };
+    template<> struct Owner<Kind::STAKE> { using type = Enemies::Cannon; };
+    template<> struct Owner<Kind::LEGS> { using type = Enemies::BoulderPusher; };
+    template<> struct Owner<Kind::STALACTITE_PART> { using type = Enemies::Stalactite; };
+    template<> struct Owner<Kind::CLOUD_FIREBALL> { using type = Enemies::FireCloud; };
+    template<> struct Owner<Kind::BOSS_FIREBALL> { using type = Enemies::BanditBoss; };
+    template<> struct Owner<Kind::BOSS_FIRECLOUD> { using type = Enemies::BanditBoss; };
+    template<> struct Owner<Kind::BOSS_CHAIN_SWEEP> { using type = Enemies::BanditBoss; };
+    template<> struct Owner<Kind::BOSS_CHAIN_SWING> { using type = Enemies::BanditBoss; };
+
+    // READY -> PREPARATION -> [ ATTACK -> DELAY -> ATTACK ] -> RELOAD -> READY ...
+    constexpr bool IsDoubleAttack(Kind kind) noexcept {
+        return kind == Kind::BOSS_FIREBALL || kind == Kind::BOSS_CHAIN_SWING;
+    }
+
+    constexpr bool IsPlayers(Kind kind) noexcept {
+        return kind == Kind::SWORD || kind == Kind::PLAYER_FIREBALL || kind == Kind::PLAYER_SPECIAL;
+    }
+
+    constexpr bool IsMelee(Kind kind) noexcept {
+        return kind == Kind::SWORD
+            || kind == Kind::AXE
+            || kind == Kind::SPEAR
+            || kind == Kind::MAW
+            || kind == Kind::STING
+            || kind == Kind::BOSS_CHAIN_SWEEP
+            || kind == Kind::BOSS_CHAIN_SWING;
+    }
+
+    // spells flying through the platforms
+    constexpr bool IsSpell(Kind kind) noexcept {
+        return kind == Kind::PLAYER_FIREBALL
+            || kind == Kind::PLAYER_SPECIAL
+            || kind == Kind::SLIME_SHOT
+            || kind == Kind::CLOUD_FIREBALL
+            || kind == Kind::BOSS_FIREBALL;
+    }
+
+    constexpr Archetype GetSpellArchetype(Kind kind) noexcept {
+        switch (kind) {
+            case Kind::PLAYER_FIREBALL: return Archetype::PLAYER_FIREBALL;
+            case Kind::PLAYER_SPECIAL: return Archetype::PLAYER_SPECIAL;
+            case Kind::SLIME_SHOT: return Archetype::SLIME_SHOT;
+            case Kind::CLOUD_FIREBALL: return Archetype::CLOUD_FIREBALL;
+            default: return Archetype::BOSS_FIREBALL;
+        }
+    }
+
+    constexpr float GetSpellLifetime(Kind kind) noexcept {
+        return kind == Kind::SLIME_SHOT || kind == Kind::CLOUD_FIREBALL? 4.f: 5.f;
+    }
+
+    inline auto GetCategoryMask(bool isPlayers) noexcept {
+        return Utils::CreateMask(isPlayers?
+            core::CategoryBits::PLAYER_PROJECTILE:
+            core::CategoryBits::ENEMY_PROJECTILE
+        );
+    }
+
+    inline auto GetTestMask(bool isPlayers) noexcept {
+        return Utils::CreateMask(
+            core::CategoryBits::HITBOX_SENSOR
+            , core::CategoryBits::PROPS
+            , core::CategoryBits::BOUNDARY
+            , isPlayers?
+                core::CategoryBits::ENEMY_PROJECTILE:
+                core::CategoryBits::PLAYER_PROJECTILE
+        );
+    }
+
+} // namespace {
+
+WeaponSystem::WeaponSystem(cocos2d::Node * map, ProjectilePool * projectiles)
+    : m_map { map }
+    , m_projectiles { projectiles }
+{
+    assert(m_map && m_projectiles);
+}
+
+Weapon WeaponSystem::Add(Unit * owner
+    , Kind kind
+    , size_t slot
+    , float damage
+    , float range
+    , float preparationTime
+    , float attackTime
+    , float reloadTime
+) {
+    assert(owner);
+    assert(kind < Kind::COUNT);
+    uint32_t index { 0U };
+    if (!m_free.empty()) {
+        index = m_free.back();
+        m_free.pop_back();
+    }
+    else {
+        index = static_cast<uint32_t>(m_owners.size());
+        m_owners.emplace_back();
+        m_kinds.emplace_back();
+        m_slots.emplace_back();
+        m_states.emplace_back();
+        m_durations.emplace_back();
+        m_timers.emplace_back();
+        m_running.emplace_back();
+        m_damage.emplace_back();
+        m_range.emplace_back();
+        m_isActive.emplace_back();
+        m_delays.emplace_back();
+        m_pending.emplace_back();
+    }
+    m_owners[index] = owner;
+    m_kinds[index] = kind;
+    m_slots[index] = static_cast<uint8_t>(slot);
+    m_states[index] = State::READY;
+    auto& durations { m_durations[index] };
+    durations[Utils::EnumCast(State::READY)] = 0.f;
+    durations[Utils::EnumCast(State::PREPARATION)] = preparationTime;
+    durations[Utils::EnumCast(State::ATTACK)] = attackTime;
+    durations[Utils::EnumCast(State::RELOAD)] = reloadTime;
+    m_timers[index] = 0.f;
+    m_running[index] = 0.f;
+    m_damage[index] = damage;
+    m_range[index] = range;
+    m_isActive[index] = 1.f;
+    m_delays[index] = DELAY;
+    m_pending[index] = 0.f;
+    m_size++;
+    return Weapon { this, index };
+}
+
+void WeaponSystem::Remove(const Weapon& weapon) noexcept {
+    const auto index { weapon.GetIndex() };
+    if (index >= m_owners.size() || !m_owners[index]) {
+        return;
+    }
+    m_owners[index] = nullptr;
+    m_states[index] = State::READY;
+    m_running[index] = 0.f;
+    m_pending[index] = 0.f;
+    m_free.push_back(index);
+    m_size--;
+}
+
+void WeaponSystem::SetActive(const Weapon& weapon, bool isActive) noexcept {
+    const auto index { weapon.GetIndex() };
+    if (index >= m_owners.size() || !m_owners[index]) {
+        return;
+    }
+    m_isActive[index] = isActive? 1.f: 0.f;
+    m_running[index] = isActive && m_states[index] != State::READY? 1.f: 0.f;
+}
+
+void WeaponSystem::SetState(uint32_t index, State state) noexcept {
+    m_states[index] = state;
+    m_timers[index] = m_durations[index][Utils::EnumCast(state)];
+    m_running[index] = m_isActive[index] != 0.f && state != State::READY? 1.f: 0.f;
+    // leaving the attack cancels the second shot
+    m_pending[index] = 0.f;
+}
+
+void WeaponSystem::Update(float dt) {
+    // was a part of the units' updates
+    const bench::ScopedSample sample { bench::Subsystem::UNITS };
+    const auto count { m_timers.size() };
+    // timers of the ready, inactive and removed weapons are stopped by zero factor,
+    // the second shot waits while the owner is paused too
+    for (size_t i = 0; i < count; i++) {
+        m_timers[i] -= dt * m_running[i];
+        m_delays[i] -= dt * m_pending[i] * m_isActive[i];
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        if (m_running[i] == 0.f) continue;
+
+        if (m_timers[i] <= 0.f) {
+            const auto next = (Utils::EnumCast(m_states[i]) + 1) % Utils::EnumSize<State>();
+            this->SetState(i, Utils::EnumCast<State>(next));
+            if (m_states[i] == State::ATTACK) {
+                m_attacks.push_back(i);
+                if (::IsDoubleAttack(m_kinds[i])) {
+                    m_delays[i] = DELAY;
+                    m_pending[i] = 1.f;
+                }
+            }
+        }
+        else if (m_pending[i] != 0.f && m_delays[i] <= 0.f) {
+            m_attacks.push_back(i);
+            m_pending[i] = 0.f;
+        }
+    }
+
+    // spawning may add weapons, e.g. the boss's fire cloud, so don't keep references
+    for (size_t i = 0; i < m_attacks.size(); i++) {
+        this->Fire(m_attacks[i]);
+    }
+    m_attacks.clear();
+}
+
+void WeaponSystem::Fire(uint32_t index) {
+    PROFILE_ZONE("WeaponSystem::Fire");
+    const auto owner { m_owners[index] };
+    if (!owner || owner->IsDead()) {
+        return;
+    }
+    switch (m_kinds[index]) {
+        case Kind::SWORD: this->Fire<Kind::SWORD>(index); break;
+        case Kind::PLAYER_FIREBALL: this->Fire<Kind::PLAYER_FIREBALL>(index); break;
+        case Kind::PLAYER_SPECIAL: this->Fire<Kind::PLAYER_SPECIAL>(index); break;
+        case Kind::AXE: this->Fire<Kind::AXE>(index); break;
+        case Kind::SPEAR: this->Fire<Kind::SPEAR>(index); break;
+        case Kind::MAW: this->Fire<Kind::MAW>(index); break;
+        case Kind::STING: this->Fire<Kind::STING>(index); break;
+        case Kind::SLIME_SHOT: this->Fire<Kind::SLIME_SHOT>(index); break;
+        case Kind::BOW: this->Fire<Kind::BOW>(index); break;
+        case Kind::STAKE: this->Fire<Kind::STAKE>(index); break;
+        case Kind::LEGS: this->Fire<Kind::LEGS>(index); break;
+        case Kind::STALACTITE_PART: this->Fire<Kind::STALACTITE_PART>(index); break;
+        case Kind::CLOUD_FIREBALL: this->Fire<Kind::CLOUD_FIREBALL>(index); break;
+        case Kind::BOSS_FIREBALL: this->Fire<Kind::BOSS_FIREBALL>(index); break;
+        case Kind::BOSS_FIRECLOUD: this->Fire<Kind::BOSS_FIRECLOUD>(index); break;
+        case Kind::BOSS_CHAIN_SWEEP: this->Fire<Kind::BOSS_CHAIN_SWEEP>(index); break;
+        case Kind::BOSS_CHAIN_SWING: this->Fire<Kind::BOSS_CHAIN_SWING>(index); break;
+        default: assert(false && "Unreachable"); break;
+    }
+}
+
+template<Kind kind>
+void WeaponSystem::Fire(uint32_t index) {
+    const auto owner { static_cast<const typename Owner<kind>::type*>(m_owners[index]) };
+    const auto slot { static_cast<size_t>(m_slots[index]) };
+    const auto damage { m_damage[index] };
+    const auto area { owner->GetAttackArea(slot) };
+
+    if constexpr (::IsMelee(kind)) {
+        // invisible projectile following the swing
+        const auto proj = m_projectiles->Acquire(Archetype::MELEE, damage, area.size);
+        proj->setContentSize(area.size);
+        proj->setPosition(area.origin);
+        owner->PushProjectile(slot, proj->getPhysicsBody());
+        proj->SetCategoryBitmask(::GetCategoryMask(::IsPlayers(kind)));
+        proj->SetContactTestBitmask(::GetTestMask(::IsPlayers(kind)));
+        m_map->addChild(proj);
+    }
+    else if constexpr (::IsSpell(kind)) {
+        const auto proj = m_projectiles->Acquire(::GetSpellArchetype(kind), damage, area.size);
+        const auto body = proj->getPhysicsBody();
+        proj->setAnchorPoint({0.0f, 0.0f});
+        proj->setContentSize(area.size);
+        proj->setPosition(area.origin);
+        owner->PushProjectile(slot, body);
+        if (body->getVelocity().x > 0.f) {
+            proj->FlipX();
+        }
+        body->setCollisionBitmask(0);
+        body->setCategoryBitmask(::GetCategoryMask(::IsPlayers(kind)));
+        body->setContactTestBitmask(::GetTestMask(::IsPlayers(kind)));
+        proj->SetLifetime(::GetSpellLifetime(kind));
+        m_map->addChild(proj, 101);
+    }
+    else if constexpr (kind == Kind::BOW || kind == Kind::STAKE) {
+        const auto archetype { kind == Kind::BOW? Archetype::ARROW: Archetype::STAKE };
+        const auto proj = m_projectiles->Acquire(archetype, damage, area.size);
+        const auto body = proj->getPhysicsBody();
+        proj->setPosition(area.origin);
+        proj->setContentSize(area.size);
+        owner->PushProjectile(slot, body);
+        if (body->getVelocity().x > 0.f) {
+            proj->FlipX();
+        }
+        if constexpr (kind == Kind::BOW) {
+            body->setCollisionBitmask(Utils::CreateMask(core::CategoryBits::BOUNDARY));
+        }
+        proj->SetCategoryBitmask(::GetCategoryMask(false));
+        proj->SetContactTestBitmask(::GetTestMask(false));
+        proj->SetLifetime(3.f);
+        m_map->addChild(proj, 100);
+    }
+    else if constexpr (kind == Kind::LEGS) {
+        const auto proj = m_projectiles->Acquire(Archetype::STONE, damage, area.size);
+        const auto body = proj->getPhysicsBody();
+        body->setCategoryBitmask(::GetCategoryMask(false));
+        body->setCollisionBitmask(
+            Utils::CreateMask(core::CategoryBits::PLATFORM, core::CategoryBits::BOUNDARY)
+        );
+        body->setContactTestBitmask(
+            Utils::CreateMask(
+                core::CategoryBits::HITBOX_SENSOR
+                , core::CategoryBits::PROPS
+                , core::CategoryBits::PLAYER_PROJECTILE
+            )
+        );
+        proj->setAnchorPoint({0.5f, 0.5f});
+        proj->setPosition(area.origin + area.size / 2.f);
+        proj->setContentSize(area.size);
+        owner->PushProjectile(slot, body);
+        proj->SetLifetime(5.f);
+        m_map->addChild(proj, 100);
+    }
+    else if constexpr (kind == Kind::STALACTITE_PART) {
+        const auto proj = Projectile::create(damage);
+        auto [prefix, name] = owner->GetPartSkeleton();
+        proj->AddAnimator(std::move(name), std::move(prefix));
+        proj->InitializeAnimations({
+            std::make_pair(Utils::EnumCast(Projectile::State::IDLE), "attack"),
+            std::make_pair(Utils::EnumCast(Projectile::State::HIT_PLAYER), "dead"),
+            std::make_pair(Utils::EnumCast(Projectile::State::HIT_GROUND), "dead")
+        });
+        const auto scaleFactor { 0.095f };
+        proj->setScale(scaleFactor);
+
+        const auto body = cocos2d::PhysicsBody::createBox(
+            area.size
+            , cocos2d::PhysicsMaterial{ 1.f, 0.0f, 0.0f }
+            , { -area.size.width / 2.f, 0.f }
+        );
+        body->setDynamic(true);
+        body->setGravityEnable(false);
+
+        proj->setAnchorPoint({0.0f, 0.0f});
+        proj->setContentSize(area.size);
+        proj->setPosition(area.origin);
+        owner->PushProjectile(slot, body);
+        body->setCollisionBitmask(0);
+        body->setCategoryBitmask(::GetCategoryMask(false));
+        body->setContactTestBitmask(
+            ::GetTestMask(false) | Utils::CreateMask(core::CategoryBits::PLATFORM)
+        );
+        proj->SetLifetime(5.f);
+        proj->addComponent(body);
+        m_map->addChild(proj, 101);
+    }
+    else if constexpr (kind == Kind::BOSS_FIRECLOUD) {
+        auto cloud = Enemies::FireCloud::create(1, area.size, owner->GetCloudModel());
+        if (!owner->IsLookingLeft()) {
+            cloud->Turn();
+        }
+        // push body up
+        owner->PushProjectile(slot, cloud->getPhysicsBody());
+        cloud->setPosition(area.origin);
+        m_map->addChild(cloud, 101);
+    }
+    else {
+        static_assert(kind != kind, "Unknown weapon kind");
+    }
+}
+
+WeaponSystem* WeaponSystem::Find(const cocos2d::Node * node) noexcept {
+    for (auto parent = node; parent; parent = parent->getParent()) {
+        if (const auto level = dynamic_cast<const LevelScene*>(parent); level) {
+            return level->GetWeaponSystem();
+        }
+    }
+    return nullptr;
+}
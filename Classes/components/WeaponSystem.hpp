@@ -0,0 +1,292 @@
+#ifndef WEAPON_SYSTEM_HPP
+#define WEAPON_SYSTEM_HPP
+
+#include "Utils.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <vector>
+
+namespace cocos2d {
+    class Node;
+}
+class Unit;
+class ProjectilePool;
+class WeaponSystem;
+
+/**
+ * Weapon defines attack damage, attack range and attack speed
+ * that unit may have.
+ *
+ * It's a handle of the weapon's state kept by the level's WeaponSystem.
+ * Default constructed handle refers to no weapon: it's never ready.
+ */
+class Weapon final {
+public:
+    static constexpr uint32_t INVALID_WEAPON { UINT32_MAX };
+
+    Weapon() = default;
+
+    Weapon(WeaponSystem * system, uint32_t index) noexcept
+        : m_system { system }
+        , m_index { index }
+    {}
+
+    explicit operator bool() const noexcept {
+        return m_system != nullptr;
+    }
+
+    /**
+     * @return
+     *      The indication whether the weapon can be used to attack or not
+     */
+    [[nodiscard]] inline bool IsReady() const noexcept;
+
+    [[nodiscard]] inline bool IsPreparing() const noexcept;
+
+    [[nodiscard]] inline bool IsAttacking() const noexcept;
+
+    [[nodiscard]] inline bool IsReloading() const noexcept;
+
+    inline void LaunchAttack() noexcept;
+
+    inline void ForceReload() noexcept;
+
+    /**
+     * This function return the damage this weapon deal.
+     * @return
+     *      Damage dealt by this weapon.
+     */
+    [[nodiscard]] inline float GetDamage() const noexcept;
+
+    /**
+     * This function return the attack range, i.e.
+     * the range in which this weapon can deal damage..
+     * @return
+     *      Range dealt by this weapon.
+     */
+    [[nodiscard]] inline float GetRange() const noexcept;
+
+    [[nodiscard]] uint32_t GetIndex() const noexcept {
+        return m_index;
+    }
+
+private:
+    WeaponSystem * m_system { nullptr };
+
+    uint32_t m_index { INVALID_WEAPON };
+};
+
+/**
+ * Level-owned state of all weapons.
+ *
+ * State timers are kept in parallel arrays and advanced by a single pass
+ * over all weapons. Weapons which reach the attack state are collected
+ * into the list of the frame's attacks, and only then the projectiles
+ * are spawned. The owner of the weapon is known from the weapon's kind,
+ * so the spawn area and the push of the projectile are asked from
+ * the concrete unit:
+ * - `cocos2d::Rect GetAttackArea(size_t slot) const`
+ * - `void PushProjectile(size_t slot, cocos2d::PhysicsBody * body) const`
+ * where the slot is the weapon's index in the owner's weapons.
+ */
+class WeaponSystem final {
+public:
+    enum class Kind : uint8_t {
+        SWORD,
+        PLAYER_FIREBALL,
+        PLAYER_SPECIAL,
+        AXE,
+        SPEAR,
+        MAW,
+        STING,
+        SLIME_SHOT,
+        BOW,
+        STAKE,
+        LEGS,
+        STALACTITE_PART,
+        CLOUD_FIREBALL,
+        BOSS_FIREBALL,
+        BOSS_FIRECLOUD,
+        BOSS_CHAIN_SWEEP,
+        BOSS_CHAIN_SWING,
+        COUNT
+    };
+
+    enum class State : uint8_t {
+        // weapon is ready to initiate an attack
+        READY,
+        // attack was initiated but is in preparation phase,
+        // e.g. load the arrow and pull the string or make a swing
+        PREPARATION,
+        // an actual attack, hopefully dealing a damage,
+        // i.e. create the projectile,
+        // e.g. fire the arrow, bullet
+        ATTACK,
+        // additional reloading time
+        RELOAD,
+        // number of states
+        COUNT
+    };
+
+    // delay between two shots of the double attack, e.g. boss's fireballs
+    static constexpr float DELAY { 0.3f };
+
+    /**
+     * @param map node the projectiles are added to
+     * @param projectiles pool the projectiles are acquired from
+     */
+    WeaponSystem(cocos2d::Node * map, ProjectilePool * projectiles);
+
+    /**
+     * @param owner the unit of the type expected by the kind
+     * @param slot index of the weapon in the owner's weapons
+     */
+    Weapon Add(Unit * owner
+        , Kind kind
+        , size_t slot
+        , float damage
+        , float range
+        , float preparationTime
+        , float attackTime
+        , float reloadTime
+    );
+
+    void Remove(const Weapon& weapon) noexcept;
+
+    /**
+     * Inactive weapons keep their state, e.g. while the owner is paused.
+     */
+    void SetActive(const Weapon& weapon, bool isActive) noexcept;
+
+    /**
+     * Advance the timers of all weapons and spawn projectiles of the attacks.
+     */
+    void Update(float dt);
+
+    [[nodiscard]] State GetState(uint32_t index) const noexcept {
+        return m_states[index];
+    }
+
+    [[nodiscard]] float GetDamage(uint32_t index) const noexcept {
+        return m_damage[index];
+    }
+
+    [[nodiscard]] float GetRange(uint32_t index) const noexcept {
+        return m_range[index];
+    }
+
+    void LaunchAttack(uint32_t index) noexcept {
+        if (m_states[index] == State::READY) {
+            // go to preparation state
+            this->SetState(index, State::PREPARATION);
+        }
+    }
+
+    void ForceReload(uint32_t index) noexcept {
+        this->SetState(index, State::RELOAD);
+    }
+
+    [[nodiscard]] size_t GetSize() const noexcept {
+        return m_size;
+    }
+
+    /**
+     * Find the weapon system of the level the node belongs to.
+     */
+    static WeaponSystem* Find(const cocos2d::Node * node) noexcept;
+
+private:
+    void SetState(uint32_t index, State state) noexcept;
+
+    /**
+     * Spawn the projectile of the weapon which is attacking.
+     */
+    void Fire(uint32_t index);
+
+    template<Kind kind>
+    void Fire(uint32_t index);
+
+    cocos2d::Node * const m_map { nullptr };
+
+    ProjectilePool * const m_projectiles { nullptr };
+
+    /// Weapons' data, the index is the weapon's id
+
+    // nullptr for the removed weapon
+    std::vector<Unit*> m_owners;
+
+    std::vector<Kind> m_kinds;
+
+    std::vector<uint8_t> m_slots;
+
+    std::vector<State> m_states;
+
+    std::vector<std::array<float, Utils::EnumSize<State>()>> m_durations;
+
+    std::vector<float> m_timers;
+
+    // 1 when the timer runs: the weapon is busy and active, 0 otherwise
+    std::vector<float> m_running;
+
+    std::vector<float> m_damage;
+
+    std::vector<float> m_range;
+
+    // 1 while the owner's update is running, 0 otherwise
+    std::vector<float> m_isActive;
+
+    // timer of the second shot of the double attack
+    std::vector<float> m_delays;
+
+    // 1 while the second shot is pending, 0 otherwise
+    std::vector<float> m_pending;
+
+    std::vector<uint32_t> m_free;
+
+    // weapons which attack in the current frame
+    std::vector<uint32_t> m_attacks;
+
+    size_t m_size { 0U };
+};
+
+/// Implementation
+
+inline bool Weapon::IsReady() const noexcept {
+    return m_system && m_system->GetState(m_index) == WeaponSystem::State::READY;
+}
+
+inline bool Weapon::IsPreparing() const noexcept {
+    return m_system && m_system->GetState(m_index) == WeaponSystem::State::PREPARATION;
+}
+
+inline bool Weapon::IsAttacking() const noexcept {
+    return m_system && m_system->GetState(m_index) == WeaponSystem::State::ATTACK;
+}
+
+inline bool Weapon::IsReloading() const noexcept {
+    return m_system && m_system->GetState(m_index) == WeaponSystem::State::RELOAD;
+}
+
+inline void Weapon::LaunchAttack() noexcept {
+    if (m_system) {
+        m_system->LaunchAttack(m_index);
+    }
+}
+
+inline void Weapon::ForceReload() noexcept {
+    if (m_system) {
+        m_system->ForceReload(m_index);
+    }
+}
+
+inline float Weapon::GetDamage() const noexcept {
+    return m_system? m_system->GetDamage(m_index): 0.f;
+}
+
+inline float Weapon::GetRange() const noexcept {
+    return m_system? m_system->GetRange(m_index): 0.f;
+}
+
+#endif // WEAPON_SYSTEM_HPP
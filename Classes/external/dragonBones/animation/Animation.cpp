@@ -248,8 +248,12 @@ AnimationState* Animation::playConfig(AnimationConfig* animationConfig)
         return nullptr;
     }
 
-    const auto animationData = _animations[animationName];
+    return _playConfig(animationConfig, _animations[animationName]);
+}
 
+AnimationState* Animation::_playConfig(AnimationConfig* animationConfig, AnimationData* animationData)
+{
+    const auto& animationName = animationConfig->animation;
     if (animationConfig->fadeOutMode == AnimationFadeOutMode::Single) 
     {
         for (const auto animationState : _animationStates) 
@@ -419,6 +423,19 @@ AnimationState* Animation::play(const std::string& animationName, int playTimes)
 
     return _lastAnimationState;
 }
+
+AnimationState* Animation::play(AnimationData* animationData, int playTimes)
+{
+    DRAGONBONES_ASSERT(animationData != nullptr, "Non-existent animation.");
+
+    _animationConfig->clear();
+    _animationConfig->resetToPose = true;
+    _animationConfig->playTimes = playTimes;
+    _animationConfig->fadeInTime = 0.0f;
+    _animationConfig->animation = animationData->name;
+
+    return _playConfig(_animationConfig, animationData);
+}
 #ifdef EGRET_WASM
 AnimationState* Animation::fadeIn(
     const std::string& animationName, float fadeInTime, int playTimes,
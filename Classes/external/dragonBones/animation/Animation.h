@@ -82,6 +82,7 @@ public:
 
 private:
     void _fadeOut(AnimationConfig* animationConfig);
+    AnimationState* _playConfig(AnimationConfig* animationConfig, AnimationData* animationData);
 
 protected:
     virtual void _onClear() override;
@@ -171,6 +172,15 @@ public:
      * @language zh_CN
      */
     AnimationState* play(const std::string& animationName = "", int playTimes = -1);
+    /**
+     * - Play the animation data resolved beforehand, e.g. from {@link #getAnimations()}.
+     * Same as {@link #play()} with the animation's name but without the name lookup.
+     * @param animationData - The animation data of this armature.
+     * @param playTimes - Playing repeat times. [-1: Use default value of the animation data, 0: No end loop playing, [1~N]: Repeat N times] (default: -1)
+     * @returns The playing animation state.
+     * @language en_US
+     */
+    AnimationState* play(AnimationData* animationData, int playTimes = -1);
     /**
      * - Fade in a specific animation.
      * @param animationName - The name of animation data.
@@ -3,8 +3,24 @@
 DRAGONBONES_NAMESPACE_BEGIN
 
 WorldClock WorldClock::clock;
+void (*WorldClock::advanceObserver)(bool isBegin) = nullptr;
 
 void WorldClock::advanceTime(float passedTime)
+{
+    if (advanceObserver != nullptr)
+    {
+        advanceObserver(true);
+    }
+
+    _advanceTime(passedTime);
+
+    if (advanceObserver != nullptr)
+    {
+        advanceObserver(false);
+    }
+}
+
+void WorldClock::_advanceTime(float passedTime)
 {
     if (passedTime < 0.0f || passedTime != passedTime)
     {
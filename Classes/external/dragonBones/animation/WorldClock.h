@@ -57,6 +57,12 @@ public:
      * @language zh_CN
      */
     static WorldClock clock;
+    /**
+     * - Invoked at the beginning (true) and at the end (false) of each advance of any clock,
+     * e.g. by a profiler. Null by default.
+     * @language en_US
+     */
+    static void (*advanceObserver)(bool isBegin);
 
 public:
     /**
@@ -91,6 +97,8 @@ private:
     std::vector<IAnimatable*> _animatebles;
     WorldClock* _clock;
 
+    void _advanceTime(float passedTime);
+
 public:
     /**
      * - Creating a Worldclock instance. Typically, you do not need to create Worldclock instance.
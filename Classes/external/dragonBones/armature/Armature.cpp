@@ -68,6 +68,7 @@ void Armature::_onClear()
     _flipX = false;
     _flipY = false;
     _cacheFrameIndex = -1;
+    _boneHierarchy.clear();
     _bones.clear();
     _slots.clear();
     _constraints.clear();
@@ -116,6 +117,7 @@ void Armature::_addBone(Bone* value)
     if (std::find(_bones.begin(), _bones.end(), value) == _bones.end())
     {
         _bones.push_back(value);
+        _boneHierarchy.clear();
     }
 }
 
@@ -210,9 +212,18 @@ void Armature::advanceTime(float passedTime)
     // Update bones and slots.
     if (_cacheFrameIndex < 0 || _cacheFrameIndex != prevCacheFrameIndex)
     {
-        for (const auto bone : _bones)
+        if (BoneHierarchy::enabled && _cacheFrameIndex < 0 && _constraints.empty())
         {
-            bone->update(_cacheFrameIndex);
+            _boneHierarchy.update(_bones, _flipX, _flipY == DragonBones::yDown);
+        }
+        else
+        {
+            _boneHierarchy.invalidate();
+
+            for (const auto bone : _bones)
+            {
+                bone->update(_cacheFrameIndex);
+            }
         }
 
         for (const auto slot : _slots)
@@ -431,6 +442,12 @@ Bone* Armature::getBone(const std::string& name) const
     {
         if (bone->getName() == name)
         {
+            if (!bone->_observed)
+            {
+                bone->_observed = true;
+                _boneHierarchy.observe(bone);
+            }
+
             return bone;
         }
     }
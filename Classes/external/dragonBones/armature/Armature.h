@@ -27,6 +27,7 @@
 #include "../animation/IAnimatable.h"
 #include "../model/ArmatureData.h"
 #include "IArmatureProxy.h"
+#include "BoneHierarchy.h"
 
 DRAGONBONES_NAMESPACE_BEGIN
 /**
@@ -109,6 +110,7 @@ protected:
     bool _flipX;
     bool _flipY;
     std::vector<Bone*> _bones;
+    BoneHierarchy _boneHierarchy;
     std::vector<Slot*> _slots;
     std::vector<EventObject*> _actions;
     Animation* _animation;
@@ -265,6 +267,8 @@ public:
     ) const;
     /**
      * - Get a specific bone.
+     * The global transform of the returned bone is kept up to date from then on,
+     * the bones which are never looked up and have no slots may be stale.
      * @param name - The bone name.
      * @see dragonBones.Bone
      * @version DragonBones 3.0
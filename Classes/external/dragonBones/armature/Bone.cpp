@@ -19,6 +19,7 @@ void Bone::_onClear()
     _childrenTransformDirty = false;
     _localDirty = true;
     _hasConstraint = false;
+    _observed = false;
     _visible = true;
     _cachedFrameIndex = -1;
     _blendState.clear();
@@ -247,7 +248,15 @@ void Bone::init(const BoneData* boneData, Armature* armatureValue)
 
     if (_boneData->parent != nullptr) 
     {
-        _parent = _armature->getBone(_boneData->parent->name);
+        // Not by `Armature::getBone`: the children don't observe the parent.
+        for (const auto bone : _armature->getBones())
+        {
+            if (bone->_boneData == _boneData->parent)
+            {
+                _parent = bone;
+                break;
+            }
+        }
     }
 
     _armature->_addBone(this);
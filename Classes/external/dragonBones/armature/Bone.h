@@ -51,6 +51,8 @@ class Bone final : public TransformObject
 {
     BIND_CLASS_TYPE_A(Bone);
 
+    friend class BoneHierarchy;
+
 public:
     /**
      * - The offset mode.
@@ -81,6 +83,13 @@ public:
      * @internal
      */
     bool _hasConstraint;
+    /**
+     * - Whether the global transform is read outside of the armature's bones:
+     * set by `Armature::getBone`, so `BoneHierarchy` writes it back,
+     * at once when the bone is looked up for the first time.
+     * @internal
+     */
+    bool _observed;
     /**
      * @internal
      */
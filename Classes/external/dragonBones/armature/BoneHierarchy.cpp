@@ -0,0 +1,597 @@
+#include "BoneHierarchy.h"
+#include "Bone.h"
+#include "../model/ArmatureData.h"
+
+#include <algorithm>
+#include <numeric>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DRAGONBONES_HIERARCHY_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define DRAGONBONES_HIERARCHY_NEON
+#include <arm_neon.h>
+#endif
+
+namespace {
+
+// 4 / PI
+constexpr float FOUR_OVER_PI = 1.27323954473516f;
+// PI / 4 split into the parts exact in float (Cody-Waite)
+constexpr float PI_Q_1 = 0.78515625f;
+constexpr float PI_Q_2 = 2.4187564849853515625e-4f;
+constexpr float PI_Q_3 = 3.77489497744594108e-8f;
+// the reduction loses the precision beyond
+constexpr float MAX_ANGLE = 8192.0f;
+// minimax polynomials on [-PI / 4, PI / 4]
+constexpr float SIN_0 = -1.9515295891e-4f;
+constexpr float SIN_1 = 8.3321608736e-3f;
+constexpr float SIN_2 = -1.6666654611e-1f;
+constexpr float COS_0 = 2.443315711809948e-5f;
+constexpr float COS_1 = -1.388731625493765e-3f;
+constexpr float COS_2 = 4.166664568298827e-2f;
+
+// Cephes' sinf and cosf sharing the range reduction; the lanes below do the same operations
+inline void sinCos(float x, float& sine, float& cosine)
+{
+    const auto absX = std::abs(x) < MAX_ANGLE ? std::abs(x) : 0.0f; // Fixed by the caller.
+    const auto octant = ((int)(absX * FOUR_OVER_PI) + 1) & ~1;
+    const auto y = (float)octant;
+    const auto r = ((absX - y * PI_Q_1) - y * PI_Q_2) - y * PI_Q_3;
+    const auto z = r * r;
+    const auto s = ((SIN_0 * z + SIN_1) * z + SIN_2) * z * r + r;
+    const auto c = ((COS_0 * z + COS_1) * z + COS_2) * z * z - 0.5f * z + 1.0f;
+    const auto quadrant = octant >> 1;
+    const auto swap = (quadrant & 1) != 0;
+    sine = swap ? c : s;
+    cosine = swap ? s : c;
+
+    if (((quadrant & 2) != 0) != std::signbit(x))
+    {
+        sine = -sine;
+    }
+
+    if (((quadrant + 1) & 2) != 0)
+    {
+        cosine = -cosine;
+    }
+}
+
+#if defined(DRAGONBONES_HIERARCHY_SSE2)
+
+struct Lanes
+{
+    static constexpr std::size_t COUNT = 4;
+
+    static void sinCos(const float* angles, float* sines, float* cosines)
+    {
+        const auto x = _mm_loadu_ps(angles);
+        const auto signMask = _mm_castsi128_ps(_mm_set1_epi32(0x80000000));
+        const auto one = _mm_set1_epi32(1);
+        const auto two = _mm_set1_epi32(2);
+        auto absX = _mm_andnot_ps(signMask, x);
+        absX = _mm_and_ps(absX, _mm_cmplt_ps(absX, _mm_set1_ps(MAX_ANGLE)));
+        auto octant = _mm_cvttps_epi32(_mm_mul_ps(absX, _mm_set1_ps(FOUR_OVER_PI)));
+        octant = _mm_andnot_si128(one, _mm_add_epi32(octant, one));
+        const auto y = _mm_cvtepi32_ps(octant);
+        auto r = _mm_sub_ps(absX, _mm_mul_ps(y, _mm_set1_ps(PI_Q_1)));
+        r = _mm_sub_ps(r, _mm_mul_ps(y, _mm_set1_ps(PI_Q_2)));
+        r = _mm_sub_ps(r, _mm_mul_ps(y, _mm_set1_ps(PI_Q_3)));
+        const auto z = _mm_mul_ps(r, r);
+
+        auto s = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(SIN_0), z), _mm_set1_ps(SIN_1));
+        s = _mm_add_ps(_mm_mul_ps(s, z), _mm_set1_ps(SIN_2));
+        s = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(s, z), r), r);
+        auto c = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(COS_0), z), _mm_set1_ps(COS_1));
+        c = _mm_add_ps(_mm_mul_ps(c, z), _mm_set1_ps(COS_2));
+        c = _mm_sub_ps(_mm_mul_ps(_mm_mul_ps(c, z), z), _mm_mul_ps(_mm_set1_ps(0.5f), z));
+        c = _mm_add_ps(c, _mm_set1_ps(1.0f));
+
+        const auto quadrant = _mm_srli_epi32(octant, 1);
+        const auto swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(quadrant, one), one));
+        auto sine = _mm_or_ps(_mm_and_ps(swap, c), _mm_andnot_ps(swap, s));
+        auto cosine = _mm_or_ps(_mm_and_ps(swap, s), _mm_andnot_ps(swap, c));
+        const auto sineSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(quadrant, two), 30));
+        const auto cosineSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(quadrant, one), two), 30));
+        sine = _mm_xor_ps(sine, _mm_xor_ps(sineSign, _mm_and_ps(x, signMask)));
+        cosine = _mm_xor_ps(cosine, cosineSign);
+
+        _mm_storeu_ps(sines, sine);
+        _mm_storeu_ps(cosines, cosine);
+    }
+};
+
+#elif defined(DRAGONBONES_HIERARCHY_NEON)
+
+struct Lanes
+{
+    static constexpr std::size_t COUNT = 4;
+
+    static void sinCos(const float* angles, float* sines, float* cosines)
+    {
+        const auto x = vld1q_f32(angles);
+        const auto one = vdupq_n_s32(1);
+        const auto two = vdupq_n_s32(2);
+        auto absX = vabsq_f32(x);
+        absX = vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(absX), vcltq_f32(absX, vdupq_n_f32(MAX_ANGLE))));
+        auto octant = vcvtq_s32_f32(vmulq_f32(absX, vdupq_n_f32(FOUR_OVER_PI)));
+        octant = vbicq_s32(vaddq_s32(octant, one), one);
+        const auto y = vcvtq_f32_s32(octant);
+        auto r = vsubq_f32(absX, vmulq_f32(y, vdupq_n_f32(PI_Q_1)));
+        r = vsubq_f32(r, vmulq_f32(y, vdupq_n_f32(PI_Q_2)));
+        r = vsubq_f32(r, vmulq_f32(y, vdupq_n_f32(PI_Q_3)));
+        const auto z = vmulq_f32(r, r);
+
+        auto s = vaddq_f32(vmulq_f32(vdupq_n_f32(SIN_0), z), vdupq_n_f32(SIN_1));
+        s = vaddq_f32(vmulq_f32(s, z), vdupq_n_f32(SIN_2));
+        s = vaddq_f32(vmulq_f32(vmulq_f32(s, z), r), r);
+        auto c = vaddq_f32(vmulq_f32(vdupq_n_f32(COS_0), z), vdupq_n_f32(COS_1));
+        c = vaddq_f32(vmulq_f32(c, z), vdupq_n_f32(COS_2));
+        c = vsubq_f32(vmulq_f32(vmulq_f32(c, z), z), vmulq_f32(vdupq_n_f32(0.5f), z));
+        c = vaddq_f32(c, vdupq_n_f32(1.0f));
+
+        const auto quadrant = vshrq_n_s32(octant, 1);
+        const auto swap = vceqq_s32(vandq_s32(quadrant, one), one);
+        const auto sine = vbslq_f32(swap, c, s);
+        const auto cosine = vbslq_f32(swap, s, c);
+        const auto sineSign = veorq_u32(
+            vshlq_n_u32(vreinterpretq_u32_s32(vandq_s32(quadrant, two)), 30),
+            vandq_u32(vreinterpretq_u32_f32(x), vdupq_n_u32(0x80000000))
+        );
+        const auto cosineSign = vshlq_n_u32(vreinterpretq_u32_s32(vandq_s32(vaddq_s32(quadrant, one), two)), 30);
+
+        vst1q_f32(sines, vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(sine), sineSign)));
+        vst1q_f32(cosines, vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(cosine), cosineSign)));
+    }
+};
+
+#endif
+
+} // namespace {
+
+DRAGONBONES_NAMESPACE_BEGIN
+
+bool BoneHierarchy::enabled = true;
+
+void BoneHierarchy::clear()
+{
+    _refresh = true;
+    _stale = false;
+    _bones.clear();
+    _parents.clear();
+    _inherits.clear();
+    _kinds.clear();
+    _dirty.clear();
+    _observed.clear();
+    _globalDirty.clear();
+    _globals.clear();
+    _matrices.clear();
+    _angles.clear();
+    _sines.clear();
+    _cosines.clear();
+}
+
+void BoneHierarchy::update(const std::vector<Bone*>& bones, bool flipX, bool flipY)
+{
+    if (_bones.size() != bones.size())
+    {
+        _build(bones);
+    }
+
+    _gather(flipX, flipY);
+
+    _sinCos(_angles.data(), _sines.data(), _cosines.data(), _angles.size());
+
+    _sweep(flipX, flipY);
+
+    _refresh = false;
+}
+
+void BoneHierarchy::invalidate()
+{
+    if (_stale)
+    {
+        for (std::size_t i = 0, l = _bones.size(); i < l; ++i)
+        {
+            _writeBack(i);
+        }
+
+        _stale = false;
+    }
+
+    _refresh = true;
+}
+
+void BoneHierarchy::observe(Bone* bone) const
+{
+    if (!_stale)
+    {
+        return;
+    }
+
+    const auto index = indexOf(_bones, bone);
+    if (index >= 0)
+    {
+        _writeBack(index);
+    }
+}
+
+void BoneHierarchy::_build(const std::vector<Bone*>& bones)
+{
+    clear();
+
+    std::vector<std::size_t> depths(bones.size(), 0);
+    for (std::size_t i = 0, l = bones.size(); i < l; ++i)
+    {
+        for (auto parent = bones[i]->getParent(); parent != nullptr; parent = parent->getParent())
+        {
+            depths[i]++;
+        }
+    }
+
+    std::vector<std::size_t> order(bones.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&depths](std::size_t a, std::size_t b) { return depths[a] < depths[b]; });
+
+    const auto count = bones.size();
+    _bones.reserve(count);
+    for (const auto index : order)
+    {
+        _bones.push_back(bones[index]);
+    }
+
+    _parents.resize(count);
+    _inherits.resize(count);
+    _kinds.resize(count);
+    _dirty.resize(count);
+    _observed.resize(count);
+    _globalDirty.resize(count);
+    _globals.resize(count);
+    _matrices.resize(count);
+    _angles.resize(count * 2);
+    _sines.resize(count * 2);
+    _cosines.resize(count * 2);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const auto bone = _bones[i];
+        const auto boneData = bone->getBoneData();
+        const auto parent = bone->getParent();
+
+        _parents[i] = parent != nullptr ? indexOf(_bones, parent) : -1;
+        DRAGONBONES_ASSERT(_parents[i] < (int)i, "The parent isn't in the armature.");
+
+        _inherits[i] =
+            (boneData->inheritTranslation ? Inherit::Translation : 0) |
+            (boneData->inheritRotation ? Inherit::Rotation : 0) |
+            (boneData->inheritScale ? Inherit::Scale : 0) |
+            (boneData->inheritReflection ? Inherit::Reflection : 0);
+    }
+}
+
+void BoneHierarchy::_gather(bool flipX, bool flipY)
+{
+    for (std::size_t i = 0, l = _bones.size(); i < l; ++i)
+    {
+        const auto bone = _bones[i];
+        const auto parent = _parents[i];
+        const auto dirty = _refresh || bone->_transformDirty || (parent >= 0 && _dirty[parent]);
+
+        bone->_blendState.dirty = false;
+        bone->_localDirty = true;
+        _dirty[i] = dirty;
+        _observed[i] = bone->_observed;
+
+        if (_refresh)
+        {
+            _globalDirty[i] = bone->_globalDirty;
+        }
+
+        if (!dirty)
+        {
+            bone->_childrenTransformDirty = false;
+            continue;
+        }
+
+        bone->_transformDirty = false;
+        bone->_childrenTransformDirty = true;
+        bone->_cachedFrameIndex = -1;
+
+        // The same as `Bone::_updateGlobalTransformMatrix`.
+        auto& global = _globals[i];
+        const auto origin = bone->origin;
+        const auto& offset = bone->offset;
+        const auto& animationPose = bone->animationPose;
+        auto inherit = parent >= 0;
+
+        if (bone->offsetMode == OffsetMode::Additive)
+        {
+            if (origin != nullptr)
+            {
+                global.x = origin->x + offset.x + animationPose.x;
+                global.y = origin->y + offset.y + animationPose.y;
+                global.skew = origin->skew + offset.skew + animationPose.skew;
+                global.rotation = origin->rotation + offset.rotation + animationPose.rotation;
+                global.scaleX = origin->scaleX * offset.scaleX * animationPose.scaleX;
+                global.scaleY = origin->scaleY * offset.scaleY * animationPose.scaleY;
+            }
+            else
+            {
+                global = offset; // Copy.
+                global.add(animationPose);
+            }
+        }
+        else if (bone->offsetMode == OffsetMode::None)
+        {
+            if (origin != nullptr)
+            {
+                global = *origin;
+                global.add(animationPose);
+            }
+            else
+            {
+                global = animationPose;
+            }
+        }
+        else
+        {
+            inherit = false;
+            global = offset;
+        }
+
+        if (!inherit)
+        {
+            _kinds[i] = Kind::Root;
+
+            if (flipX || flipY)
+            {
+                if (flipX)
+                {
+                    global.x = -global.x;
+                }
+
+                if (flipY)
+                {
+                    global.y = -global.y;
+                }
+
+                if (flipX && flipY)
+                {
+                    global.rotation = global.rotation + Transform::PI;
+                }
+                else
+                {
+                    global.rotation = flipX ? Transform::PI - global.rotation : -global.rotation;
+                    global.skew += Transform::PI;
+                }
+            }
+        }
+        else if ((_inherits[i] & Inherit::Scale) && (_inherits[i] & Inherit::Rotation))
+        {
+            _kinds[i] = Kind::Concat;
+        }
+        else
+        {
+            _kinds[i] = Kind::Dependent;
+            continue;
+        }
+
+        _angles[i * 2] = global.rotation;
+        _angles[i * 2 + 1] = global.skew + global.rotation;
+    }
+}
+
+void BoneHierarchy::_sweep(bool flipX, bool flipY)
+{
+    for (std::size_t i = 0, l = _bones.size(); i < l; ++i)
+    {
+        if (!_dirty[i])
+        {
+            continue;
+        }
+
+        if (_kinds[i] == Kind::Dependent)
+        {
+            _updateDependent(i, flipX, flipY);
+        }
+        else
+        {
+            // The same as `Transform::toMatrix`: the unit scales and the zero skew
+            // give the same values, so the matrix is built without branches.
+            auto& global = _globals[i];
+            auto& matrix = _matrices[i];
+            matrix.a = _cosines[i * 2] * global.scaleX;
+            matrix.b = _sines[i * 2] * global.scaleX;
+            matrix.c = -_sines[i * 2 + 1] * global.scaleY;
+            matrix.d = _cosines[i * 2 + 1] * global.scaleY;
+            matrix.tx = global.x;
+            matrix.ty = global.y;
+
+            if (_kinds[i] == Kind::Concat)
+            {
+                matrix.concat(_matrices[_parents[i]]);
+
+                if (_inherits[i] & Inherit::Translation)
+                {
+                    global.x = matrix.tx;
+                    global.y = matrix.ty;
+                }
+                else
+                {
+                    matrix.tx = global.x;
+                    matrix.ty = global.y;
+                }
+
+                _globalDirty[i] = true;
+            }
+        }
+
+        if (_observed[i])
+        {
+            _writeBack(i);
+        }
+        else
+        {
+            _stale = true;
+        }
+    }
+}
+
+void BoneHierarchy::_updateDependent(std::size_t i, bool flipX, bool flipY)
+{
+    // The inheriting branches of `Bone::_updateGlobalTransformMatrix` but the rotation and the scale both.
+    const auto parent = _parents[i];
+    const auto inherits = _inherits[i];
+    const auto& parentMatrix = _matrices[parent];
+    auto& global = _globals[i];
+    auto& matrix = _matrices[i];
+    auto rotation = 0.0f;
+
+    if (inherits & Inherit::Scale)
+    {
+        _updateGlobal(parent);
+        const auto& parentGlobal = _globals[parent];
+
+        if (flipX && flipY)
+        {
+            rotation = global.rotation - (parentGlobal.rotation + Transform::PI);
+        }
+        else if (flipX)
+        {
+            rotation = global.rotation + parentGlobal.rotation + Transform::PI;
+        }
+        else if (flipY)
+        {
+            rotation = global.rotation + parentGlobal.rotation;
+        }
+        else
+        {
+            rotation = global.rotation - parentGlobal.rotation;
+        }
+
+        global.rotation = rotation;
+        global.toMatrix(matrix);
+        matrix.concat(parentMatrix);
+
+        if (inherits & Inherit::Translation)
+        {
+            global.x = matrix.tx;
+            global.y = matrix.ty;
+        }
+        else
+        {
+            matrix.tx = global.x;
+            matrix.ty = global.y;
+        }
+
+        _globalDirty[i] = true;
+        return;
+    }
+
+    if (inherits & Inherit::Translation)
+    {
+        const auto x = global.x;
+        const auto y = global.y;
+        global.x = parentMatrix.a * x + parentMatrix.c * y + parentMatrix.tx;
+        global.y = parentMatrix.b * x + parentMatrix.d * y + parentMatrix.ty;
+    }
+    else
+    {
+        if (flipX)
+        {
+            global.x = -global.x;
+        }
+
+        if (flipY)
+        {
+            global.y = -global.y;
+        }
+    }
+
+    if (inherits & Inherit::Rotation)
+    {
+        _updateGlobal(parent);
+        const auto& parentGlobal = _globals[parent];
+
+        if (parentGlobal.scaleX < 0.0f)
+        {
+            rotation = global.rotation + parentGlobal.rotation + Transform::PI;
+        }
+        else
+        {
+            rotation = global.rotation + parentGlobal.rotation;
+        }
+
+        if (parentMatrix.a * parentMatrix.d - parentMatrix.b * parentMatrix.c < 0.0f)
+        {
+            rotation -= global.rotation * 2.0f;
+
+            if (flipX != flipY || (inherits & Inherit::Reflection))
+            {
+                global.skew += Transform::PI;
+            }
+        }
+
+        global.rotation = rotation;
+    }
+    else if (flipX || flipY)
+    {
+        if (flipX && flipY)
+        {
+            rotation = global.rotation + Transform::PI;
+        }
+        else
+        {
+            rotation = flipX ? Transform::PI - global.rotation : -global.rotation;
+            global.skew += Transform::PI;
+        }
+
+        global.rotation = rotation;
+    }
+
+    global.toMatrix(matrix);
+}
+
+void BoneHierarchy::_updateGlobal(std::size_t i)
+{
+    if (_globalDirty[i])
+    {
+        _globalDirty[i] = false;
+        _globals[i].fromMatrix(_matrices[i]);
+    }
+}
+
+void BoneHierarchy::_writeBack(std::size_t i) const
+{
+    const auto bone = _bones[i];
+    bone->global = _globals[i];
+    bone->globalTransformMatrix = _matrices[i];
+    bone->_globalDirty = _globalDirty[i] != 0;
+}
+
+void BoneHierarchy::_sinCos(const float* angles, float* sines, float* cosines, std::size_t count)
+{
+    std::size_t i = 0;
+#if defined(DRAGONBONES_HIERARCHY_SSE2) || defined(DRAGONBONES_HIERARCHY_NEON)
+    for (; i + Lanes::COUNT <= count; i += Lanes::COUNT)
+    {
+        Lanes::sinCos(angles + i, sines + i, cosines + i);
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        ::sinCos(angles[i], sines[i], cosines[i]);
+    }
+
+    for (i = 0; i < count; ++i)
+    {
+        if (!(std::abs(angles[i]) < MAX_ANGLE)) // Out of the range or NaN.
+        {
+            sines[i] = std::sin(angles[i]);
+            cosines[i] = std::cos(angles[i]);
+        }
+    }
+}
+
+DRAGONBONES_NAMESPACE_END
@@ -0,0 +1,118 @@
+#ifndef DRAGONBONES_BONEHIERARCHY_H
+#define DRAGONBONES_BONEHIERARCHY_H
+
+#include "../core/DragonBones.h"
+#include "../geom/Matrix.h"
+#include "../geom/Transform.h"
+
+#include <cstdint>
+#include <vector>
+
+DRAGONBONES_NAMESPACE_BEGIN
+
+/**
+ * - The bones of an armature flattened into contiguous arrays, parents first.
+ * Evaluates the global transforms of the whole armature in one forward sweep
+ * instead of `Bone::update` bone by bone: the local transforms are gathered,
+ * the sines and cosines of all the bones are computed in one batch, then each
+ * matrix is concatenated with its parent's by index.
+ * The results are written back only to the bones observed from the outside:
+ * the parents of the slots, the bones of the weighted meshes and the constraints,
+ * and any bone looked up by `Armature::getBone`, see `Bone::_observed`.
+ *
+ * Used by `Armature::advanceTime` when the frame isn't cached and the armature
+ * has no constraints, otherwise the bones are updated one by one.
+ * @internal
+ */
+class BoneHierarchy
+{
+public:
+    /**
+     * - Disable to always update the bones one by one, e.g. to compare both paths.
+     */
+    static bool enabled;
+
+private:
+    enum Inherit : std::uint8_t
+    {
+        Translation = 1 << 0,
+        Rotation = 1 << 1,
+        Scale = 1 << 2,
+        Reflection = 1 << 3
+    };
+
+    enum class Kind : std::uint8_t
+    {
+        // doesn't inherit: the flips are applied to the local transform
+        Root,
+        // inherits the rotation and the scale: local matrix concatenated with the parent's
+        Concat,
+        // depends on the parent's global rotation or scale, evaluated by `Transform::toMatrix`
+        Dependent
+    };
+
+    bool _refresh;
+    // the bones' globals are newer than the unobserved bones
+    bool _stale;
+    // in the topological order
+    std::vector<Bone*> _bones;
+    std::vector<std::int32_t> _parents;
+    std::vector<std::uint8_t> _inherits;
+    std::vector<Kind> _kinds;
+    std::vector<std::uint8_t> _dirty;
+    std::vector<std::uint8_t> _observed;
+    std::vector<std::uint8_t> _globalDirty;
+    std::vector<Transform> _globals;
+    std::vector<Matrix> _matrices;
+    // two per bone: rotation and `skew + rotation`, computed for all the bones at once
+    std::vector<float> _angles;
+    std::vector<float> _sines;
+    std::vector<float> _cosines;
+
+public:
+    BoneHierarchy() :
+        _refresh(true),
+        _stale(false)
+    {
+    }
+
+    /**
+     * - Forget the bones, rebuilt by the next `update`.
+     */
+    void clear();
+    /**
+     * - Update the bones of the armature, the same as `Bone::update(-1)` for each bone.
+     * @param flipY - Whether the global Y axis is flipped, see `Bone::_updateGlobalTransformMatrix`.
+     */
+    void update(const std::vector<Bone*>& bones, bool flipX, bool flipY);
+    /**
+     * - The bones are about to be updated one by one: write back the unobserved bones
+     * and evaluate all of them by the next `update`.
+     */
+    void invalidate();
+    /**
+     * - The bone is read from the outside from now on: write back its transform,
+     * left stale by the sweeps while it wasn't observed.
+     */
+    void observe(Bone* bone) const;
+    inline std::size_t getBoneCount() const
+    {
+        return _bones.size();
+    }
+
+private:
+    void _build(const std::vector<Bone*>& bones);
+    void _gather(bool flipX, bool flipY);
+    void _sweep(bool flipX, bool flipY);
+    void _updateDependent(std::size_t i, bool flipX, bool flipY);
+    void _updateGlobal(std::size_t i);
+    void _writeBack(std::size_t i) const;
+    /**
+     * - The sines and the cosines of the angles, 4 at once with SSE2 or NEON.
+     */
+    static void _sinCos(const float* angles, float* sines, float* cosines, std::size_t count);
+};
+
+DRAGONBONES_NAMESPACE_END
+
+#endif // DRAGONBONES_BONEHIERARCHY_H
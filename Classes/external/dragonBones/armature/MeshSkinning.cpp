@@ -0,0 +1,449 @@
+#include "MeshSkinning.h"
+#include "Bone.h"
+#include "../model/DragonBonesData.h"
+#include "../model/DisplayData.h"
+
+#include <algorithm>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DRAGONBONES_SKINNING_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define DRAGONBONES_SKINNING_NEON
+#include <arm_neon.h>
+#else
+// without vector instructions the blocks are slower than the scalar loop
+#define DRAGONBONES_SKINNING_SCALAR
+#endif
+
+namespace {
+
+// a copied bone matrix: a, b, c, d, tx, ty and the padding
+constexpr std::size_t MATRIX_STRIDE = 8;
+
+#if defined(__AVX2__)
+
+struct Lanes
+{
+    static constexpr std::size_t COUNT = 8;
+    using Vector = __m256;
+
+    static Vector set(float value) { return _mm256_set1_ps(value); }
+    static Vector load(const float* values) { return _mm256_loadu_ps(values); }
+    static void store(float* values, Vector value) { _mm256_storeu_ps(values, value); }
+    static Vector add(Vector lhs, Vector rhs) { return _mm256_add_ps(lhs, rhs); }
+    static Vector mul(Vector lhs, Vector rhs) { return _mm256_mul_ps(lhs, rhs); }
+    static Vector min(Vector lhs, Vector rhs) { return _mm256_min_ps(lhs, rhs); }
+    static Vector max(Vector lhs, Vector rhs) { return _mm256_max_ps(lhs, rhs); }
+
+    static void gatherMatrices(const float* matrices, const std::int32_t* indices, Vector* rows)
+    {
+        // hardware gathers are slower than the loads and the transposes of both halves
+        for (std::size_t half = 0; half < 2; ++half)
+        {
+            const auto offset = half * 4;
+            const auto load = [&](std::size_t lane) {
+                return _mm256_insertf128_ps(
+                    _mm256_castps128_ps256(_mm_loadu_ps(matrices + indices[lane] * MATRIX_STRIDE + offset)),
+                    _mm_loadu_ps(matrices + indices[lane + 4] * MATRIX_STRIDE + offset),
+                    1
+                );
+            };
+            const auto r0 = load(0), r1 = load(1), r2 = load(2), r3 = load(3);
+            const auto t0 = _mm256_unpacklo_ps(r0, r1);
+            const auto t1 = _mm256_unpacklo_ps(r2, r3);
+            rows[offset] = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0));
+            rows[offset + 1] = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2));
+            if (half == 0)
+            {
+                const auto t2 = _mm256_unpackhi_ps(r0, r1);
+                const auto t3 = _mm256_unpackhi_ps(r2, r3);
+                rows[2] = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0));
+                rows[3] = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(3, 2, 3, 2));
+            }
+        }
+    }
+
+    static void gatherPairs(const float* pairs, const std::int32_t* indices, Vector& x, Vector& y)
+    {
+        const auto load = [&](std::size_t lane) {
+            const auto pair = _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(pairs + indices[lane]));
+            return _mm_loadh_pi(pair, reinterpret_cast<const __m64*>(pairs + indices[lane + 1]));
+        };
+        const auto p0 = _mm256_insertf128_ps(_mm256_castps128_ps256(load(0)), load(4), 1);
+        const auto p1 = _mm256_insertf128_ps(_mm256_castps128_ps256(load(2)), load(6), 1);
+        x = _mm256_shuffle_ps(p0, p1, _MM_SHUFFLE(2, 0, 2, 0));
+        y = _mm256_shuffle_ps(p0, p1, _MM_SHUFFLE(3, 1, 3, 1));
+    }
+};
+
+#elif defined(DRAGONBONES_SKINNING_SSE2)
+
+struct Lanes
+{
+    static constexpr std::size_t COUNT = 4;
+    using Vector = __m128;
+
+    static Vector set(float value) { return _mm_set1_ps(value); }
+    static Vector load(const float* values) { return _mm_loadu_ps(values); }
+    static void store(float* values, Vector value) { _mm_storeu_ps(values, value); }
+    static Vector add(Vector lhs, Vector rhs) { return _mm_add_ps(lhs, rhs); }
+    static Vector mul(Vector lhs, Vector rhs) { return _mm_mul_ps(lhs, rhs); }
+    static Vector min(Vector lhs, Vector rhs) { return _mm_min_ps(lhs, rhs); }
+    static Vector max(Vector lhs, Vector rhs) { return _mm_max_ps(lhs, rhs); }
+
+    static void gatherMatrices(const float* matrices, const std::int32_t* indices, Vector* rows)
+    {
+        auto r0 = _mm_loadu_ps(matrices + indices[0] * MATRIX_STRIDE);
+        auto r1 = _mm_loadu_ps(matrices + indices[1] * MATRIX_STRIDE);
+        auto r2 = _mm_loadu_ps(matrices + indices[2] * MATRIX_STRIDE);
+        auto r3 = _mm_loadu_ps(matrices + indices[3] * MATRIX_STRIDE);
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        rows[0] = r0;
+        rows[1] = r1;
+        rows[2] = r2;
+        rows[3] = r3;
+
+        auto t0 = _mm_loadu_ps(matrices + indices[0] * MATRIX_STRIDE + 4);
+        auto t1 = _mm_loadu_ps(matrices + indices[1] * MATRIX_STRIDE + 4);
+        auto t2 = _mm_loadu_ps(matrices + indices[2] * MATRIX_STRIDE + 4);
+        auto t3 = _mm_loadu_ps(matrices + indices[3] * MATRIX_STRIDE + 4);
+        _MM_TRANSPOSE4_PS(t0, t1, t2, t3);
+        rows[4] = t0;
+        rows[5] = t1;
+    }
+
+    static void gatherPairs(const float* pairs, const std::int32_t* indices, Vector& x, Vector& y)
+    {
+        auto p01 = _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(pairs + indices[0]));
+        p01 = _mm_loadh_pi(p01, reinterpret_cast<const __m64*>(pairs + indices[1]));
+        auto p23 = _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(pairs + indices[2]));
+        p23 = _mm_loadh_pi(p23, reinterpret_cast<const __m64*>(pairs + indices[3]));
+        x = _mm_shuffle_ps(p01, p23, _MM_SHUFFLE(2, 0, 2, 0));
+        y = _mm_shuffle_ps(p01, p23, _MM_SHUFFLE(3, 1, 3, 1));
+    }
+};
+
+#elif defined(DRAGONBONES_SKINNING_NEON)
+
+struct Lanes
+{
+    static constexpr std::size_t COUNT = 4;
+    using Vector = float32x4_t;
+
+    static Vector set(float value) { return vdupq_n_f32(value); }
+    static Vector load(const float* values) { return vld1q_f32(values); }
+    static void store(float* values, Vector value) { vst1q_f32(values, value); }
+    // not fused: the result matches the scalar path
+    static Vector add(Vector lhs, Vector rhs) { return vaddq_f32(lhs, rhs); }
+    static Vector mul(Vector lhs, Vector rhs) { return vmulq_f32(lhs, rhs); }
+    static Vector min(Vector lhs, Vector rhs) { return vminq_f32(lhs, rhs); }
+    static Vector max(Vector lhs, Vector rhs) { return vmaxq_f32(lhs, rhs); }
+
+    static void gatherMatrices(const float* matrices, const std::int32_t* indices, Vector* rows)
+    {
+        for (std::size_t half = 0; half < 2; ++half)
+        {
+            const auto offset = half * 4;
+            const auto r01 = vtrnq_f32(
+                vld1q_f32(matrices + indices[0] * MATRIX_STRIDE + offset),
+                vld1q_f32(matrices + indices[1] * MATRIX_STRIDE + offset)
+            );
+            const auto r23 = vtrnq_f32(
+                vld1q_f32(matrices + indices[2] * MATRIX_STRIDE + offset),
+                vld1q_f32(matrices + indices[3] * MATRIX_STRIDE + offset)
+            );
+            rows[offset] = vcombine_f32(vget_low_f32(r01.val[0]), vget_low_f32(r23.val[0]));
+            rows[offset + 1] = vcombine_f32(vget_low_f32(r01.val[1]), vget_low_f32(r23.val[1]));
+            if (half == 0)
+            {
+                rows[2] = vcombine_f32(vget_high_f32(r01.val[0]), vget_high_f32(r23.val[0]));
+                rows[3] = vcombine_f32(vget_high_f32(r01.val[1]), vget_high_f32(r23.val[1]));
+            }
+        }
+    }
+
+    static void gatherPairs(const float* pairs, const std::int32_t* indices, Vector& x, Vector& y)
+    {
+        const auto p01 = vcombine_f32(vld1_f32(pairs + indices[0]), vld1_f32(pairs + indices[1]));
+        const auto p23 = vcombine_f32(vld1_f32(pairs + indices[2]), vld1_f32(pairs + indices[3]));
+        const auto xy = vuzpq_f32(p01, p23);
+        x = xy.val[0];
+        y = xy.val[1];
+    }
+};
+
+#endif
+
+unsigned getWeightFloatOffset(const dragonBones::WeightData& weightData, const std::int16_t* intArray)
+{
+    int weightFloatOffset = intArray[weightData.offset + (unsigned)dragonBones::BinaryOffset::WeigthFloatOffset];
+    if (weightFloatOffset < 0)
+    {
+        weightFloatOffset += 65536; // Fixed out of bouds bug.
+    }
+
+    return (unsigned)weightFloatOffset;
+}
+
+} // namespace {
+
+DRAGONBONES_NAMESPACE_BEGIN
+
+#if defined(DRAGONBONES_SKINNING_SCALAR)
+const std::size_t MeshSkinning::LANES = 1;
+#else
+const std::size_t MeshSkinning::LANES = Lanes::COUNT;
+#endif
+
+void SkinningLayout::init(const VerticesData& verticesData)
+{
+    const auto weightData = verticesData.weight;
+    const auto intArray = verticesData.data->intArray;
+    const auto floatArray = verticesData.data->floatArray;
+    const auto boneCount = weightData->bones.size();
+    const auto lanes = MeshSkinning::LANES;
+
+    struct Vertex
+    {
+        std::size_t boneIndex; // in the int array
+        std::size_t floatIndex;
+        std::size_t deformIndex;
+        std::size_t influenceCount;
+    };
+    vertexCount = MeshSkinning::getVertexCount(verticesData);
+    std::vector<Vertex> vertices(vertexCount);
+    for (
+        std::size_t i = 0, iB = weightData->offset + (unsigned)BinaryOffset::WeigthBoneIndices + boneCount, iV = getWeightFloatOffset(*weightData, intArray), iF = 0;
+        i < vertexCount;
+        ++i
+    )
+    {
+        auto& vertex = vertices[i];
+        vertex.influenceCount = (std::size_t)intArray[iB++];
+        vertex.boneIndex = iB;
+        vertex.floatIndex = iV;
+        vertex.deformIndex = iF;
+        iB += vertex.influenceCount;
+        iV += vertex.influenceCount * 3;
+        iF += vertex.influenceCount * 2;
+    }
+
+    const auto blockCount = (vertexCount + lanes - 1) / lanes;
+    std::vector<std::int32_t> order(vertexCount);
+    for (std::size_t i = 0; i < vertexCount; ++i)
+    {
+        order[i] = (std::int32_t)i;
+    }
+
+    std::stable_sort(order.begin(), order.end(), [&vertices](std::int32_t lhs, std::int32_t rhs) {
+        return vertices[lhs].influenceCount < vertices[rhs].influenceCount;
+    });
+    vertexIndices.resize(blockCount * lanes);
+    for (std::size_t i = 0; i < vertexIndices.size(); ++i)
+    {
+        vertexIndices[i] = order[std::min(i, vertexCount - 1)];
+    }
+
+    firstInfluence.assign(blockCount + 1, 0);
+    for (std::size_t block = 0; block < blockCount; ++block)
+    {
+        // sorted: the last lane has the most influences
+        const auto last = vertexIndices[block * lanes + lanes - 1];
+        firstInfluence[block + 1] = firstInfluence[block] + (unsigned)vertices[last].influenceCount;
+    }
+
+    const auto size = (std::size_t)firstInfluence.back() * lanes;
+    boneIndices.assign(size, (std::int32_t)boneCount);
+    deformIndices.assign(size, 0);
+    weights.assign(size, 0.0f);
+    xs.assign(size, 0.0f);
+    ys.assign(size, 0.0f);
+    for (std::size_t block = 0; block < blockCount; ++block)
+    {
+        for (std::size_t lane = 0; lane < lanes; ++lane)
+        {
+            const auto& vertex = vertices[vertexIndices[block * lanes + lane]];
+            for (std::size_t j = 0; j < vertex.influenceCount; ++j)
+            {
+                const auto k = (firstInfluence[block] + j) * lanes + lane;
+                const auto iV = vertex.floatIndex + j * 3;
+                boneIndices[k] = intArray[vertex.boneIndex + j];
+                deformIndices[k] = (std::int32_t)(vertex.deformIndex + j * 2);
+                weights[k] = floatArray[iV];
+                xs[k] = floatArray[iV + 1];
+                ys[k] = floatArray[iV + 2];
+            }
+        }
+    }
+}
+
+void MeshSkinning::skin(
+    const VerticesData& verticesData, const std::vector<Bone*>& bones, const std::vector<float>& deformVertices,
+    float scale, float* positions, float* bounds
+)
+{
+#if defined(DRAGONBONES_SKINNING_SCALAR)
+    skinScalar(verticesData, bones, deformVertices, scale, positions, bounds);
+#else
+    const auto weightData = verticesData.weight;
+    // a missing bone shifts the following influences (see `skinScalar`)
+    const auto isComplete = std::none_of(bones.cbegin(), bones.cend(), [](const Bone* bone) {
+        return bone == nullptr;
+    });
+    if (!isComplete || bones.size() != weightData->bones.size())
+    {
+        skinScalar(verticesData, bones, deformVertices, scale, positions, bounds);
+        return;
+    }
+
+    if (weightData->skinning == nullptr)
+    {
+        weightData->skinning = new SkinningLayout();
+        weightData->skinning->init(verticesData);
+    }
+
+    const auto& layout = *weightData->skinning;
+    if (layout.vertexCount == 0)
+    {
+        return;
+    }
+
+    // with the zero matrix at `bones.size()` for the padding
+    static thread_local std::vector<float> matrices;
+    matrices.assign((bones.size() + 1) * MATRIX_STRIDE, 0.0f);
+    for (std::size_t i = 0, l = bones.size(); i < l; ++i)
+    {
+        const auto& matrix = bones[i]->globalTransformMatrix;
+        const auto copy = matrices.data() + i * MATRIX_STRIDE;
+        copy[0] = matrix.a;
+        copy[1] = matrix.b;
+        copy[2] = matrix.c;
+        copy[3] = matrix.d;
+        copy[4] = matrix.tx;
+        copy[5] = matrix.ty;
+    }
+
+    const auto hasFFD = !deformVertices.empty();
+    const auto scales = Lanes::set(scale);
+    const auto zero = Lanes::set(0.0f);
+
+    auto minX = Lanes::set(bounds[0]);
+    auto minY = Lanes::set(bounds[1]);
+    auto maxX = Lanes::set(bounds[2]);
+    auto maxY = Lanes::set(bounds[3]);
+    float xG[Lanes::COUNT];
+    float yG[Lanes::COUNT];
+    Lanes::Vector rows[6];
+    for (std::size_t block = 0, l = layout.firstInfluence.size() - 1; block < l; ++block)
+    {
+        auto x = zero;
+        auto y = zero;
+        for (auto k = layout.firstInfluence[block]; k < layout.firstInfluence[block + 1]; ++k)
+        {
+            const auto offset = (std::size_t)k * Lanes::COUNT;
+            auto xL = Lanes::mul(Lanes::load(layout.xs.data() + offset), scales);
+            auto yL = Lanes::mul(Lanes::load(layout.ys.data() + offset), scales);
+            if (hasFFD)
+            {
+                Lanes::Vector xD, yD;
+                Lanes::gatherPairs(deformVertices.data(), layout.deformIndices.data() + offset, xD, yD);
+                xL = Lanes::add(xL, xD);
+                yL = Lanes::add(yL, yD);
+            }
+
+            // the same order of operations as the scalar path
+            Lanes::gatherMatrices(matrices.data(), layout.boneIndices.data() + offset, rows);
+            const auto weight = Lanes::load(layout.weights.data() + offset);
+            const auto xM = Lanes::add(Lanes::add(Lanes::mul(rows[0], xL), Lanes::mul(rows[2], yL)), rows[4]);
+            const auto yM = Lanes::add(Lanes::add(Lanes::mul(rows[1], xL), Lanes::mul(rows[3], yL)), rows[5]);
+            x = Lanes::add(x, Lanes::mul(xM, weight));
+            y = Lanes::add(y, Lanes::mul(yM, weight));
+        }
+
+        minX = Lanes::min(minX, x);
+        minY = Lanes::min(minY, y);
+        maxX = Lanes::max(maxX, x);
+        maxY = Lanes::max(maxY, y);
+
+        // the padding lanes rewrite the same values
+        Lanes::store(xG, x);
+        Lanes::store(yG, y);
+        const auto vertexIndices = layout.vertexIndices.data() + block * Lanes::COUNT;
+        for (std::size_t lane = 0; lane < Lanes::COUNT; ++lane)
+        {
+            positions[vertexIndices[lane] * 2] = xG[lane];
+            positions[vertexIndices[lane] * 2 + 1] = yG[lane];
+        }
+    }
+
+    float values[Lanes::COUNT];
+    Lanes::store(values, minX);
+    bounds[0] = *std::min_element(values, values + Lanes::COUNT);
+    Lanes::store(values, minY);
+    bounds[1] = *std::min_element(values, values + Lanes::COUNT);
+    Lanes::store(values, maxX);
+    bounds[2] = *std::max_element(values, values + Lanes::COUNT);
+    Lanes::store(values, maxY);
+    bounds[3] = *std::max_element(values, values + Lanes::COUNT);
+#endif
+}
+
+void MeshSkinning::skinScalar(
+    const VerticesData& verticesData, const std::vector<Bone*>& bones, const std::vector<float>& deformVertices,
+    float scale, float* positions, float* bounds
+)
+{
+    const auto weightData = verticesData.weight;
+    const auto intArray = verticesData.data->intArray;
+    const auto floatArray = verticesData.data->floatArray;
+    const auto vertexCount = getVertexCount(verticesData);
+    const auto hasFFD = !deformVertices.empty();
+
+    for (
+        std::size_t i = 0, iB = weightData->offset + (unsigned)BinaryOffset::WeigthBoneIndices + bones.size(), iV = getWeightFloatOffset(*weightData, intArray), iF = 0;
+        i < vertexCount;
+        ++i
+    )
+    {
+        const auto boneCount = (std::size_t)intArray[iB++];
+        auto xG = 0.0f, yG = 0.0f;
+        for (std::size_t j = 0; j < boneCount; ++j)
+        {
+            const auto boneIndex = (unsigned)intArray[iB++];
+            const auto bone = bones[boneIndex];
+            if (bone != nullptr)
+            {
+                const auto& matrix = bone->globalTransformMatrix;
+                const auto weight = floatArray[iV++];
+                auto xL = floatArray[iV++] * scale;
+                auto yL = floatArray[iV++] * scale;
+
+                if (hasFFD)
+                {
+                    xL += deformVertices[iF++];
+                    yL += deformVertices[iF++];
+                }
+
+                xG += (matrix.a * xL + matrix.c * yL + matrix.tx) * weight;
+                yG += (matrix.b * xL + matrix.d * yL + matrix.ty) * weight;
+            }
+        }
+
+        positions[i * 2] = xG;
+        positions[i * 2 + 1] = yG;
+        bounds[0] = std::min(bounds[0], xG);
+        bounds[1] = std::min(bounds[1], yG);
+        bounds[2] = std::max(bounds[2], xG);
+        bounds[3] = std::max(bounds[3], yG);
+    }
+}
+
+std::size_t MeshSkinning::getVertexCount(const VerticesData& verticesData)
+{
+    return (std::size_t)verticesData.data->intArray[verticesData.offset + (unsigned)BinaryOffset::MeshVertexCount];
+}
+
+DRAGONBONES_NAMESPACE_END
@@ -0,0 +1,81 @@
+#ifndef DRAGONBONES_MESHSKINNING_H
+#define DRAGONBONES_MESHSKINNING_H
+
+#include "../core/DragonBones.h"
+
+#include <cstdint>
+#include <vector>
+
+DRAGONBONES_NAMESPACE_BEGIN
+
+/**
+ * - The vertices of the weighted mesh rearranged for the blocks of `MeshSkinning`.
+ * Built once per weight data, see `WeightData::skinning`.
+ * @internal
+ */
+class SkinningLayout
+{
+public:
+    std::size_t vertexCount;
+    // the vertex of the lane; sorted by the number of influences, so the blocks need little padding.
+    // The lanes after the last vertex repeat a vertex of the block: same result, same bounds
+    std::vector<std::int32_t> vertexIndices;
+    // influences of the block `i` are [firstInfluence[i], firstInfluence[i + 1]), each `MeshSkinning::LANES` wide
+    std::vector<unsigned> firstInfluence;
+    // index in the slot's bones; `bones.size()` pads the vertices with fewer influences (zero matrix)
+    std::vector<std::int32_t> boneIndices;
+    // index of `x` in the deform vertices
+    std::vector<std::int32_t> deformIndices;
+    std::vector<float> weights;
+    std::vector<float> xs;
+    std::vector<float> ys;
+
+    SkinningLayout() :
+        vertexCount(0)
+    {
+    }
+
+    void init(const VerticesData& verticesData);
+};
+/**
+ * - Skinning of the weighted mesh vertices.
+ * The vertices are processed in blocks of `LANES`, one lane per vertex: the influences
+ * of a block are stored influence-major by `SkinningLayout`, so the weights and the local
+ * positions are contiguous. The bone matrices are copied once per call and transposed
+ * into the lanes by the gather.
+ * The block width and the instructions are chosen at compile time:
+ * AVX2 (8 lanes, with `-mavx2`, see `DRAGONBONES_SKINNING_AVX2`), SSE2 or NEON (4 lanes),
+ * otherwise `skin` is the scalar path.
+ * @internal
+ */
+class MeshSkinning
+{
+public:
+    static const std::size_t LANES;
+
+    /**
+     * - Skin the vertices: write `(x, y)` pairs in the armature space and their bounds.
+     * Falls back to `skinScalar` when a bone of the mesh is missing in the armature.
+     * @param positions - `2 * vertexCount` values.
+     * @param bounds - `[minX, minY, maxX, maxY]`, extended by the vertices.
+     */
+    static void skin(
+        const VerticesData& verticesData, const std::vector<Bone*>& bones, const std::vector<float>& deformVertices,
+        float scale, float* positions, float* bounds
+    );
+    /**
+     * - The reference implementation, vertex by vertex.
+     */
+    static void skinScalar(
+        const VerticesData& verticesData, const std::vector<Bone*>& bones, const std::vector<float>& deformVertices,
+        float scale, float* positions, float* bounds
+    );
+    /**
+     * - Number of the vertices of the weighted mesh.
+     */
+    static std::size_t getVertexCount(const VerticesData& verticesData);
+};
+
+DRAGONBONES_NAMESPACE_END
+
+#endif // DRAGONBONES_MESHSKINNING_H
@@ -83,7 +83,8 @@ public:
      */
     inline virtual bool hasDBEventListener(const std::string& type) const override
     {
-        return _dispatcher->isEnabled();
+        // events are buffered only for the types someone listens to
+        return _dispatcher->isEnabled() && _dispatcher->hasEventListener(type);
     }
     /**
      * @inheritDoc
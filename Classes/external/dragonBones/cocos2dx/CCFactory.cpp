@@ -150,11 +150,22 @@ DragonBonesData* CCFactory::loadDragonBonesData(const std::string& filePath, con
             cocos2d::Data cocos2dData;
             cocos2d::FileUtils::getInstance()->getContents(fullpath, &cocos2dData);
 #else
-            const auto cocos2dData = cocos2d::FileUtils::getInstance()->getDataFromFile(fullpath);
+            auto cocos2dData = cocos2d::FileUtils::getInstance()->getDataFromFile(fullpath);
 #endif
-            const auto binary = (unsigned char*)malloc(sizeof(unsigned char)* cocos2dData.getSize());
-            memcpy(binary, cocos2dData.getBytes(), cocos2dData.getSize());
+            // The parsed data refers to the arrays right in the file's buffer and frees it on clear,
+            // so the buffer is taken from the cocos2d::Data without a copy.
+            ssize_t size = 0;
+            const auto binary = cocos2dData.takeBuffer(&size);
+            if (binary == nullptr)
+            {
+                return nullptr;
+            }
+
             const auto data = parseDragonBonesData((char*)binary, name, scale);
+            if (data == nullptr)
+            {
+                free(binary);
+            }
 
             return data;
         }
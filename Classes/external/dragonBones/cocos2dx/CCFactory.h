@@ -210,6 +210,16 @@ public:
     {
         return _dragonBonesInstance->getClock();
     }
+
+	// \update
+	// \brief gives access to the shared instance so the clock can be driven
+	//	manually (e.g. by the headless runner with a fixed time step)
+	//	instead of the scheduled "dragonBonesClock" callback.
+	// \author Roout
+    static DragonBones* getInstance()
+    {
+        return _dragonBonesInstance;
+    }
 };
 
 DRAGONBONES_NAMESPACE_END
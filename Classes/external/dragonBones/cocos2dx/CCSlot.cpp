@@ -1,6 +1,7 @@
 #include "CCSlot.h"
 #include "CCTextureAtlasData.h"
 #include "CCArmatureDisplay.h"
+#include "../armature/MeshSkinning.h"
 
 DRAGONBONES_NAMESPACE_BEGIN
 
@@ -215,72 +216,23 @@ void CCSlot::_updateMesh()
 
     if (weightData != nullptr)
     {
-        const auto data = verticesData->data;
-        const auto intArray = data->intArray;
-        const auto floatArray = data->floatArray;
-        const auto vertexCount = (std::size_t)intArray[verticesData->offset + (unsigned)BinaryOffset::MeshVertexCount];
-        int weightFloatOffset = intArray[weightData->offset + (unsigned)BinaryOffset::WeigthFloatOffset];
-
-        if (weightFloatOffset < 0)
+        const auto vertexCount = MeshSkinning::getVertexCount(*verticesData);
+        // the slots are updated on the main thread only
+        static std::vector<float> positions;
+        positions.resize(vertexCount * 2);
+        float bounds[] = { 999999.0f, 999999.0f, -999999.0f, -999999.0f };
+        MeshSkinning::skin(*verticesData, bones, deformVertices, scale, positions.data(), bounds);
+
+        for (std::size_t i = 0; i < vertexCount; ++i)
         {
-            weightFloatOffset += 65536; // Fixed out of bouds bug. 
+            vertices[i].vertices.set(positions[i * 2], -positions[i * 2 + 1], 0.0f);
         }
 
-        for (
-            std::size_t i = 0, iB = weightData->offset + (unsigned)BinaryOffset::WeigthBoneIndices + bones.size(), iV = (std::size_t)weightFloatOffset, iF = 0;
-            i < vertexCount;
-            ++i
-        )
-        {
-            const auto boneCount = (std::size_t)intArray[iB++];
-            auto xG = 0.0f, yG = 0.0f;
-            for (std::size_t j = 0; j < boneCount; ++j)
-            {
-                const auto boneIndex = (unsigned)intArray[iB++];
-                const auto bone = bones[boneIndex];
-                if (bone != nullptr) 
-                {
-                    const auto& matrix = bone->globalTransformMatrix;
-                    const auto weight = floatArray[iV++];
-                    auto xL = floatArray[iV++] * scale;
-                    auto yL = floatArray[iV++] * scale;
-
-                    if (hasFFD) 
-                    {
-                        xL += deformVertices[iF++];
-                        yL += deformVertices[iF++];
-                    }
-
-                    xG += (matrix.a * xL + matrix.c * yL + matrix.tx) * weight;
-                    yG += (matrix.b * xL + matrix.d * yL + matrix.ty) * weight;
-                }
-            }
-
-            auto& vertex = vertices[i];
-            auto& vertexPosition = vertex.vertices;
-
-            vertexPosition.set(xG, -yG, 0.0f);
-
-            if (boundsRect.origin.x > xG)
-            {
-                boundsRect.origin.x = xG;
-            }
-
-            if (boundsRect.size.width < xG)
-            {
-                boundsRect.size.width = xG;
-            }
-
-            if (boundsRect.origin.y > -yG)
-            {
-                boundsRect.origin.y = -yG;
-            }
-
-            if (boundsRect.size.height < -yG)
-            {
-                boundsRect.size.height = -yG;
-            }
-        }
+        // the display's y is flipped
+        boundsRect.origin.x = bounds[0];
+        boundsRect.size.width = bounds[2];
+        boundsRect.origin.y = -bounds[3];
+        boundsRect.size.height = -bounds[1];
     }
     else if (hasFFD)
     {
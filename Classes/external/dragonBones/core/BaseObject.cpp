@@ -1,114 +1,331 @@
 #include "BaseObject.h"
+
+#include <algorithm>
+
 DRAGONBONES_NAMESPACE_BEGIN
 
-unsigned BaseObject::_hashCode = 0;
+/**
+ * - The local pools of the thread: moved to the pools of their classes when the thread exits.
+ * The local pools themselves are trivially destructible, so the objects returned later,
+ * e.g. by the destructors of the static objects, are just kept by them.
+ * @internal
+ */
+class BaseObject::ThreadLocals
+{
+public:
+    LocalPool* head = nullptr;
+
+    ~ThreadLocals()
+    {
+        for (auto local = head; local != nullptr; local = local->_nextLocal)
+        {
+            auto& pool = *local->_pool;
+            std::lock_guard<std::mutex> lock(pool._mutex);
+            while (local->_head != nullptr)
+            {
+                const auto object = local->_head;
+                local->_head = object->_nextInPool;
+                object->_nextInPool = pool._head;
+                pool._head = object;
+                pool._count++;
+            }
+
+            pool._live += local->_live.load(std::memory_order_relaxed);
+            local->_count.store(0, std::memory_order_relaxed);
+            local->_live.store(0, std::memory_order_relaxed);
+            pool._locals.erase(std::find(pool._locals.begin(), pool._locals.end(), local));
+        }
+    }
+
+    static ThreadLocals& get()
+    {
+        static thread_local ThreadLocals locals;
+        return locals;
+    }
+};
+
+std::atomic<unsigned> BaseObject::_hashCode { 0 };
 unsigned BaseObject::_defaultMaxCount = 3000;
+std::mutex BaseObject::_poolMutex;
 std::map<std::size_t, unsigned> BaseObject::_maxCountMap;
-std::map<std::size_t, std::vector<BaseObject*>> BaseObject::_poolsMap;
+std::vector<BaseObject::Pool*> BaseObject::_pools;
 
-void BaseObject::_returnObject(BaseObject* object)
+BaseObject::Pool::Pool(std::size_t classTypeIndex, const char* name, const char* liveCounter, const char* pooledCounter) :
+    classTypeIndex(classTypeIndex),
+    name(name),
+    liveCounter(liveCounter),
+    pooledCounter(pooledCounter),
+    _head(nullptr),
+    _count(0),
+    _live(0),
+    _maxCount(0),
+    _chunk(nullptr),
+    _chunkLeft(0),
+    _vacant(nullptr)
 {
-    const auto classType = object->getClassTypeIndex();
-    const auto maxCountIterator = _maxCountMap.find(classType);
-    const auto maxCount = maxCountIterator != _maxCountMap.end() ? maxCountIterator->second : _defaultMaxCount;
-    auto& pool = _poolsMap[classType];
-    if (pool.size() < maxCount)
+    std::lock_guard<std::mutex> lock(BaseObject::_poolMutex);
+    const auto iterator = BaseObject::_maxCountMap.find(classTypeIndex);
+    _maxCount = iterator != BaseObject::_maxCountMap.end() ? iterator->second : BaseObject::_defaultMaxCount;
+    BaseObject::_pools.push_back(this);
+}
+
+void BaseObject::_registerLocal(Pool& pool, LocalPool& local)
+{
+    auto& locals = ThreadLocals::get();
     {
-        if (!object->_isInPool)
+        std::lock_guard<std::mutex> lock(pool._mutex);
+        pool._locals.push_back(&local);
+    }
+
+    local._pool = &pool;
+    local._nextLocal = locals.head;
+    locals.head = &local;
+}
+
+void BaseObject::_flushLocal(LocalPool& local, int keep)
+{
+    std::vector<BaseObject*> removed;
+    {
+        auto& pool = *local._pool;
+        std::lock_guard<std::mutex> lock(pool._mutex);
+        for (auto count = local._count.load(std::memory_order_relaxed); count > keep; count--)
         {
-            object->_isInPool = true;
-            pool.push_back(object);
+            const auto object = local._head;
+            local._head = object->_nextInPool;
+            _add(local._count, -1);
+            if (pool._count < pool._maxCount)
+            {
+                object->_nextInPool = pool._head;
+                pool._head = object;
+                pool._count++;
+            }
+            else
+            {
+                object->_nextInPool = nullptr;
+                removed.push_back(object);
+            }
         }
-        else
+    }
+    // destructors may return other objects to the pools, so destroy without the lock
+    for (const auto object : removed)
+    {
+        _destroyObject(object);
+    }
+}
+
+void BaseObject::_refillLocal(LocalPool& local)
+{
+    auto& pool = *local._pool;
+    std::lock_guard<std::mutex> lock(pool._mutex);
+    for (int i = 0; i < LOCAL_BATCH && pool._head != nullptr; ++i)
+    {
+        const auto object = pool._head;
+        pool._head = object->_nextInPool;
+        pool._count--;
+        object->_nextInPool = local._head;
+        local._head = object;
+        _add(local._count, 1);
+    }
+}
+
+void* BaseObject::_allocate(Pool& pool, std::size_t size, std::size_t alignment)
+{
+    if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__ || size % alignment != 0)
+    {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(pool._mutex);
+    if (pool._vacant != nullptr)
+    {
+        const auto storage = pool._vacant;
+        pool._vacant = *static_cast<void**>(storage);
+        return storage;
+    }
+
+    if (pool._chunkLeft == 0)
+    {
+        const auto chunk = static_cast<char*>(::operator new(size * SLAB_OBJECTS, std::nothrow));
+        if (chunk == nullptr)
         {
-            DRAGONBONES_ASSERT(false, "The object is already in the pool.");
+            return nullptr;
         }
+
+        pool._chunks.push_back(chunk);
+        pool._chunk = chunk;
+        pool._chunkLeft = SLAB_OBJECTS;
     }
-    else
+
+    const auto storage = pool._chunk;
+    pool._chunk += size;
+    pool._chunkLeft--;
+    return storage;
+}
+
+void BaseObject::_destroyObject(BaseObject* object)
+{
+    if (!object->_isInSlab)
     {
         delete object;
+        return;
     }
+
+    auto& pool = object->_getPool();
+    // the object is placed at the start of the storage
+    const auto storage = dynamic_cast<void*>(object);
+    object->~BaseObject();
+
+    std::lock_guard<std::mutex> lock(pool._mutex);
+    *static_cast<void**>(storage) = pool._vacant;
+    pool._vacant = storage;
 }
 
-void BaseObject::setMaxCount(std::size_t classType, unsigned maxCount)
+void BaseObject::_returnObject(BaseObject* object)
 {
-    if (classType > 0)
+    if (object->_isInPool)
+    {
+        DRAGONBONES_ASSERT(false, "The object is already in the pool.");
+        return;
+    }
+
+    auto& local = object->_getLocalPool();
+    if (object->_localPool == &local)
     {
-        const auto iterator = _poolsMap.find(classType);
-        if (iterator != _poolsMap.end())
+        object->_isInPool = true;
+        object->_nextInPool = local._head;
+        local._head = object;
+        _add(local._count, 1);
+        _add(local._live, -1);
+        if (local._count.load(std::memory_order_relaxed) > LOCAL_CAPACITY)
         {
-            auto& pool = iterator->second;
-            if (pool.size() > (size_t)maxCount)
-            {
-                for (auto i = (size_t)maxCount, l = pool.size(); i < l; ++i)
-                {
-                    delete pool[i];
-                }
+            _flushLocal(local, LOCAL_CAPACITY - LOCAL_BATCH);
+        }
 
-                pool.resize(maxCount);
-            }
+        return;
+    }
+    // borrowed by another thread
+    auto& pool = object->_getPool();
+    {
+        std::lock_guard<std::mutex> lock(pool._mutex);
+        pool._live--;
+        if (pool._count < pool._maxCount)
+        {
+            object->_isInPool = true;
+            object->_nextInPool = pool._head;
+            pool._head = object;
+            pool._count++;
+            return;
         }
+    }
+    // destructors may return other objects to the pool, so destroy without the lock
+    _destroyObject(object);
+}
 
-        _maxCountMap[classType] = maxCount;
+void BaseObject::_trimPool(Pool& pool, unsigned maxCount, std::vector<BaseObject*>& removed)
+{
+    std::lock_guard<std::mutex> lock(pool._mutex);
+    while (pool._count > maxCount)
+    {
+        const auto object = pool._head;
+        pool._head = object->_nextInPool;
+        pool._count--;
+        object->_nextInPool = nullptr;
+        removed.push_back(object);
+    }
+}
+
+void BaseObject::_flushLocals(std::size_t classType)
+{
+    // the objects cached by the other threads are left to them
+    for (auto local = ThreadLocals::get().head; local != nullptr; local = local->_nextLocal)
+    {
+        if (classType == 0 || local->_pool->classTypeIndex == classType)
+        {
+            _flushLocal(*local, 0);
+        }
     }
-    else
+}
+
+void BaseObject::setMaxCount(std::size_t classType, unsigned maxCount)
+{
+    _flushLocals(classType);
+    std::vector<BaseObject*> removed;
     {
-        _defaultMaxCount = maxCount;
-        for (auto& pair : _poolsMap)
+        std::lock_guard<std::mutex> lock(_poolMutex);
+        if (classType > 0)
         {
-            auto& pool = pair.second;
-            if (pool.size() > (size_t)maxCount)
+            for (const auto pool : _pools)
             {
-                for (auto i = (size_t)maxCount, l = pool.size(); i < l; ++i)
+                if (pool->classTypeIndex == classType)
                 {
-                    delete pool[i];
+                    _trimPool(*pool, maxCount, removed);
+                    std::lock_guard<std::mutex> poolLock(pool->_mutex);
+                    pool->_maxCount = maxCount;
                 }
+            }
 
-                pool.resize(maxCount);
+            _maxCountMap[classType] = maxCount;
+        }
+        else
+        {
+            _defaultMaxCount = maxCount;
+            for (const auto pool : _pools)
+            {
+                _trimPool(*pool, maxCount, removed);
+                std::lock_guard<std::mutex> poolLock(pool->_mutex);
+                pool->_maxCount = maxCount;
             }
 
-            if (_maxCountMap.find(pair.first) != _maxCountMap.end())
+            for (auto& pair : _maxCountMap)
             {
-                _maxCountMap[pair.first] = maxCount;
+                pair.second = maxCount;
             }
         }
     }
+
+    for (const auto object : removed)
+    {
+        _destroyObject(object);
+    }
 }
 
 void BaseObject::clearPool(std::size_t classType)
 {
-    if (classType > 0)
+    _flushLocals(classType);
+    std::vector<BaseObject*> removed;
     {
-        const auto iterator = _poolsMap.find(classType);
-        if (iterator != _poolsMap.end())
+        std::lock_guard<std::mutex> lock(_poolMutex);
+        for (const auto pool : _pools)
         {
-            auto& pool = iterator->second;
-            if (!pool.empty())
+            if (classType == 0 || pool->classTypeIndex == classType)
             {
-                for (auto object : pool)
-                {
-                    delete object;
-                }
-
-                pool.clear();
+                _trimPool(*pool, 0, removed);
             }
         }
     }
-    else
+
+    for (const auto object : removed)
     {
-        for (auto& pair : _poolsMap)
-        {
-            auto& pool = pair.second;
-            if (!pool.empty())
-            {
-                for (auto object : pool)
-                {
-                    delete object;
-                }
+        _destroyObject(object);
+    }
+}
 
-                pool.clear();
-            }
+void BaseObject::getPoolCounters(std::vector<PoolCounters>& counters)
+{
+    counters.clear();
+    std::lock_guard<std::mutex> lock(_poolMutex);
+    for (const auto pool : _pools)
+    {
+        std::lock_guard<std::mutex> poolLock(pool->_mutex);
+        int live = pool->_live;
+        unsigned pooled = pool->_count;
+        for (const auto local : pool->_locals)
+        {
+            live += local->_live.load(std::memory_order_relaxed);
+            pooled += static_cast<unsigned>(local->_count.load(std::memory_order_relaxed));
         }
+
+        counters.push_back({ pool, live > 0 ? static_cast<unsigned>(live) : 0u, pooled });
     }
 }
 
@@ -25,6 +25,10 @@
 
 #include "DragonBones.h"
 
+#include <atomic>
+#include <mutex>
+#include <new>
+
 DRAGONBONES_NAMESPACE_BEGIN
 /**
  * - The BaseObject is the base class for all objects in the DragonBones framework.
@@ -40,12 +44,126 @@ DRAGONBONES_NAMESPACE_BEGIN
  */
 class BaseObject
 {
+public:
+    class LocalPool;
+    /**
+     * - The free list of a class: the pooled objects are linked through `_nextInPool`,
+     * so borrowing and returning an object doesn't look up the class nor allocate.
+     * New objects are placed in the class's slab: chunks of `SLAB_OBJECTS` objects which are never released,
+     * the storage of the destroyed objects is reused by the next ones.
+     * One per class, bound by `BIND_CLASS_TYPE`, registered on the first use.
+     * @internal
+     */
+    class Pool
+    {
+        friend class BaseObject;
+
+    public:
+        const std::size_t classTypeIndex;
+        const char* const name;
+        // names of the profiler's counters
+        const char* const liveCounter;
+        const char* const pooledCounter;
+
+    private:
+        // data is parsed on the loading threads too, so the pools are shared between threads
+        std::mutex _mutex;
+        BaseObject* _head;
+        unsigned _count;
+        // returned by the other threads than the borrowing one, see `LocalPool::_live`
+        int _live;
+        unsigned _maxCount;
+        // the rest of the last chunk
+        char* _chunk;
+        unsigned _chunkLeft;
+        // storage of the destroyed objects linked through its first bytes
+        void* _vacant;
+        std::vector<void*> _chunks;
+        std::vector<LocalPool*> _locals;
+
+    public:
+        Pool(std::size_t classTypeIndex, const char* name, const char* liveCounter, const char* pooledCounter);
+        Pool(const Pool&) = delete;
+        Pool& operator=(const Pool&) = delete;
+    };
+    /**
+     * - The objects of a class cached by a thread: the thread which borrowed an object
+     * returns it here and borrows it again without locks. The objects returned by the other threads
+     * go to the pool of the class. Up to `LOCAL_CAPACITY` objects are kept by a thread on top of the pool's max count,
+     * they are moved to the pool when the thread exits.
+     * One per class and thread, bound by `BIND_CLASS_TYPE`, registered on the first use.
+     * @internal
+     */
+    class LocalPool
+    {
+        friend class BaseObject;
+
+    private:
+        Pool* _pool;
+        BaseObject* _head;
+        // written by the owner thread only, read by `getPoolCounters`
+        std::atomic<int> _count;
+        // borrowed minus returned by the thread, negative when the thread returns the objects of the other ones
+        std::atomic<int> _live;
+        // next local pool of the thread
+        LocalPool* _nextLocal;
+
+    public:
+        constexpr LocalPool() :
+            _pool(nullptr),
+            _head(nullptr),
+            _count(0),
+            _live(0),
+            _nextLocal(nullptr)
+        {}
+        LocalPool(const LocalPool&) = delete;
+        LocalPool& operator=(const LocalPool&) = delete;
+    };
+    /**
+     * - Number of the objects of a class.
+     * @internal
+     */
+    struct PoolCounters
+    {
+        const Pool* pool;
+        // borrowed and not returned yet
+        unsigned live;
+        // in the free list
+        unsigned pooled;
+    };
+
 private:
-    static unsigned _hashCode;
+    static constexpr unsigned SLAB_OBJECTS = 64;
+    static constexpr int LOCAL_CAPACITY = 128;
+    // moved between the thread's and the class's pool at once
+    static constexpr int LOCAL_BATCH = 32;
+
+    class ThreadLocals;
+
+    static std::atomic<unsigned> _hashCode;
     static unsigned _defaultMaxCount;
+    // guards the registry and the max counts, the free lists have their own locks
+    static std::mutex _poolMutex;
+    // set before the pool of the class is registered
     static std::map<std::size_t, unsigned> _maxCountMap;
-    static std::map<std::size_t, std::vector<BaseObject*>> _poolsMap;
+    static std::vector<Pool*> _pools;
     static void _returnObject(BaseObject *object);
+    static void _trimPool(Pool& pool, unsigned maxCount, std::vector<BaseObject*>& removed);
+    static void _registerLocal(Pool& pool, LocalPool& local);
+    // the pool of the class gets the objects of the thread over `keep`
+    static void _flushLocal(LocalPool& local, int keep);
+    // all objects of the calling thread's local pools of the class (or of all classes if 0)
+    static void _flushLocals(std::size_t classType);
+    static void _refillLocal(LocalPool& local);
+    // nullptr if the class's objects don't fit the slab or it's out of memory
+    static void* _allocate(Pool& pool, std::size_t size, std::size_t alignment);
+    // destruct the object and reuse its storage if it's in the slab, delete it otherwise
+    static void _destroyObject(BaseObject* object);
+    // only the owner thread changes the counter, so it doesn't need a locked instruction
+    static void _add(std::atomic<int>& counter, int value)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
 
 public:
     /**
@@ -91,24 +209,53 @@ public:
      */
     static T* borrowObject() 
     {
-        const auto classTypeIndex = T::getTypeIndex();
-        const auto iterator = _poolsMap.find(classTypeIndex);
-        if (iterator != _poolsMap.end())
+        auto& local = T::getLocalPool();
+        if (local._head == nullptr)
         {
-            auto& pool = iterator->second;
-            if (!pool.empty())
+            if (local._pool == nullptr)
             {
-                const auto object = static_cast<T*>(pool.back());
-                pool.pop_back();
-                object->_isInPool = false;
-                return object;
+                _registerLocal(T::getPool(), local);
             }
+
+            _refillLocal(local);
         }
 
-        const auto object = new (std::nothrow) T();
+        _add(local._live, 1);
+        if (local._head != nullptr)
+        {
+            const auto object = static_cast<T*>(local._head);
+            local._head = object->_nextInPool;
+            _add(local._count, -1);
+            object->_nextInPool = nullptr;
+            object->_isInPool = false;
+            object->_localPool = &local;
+            return object;
+        }
+
+        T* object = nullptr;
+        if (const auto storage = _allocate(T::getPool(), sizeof(T), alignof(T)))
+        {
+            object = new (storage) T();
+            object->_isInSlab = true;
+        }
+        else
+        {
+            object = new (std::nothrow) T();
+        }
+
+        if (object != nullptr)
+        {
+            object->_localPool = &local;
+        }
 
         return object;
     }
+    /**
+     * - The live and the pooled objects of each class which was borrowed, e.g. for the profiler.
+     * @param counters - Filled, reuse it between the calls to avoid the allocations.
+     * @internal
+     */
+    static void getPoolCounters(std::vector<PoolCounters>& counters);
 
 public:
     /**
@@ -125,6 +272,10 @@ public:
 
 private:
     bool _isInPool;
+    bool _isInSlab;
+    BaseObject* _nextInPool;
+    // the thread's pool the object was borrowed from
+    LocalPool* _localPool;
 
 public:
     virtual ~BaseObject() {}
@@ -132,10 +283,16 @@ public:
 protected:
     BaseObject() :
         hashCode(BaseObject::_hashCode++),
-        _isInPool(false)
+        _isInPool(false),
+        _isInSlab(false),
+        _nextInPool(nullptr),
+        _localPool(nullptr)
     {}
 
     virtual void _onClear() = 0;
+    virtual Pool& _getPool() const = 0;
+    // the calling thread's pool of the class
+    virtual LocalPool& _getLocalPool() const = 0;
 
 public:
     virtual std::size_t getClassTypeIndex() const = 0;
@@ -25,6 +25,7 @@
 
 #include <cmath>
 #include <cstdint>
+#include <cstdlib>
 #include <string>
 #include <algorithm>
 #include <vector>
@@ -51,6 +52,28 @@ public:\
     CLASS(){}\
     virtual ~CLASS(){};
 
+// the free lists of the class, see `BaseObject::Pool` and `BaseObject::LocalPool`
+#define BIND_CLASS_POOL(CLASS) \
+public:\
+    static BaseObject::Pool& getPool()\
+    {\
+        static BaseObject::Pool pool(CLASS::getTypeIndex(), #CLASS, #CLASS " live", #CLASS " pooled");\
+        return pool;\
+    }\
+    virtual BaseObject::Pool& _getPool() const override\
+    {\
+        return CLASS::getPool();\
+    }\
+    static BaseObject::LocalPool& getLocalPool()\
+    {\
+        static thread_local BaseObject::LocalPool local;\
+        return local;\
+    }\
+    virtual BaseObject::LocalPool& _getLocalPool() const override\
+    {\
+        return CLASS::getLocalPool();\
+    }\
+
 #define BIND_CLASS_TYPE(CLASS) \
 public:\
     static std::size_t getTypeIndex()\
@@ -62,6 +85,7 @@ public:\
     {\
         return CLASS::getTypeIndex();\
     }\
+    BIND_CLASS_POOL(CLASS)\
 
 #define BIND_CLASS_TYPE_A(CLASS) \
 public:\
@@ -74,6 +98,7 @@ public:\
     {\
         return CLASS::getTypeIndex();\
     }\
+    BIND_CLASS_POOL(CLASS)\
 public:\
     CLASS(){_onClear();}\
     ~CLASS(){_onClear();}\
@@ -92,6 +117,7 @@ public:\
     {\
         return CLASS::getTypeIndex();\
     }\
+    BIND_CLASS_POOL(CLASS)\
 private:\
     CLASS(const CLASS&);\
     void operator=(const CLASS&)
@@ -414,6 +440,9 @@ class Slot;
 class Constraint;
 class IKConstraint;
 class DeformVertices;
+class BoneHierarchy;
+class SkinningLayout;
+class MeshSkinning;
 
 class IAnimatable;
 class WorldClock;
@@ -5,6 +5,7 @@
 #include "DisplayData.h"
 #include "UserData.h"
 #include "BoundingBoxData.h"
+#include "../armature/MeshSkinning.h"
 
 DRAGONBONES_NAMESPACE_BEGIN
 
@@ -93,6 +94,12 @@ void WeightData::_onClear()
     count = 0;
     offset = 0;
     bones.clear();
+
+    if (skinning != nullptr)
+    {
+        delete skinning;
+        skinning = nullptr;
+    }
 }
 
 void WeightData::addBone(BoneData* value)
@@ -176,6 +176,10 @@ public:
     unsigned count;
     unsigned offset;
     std::vector<BoneData*> bones;
+    /**
+     * - Built by the first skinning of the mesh.
+     */
+    SkinningLayout* skinning = nullptr;
 
 protected:
     virtual void _onClear() override;
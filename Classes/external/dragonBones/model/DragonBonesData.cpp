@@ -14,7 +14,7 @@ void DragonBonesData::_onClear()
 
     if (binary != nullptr)
     {
-        delete binary;
+        free((void*)binary);
     }
 
     if (userData != nullptr)
@@ -1678,7 +1678,8 @@ unsigned JSONDataParser::_parseIKConstraintFrame(const rapidjson::Value& rawData
 
 const std::vector<ActionData*>& JSONDataParser::_parseActionData(const rapidjson::Value& rawData, ActionType type, BoneData* bone, SlotData* slot)
 {
-    static std::vector<ActionData*> actions;
+    // skeletons are parsed on the loading threads too
+    thread_local static std::vector<ActionData*> actions;
     actions.clear();
 
     if (rawData.IsString())
@@ -1887,7 +1888,8 @@ DragonBonesData* JSONDataParser::_parseDragonBonesData(const rapidjson::Value& r
                 const auto l5 = _frameArray.size() * 2;
                 const auto l6 = _timelineArray.size() * 2;
                 
-                auto binary = new char[l1 + l2 + l3 + l4 + l5 + l6];
+                // the same allocator as of the binary data loaded by the factory, see DragonBonesData::_onClear
+                auto binary = (char*)malloc(l1 + l2 + l3 + l4 + l5 + l6);
                 auto intArray = (int16_t*)binary;
                 auto floatArray = (float*)(binary + l1);
                 auto frameIntArray = (int16_t*)(binary + l1 + l2);
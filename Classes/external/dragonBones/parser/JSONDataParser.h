@@ -157,6 +157,12 @@ protected:
     AnimationData* _animation;
     TimelineData* _timeline;
     rapidjson::Value* _rawTextureAtlases;
+    std::vector<std::int16_t> _intArray;
+    std::vector<float> _floatArray;
+    std::vector<std::int16_t> _frameIntArray;
+    std::vector<float> _frameFloatArray;
+    std::vector<std::int16_t> _frameArray;
+    std::vector<std::uint16_t> _timelineArray;
 
 private:
     int _defaultColorOffset;
@@ -168,12 +174,6 @@ private:
     ColorTransform _helpColorTransform;
     Point _helpPoint;
     std::vector<float> _helpArray;
-    std::vector<std::int16_t> _intArray;
-    std::vector<float> _floatArray;
-    std::vector<std::int16_t> _frameIntArray;
-    std::vector<float> _frameFloatArray;
-    std::vector<std::int16_t> _frameArray;
-    std::vector<std::uint16_t> _timelineArray;
     std::vector<const rapidjson::Value*> _cacheRawMeshes;
     std::vector<MeshDisplayData*> _cacheMeshes;
     std::vector<ActionFrame> _actionFrames;
@@ -195,6 +195,12 @@ public:
         _animation(nullptr),
         _timeline(nullptr),
         _rawTextureAtlases(nullptr),
+        _intArray(),
+        _floatArray(),
+        _frameIntArray(),
+        _frameFloatArray(),
+        _frameArray(),
+        _timelineArray(),
 
         _defaultColorOffset(-1),
         _prevClockwise(0),
@@ -205,12 +211,6 @@ public:
         _helpColorTransform(),
         _helpPoint(),
         _helpArray(),
-        _intArray(),
-        _floatArray(),
-        _frameIntArray(),
-        _frameFloatArray(),
-        _frameArray(),
-        _timelineArray(),
         _cacheMeshes(),
         _cacheRawMeshes(),
         _actionFrames(),
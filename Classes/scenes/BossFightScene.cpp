@@ -1,9 +1,17 @@
 #include "BossFightScene.hpp"
 #include "Interface.hpp"
 
-#include "components/ParallaxBackground.hpp"
 #include "components/Movement.hpp"
 
+#include "EntityRegistry.hpp"
+#include "components/ProjectilePool.hpp"
+#include "components/HealthBarRenderer.hpp"
+#include "ActivationRegion.hpp"
+#include "components/WeaponSystem.hpp"
+#include "SimulationClock.hpp"
+#include "BotPlanner.hpp"
+#include "Settings.hpp"
+
 BossFightScene::BossFightScene(int id) 
     : LevelScene {id}
 {}
@@ -12,10 +20,8 @@ cocos2d::Scene* BossFightScene::createRootScene(int id) {
     const auto root = cocos2d::Scene::createWithPhysics();
     const auto world = root->getPhysicsWorld();
     world->setGravity(cocos2d::Vec2(0, LevelScene::GRAVITY));
-    world->setSubsteps(2);
-#ifndef COCOS2D_DEBUG
-    world->setFixedUpdateRate(60);
-#endif 
+    // stepped by the level's simulation clock
+    world->setAutoStep(false);
     world->setDebugDrawMask(cocos2d::PhysicsWorld::DEBUGDRAW_NONE);
 
     const auto uInterface = Interface::create();
@@ -52,20 +58,20 @@ bool BossFightScene::init() {
     const auto tileMap { cocos2d::FastTMXTiledMap::create(m_tmxFile) };
     tileMap->setName("Map");
     this->addChild(tileMap);
+    m_registry = std::make_unique<EntityRegistry>(tileMap->getContentSize());
+    m_projectiles = std::make_unique<ProjectilePool>();
+    m_activation = std::make_unique<ActivationRegion>();
+    m_weapons = std::make_unique<WeaponSystem>(tileMap, m_projectiles.get());
+    m_clock = std::make_unique<SimulationClock>(settings::Simulation::GetInstance().GetTickRate());
+    m_planner = std::make_unique<BotPlanner>();
+    m_healthBars = HealthBarRenderer::create();
+    m_healthBars->setTag(EXIST_ON_RESTART_TAG);
+    tileMap->addChild(m_healthBars, HealthBarRenderer::Z_ORDER);
     
-    // add parallax background
-    auto back = Background::create(tileMap->getContentSize());
-    tileMap->addChild(back, -1);
-
     // mark untouchable layers:
     for(auto& child: tileMap->getChildren()) {
         child->setName("Untouchable");
     }
 
-    this->Restart();    
-    
-    back->setAnchorPoint({0.f, 0.f});
-    back->setPosition(-tileMap->getPosition());
-
-    return true;
+    return this->Preload(tileMap);
 }
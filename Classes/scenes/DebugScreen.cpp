@@ -2,8 +2,10 @@
 #include "ui/CocosGUI.h"
 
 #include "units/Player.hpp"
+#include "scenes/LevelScene.hpp"
 #include "Core.hpp"
 #include "Settings.hpp"
+#include "ActivationRegion.hpp"
 
 #include <array>
 
@@ -132,6 +134,21 @@ bool DebugScreen::init() {
     for(auto checkbox: checkboxes) {
         background->addChild(checkbox);
     }
+
+    // entities of the level updated near the camera and asleep elsewhere
+    const auto level { dynamic_cast<LevelScene*>(scene->getChildByName("Level")) };
+    if (const auto activation = level? level->GetActivationRegion(): nullptr; activation) {
+        const auto text { cocos2d::StringUtils::format("Active: %zu  Sleeping: %zu"
+            , activation->GetActiveCount()
+            , activation->GetSleepingCount()
+        )};
+        auto entities = cocos2d::Label::createWithTTF(text, "fonts/arial.ttf", 25);
+        entities->setTextColor(cocos2d::Color4B::WHITE);
+        entities->setAnchorPoint(cocos2d::Vec2::ANCHOR_MIDDLE);
+        const auto state { captions[Utils::EnumCast(OptionKind::kState)] };
+        entities->setPosition(0.f, state->getPositionY() - 2.f * state->getContentSize().height);
+        background->addChild(entities);
+    }
     return true;
 };
 
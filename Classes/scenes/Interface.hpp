@@ -6,6 +6,7 @@
 #include "PauseNode.hpp"
 #include "DeathScreen.hpp"
 #include "DebugScreen.hpp"
+#include "Profiler.hpp"
 
 /**
  * Responsibility:
@@ -55,6 +56,9 @@ public:
                     (void) this->LaunchDebugScreen();
                 }
             }
+            else if(code == cocos2d::EventKeyboard::KeyCode::KEY_F12) {
+                this->DumpTrace();
+            }
             return true;
         };
         dispatcher->addEventListenerWithSceneGraphPriority(listener, this);
@@ -73,6 +77,24 @@ public:
     }
 
 private:
+    /**
+     * Write the last seconds recorded by the profiler as a Chrome trace
+     */
+    void DumpTrace() {
+        auto& profiler = bench::Profiler::GetInstance();
+        if(!profiler.IsEnabled()) {
+            cocos2d::log("Profiler is disabled, build with PLATFORMER_PROFILER");
+            return;
+        }
+        const auto path = profiler.GetDumpPath();
+        if(profiler.Dump(path)) {
+            cocos2d::log("Trace is written to %s", path.c_str());
+        }
+        else {
+            cocos2d::log("Failed to write the trace to %s", path.c_str());
+        }
+    }
+
     void LaunchDeathScreen() {
         const auto visibleSize = cocos2d::Director::getInstance()->getVisibleSize();
         const auto origin = cocos2d::Director::getInstance()->getVisibleOrigin();
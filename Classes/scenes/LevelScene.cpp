@@ -26,11 +26,30 @@
 #include "Utils.hpp"
 #include "TileMapParser.hpp"
 #include "ContactHandler.hpp"
+#include "EntityRegistry.hpp"
+#include "components/ProjectilePool.hpp"
+#include "components/HealthBarRenderer.hpp"
+#include "components/DragonBonesAnimator.hpp"
+#include "components/ArmaturePool.hpp"
+#include "ActivationRegion.hpp"
+#include "components/WeaponSystem.hpp"
+#include "SimulationClock.hpp"
+#include "BotPlanner.hpp"
+#include "NavigationGraph.hpp"
+#include "TileMapHelper.hpp"
+#include "AssetPreloader.hpp"
+#include "FrameSampler.hpp"
+#include "Profiler.hpp"
+#include "FlightRecorder.hpp"
 
 #include "configs/JsonUnits.hpp"
+#include "dragonBones/DragonBonesHeaders.h"
 
 #include <unordered_map>
+#include <algorithm>
+#include <chrono>
 #include <functional>
+#include <cassert>
 
 namespace {
 
@@ -50,6 +69,21 @@ void EnumerateDepth(cocos2d::Node *root, std::function<void(cocos2d::Node*)> mod
     }
 }
 
+#if defined(PLATFORMER_PROFILER)
+/**
+ * Live and pooled DragonBones objects of each class,
+ * e.g. to spot the timelines or the events which aren't returned
+ */
+void CountPooledObjects() {
+    static std::vector<dragonBones::BaseObject::PoolCounters> counters;
+    dragonBones::BaseObject::getPoolCounters(counters);
+    for (const auto& [pool, live, pooled]: counters) {
+        PROFILE_COUNTER(pool->liveCounter, live);
+        PROFILE_COUNTER(pool->pooledCounter, pooled);
+    }
+}
+#endif
+
 } // namespace {
 
 LevelScene::LevelScene(int id) 
@@ -63,10 +97,8 @@ cocos2d::Scene* LevelScene::createRootScene(int id) {
     const auto root = cocos2d::Scene::createWithPhysics();
     const auto world = root->getPhysicsWorld();
     world->setGravity(cocos2d::Vec2(0, GRAVITY));
-    world->setSubsteps(2);
-#ifndef COCOS2D_DEBUG
-    world->setFixedUpdateRate(60);
-#endif 
+    // stepped by the level's simulation clock
+    world->setAutoStep(false);
     using Debug = settings::DebugMode;
     const auto isEnabled = Debug::GetInstance().IsEnabled(Debug::OptionKind::kPhysics);
     world->setDebugDrawMask(isEnabled? 
@@ -108,7 +140,25 @@ bool LevelScene::init() {
     auto tileMap { cocos2d::FastTMXTiledMap::create(m_tmxFile) };
     tileMap->setName("Map");
     addChild(tileMap);
+    m_registry = std::make_unique<EntityRegistry>(tileMap->getContentSize());
+    m_projectiles = std::make_unique<ProjectilePool>();
+    m_activation = std::make_unique<ActivationRegion>();
+    m_weapons = std::make_unique<WeaponSystem>(tileMap, m_projectiles.get());
+    m_clock = std::make_unique<SimulationClock>(settings::Simulation::GetInstance().GetTickRate());
+    m_planner = std::make_unique<BotPlanner>();
+    m_healthBars = HealthBarRenderer::create();
+    m_healthBars->setTag(EXIST_ON_RESTART_TAG);
+    tileMap->addChild(m_healthBars, HealthBarRenderer::Z_ORDER);
 
+    // mark untouchable layers:
+    for (auto& child: tileMap->getChildren()) {
+        child->setTag(EXIST_ON_RESTART_TAG);
+    }
+
+    return Preload(tileMap);
+}
+
+bool LevelScene::Preload(cocos2d::FastTMXTiledMap * map) {
     // load 
     auto fileUtils = cocos2d::FileUtils::getInstance();
     std::string json = fileUtils->getStringFromFile("configuration/units.json");
@@ -121,21 +171,30 @@ bool LevelScene::init() {
     doc.Parse(json.c_str());
     json_models::FromJson(doc["units"], *m_units);
 
+    m_parser = std::make_unique<TileMapParser>(map, m_tmxFile);
+    // prefer the baked level, parse the TMX only when it's absent or outdated
+    if (!m_parser->Load()) {
+        m_parser->Parse();
+    }
+    // the map's geometry doesn't change on restart, so do the routes
+    m_navigation = std::make_unique<NavigationGraph>(m_parser->GetTileMapCache(), JUMP_HEIGHT);
+    m_preloader = std::make_unique<AssetPreloader>(AssetPreloader::Collect(*m_parser, *m_units));
+    return true;
+}
+
+void LevelScene::OnAssetsLoaded() {
+    const auto tileMap = getChildByName<cocos2d::FastTMXTiledMap*>("Map");
     // add parallax background
     auto back = Background::create(tileMap->getContentSize());
+    back->setTag(EXIST_ON_RESTART_TAG);
     tileMap->addChild(back, -1);
+    // the skeletons are resident: build the armatures of the units and props in advance,
+    // later restarts reuse the armatures released by the removed ones
+    ArmaturePool::GetInstance().Prewarm(AssetPreloader::Collect(*m_parser, *m_units));
+    Restart();
 
-    // mark untouchable layers:
-    for (auto& child: tileMap->getChildren()) {
-        child->setTag(EXIST_ON_RESTART_TAG);
-    }
-
-    Restart();    
-    
     back->setAnchorPoint({0.f, 0.f});
     back->setPosition(-tileMap->getPosition());
-
-    return true;
 }
 
 void LevelScene::onEnter() {
@@ -152,6 +211,85 @@ void LevelScene::onExit() {
     getEventDispatcher()->removeAllEventListeners();
 }
 
+void LevelScene::update(float dt) {
+    if (m_preloader) {
+        // textures are uploaded in slices, the level is populated when all of them are resident
+        if (m_preloader->Update()) {
+            m_preloader.reset();
+            OnAssetsLoaded();
+            // the loading hitch isn't a stutter
+            bench::FlightRecorder::GetInstance().Reset();
+        }
+        return;
+    }
+    const auto start { bench::FlightRecorder::Clock::now() };
+    const auto ticks = m_clock->Advance(dt);
+    PROFILE_COUNTER("ticks", ticks);
+#if defined(PLATFORMER_PROFILER)
+    if (bench::Profiler::GetInstance().IsEnabled()) {
+        CountPooledObjects();
+    }
+#endif
+    if (ticks > 0U) {
+        m_clock->Restore();
+        for (uint32_t i = 0U; i < ticks; i++) {
+            Tick(m_clock->GetTickDuration());
+        }
+    }
+    // render the state between the last two ticks
+    m_clock->Interpolate();
+    // the camera follows the rendered player
+    if (const auto player = m_registry->GetPlayer(); player) {
+        static_cast<Player*>(player)->UpdateCamera(dt);
+    }
+    const std::chrono::duration<float, std::milli> duration { bench::FlightRecorder::Clock::now() - start };
+    Record(dt, ticks, duration.count());
+}
+
+void LevelScene::Record(float dt, uint32_t ticks, float updateTime) {
+    auto& recorder { bench::FlightRecorder::GetInstance() };
+    auto& frame { recorder.GetCurrent() };
+    frame.frameTime = dt * 1000.f;
+    frame.updateTime = updateTime;
+    frame.ticks = static_cast<uint8_t>(std::min<uint32_t>(ticks, UINT8_MAX));
+    frame.projectiles = static_cast<uint16_t>(std::min<size_t>(m_projectiles->GetLive(), UINT16_MAX));
+    frame.units = static_cast<uint16_t>(std::min<size_t>(m_registry->GetSize(), UINT16_MAX));
+    frame.animators = static_cast<uint16_t>(
+        std::min<size_t>(dragonBones::Animator::GetRunningCount(), UINT16_MAX));
+    if (const auto player = m_registry->GetPlayer(); player) {
+        const auto& input { static_cast<Player*>(player)->GetInputHandler()->GetInput() };
+        using Button = bench::FlightRecorder::Button;
+        frame.dx = static_cast<int8_t>(input.dx);
+        frame.buttons = static_cast<uint8_t>(
+            (input.jump? Button::JUMP: 0U)
+            | (input.dash? Button::DASH: 0U)
+            | (input.meleeAttack? Button::MELEE_ATTACK: 0U)
+            | (input.rangeAttack? Button::RANGE_ATTACK: 0U)
+            | (input.specialAttack? Button::SPECIAL_ATTACK: 0U));
+    }
+    recorder.EndFrame(getScene());
+}
+
+void LevelScene::Tick(float dt) {
+    PROFILE_ZONE("LevelScene::Tick");
+    PROFILE_COUNTER("simulated entities", m_clock->GetSize());
+    PROFILE_COUNTER("bots", m_planner->GetSize());
+    m_clock->BeginTick();
+    // the grid is updated before the units, so they query the state of the last tick
+    m_registry->Update();
+    m_activation->Update(m_registry->GetPlayer());
+    m_weapons->Update(dt);
+    // bots decide on the state after the weapons' update, then act on their own update
+    m_planner->Update(m_registry->GetPlayer());
+    m_clock->UpdateEntities();
+    const bench::ScopedSample sample { bench::Subsystem::PHYSICS };
+    PROFILE_ZONE("PhysicsWorld::step");
+    const auto start { bench::FlightRecorder::Clock::now() };
+    // the world belongs to the root scene, not to the level
+    getScene()->getPhysicsWorld()->step(dt);
+    bench::FlightRecorder::GetInstance().AddPhysicsTime(bench::FlightRecorder::Clock::now() - start);
+}
+
 void LevelScene::pause() {
     // pause for this target
     // - event system
@@ -179,15 +317,21 @@ void LevelScene::resume() {
     EnumerateDepth(map, [](cocos2d::Node* node) {
         node->resume();
     });
+    // entities out of the camera stay asleep
+    m_activation->Restore();
     // resume physic world
     const auto runningScene { cocos2d::Director::getInstance()->getRunningScene() };
     runningScene->getPhysicsWorld()->setSpeed(1.0);
 };
 
 void LevelScene::Restart() {
+    PROFILE_ZONE("LevelScene::Restart");
     // Tilemap:
     // - remove children exсept layers and objects.
     auto tileMap = getChildByName<cocos2d::FastTMXTiledMap*>("Map");
+    // projectiles in flight go back to the pool, otherwise they're lost
+    // and the pool still counts them as live
+    m_projectiles->ReleaseChildren(tileMap);
     // NOTE:
     // cannot directly invoke `child->removeFromParent();` because 
     // it invalidates iterator by erase call inside the `removeFromParent` 
@@ -230,10 +374,7 @@ void LevelScene::menuCloseCallback(cocos2d::Ref* pSender) {
 
 void LevelScene::InitTileMapObjects(cocos2d::FastTMXTiledMap * map) {
 
-    if(!m_parser) {
-        m_parser = std::make_unique<TileMapParser>(map, m_tmxFile);
-        m_parser->Parse();
-    }
+    assert(m_parser && "The map is parsed by `Preload`");
 
     /// TODO: get rid of this shitty maps
     std::unordered_map<size_t, Path> paths;
@@ -263,7 +404,7 @@ void LevelScene::InitTileMapObjects(cocos2d::FastTMXTiledMap * map) {
     constexpr int PLAYER_ZORDER = 100;
     for(size_t i = 0; i < Utils::EnumSize<core::CategoryName>(); i++) {
         const auto category { static_cast<core::CategoryName>(i) };
-        const auto parsedForms { m_parser->Peek(category) };
+        const auto& parsedForms { m_parser->Peek(category) };
         for(const auto& form: parsedForms) {
             if(form.m_type == core::CategoryName::PLAYER) {
                 const auto contentSize = form.m_rect.size * form.m_scale;
@@ -469,4 +610,18 @@ void LevelScene::InitTileMapObjects(cocos2d::FastTMXTiledMap * map) {
     if(auto it = influences.find(bossId); it != influences.end()) {
         boss->AttachInfluenceArea(it->second);
     }
+
+    // create projectiles before the fight starts
+    using Archetype = ProjectilePool::Archetype;
+    m_projectiles->Prewarm(Archetype::MELEE, 4U + warriors.size());
+    m_projectiles->Prewarm(Archetype::PLAYER_FIREBALL, 4U);
+    m_projectiles->Prewarm(Archetype::PLAYER_SPECIAL, 2U);
+    m_projectiles->Prewarm(Archetype::ARROW, 2U * archers.size());
+    m_projectiles->Prewarm(Archetype::STAKE, 2U * cannons.size());
+    m_projectiles->Prewarm(Archetype::STONE, 2U * boulderPushers.size());
+    m_projectiles->Prewarm(Archetype::SLIME_SHOT, 2U * slimes.size());
+    if(boss) {
+        m_projectiles->Prewarm(Archetype::BOSS_FIREBALL, 4U);
+        m_projectiles->Prewarm(Archetype::CLOUD_FIREBALL, 4U);
+    }
 }
@@ -11,6 +11,16 @@ namespace json_autogenerated_classes {
 } // namespace json_autogenerated_classes
 namespace json_models = json_autogenerated_classes;
 
+class EntityRegistry;
+class ProjectilePool;
+class HealthBarRenderer;
+class ActivationRegion;
+class WeaponSystem;
+class SimulationClock;
+class BotPlanner;
+class NavigationGraph;
+class AssetPreloader;
+
 class LevelScene : public cocos2d::Scene {
 public:
     static constexpr int EXIST_ON_RESTART_TAG { 
@@ -46,8 +56,49 @@ public:
 
     void onExit() override;
 
+    void update(float dt) override;
+
     void Restart();
 
+    /**
+     * @return whether the assets are resident and the level is populated
+     */
+    [[nodiscard]] bool IsLoaded() const noexcept {
+        return m_preloader == nullptr;
+    }
+
+    [[nodiscard]] EntityRegistry* GetRegistry() const noexcept {
+        return m_registry.get();
+    }
+
+    [[nodiscard]] ProjectilePool* GetProjectilePool() const noexcept {
+        return m_projectiles.get();
+    }
+
+    [[nodiscard]] HealthBarRenderer* GetHealthBars() const noexcept {
+        return m_healthBars;
+    }
+
+    [[nodiscard]] ActivationRegion* GetActivationRegion() const noexcept {
+        return m_activation.get();
+    }
+
+    [[nodiscard]] WeaponSystem* GetWeaponSystem() const noexcept {
+        return m_weapons.get();
+    }
+
+    [[nodiscard]] SimulationClock* GetClock() const noexcept {
+        return m_clock.get();
+    }
+
+    [[nodiscard]] BotPlanner* GetPlanner() const noexcept {
+        return m_planner.get();
+    }
+
+    [[nodiscard]] NavigationGraph* GetNavigation() const noexcept {
+        return m_navigation.get();
+    }
+
     /// Lifecycle
 	~LevelScene();
     LevelScene(const LevelScene&) = delete;
@@ -60,6 +111,26 @@ protected:
 
     virtual void InitTileMapObjects(cocos2d::FastTMXTiledMap * map);
 
+    /**
+     * Load the units' models, parse the map and start loading the assets of its objects.
+     * The level is populated by `update` once they are resident.
+     * @return false if the units' models can't be loaded
+     */
+    [[nodiscard]] bool Preload(cocos2d::FastTMXTiledMap * map);
+
+    void OnAssetsLoaded();
+
+    /**
+     * Advance the simulation by a single fixed step.
+     */
+    void Tick(float dt);
+
+    /**
+     * Summarize the frame for the flight recorder.
+     * @param updateTime time spent by `update` (milliseconds)
+     */
+    void Record(float dt, uint32_t ticks, float updateTime);
+
     std::unique_ptr<TileMapParser> m_parser { nullptr };
 
     // level id. Used to load a map
@@ -68,6 +139,33 @@ protected:
     std::string m_tmxFile;
 
     std::unique_ptr<json_models::Units> m_units;
+
+    // units of the level, used to find targets
+    std::unique_ptr<EntityRegistry> m_registry;
+
+    // recycled projectiles of the level's weapons
+    std::unique_ptr<ProjectilePool> m_projectiles;
+
+    // health bars of the units, owned by the tile map
+    HealthBarRenderer * m_healthBars { nullptr };
+
+    // entities updated only near the camera
+    std::unique_ptr<ActivationRegion> m_activation;
+
+    // state of the units' weapons
+    std::unique_ptr<WeaponSystem> m_weapons;
+
+    // fixed step of physics and units, interpolated for rendering
+    std::unique_ptr<SimulationClock> m_clock;
+
+    // decisions of the bots, made in parallel
+    std::unique_ptr<BotPlanner> m_planner;
+
+    // walkable surfaces of the map, built by `Preload`
+    std::unique_ptr<NavigationGraph> m_navigation;
+
+    // alive until the assets of the level are resident
+    std::unique_ptr<AssetPreloader> m_preloader;
 };
 
 #endif // LEVEL_SCENE_HPP
\ No newline at end of file
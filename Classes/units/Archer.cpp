@@ -1,9 +1,11 @@
 #include "Archer.hpp"
 #include "Player.hpp"
 #include "Core.hpp"
+#include "FrameSampler.hpp"
+#include "Profiler.hpp"
 
 #include "components/DragonBonesAnimator.hpp"
-#include "components/Weapon.hpp"
+#include "components/WeaponSystem.hpp"
 #include "components/Movement.hpp"
 
 #include "configs/JsonUnits.hpp"
@@ -31,13 +33,14 @@ Archer::Archer(size_t id
     , const cocos2d::Size& contentSize
     , const json_models::Archer * model
 )
-    : Bot{ id, core::EntityNames::ARCHER }
+    : Bot{ id, model->dragonbones }
     , m_model { model }
 {
     m_contentSize = contentSize;
     m_physicsBodySize = cocos2d::Size { contentSize.width * 0.875f, contentSize.height };
     m_hitBoxSize = m_physicsBodySize;
     m_health = m_model->health;
+    m_frameCacheRate = static_cast<unsigned>(m_model->frameCache);
 }
 
 bool Archer::init() {
@@ -48,12 +51,12 @@ bool Archer::init() {
 }
 
 void Archer::update(float dt) {
+    const bench::ScopedSample sample { bench::Subsystem::UNITS };
+    PROFILE_ZONE("Archer::update");
     cocos2d::Node::update(dt);
     // custom updates
     UpdateDebugLabel();
     if (!IsDead()) {
-        UpdateWeapons(dt);
-        TryAttack();
         UpdateCurses(dt);
     }
     UpdateState(dt);
@@ -75,10 +78,10 @@ void Archer::UpdateState(const float dt) noexcept {
     if (m_health <= 0) {
         m_currentState = State::DEAD;
     }
-    else if (m_weapons[WeaponClass::RANGE]->IsPreparing()) {
+    else if (m_weapons[WeaponClass::RANGE].IsPreparing()) {
         m_currentState = State::PREPARE_ATTACK;
     }
-    else if (m_weapons[WeaponClass::RANGE]->IsAttacking()) {
+    else if (m_weapons[WeaponClass::RANGE].IsAttacking()) {
         m_currentState = State::ATTACK;
     }
     else {
@@ -103,7 +106,7 @@ void Archer::UpdateAnimation() {
 
 void Archer::OnDeath() {
     removeComponent(getPhysicsBody());
-    getChildByName("health")->removeFromParent();
+    RemoveHealthBar();
     m_animator->EndWith([this](){
         runAction(cocos2d::RemoveSelf::create(true));
     });
@@ -169,43 +172,48 @@ void Archer::AddWeapons() {
     float preparationTime { m_animator->GetDuration(Utils::EnumCast(State::ATTACK)) }; /// TODO: update animation!
     float attackDuration { 0.1f };
     float reloadTime { bow.cooldown };
-    
-    auto genPos = [this]()->cocos2d::Rect {
-        float attackRange { m_weapons[WeaponClass::RANGE]->GetRange() };
-        cocos2d::Size arrowSize { attackRange, floorf(attackRange / 8.5f) };
-
-        auto position = getPosition();
-        if (IsLookingLeft()) {
-            position.x -= m_contentSize.width / 2.f + arrowSize.width;
-        }
-        else {
-            position.x += m_contentSize.width / 2.f;
-        }
-        position.y += m_contentSize.height / 2.f;
 
-        return { position, arrowSize };
-    };
-    auto genVel = [this](cocos2d::PhysicsBody* body) {
-        const auto& velocity = m_model->weapons.bow.projectile.velocity;
-        body->setVelocity({ IsLookingLeft()? -velocity[0]: velocity[0], velocity[1] });
-    };
+    m_weapons[WeaponClass::RANGE] = m_weaponSystem->Add(this
+        , WeaponSystem::Kind::BOW
+        , WeaponClass::RANGE
+        , damage
+        , range
+        , preparationTime
+        , attackDuration
+        , reloadTime
+    );
+}
+
+cocos2d::Rect Archer::GetAttackArea(size_t weapon) const {
+    float attackRange { m_weapons[WeaponClass::RANGE].GetRange() };
+    cocos2d::Size arrowSize { attackRange, floorf(attackRange / 8.5f) };
+
+    auto position = getPosition();
+    if (IsLookingLeft()) {
+        position.x -= m_contentSize.width / 2.f + arrowSize.width;
+    }
+    else {
+        position.x += m_contentSize.width / 2.f;
+    }
+    position.y += m_contentSize.height / 2.f;
+
+    return { position, arrowSize };
+}
 
-    auto& weapon = m_weapons[WeaponClass::RANGE];
-    weapon.reset(new Bow(
-        damage, range, preparationTime, attackDuration, reloadTime));
-    weapon->AddPositionGenerator(std::move(genPos));
-    weapon->AddVelocityGenerator(std::move(genVel));
+void Archer::PushProjectile(size_t weapon, cocos2d::PhysicsBody * body) const {
+    const auto& velocity = m_model->weapons.bow.projectile.velocity;
+    body->setVelocity({ IsLookingLeft()? -velocity[0]: velocity[0], velocity[1] });
 }
 
 void Archer::Attack() {
     assert(!IsDead());
-    assert(m_weapons[WeaponClass::RANGE]->IsReady());
+    assert(m_weapons[WeaponClass::RANGE].IsReady());
 
-    m_weapons[WeaponClass::RANGE]->LaunchAttack();
+    m_weapons[WeaponClass::RANGE].LaunchAttack();
 }
 
-bool Archer::NeedAttack() const noexcept {
-    return !IsDead() && m_detectEnemy && m_weapons[WeaponClass::RANGE]->IsReady();
+bool Archer::NeedAttack(const Snapshot&) const noexcept {
+    return !IsDead() && m_detectEnemy && m_weapons[WeaponClass::RANGE].IsReady();
 }
 
 } // namespace Enemies
\ No newline at end of file
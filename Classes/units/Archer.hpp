@@ -32,6 +32,12 @@ public:
      */
     void Attack() override;
 
+/// Weapon interface
+
+    [[nodiscard]] cocos2d::Rect GetAttackArea(size_t weapon) const;
+
+    void PushProjectile(size_t weapon, cocos2d::PhysicsBody * body) const;
+
 private:
     enum WeaponClass{ RANGE };
 
@@ -53,7 +59,7 @@ private:
 
     void AddWeapons() override;
 
-    bool NeedAttack() const noexcept override;
+    bool NeedAttack(const Snapshot& snapshot) const noexcept override;
 
 /// Configs (Json Model Data):
     json_models::Archer const *const m_model { nullptr };
@@ -1,7 +1,7 @@
 #include "AxWarrior.hpp"
 #include "Core.hpp"
 
-#include "components/Weapon.hpp"
+#include "components/WeaponSystem.hpp"
 #include "components/Influence.hpp"
 #include "components/Movement.hpp"
 #include "components/DragonBonesAnimator.hpp"
@@ -38,52 +38,59 @@ AxWarrior::AxWarrior(size_t id
     , const cocos2d::Size& contentSize
     , const json_models::AxWarrior *model
 )
-    : Warrior { id, core::EntityNames::WARRIOR, contentSize }
+    : Warrior { id, model->dragonbones, contentSize }
     , m_model { model }
 {
     assert(model);
+    m_frameCacheRate = static_cast<unsigned>(m_model->frameCache);
 }
 
 
 void AxWarrior::Attack() {
     assert(!IsDead());
     assert(m_weapons[WeaponClass::MELEE]);
-    assert(m_weapons[WeaponClass::MELEE]->IsReady());
+    assert(m_weapons[WeaponClass::MELEE].IsReady());
 
-    m_weapons[WeaponClass::MELEE]->LaunchAttack();
+    m_weapons[WeaponClass::MELEE].LaunchAttack();
 }
 
 void AxWarrior::AddWeapons() {
     float attackDuration { 0.15f };
     float preparationTime { m_animator->GetDuration(Utils::EnumCast(State::ATTACK)) - attackDuration };
 
-    auto genPos = [this]() -> cocos2d::Rect {
-        auto attackRange { m_weapons[WeaponClass::MELEE]->GetRange() };
-
-        auto position = getPosition();
-        if (m_side == Side::RIGHT) {
-            position.x += m_contentSize.width / 2.f;
-        }
-        else {
-            position.x -= m_contentSize.width / 2.f + attackRange;
-        }
-        // shift a little bit higher to avoid immediate collision with the ground
-        position.y += m_contentSize.height * 0.05f;
-        cocos2d::Rect attackedArea {
-            position,
-            cocos2d::Size{ attackRange, m_contentSize.height * 1.05f } // a little bigger than the designed size
-        };
-        return attackedArea;
-    };
-    auto genVel = [this](cocos2d::PhysicsBody* body) {
-        body->setVelocity(getPhysicsBody()->getVelocity());
+	const auto& axe = m_model->weapons.axe;
+    m_weapons[WeaponClass::MELEE] = m_weaponSystem->Add(this
+        , WeaponSystem::Kind::AXE
+        , WeaponClass::MELEE
+        , axe.damage
+        , axe.range
+        , preparationTime
+        , attackDuration
+        , axe.cooldown
+    );
+}
+
+cocos2d::Rect AxWarrior::GetAttackArea(size_t weapon) const {
+    auto attackRange { m_weapons[WeaponClass::MELEE].GetRange() };
+
+    auto position = getPosition();
+    if (m_side == Side::RIGHT) {
+        position.x += m_contentSize.width / 2.f;
+    }
+    else {
+        position.x -= m_contentSize.width / 2.f + attackRange;
+    }
+    // shift a little bit higher to avoid immediate collision with the ground
+    position.y += m_contentSize.height * 0.05f;
+    cocos2d::Rect attackedArea {
+        position,
+        cocos2d::Size{ attackRange, m_contentSize.height * 1.05f } // a little bigger than the designed size
     };
+    return attackedArea;
+}
 
-	const auto& axe = m_model->weapons.axe;
-    auto& weapon = m_weapons[WeaponClass::MELEE];
-    weapon.reset(new Axe(axe.damage, axe.range, preparationTime, attackDuration, axe.cooldown));
-    weapon->AddPositionGenerator(std::move(genPos));
-    weapon->AddVelocityGenerator(std::move(genVel));
+void AxWarrior::PushProjectile(size_t weapon, cocos2d::PhysicsBody * body) const {
+    body->setVelocity(getPhysicsBody()->getVelocity());
 }
 
 
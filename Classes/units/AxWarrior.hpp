@@ -18,6 +18,12 @@ public:
 
     bool init() override;
 
+/// Weapon interface
+
+    [[nodiscard]] cocos2d::Rect GetAttackArea(size_t weapon) const;
+
+    void PushProjectile(size_t weapon, cocos2d::PhysicsBody * body) const;
+
 private:
     enum WeaponClass { MELEE };
 
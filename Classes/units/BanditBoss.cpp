@@ -1,10 +1,13 @@
 #include "BanditBoss.hpp"
 #include "Player.hpp"
 #include "Core.hpp"
+#include "AssetPaths.hpp"
+#include "FrameSampler.hpp"
+#include "Profiler.hpp"
 #include "PhysicsHelper.hpp"
 
 #include "components/DragonBonesAnimator.hpp"
-#include "components/Weapon.hpp"
+#include "components/WeaponSystem.hpp"
 #include "components/Influence.hpp"
 #include "components/Movement.hpp"
 #include "components/Dash.hpp"
@@ -20,9 +23,9 @@ namespace {
  * can't define what is being busy mean for different units so it's 
  * using internal linkage
  */
-inline bool IsBusy(const std::unique_ptr<Weapon>& weapon) noexcept {
+inline bool IsBusy(const Weapon& weapon) noexcept {
     assert(weapon);
-    return (weapon->IsPreparing() || weapon->IsAttacking());
+    return (weapon.IsPreparing() || weapon.IsAttacking());
 }
 
 } // namespace {
@@ -51,7 +54,7 @@ BanditBoss::BanditBoss(size_t id
     , const json_models::BanditBoss *boss
     , const json_models::UnitsFirecloud *cloud
 )
-    : Bot{ id, core::EntityNames::BOSS }
+    : Bot{ id, boss->dragonbones }
     , m_boss { boss }
     , m_cloud { cloud }
 {
@@ -61,6 +64,7 @@ BanditBoss::BanditBoss(size_t id
     m_physicsBodySize = cocos2d::Size { contentSize.width * 0.75f, contentSize.height };
     m_hitBoxSize = m_physicsBodySize;
     m_health = m_boss->health;
+    m_frameCacheRate = static_cast<unsigned>(m_boss->frameCache);
 }
 
 
@@ -84,13 +88,13 @@ bool BanditBoss::init() {
 }
 
 void BanditBoss::update(float dt) {
+    const bench::ScopedSample sample { bench::Subsystem::UNITS };
+    PROFILE_ZONE("BanditBoss::update");
     cocos2d::Node::update(dt);
     // custom updates
     UpdateDebugLabel();
     if (!IsDead()) {
-        UpdateWeapons(dt);
         UpdatePosition(dt); 
-        TryAttack();
         UpdateCurses(dt);
     }
     UpdateState(dt);
@@ -110,31 +114,31 @@ void BanditBoss::OnEnemyLeave() {
 }
 
 void BanditBoss::LaunchFireballs() {
-    assert(m_weapons[FIREBALL_ATTACK]->IsReady() 
+    assert(m_weapons[FIREBALL_ATTACK].IsReady() 
         && !IsDead() 
         && "You don't check condition beforehand");
 
-    m_weapons[FIREBALL_ATTACK]->LaunchAttack();
+    m_weapons[FIREBALL_ATTACK].LaunchAttack();
 }
 
 void BanditBoss::LaunchFirecloud() {
-    assert(m_weapons[FIRECLOUD_ATTACK]->IsReady() 
+    assert(m_weapons[FIRECLOUD_ATTACK].IsReady() 
         && !IsDead() 
         && "You don't check condition beforehand"
     );
 
     // start attack with weapon
-    m_weapons[FIRECLOUD_ATTACK]->LaunchAttack();
+    m_weapons[FIRECLOUD_ATTACK].LaunchAttack();
 }
 
 void BanditBoss::LaunchSweepAttack() {
-    assert(m_weapons[SWEEP_ATTACK]->IsReady() 
+    assert(m_weapons[SWEEP_ATTACK].IsReady() 
         && !IsDead() 
         && "You don't check condition beforehand"
     );
     
     // create projectile - area where the chains aredealing damage during jump
-    m_weapons[SWEEP_ATTACK]->LaunchAttack();
+    m_weapons[SWEEP_ATTACK].LaunchAttack();
     // jump
     using Move = Movement::Direction;
     
@@ -149,11 +153,10 @@ void BanditBoss::LaunchDash() {
 }
 
 // FIREBALLS
-bool BanditBoss::CanLaunchFireballs() const noexcept {
-    const auto player = getParent()->getChildByName<Unit*>(core::EntityNames::PLAYER);
-    if (player 
-        && !player->IsDead()
-        && m_weapons[FIREBALL_ATTACK]->IsReady()
+bool BanditBoss::CanLaunchFireballs(const Snapshot& snapshot) const noexcept {
+    if (snapshot.hasTarget 
+        && !snapshot.isTargetDead
+        && m_weapons[FIREBALL_ATTACK].IsReady()
         && m_detectEnemy
     ) {
        return true;
@@ -163,11 +166,10 @@ bool BanditBoss::CanLaunchFireballs() const noexcept {
 }
 
 // FIRECLOUD
-bool BanditBoss::CanLaunchFirecloud() const noexcept {
-    const auto player = getParent()->getChildByName<Unit*>(core::EntityNames::PLAYER);
-    if (player 
-        && !player->IsDead()
-        && m_weapons[FIRECLOUD_ATTACK]->IsReady()
+bool BanditBoss::CanLaunchFirecloud(const Snapshot& snapshot) const noexcept {
+    if (snapshot.hasTarget 
+        && !snapshot.isTargetDead
+        && m_weapons[FIRECLOUD_ATTACK].IsReady()
         && m_health <= m_boss->health / 2
     ) {
         return true;
@@ -177,11 +179,10 @@ bool BanditBoss::CanLaunchFirecloud() const noexcept {
 }
 
 // JUMP + CHAINS
-bool BanditBoss::CanLaunchSweepAttack() const noexcept {
-    const auto player = getParent()->getChildByName<Unit*>(core::EntityNames::PLAYER);
-    if (player 
-        && !player->IsDead()
-        && m_weapons[SWEEP_ATTACK]->IsReady()
+bool BanditBoss::CanLaunchSweepAttack(const Snapshot& snapshot) const noexcept {
+    if (snapshot.hasTarget 
+        && !snapshot.isTargetDead
+        && m_weapons[SWEEP_ATTACK].IsReady()
         && IsOnGround() // can't jump in the air
     ) {
         cocos2d::Size aggroSize { m_contentSize.height * 2.f, m_contentSize.height };
@@ -191,9 +192,9 @@ bool BanditBoss::CanLaunchSweepAttack() const noexcept {
         };
         const cocos2d::Rect right { getPosition(), aggroSize };
 
-        const auto playerSize { player->getContentSize() };
+        const auto playerSize { snapshot.targetSize };
         const cocos2d::Rect boundingBox {
-            player->getPosition() - cocos2d::Vec2{ playerSize.width / 2.f, 0.f }, 
+            snapshot.targetPosition - cocos2d::Vec2{ playerSize.width / 2.f, 0.f }, 
             playerSize
         };
         return (left.intersectsRect(boundingBox) || right.intersectsRect(boundingBox));
@@ -211,9 +212,9 @@ bool BanditBoss::CanLaunchSweepAttack() const noexcept {
  * 4. health > 50%? player is quite far from the boss
  * 5. No other attacks performed
  */
-bool BanditBoss::CanLaunchDash() const noexcept {
+bool BanditBoss::CanLaunchDash(const Snapshot& snapshot) const noexcept {
     bool canDash = !m_dash->IsOnCooldown() 
-        && std::none_of(m_weapons.cbegin(), m_weapons.cend(), [](const std::unique_ptr<Weapon>& weapon) {
+        && std::none_of(m_weapons.cbegin(), m_weapons.cend(), [](const Weapon& weapon) {
             return (weapon && IsBusy(weapon));
     });
 
@@ -223,9 +224,8 @@ bool BanditBoss::CanLaunchDash() const noexcept {
             && m_previousState == State::FIRECLOUD_ATTACK 
             && m_currentState != m_previousState
         );
-        auto player = getParent()->getChildByName<Unit*>(core::EntityNames::PLAYER);
         float bossX = getPositionX();
-        float playerX = player->getPositionX();
+        float playerX = snapshot.targetPosition.x;
         float duration { m_animator->GetDuration(Utils::EnumCast(State::DASH)) };
         float dashDistance = duration * m_boss->weapons.dash.velocity[0];
         // health > 50%? player is quite far from the boss
@@ -239,12 +239,12 @@ bool BanditBoss::CanLaunchDash() const noexcept {
 }
 
 void BanditBoss::LaunchBasicAttack() {
-    assert(m_weapons[BASIC_ATTACK]->IsReady() 
+    assert(m_weapons[BASIC_ATTACK].IsReady() 
         && !IsDead() 
         && "You don't check condition beforehand"
     );
     // create projectile - area where the chains are dealing damage
-    m_weapons[BASIC_ATTACK]->LaunchAttack();
+    m_weapons[BASIC_ATTACK].LaunchAttack();
 }
 
 /**
@@ -255,19 +255,18 @@ void BanditBoss::LaunchBasicAttack() {
  * 3. Player is close enough to attack him
  * 4. No other attacks performed
  */
-bool BanditBoss::CanLaunchBasicAttack() const noexcept {
-    const auto player =getParent()->getChildByName<Unit*>(core::EntityNames::PLAYER);
-    assert(player && !IsDead() && "Expected to be called only satisfying those conditions");
-    if (m_weapons[BASIC_ATTACK]->IsReady()) {
-        const auto attackRange { m_weapons[BASIC_ATTACK]->GetRange()};
+bool BanditBoss::CanLaunchBasicAttack(const Snapshot& snapshot) const noexcept {
+    assert(snapshot.hasTarget && !IsDead() && "Expected to be called only satisfying those conditions");
+    if (m_weapons[BASIC_ATTACK].IsReady()) {
+        const auto attackRange { m_weapons[BASIC_ATTACK].GetRange()};
         const cocos2d::Rect aggroArea { 
            getPosition() - cocos2d::Vec2 { attackRange + m_contentSize.width / 2.f, 0.f }, 
             cocos2d::Size { 2 * attackRange + m_contentSize.width, m_contentSize.height } // aggro area size
         };
-        const auto playerSize { player->getContentSize() };
+        const auto playerSize { snapshot.targetSize };
         const cocos2d::Rect boundingBox {
             // substract half cuz it has anchor point bottom-middle
-            player->getPosition() - cocos2d::Vec2{ playerSize.width / 2.f, 0.f }, 
+            snapshot.targetPosition - cocos2d::Vec2{ playerSize.width / 2.f, 0.f }, 
             playerSize
         };
         return aggroArea.intersectsRect(boundingBox);
@@ -276,61 +275,70 @@ bool BanditBoss::CanLaunchBasicAttack() const noexcept {
     return false;
 }
 
-void BanditBoss::TryAttack() {
+Command BanditBoss::Decide(const Snapshot& snapshot) const noexcept {
     assert(!IsDead());
-    const auto target = getParent()->getChildByName<Unit*>(core::EntityNames::PLAYER);
     const auto canBeInterrupted = (m_currentState == State::WALK 
         || m_currentState == State::IDLE
         || m_currentState == State::BASIC_WALK
     );
-    if (target && canBeInterrupted) {
-        if (CanLaunchDash()) {
-           LookAt(target->getPosition());
-            Stop(Movement::Axis::XY);
-           LaunchDash();
+    Command command;
+    if (snapshot.hasTarget && canBeInterrupted) {
+        // every attack is launched facing the target
+        command.actions = Command::TURN | Command::STOP | Command::ATTACK;
+        command.point = snapshot.targetPosition;
+        if (CanLaunchDash(snapshot)) {
+            command.attack = WeaponClass::DASH;
         }
-        else if (CanLaunchSweepAttack()) {
+        else if (CanLaunchSweepAttack(snapshot)) {
             // if player is in range and SWEEP can be performed -> perform jump attack
-           LookAt(target->getPosition());
-            Stop(Movement::Axis::XY);
-           LaunchSweepAttack();
+            command.attack = WeaponClass::SWEEP_ATTACK;
         }
-        else if (CanLaunchBasicAttack()) {
+        else if (CanLaunchBasicAttack(snapshot)) {
             // if player is in range and SWING can be performed -> invoke basic attack
-           LookAt(target->getPosition());
-            Stop(Movement::Axis::XY);
-           LaunchBasicAttack();
+            command.attack = WeaponClass::BASIC_ATTACK;
         }
-        else if (CanLaunchFireballs()) {
+        else if (CanLaunchFireballs(snapshot)) {
             // fireballs
-           LookAt(target->getPosition());
-            Stop(Movement::Axis::XY);
-           LaunchFireballs();
+            command.attack = WeaponClass::FIREBALL_ATTACK;
         }
-        else if (CanLaunchFirecloud()) {
-           LookAt(target->getPosition());
-            Stop(Movement::Axis::XY);
-           LaunchFirecloud();
+        else if (CanLaunchFirecloud(snapshot)) {
+            command.attack = WeaponClass::FIRECLOUD_ATTACK;
         }
         else if (m_detectEnemy) {
-            const auto player = target;
             bool playerIsNear { false };
-            if (!player->IsDead()) {
-                const auto bossX =getPositionX();
-                const auto playerX = player->getPositionX();
+            if (!snapshot.isTargetDead) {
+                const auto bossX = getPositionX();
+                const auto playerX = snapshot.targetPosition.x;
                 playerIsNear = std::fabs(bossX - playerX) <= m_contentSize.width / 2.f;
             }
-
+            command.actions = 0U;
             /// Move towards player:
             if (!playerIsNear) {
-               LookAt(target->getPosition());
                 using Move = Movement::Direction;
-                MoveAlong(IsLookingLeft()? Move::LEFT: Move::RIGHT);
+                command.actions = Command::TURN | Command::MOVE;
+                command.direction = snapshot.targetPosition.x < getPositionX()? Move::LEFT: Move::RIGHT;
             }
         }
         else {
-           LookAt(target->getPosition());
-            Stop(Movement::Axis::XY);
+            command.actions = Command::TURN | Command::STOP;
+        }
+    }
+    return command;
+}
+
+void BanditBoss::Apply(const Command& command) {
+    // the attack is chosen by the command, not by `Attack`
+    auto movement { command };
+    movement.actions &= ~Command::ATTACK;
+    Bot::Apply(movement);
+    if (command.Has(Command::ATTACK)) {
+        switch (command.attack) {
+            case WeaponClass::DASH: LaunchDash(); break;
+            case WeaponClass::SWEEP_ATTACK: LaunchSweepAttack(); break;
+            case WeaponClass::BASIC_ATTACK: LaunchBasicAttack(); break;
+            case WeaponClass::FIREBALL_ATTACK: LaunchFireballs(); break;
+            case WeaponClass::FIRECLOUD_ATTACK: LaunchFirecloud(); break;
+            default: assert(false && "Unknown attack"); break;
         }
     }
 }
@@ -389,7 +397,7 @@ void BanditBoss::UpdateAnimation() {
 
 void BanditBoss::OnDeath() {
     removeComponent(getPhysicsBody());
-    getChildByName("health")->removeFromParent();
+    RemoveHealthBar();
     m_animator->EndWith([this]() {
        runAction(cocos2d::RemoveSelf::create(true));
     });
@@ -427,8 +435,7 @@ void BanditBoss::AddPhysicsBody() {
 }
 
 void BanditBoss::AddAnimator() {
-    std::string chachedArmatureName = m_dragonBonesName;
-    std::string prefix = m_dragonBonesName + "/" + m_dragonBonesName;
+    auto [prefix, chachedArmatureName] = assets::GetNestedSkeleton(m_dragonBonesName);
     m_animator = dragonBones::Animator::create(std::move(prefix), std::move(chachedArmatureName));
     // TODO: introduce multi-resolution scaling
     m_animator->setScale(0.2f); 
@@ -455,37 +462,15 @@ void BanditBoss::AddWeapons() {
         float attackDuration { 0.4f * animDuration };
         float preparationTime { animDuration - attackDuration };
 
-        auto genPos = [this]() -> cocos2d::Rect {
-            const auto attackRange { m_weapons[FIREBALL_ATTACK]->GetRange() * 0.25f };
-
-            auto position = getPosition();
-            if (m_side == Side::RIGHT) {
-                position.x += m_contentSize.width / 2.f;
-            }
-            else {
-                position.x -= m_contentSize.width / 2.f + attackRange;
-            }
-            // shift a little bit higher to avoid immediate collision with the ground
-            position.y += m_contentSize.height * 0.2f;
-            cocos2d::Rect attackedArea { position, cocos2d::Size { 
-                m_weapons[FIREBALL_ATTACK]->GetRange() * 2.f
-                , m_contentSize.height * 1.05f } // a little bigger than the designed size
-            };
-            return attackedArea;
-        };
-        auto genVel = [this](cocos2d::PhysicsBody* body) {
-            float xSpeed = m_boss->weapons.firebook.projectile.velocity[0];
-            body->setVelocity({ IsLookingLeft()? -xSpeed: xSpeed, 0.f });
-        };
-
-        auto& weapon = m_weapons[WeaponClass::FIREBALL_ATTACK];
-        weapon.reset(new BossFireball(firebook.projectile.damage
+        m_weapons[WeaponClass::FIREBALL_ATTACK] = m_weaponSystem->Add(this
+            , WeaponSystem::Kind::BOSS_FIREBALL
+            , WeaponClass::FIREBALL_ATTACK
+            , firebook.projectile.damage
             , firebook.range
             , preparationTime
             , attackDuration
-            , firebook.cooldown));
-        weapon->AddPositionGenerator(std::move(genPos));
-        weapon->AddVelocityGenerator(std::move(genVel));
+            , firebook.cooldown
+        );
     }
     {
         const auto& firecloud = m_boss->weapons.firecloud;
@@ -493,35 +478,78 @@ void BanditBoss::AddWeapons() {
         float attackDuration { 0.4f * animDuration };
         float preparationTime { animDuration - attackDuration };
 
-        auto genPos = [this]() -> cocos2d::Rect {
-            auto attackRange { m_weapons[FIRECLOUD_ATTACK]->GetRange()};
-            auto position = getPosition();
-            position.y += m_contentSize.height;
-            return { position, cocos2d::Size{ attackRange, m_contentSize.height * 0.35f } };
-        };
-        auto genVel = [dx = firecloud.impulse[0], dy = firecloud.impulse[1]](cocos2d::PhysicsBody* body) {
-            cocos2d::Vec2 impulse { dx, body->getMass() * dy };
-            body->applyImpulse(impulse);
-        };
-
-        auto& weapon = m_weapons[WeaponClass::FIRECLOUD_ATTACK];
-        weapon.reset(new BossFireCloud(0.f
+        m_weapons[WeaponClass::FIRECLOUD_ATTACK] = m_weaponSystem->Add(this
+            , WeaponSystem::Kind::BOSS_FIRECLOUD
+            , WeaponClass::FIRECLOUD_ATTACK
+            , 0.f
             , firecloud.range
             , preparationTime
             , attackDuration
             , firecloud.cooldown
-            , m_cloud));
-        weapon->AddPositionGenerator(std::move(genPos));
-        weapon->AddVelocityGenerator(std::move(genVel));
+        );
     }
     {
         const auto& chainSweeper = m_boss->weapons.chainSweep;
         float animDuration = m_animator->GetDuration(Utils::EnumCast(State::SWEEP_ATTACK));
         float attackDuration { 0.4f * animDuration };
         float preparationTime { animDuration - attackDuration };
-        
-        auto genPos = [this]() -> cocos2d::Rect {
-            auto attackRange { m_weapons[SWEEP_ATTACK]->GetRange()};
+
+        m_weapons[WeaponClass::SWEEP_ATTACK] = m_weaponSystem->Add(this
+            , WeaponSystem::Kind::BOSS_CHAIN_SWEEP
+            , WeaponClass::SWEEP_ATTACK
+            , chainSweeper.projectile.damage
+            , chainSweeper.range
+            , preparationTime
+            , attackDuration
+            , chainSweeper.cooldown
+        );
+    }
+    {
+        const auto& chainSwing = m_boss->weapons.chainSwing;
+        float animDuration = m_animator->GetDuration(Utils::EnumCast(State::BASIC_ATTACK));
+        float attackDuration { 0.8f * animDuration };
+        float preparationTime { animDuration - attackDuration };
+
+        m_weapons[WeaponClass::BASIC_ATTACK] = m_weaponSystem->Add(this
+            , WeaponSystem::Kind::BOSS_CHAIN_SWING
+            , WeaponClass::BASIC_ATTACK
+            , chainSwing.projectile.damage
+            , chainSwing.range
+            , preparationTime
+            , attackDuration
+            , chainSwing.cooldown
+        );
+    }
+}
+
+cocos2d::Rect BanditBoss::GetAttackArea(size_t weapon) const {
+    switch (weapon) {
+        case WeaponClass::FIREBALL_ATTACK: {
+            const auto attackRange { m_weapons[FIREBALL_ATTACK].GetRange() * 0.25f };
+
+            auto position = getPosition();
+            if (m_side == Side::RIGHT) {
+                position.x += m_contentSize.width / 2.f;
+            }
+            else {
+                position.x -= m_contentSize.width / 2.f + attackRange;
+            }
+            // shift a little bit higher to avoid immediate collision with the ground
+            position.y += m_contentSize.height * 0.2f;
+            cocos2d::Rect attackedArea { position, cocos2d::Size { 
+                m_weapons[FIREBALL_ATTACK].GetRange() * 2.f
+                , m_contentSize.height * 1.05f } // a little bigger than the designed size
+            };
+            return attackedArea;
+        }
+        case WeaponClass::FIRECLOUD_ATTACK: {
+            auto attackRange { m_weapons[FIRECLOUD_ATTACK].GetRange()};
+            auto position = getPosition();
+            position.y += m_contentSize.height;
+            return { position, cocos2d::Size{ attackRange, m_contentSize.height * 0.35f } };
+        }
+        case WeaponClass::SWEEP_ATTACK: {
+            auto attackRange { m_weapons[SWEEP_ATTACK].GetRange()};
             cocos2d::Size area { attackRange, attackRange };
 
             auto position = getPosition();
@@ -534,28 +562,9 @@ void BanditBoss::AddWeapons() {
             position.y -= m_contentSize.height / 3.f;
 
             return { position, area };
-        };
-        auto genVel = [this](cocos2d::PhysicsBody* body) {
-            body->setVelocity(getPhysicsBody()->getVelocity());
-        };
-        
-        auto& weapon = m_weapons[WeaponClass::SWEEP_ATTACK];
-        weapon.reset(new BossChainSweep(chainSweeper.projectile.damage
-            , chainSweeper.range
-            , preparationTime
-            , attackDuration
-            , chainSweeper.cooldown));
-        weapon->AddPositionGenerator(std::move(genPos));
-        weapon->AddVelocityGenerator(std::move(genVel));
-    }
-    {
-        const auto& chainSwing = m_boss->weapons.chainSwing;
-        float animDuration = m_animator->GetDuration(Utils::EnumCast(State::BASIC_ATTACK));
-        float attackDuration { 0.8f * animDuration };
-        float preparationTime { animDuration - attackDuration };
-
-        auto genPos = [this]() -> cocos2d::Rect {
-            auto attackRange { m_weapons[BASIC_ATTACK]->GetRange()};
+        }
+        case WeaponClass::BASIC_ATTACK: {
+            auto attackRange { m_weapons[BASIC_ATTACK].GetRange()};
             cocos2d::Size area { attackRange, attackRange / 4.f };
 
             auto position = getPosition();
@@ -568,19 +577,30 @@ void BanditBoss::AddWeapons() {
             position.y += m_contentSize.height / 4.f;
 
             return { position, area };
-        };
-        auto genVel = [this](cocos2d::PhysicsBody* body) {
-            body->setVelocity(getPhysicsBody()->getVelocity());
-        };
+        }
+        default: assert(false && "Unknown weapon"); break;
+    }
+    return {};
+}
 
-        auto& weapon = m_weapons[WeaponClass::BASIC_ATTACK];
-        weapon.reset(new BossChainSwing(chainSwing.projectile.damage
-            , chainSwing.range
-            , preparationTime
-            , attackDuration
-            , chainSwing.cooldown));
-        weapon->AddPositionGenerator(std::move(genPos));
-        weapon->AddVelocityGenerator(std::move(genVel));
+void BanditBoss::PushProjectile(size_t weapon, cocos2d::PhysicsBody * body) const {
+    switch (weapon) {
+        case WeaponClass::FIREBALL_ATTACK: {
+            float xSpeed = m_boss->weapons.firebook.projectile.velocity[0];
+            body->setVelocity({ IsLookingLeft()? -xSpeed: xSpeed, 0.f });
+        } break;
+        case WeaponClass::FIRECLOUD_ATTACK: {
+            const auto& firecloud = m_boss->weapons.firecloud;
+            cocos2d::Vec2 impulse { firecloud.impulse[0], body->getMass() * firecloud.impulse[1] };
+            body->applyImpulse(impulse);
+        } break;
+        case WeaponClass::SWEEP_ATTACK: {
+            body->setVelocity(getPhysicsBody()->getVelocity());
+        } break;
+        case WeaponClass::BASIC_ATTACK: {
+            body->setVelocity(getPhysicsBody()->getVelocity());
+        } break;
+        default: assert(false && "Unknown weapon"); break;
     }
 }
 
@@ -40,6 +40,16 @@ public:
 
     void OnEnemyLeave() override;
 
+/// Weapon interface
+
+    [[nodiscard]] cocos2d::Rect GetAttackArea(size_t weapon) const;
+
+    void PushProjectile(size_t weapon, cocos2d::PhysicsBody * body) const;
+
+    [[nodiscard]] const json_models::UnitsFirecloud* GetCloudModel() const noexcept {
+        return m_cloud;
+    }
+
 protected:
 
     enum WeaponClass { 
@@ -87,7 +97,7 @@ private:
      * 2. Player exist and is alive
      * 3. No other attacks performed
      */
-    bool CanLaunchFireballs() const noexcept;
+    bool CanLaunchFireballs(const Snapshot& snapshot) const noexcept;
 
     /**
      * Check whether FIRECLOUD_ATTACK can be launched.
@@ -97,7 +107,7 @@ private:
      * 3. health is <= 50% 
      * 4. No other attacks performed
      */
-    bool CanLaunchFirecloud() const noexcept;
+    bool CanLaunchFirecloud(const Snapshot& snapshot) const noexcept;
     
     /**
      * Check whether SWEEP_ATTACK can be launched.
@@ -107,7 +117,7 @@ private:
      * 3. Player is in jump range
      * 4. No other attacks performed
      */
-    bool CanLaunchSweepAttack() const noexcept;
+    bool CanLaunchSweepAttack(const Snapshot& snapshot) const noexcept;
 
     /**
      * Check whether DASH can be launched.
@@ -118,7 +128,7 @@ private:
      * 4. health > 50%? player is quite far from the boss
      * 5. No other attacks performed
      */
-    bool CanLaunchDash() const noexcept;
+    bool CanLaunchDash(const Snapshot& snapshot) const noexcept;
     
     /**
      * Check whether BASIC_ATTACK can be launched.
@@ -128,11 +138,15 @@ private:
      * 3. Player is close enough to attack him
      * 4. No other attacks performed
      */
-    bool CanLaunchBasicAttack() const noexcept;
+    bool CanLaunchBasicAttack(const Snapshot& snapshot) const noexcept;
 
-/// Bot interface
+/// Decision interface
+
+    [[nodiscard]] Command Decide(const Snapshot& snapshot) const noexcept override;
 
-    void TryAttack() override;
+    void Apply(const Command& command) override;
+
+/// Bot interface
    
     void UpdateState(const float dt) noexcept override;
 
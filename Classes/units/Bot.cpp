@@ -5,7 +5,7 @@
 #include "Settings.hpp"
 
 #include "components/Influence.hpp"
-#include "components/Weapon.hpp"
+#include "components/WeaponSystem.hpp"
 #include "components/DragonBonesAnimator.hpp"
 #include "components/Movement.hpp"
 
@@ -59,22 +59,52 @@ Bot::Bot(size_t id, const std::string& dragonBonesName):
     m_hitBoxSize = m_physicsBodySize;
 }
 
-bool Bot::NeedAttack() const noexcept {
+void Bot::onEnter() {
+    Unit::onEnter();
+    m_planner = BotPlanner::Find(this);
+    if (m_planner) {
+        m_plannerId = m_planner->Add(this);
+    }
+}
+
+void Bot::onExit() {
+    if (m_planner) {
+        m_planner->Remove(m_plannerId);
+        m_planner = nullptr;
+        m_plannerId = BotPlanner::INVALID_BOT;
+    }
+    Unit::onExit();
+}
+
+void Bot::pause() {
+    Unit::pause();
+    if (m_planner) {
+        m_planner->SetActive(m_plannerId, false);
+    }
+}
+
+void Bot::resume() {
+    Unit::resume();
+    if (m_planner) {
+        m_planner->SetActive(m_plannerId, true);
+    }
+}
+
+bool Bot::NeedAttack(const Snapshot& snapshot) const noexcept {
     assert(!IsDead());
     constexpr auto MELEE { 0U };
     bool attackIsReady { 
         m_detectEnemy && 
-        m_weapons[MELEE]->IsReady()
+        m_weapons[MELEE].IsReady()
     };
-    auto enemyIsClose = [this, MELEE]() { 
-        const auto target = this->getParent()->getChildByName<const Unit*>(core::EntityNames::PLAYER);
+    auto enemyIsClose = [this, MELEE, &snapshot]() { 
         // use some simple algorithm to determine whether a player is close enough to the target
         // to perform an attack
-        if(target && !target->IsDead()) {
-            const auto radius = m_weapons[MELEE]->GetRange();
+        if(snapshot.hasTarget && !snapshot.isTargetDead) {
+            const auto radius = m_weapons[MELEE].GetRange();
             const cocos2d::Rect lhs { 
-                target->getPosition() - cocos2d::Vec2{ target->GetHitBox().width / 2.f, 0.f },
-                target->GetHitBox()
+                snapshot.targetPosition - cocos2d::Vec2{ snapshot.targetHitBox.width / 2.f, 0.f },
+                snapshot.targetHitBox
             };
             const cocos2d::Rect rhs { // check attack in both directions
                 this->getPosition() - cocos2d::Vec2 { m_contentSize.width / 2.f + radius, 0.f },
@@ -87,14 +117,29 @@ bool Bot::NeedAttack() const noexcept {
     return attackIsReady && enemyIsClose();
 }
 
-void Bot::TryAttack() {
+Command Bot::Decide(const Snapshot& snapshot) const noexcept {
     assert(!IsDead());
-    const auto target = getParent()->getChildByName(core::EntityNames::PLAYER);
-    if (target && NeedAttack()) { // attack if possible
-        LookAt(target->getPosition());
+    Command command;
+    if (snapshot.hasTarget && NeedAttack(snapshot)) { // attack if possible
+        command.actions = Command::TURN | Command::STOP | Command::ATTACK;
+        command.point = snapshot.targetPosition;
+    }
+    return command;
+}
+
+void Bot::Apply(const Command& command) {
+    if (command.Has(Command::TURN)) {
+        LookAt(command.point);
+    }
+    if (command.Has(Command::STOP)) {
         Stop(Movement::Axis::XY);
+    }
+    if (command.Has(Command::MOVE)) {
+        MoveAlong(command.direction);
+    }
+    if (command.Has(Command::ATTACK)) {
         Attack();
-    } 
+    }
 }
 
 void Bot::UpdateDebugLabel() noexcept {
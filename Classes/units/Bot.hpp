@@ -4,6 +4,7 @@
 #include "cocos2d.h"
 
 #include "Unit.hpp"
+#include "BotPlanner.hpp"
 #include <string>
 
 class Influence;
@@ -49,6 +50,18 @@ class Bot : public Unit {
 public:
 
     [[nodiscard]] bool init() override;
+
+    /**
+     * Register the bot in the level's planner
+     * @note call this method at the begining of the overriden one
+     */
+    void onEnter() override;
+
+    void onExit() override;
+
+    void pause() override;
+
+    void resume() override;
     
     inline size_t GetId() const noexcept;
 
@@ -58,15 +71,27 @@ public:
 
     virtual void OnEnemyLeave() = 0;
 
+/// Decision interface
+
+    /**
+     * Choose what to do in this tick, by default attack the target when possible.
+     * Runs on the planner's worker threads: read only the own state and
+     * the snapshot, don't modify anything.
+     */
+    [[nodiscard]] virtual Command Decide(const Snapshot& snapshot) const noexcept;
+
+    /**
+     * Carry out the decided command. Runs on the main thread.
+     */
+    virtual void Apply(const Command& command);
+
 protected:
 
     Bot(size_t id, const std::string& dragonBonesName);
     
     void UpdateDebugLabel() noexcept override;
 
-    virtual void TryAttack();
-
-    virtual bool NeedAttack() const noexcept;
+    virtual bool NeedAttack(const Snapshot& snapshot) const noexcept;
 
     /// Properties:
 protected:
@@ -79,6 +104,11 @@ protected:
 
     Influence * m_influence { nullptr };
 
+    // level's planner, available while the bot is running
+    BotPlanner * m_planner { nullptr };
+
+    uint32_t m_plannerId { UINT32_MAX };
+
 private:
     const size_t m_id { 0 };
 
@@ -1,9 +1,11 @@
 #include "BoulderPusher.hpp"
 #include "Player.hpp"
 #include "Core.hpp"
+#include "FrameSampler.hpp"
+#include "Profiler.hpp"
 
 #include "components/DragonBonesAnimator.hpp"
-#include "components/Weapon.hpp"
+#include "components/WeaponSystem.hpp"
 #include "components/Movement.hpp"
 
 #include "configs/JsonUnits.hpp"
@@ -31,7 +33,7 @@ BoulderPusher::BoulderPusher(size_t id
     , const cocos2d::Size& contentSize
     , const json_models::BoulderPusher *model
 )
-    : Bot{ id, core::EntityNames::BOULDER_PUSHER }
+    : Bot{ id, model->dragonbones }
     , m_model { model }
 {
     assert(model);
@@ -39,6 +41,7 @@ BoulderPusher::BoulderPusher(size_t id
     m_physicsBodySize = cocos2d::Size{ contentSize.width * 0.75f, contentSize.height };
     m_hitBoxSize = m_physicsBodySize;
     m_health = m_model->health;
+    m_frameCacheRate = static_cast<unsigned>(m_model->frameCache);
 }
 
 bool BoulderPusher::init() {
@@ -49,13 +52,13 @@ bool BoulderPusher::init() {
 }
 
 void BoulderPusher::update(float dt) {
+    const bench::ScopedSample sample { bench::Subsystem::UNITS };
+    PROFILE_ZONE("BoulderPusher::update");
     // update components
     cocos2d::Node::update(dt);
     // custom updates
     UpdateDebugLabel();
     if (!IsDead()) {
-        UpdateWeapons(dt);
-        TryAttack();
         UpdateCurses(dt);
     }
     UpdateState(dt);
@@ -76,10 +79,10 @@ void BoulderPusher::UpdateState(const float dt) noexcept {
     if (m_health <= 0) {
         m_currentState = State::DEAD;
     }
-    else if (m_weapons[WeaponClass::RANGE]->IsPreparing()) {
+    else if (m_weapons[WeaponClass::RANGE].IsPreparing()) {
         m_currentState = State::PREPARE_ATTACK;
     }
-    else if (m_weapons[WeaponClass::RANGE]->IsAttacking()) {
+    else if (m_weapons[WeaponClass::RANGE].IsAttacking()) {
         m_currentState = State::ATTACK;
     }
     else {
@@ -103,7 +106,7 @@ void BoulderPusher::UpdateAnimation() {
 
 void BoulderPusher::OnDeath() {
     removeComponent(getPhysicsBody());
-    getChildByName("health")->removeFromParent();
+    RemoveHealthBar();
     m_animator->EndWith([this]() {
         runAction(cocos2d::RemoveSelf::create(true));
     });
@@ -167,49 +170,51 @@ void BoulderPusher::AddWeapons() {
     const auto preparationTime { 0.4f };
     const auto attackDuration { m_animator->GetDuration(Utils::EnumCast(State::ATTACK)) - preparationTime };
 
-    auto genPos = [this]() -> cocos2d::Rect {
-        auto radius { m_weapons[WeaponClass::RANGE]->GetRange() };
-        cocos2d::Size stoneSize { radius * 2.f, radius * 2.f };
-
-        auto position = getPosition();
-        if (IsLookingLeft()) {
-            position.x -= m_contentSize.width / 2.f + stoneSize.width;
-        }
-        else {
-            position.x += m_contentSize.width / 2.f;
-        }
-        return { position, stoneSize };
-    };
-    auto genVel = [this](cocos2d::PhysicsBody* body) {
-        const auto& legs = m_model->weapons.legs;
-        cocos2d::Vec2 impulse { body->getMass() * legs.projectile.impulse[0], 0.f };
-        if (IsLookingLeft()) {
-            impulse.x *= -1.f;
-        }
-        body->applyImpulse(impulse);
-        body->setAngularVelocity(impulse.x > 0.f? -legs.projectile.angular[0]: legs.projectile.angular[0]);
-    };
-
-    auto& weapon = m_weapons[WeaponClass::RANGE];
-    weapon.reset(new Legs(legs.projectile.damage
+    m_weapons[WeaponClass::RANGE] = m_weaponSystem->Add(this
+        , WeaponSystem::Kind::LEGS
+        , WeaponClass::RANGE
+        , legs.projectile.damage
         , legs.range
         , preparationTime
         , attackDuration
-        , legs.cooldown));
-    weapon->AddPositionGenerator(std::move(genPos));
-    weapon->AddVelocityGenerator(std::move(genVel));
+        , legs.cooldown
+    );
+}
+
+cocos2d::Rect BoulderPusher::GetAttackArea(size_t weapon) const {
+    auto radius { m_weapons[WeaponClass::RANGE].GetRange() };
+    cocos2d::Size stoneSize { radius * 2.f, radius * 2.f };
+
+    auto position = getPosition();
+    if (IsLookingLeft()) {
+        position.x -= m_contentSize.width / 2.f + stoneSize.width;
+    }
+    else {
+        position.x += m_contentSize.width / 2.f;
+    }
+    return { position, stoneSize };
+}
+
+void BoulderPusher::PushProjectile(size_t weapon, cocos2d::PhysicsBody * body) const {
+    const auto& legs = m_model->weapons.legs;
+    cocos2d::Vec2 impulse { body->getMass() * legs.projectile.impulse[0], 0.f };
+    if (IsLookingLeft()) {
+        impulse.x *= -1.f;
+    }
+    body->applyImpulse(impulse);
+    body->setAngularVelocity(impulse.x > 0.f? -legs.projectile.angular[0]: legs.projectile.angular[0]);
 }
 
-bool BoulderPusher::NeedAttack() const noexcept {
+bool BoulderPusher::NeedAttack(const Snapshot&) const noexcept {
     assert(!IsDead());
-    return m_detectEnemy && m_weapons[WeaponClass::RANGE]->IsReady();
+    return m_detectEnemy && m_weapons[WeaponClass::RANGE].IsReady();
 }
 
 void BoulderPusher::Attack() {
     assert(!IsDead());
-    assert(m_weapons[WeaponClass::RANGE]->IsReady());
+    assert(m_weapons[WeaponClass::RANGE].IsReady());
 
-    m_weapons[WeaponClass::RANGE]->LaunchAttack();
+    m_weapons[WeaponClass::RANGE].LaunchAttack();
 }
 
 } // namespace Enemies
\ No newline at end of file
@@ -1,9 +1,11 @@
 #include "Cannon.hpp"
 #include "Player.hpp"
 #include "Core.hpp"
+#include "FrameSampler.hpp"
+#include "Profiler.hpp"
 
 #include "components/DragonBonesAnimator.hpp"
-#include "components/Weapon.hpp"
+#include "components/WeaponSystem.hpp"
 #include "components/Movement.hpp"
 
 #include "configs/JsonUnits.hpp"
@@ -33,7 +35,7 @@ Cannon::Cannon(size_t id
     , float scale
     , const json_models::UnitsCannon *model
 )
-    : Bot{ id, core::EntityNames::CANNON }
+    : Bot{ id, model->dragonbones }
     , m_scale { scale }
     , m_model { model }
 {
@@ -42,6 +44,7 @@ Cannon::Cannon(size_t id
     m_physicsBodySize = cocos2d::Size { contentSize.width * 0.875f, contentSize.height };
     m_hitBoxSize = m_physicsBodySize;
     m_health = m_model->health;
+    m_frameCacheRate = static_cast<unsigned>(m_model->frameCache);
 }
 
 bool Cannon::init() {
@@ -52,13 +55,13 @@ bool Cannon::init() {
 }
 
 void Cannon::update(float dt) {
+    const bench::ScopedSample sample { bench::Subsystem::UNITS };
+    PROFILE_ZONE("Cannon::update");
     // update components
     cocos2d::Node::update(dt);
     // custom updates
     UpdateDebugLabel();
     if (!IsDead()) {
-        UpdateWeapons(dt);
-        TryAttack();
         UpdateCurses(dt);
     }
     UpdateState(dt);
@@ -66,7 +69,7 @@ void Cannon::update(float dt) {
 }
 
 void Cannon::onEnter() {
-    cocos2d::Node::onEnter();
+    Bot::onEnter();
     
     if (IsLookingLeft()) {
         m_animator->setPositionX(-m_contentSize.width / 2.f);
@@ -91,10 +94,10 @@ void Cannon::UpdateState(const float dt) noexcept {
     if (m_health <= 0) {
         m_currentState = State::DEAD;
     }
-    else if (m_weapons[WeaponClass::RANGE]->IsPreparing()) {
+    else if (m_weapons[WeaponClass::RANGE].IsPreparing()) {
         m_currentState = State::PREPARE_ATTACK;
     }
-    else if (m_weapons[WeaponClass::RANGE]->IsAttacking()) {
+    else if (m_weapons[WeaponClass::RANGE].IsAttacking()) {
         m_currentState = State::ATTACK;
     }
     else {
@@ -119,7 +122,7 @@ void Cannon::UpdateAnimation() {
 
 void Cannon::OnDeath() {
     removeComponent(getPhysicsBody());
-    getChildByName("health")->removeFromParent();
+    RemoveHealthBar();
     m_animator->EndWith([this]() {
         runAction(cocos2d::RemoveSelf::create(true));
     });
@@ -175,56 +178,57 @@ void Cannon::AddWeapons() {
     // The projectile need to be created only when the attack-animation ends
     float preparationTime { m_animator->GetDuration(Utils::EnumCast(State::ATTACK)) }; /// TODO: update animation!
     float attackDuration { 0.1f };
-    
-    auto genPos = [this]()->cocos2d::Rect {
-        auto attackRange { m_weapons[WeaponClass::RANGE]->GetRange() };
-        cocos2d::Size stake { attackRange, floorf(attackRange / 8.5f) };
-
-        auto position = getPosition();
-        if (IsLookingLeft()) {
-            position.x -= m_contentSize.width / 2.f + stake.width;
-        }
-        else {
-            position.x += m_contentSize.width / 2.f;
-        }
-        position.y += m_contentSize.height / 2.f - stake.height / 2.f;
-
-        return { position, stake };
-    };
-    auto genVel = [this](cocos2d::PhysicsBody* body) {
-        float xSpeed = m_model->weapons.cannon.projectile.velocity[0];
-        body->setVelocity({ IsLookingLeft()? -xSpeed: xSpeed, 0.f });
-    };
 
-    auto& weapon = m_weapons[WeaponClass::RANGE];
-    weapon.reset(new Stake(cannon.projectile.damage
+    m_weapons[WeaponClass::RANGE] = m_weaponSystem->Add(this
+        , WeaponSystem::Kind::STAKE
+        , WeaponClass::RANGE
+        , cannon.projectile.damage
         , cannon.range
         , preparationTime
         , attackDuration
-        , cannon.cooldown));
-    weapon->AddPositionGenerator(std::move(genPos));
-    weapon->AddVelocityGenerator(std::move(genVel));
+        , cannon.cooldown
+    );
 }
 
-void Cannon::TryAttack() {
-    assert(!IsDead());
+cocos2d::Rect Cannon::GetAttackArea(size_t weapon) const {
+    auto attackRange { m_weapons[WeaponClass::RANGE].GetRange() };
+    cocos2d::Size stake { attackRange, floorf(attackRange / 8.5f) };
 
-    const auto target = getParent()->getChildByName(core::EntityNames::PLAYER);
-    if (target && NeedAttack()) { // attack if possible
-        Stop(Movement::Axis::XY);
-        Attack();
-    } 
+    auto position = getPosition();
+    if (IsLookingLeft()) {
+        position.x -= m_contentSize.width / 2.f + stake.width;
+    }
+    else {
+        position.x += m_contentSize.width / 2.f;
+    }
+    position.y += m_contentSize.height / 2.f - stake.height / 2.f;
+
+    return { position, stake };
+}
+
+void Cannon::PushProjectile(size_t weapon, cocos2d::PhysicsBody * body) const {
+    float xSpeed = m_model->weapons.cannon.projectile.velocity[0];
+    body->setVelocity({ IsLookingLeft()? -xSpeed: xSpeed, 0.f });
+}
+
+Command Cannon::Decide(const Snapshot& snapshot) const noexcept {
+    assert(!IsDead());
+    Command command;
+    if (snapshot.hasTarget && NeedAttack(snapshot)) { // attack if possible
+        command.actions = Command::STOP | Command::ATTACK;
+    }
+    return command;
 }
 
 void Cannon::Attack() {
     assert(!IsDead());
-    assert(m_weapons[WeaponClass::RANGE]->IsReady());
+    assert(m_weapons[WeaponClass::RANGE].IsReady());
 
-    m_weapons[WeaponClass::RANGE]->LaunchAttack();
+    m_weapons[WeaponClass::RANGE].LaunchAttack();
 }
 
-bool Cannon::NeedAttack() const noexcept {
-    return m_detectEnemy && m_weapons[WeaponClass::RANGE]->IsReady();
+bool Cannon::NeedAttack(const Snapshot&) const noexcept {
+    return m_detectEnemy && m_weapons[WeaponClass::RANGE].IsReady();
 }
 
 } // namespace Enemies
\ No newline at end of file
@@ -35,7 +35,13 @@ public:
      */
     void Attack() override;
 
-    void TryAttack() override;
+    [[nodiscard]] Command Decide(const Snapshot& snapshot) const noexcept override;
+
+/// Weapon interface
+
+    [[nodiscard]] cocos2d::Rect GetAttackArea(size_t weapon) const;
+
+    void PushProjectile(size_t weapon, cocos2d::PhysicsBody * body) const;
 
 private:
     enum WeaponClass{ RANGE };
@@ -59,7 +65,7 @@ private:
 
     void AddWeapons() override;
 
-    bool NeedAttack() const noexcept override;
+    bool NeedAttack(const Snapshot& snapshot) const noexcept override;
 
 private:
 
@@ -1,9 +1,12 @@
 #include "FireCloud.hpp"
 #include "Player.hpp"
 #include "Core.hpp"
+#include "AssetPaths.hpp"
+#include "FrameSampler.hpp"
+#include "Profiler.hpp"
 
 #include "components/DragonBonesAnimator.hpp"
-#include "components/Weapon.hpp"
+#include "components/WeaponSystem.hpp"
 #include "components/Movement.hpp"
 
 #include "configs/JsonUnits.hpp"
@@ -31,13 +34,14 @@ FireCloud::FireCloud(size_t id
     , const cocos2d::Size& contentSize
     , const json_models::UnitsFirecloud *model
 )
-    : Bot{ id, core::EntityNames::FIRECLOUD }
+    : Bot{ id, model->dragonbones }
     , m_model { model }
 {
     assert(model);
     m_contentSize = cocos2d::Size { contentSize.width, contentSize.height * 2.f };
     m_physicsBodySize = m_contentSize;
     m_hitBoxSize = m_physicsBodySize;
+    m_frameCacheRate = static_cast<unsigned>(m_model->frameCache);
 }
 
 bool FireCloud::init() {
@@ -45,9 +49,7 @@ bool FireCloud::init() {
         return false; 
     }
 
-    if (auto healthBar = getChildByName("health"); healthBar) {
-        healthBar->removeFromParent();
-    }
+    RemoveHealthBar();
 
     m_health = m_model->health; 
     m_lifetime = m_model->lifetime;
@@ -57,15 +59,16 @@ bool FireCloud::init() {
 }
 
 void FireCloud::update(float dt) {
+    const bench::ScopedSample sample { bench::Subsystem::UNITS };
+    PROFILE_ZONE("FireCloud::update");
     cocos2d::Node::update(dt);
     // custom updates
     UpdateDebugLabel();
     if (!IsDead()) {
-        UpdateWeapons(dt);
+        UpdateShells(dt);
         UpdatePosition(dt);
         // TODO: remove cuz it's undestructable
         // UpdateCurses(dt);
-        TryAttack();
     }
     UpdateState(dt);
     UpdateAnimation(); 
@@ -85,8 +88,7 @@ void FireCloud::UpdatePosition(const float dt) noexcept {
     m_movement->Update();
 }
 
-void FireCloud::UpdateWeapons(const float dt) noexcept {
-    Unit::UpdateWeapons(dt);
+void FireCloud::UpdateShells(const float dt) noexcept {
     if (m_shells <= 0.f) {
         m_shellRenewTimer -= dt;
         if (m_shellRenewTimer <= 0.f) {
@@ -95,10 +97,12 @@ void FireCloud::UpdateWeapons(const float dt) noexcept {
     }
 }
 
-void FireCloud::TryAttack() {
-    if (NeedAttack()) { // attack if possible
-        Attack();
-    } 
+Command FireCloud::Decide(const Snapshot& snapshot) const noexcept {
+    Command command;
+    if (NeedAttack(snapshot)) { // attack if possible
+        command.actions = Command::ATTACK;
+    }
+    return command;
 }
 
 void FireCloud::UpdateState(const float dt) noexcept {
@@ -164,8 +168,7 @@ void FireCloud::AddPhysicsBody() {
 }
 
 void FireCloud::AddAnimator() {
-    std::string chachedArmatureName = m_dragonBonesName;
-    std::string prefix = "boss/boss_cloud";
+    auto [prefix, chachedArmatureName] = assets::GetFireCloudSkeleton(m_dragonBonesName);
     m_animator = dragonBones::Animator::create(std::move(prefix), std::move(chachedArmatureName));
     m_animator->setScale(0.27f);
     m_animator->InitializeAnimations({
@@ -185,48 +188,50 @@ void FireCloud::AddWeapons() {
     const auto preparationTime { 0.f }; 
     const auto attackDuration { 0.1f };
 
-    auto genPos = [this]()->cocos2d::Rect {
-        auto attackRange { m_weapons[WeaponClass::RANGE]->GetRange() };
-        cocos2d::Size fireballSize { attackRange, attackRange * 1.4f };
-
-        auto position = getPosition();
-        position.y -= m_contentSize.height * 0.1f;
-        position.x = static_cast<float>(
-            cocos2d::RandomHelper::random_int(
-                static_cast<int>(position.x - m_contentSize.width / 3.f), 
-                static_cast<int>(position.x + m_contentSize.width / 3.f)
-            )
-        );
-
-        return { position, fireballSize };
-    };
-    auto genVel = [this](cocos2d::PhysicsBody* body) {
-        const auto& velocity = m_model->weapons.fireball.projectile.velocity;
-        body->setVelocity({ IsLookingLeft()? -velocity[0]: velocity[0], -velocity[1] });
-    };
-
     const auto& fireball = m_model->weapons.fireball;
-    auto& weapon = m_weapons[WeaponClass::RANGE];
-    weapon.reset(new CloudFireball(fireball.projectile.damage
+    m_weapons[WeaponClass::RANGE] = m_weaponSystem->Add(this
+        , WeaponSystem::Kind::CLOUD_FIREBALL
+        , WeaponClass::RANGE
+        , fireball.projectile.damage
         , fireball.range
         , preparationTime
         , attackDuration
-        , fireball.cooldown));
-    weapon->AddPositionGenerator(std::move(genPos));
-    weapon->AddVelocityGenerator(std::move(genVel));
+        , fireball.cooldown
+    );
+}
+
+cocos2d::Rect FireCloud::GetAttackArea(size_t weapon) const {
+    auto attackRange { m_weapons[WeaponClass::RANGE].GetRange() };
+    cocos2d::Size fireballSize { attackRange, attackRange * 1.4f };
+
+    auto position = getPosition();
+    position.y -= m_contentSize.height * 0.1f;
+    position.x = static_cast<float>(
+        cocos2d::RandomHelper::random_int(
+            static_cast<int>(position.x - m_contentSize.width / 3.f), 
+            static_cast<int>(position.x + m_contentSize.width / 3.f)
+        )
+    );
+
+    return { position, fireballSize };
+}
+
+void FireCloud::PushProjectile(size_t weapon, cocos2d::PhysicsBody * body) const {
+    const auto& velocity = m_model->weapons.fireball.projectile.velocity;
+    body->setVelocity({ IsLookingLeft()? -velocity[0]: velocity[0], -velocity[1] });
 }
 
 void FireCloud::Attack() {
     if (--m_shells <= 0) {
         m_shellRenewTimer = m_model->shellRefillCooldown;
     }
-    m_weapons[WeaponClass::RANGE]->LaunchAttack();
+    m_weapons[WeaponClass::RANGE].LaunchAttack();
 }
 
-bool FireCloud::NeedAttack() const noexcept {
+bool FireCloud::NeedAttack(const Snapshot&) const noexcept {
     assert(!IsDead());
     return (m_shells 
-        && m_weapons[WeaponClass::RANGE]->IsReady() 
+        && m_weapons[WeaponClass::RANGE].IsReady() 
         && m_currentState == State::LATE);
 }
 
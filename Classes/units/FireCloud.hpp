@@ -33,6 +33,12 @@ public:
      */
     void Attack() override;
 
+/// Weapon interface
+
+    [[nodiscard]] cocos2d::Rect GetAttackArea(size_t weapon) const;
+
+    void PushProjectile(size_t weapon, cocos2d::PhysicsBody * body) const;
+
 private:
     enum WeaponClass{ RANGE };
 
@@ -46,11 +52,9 @@ private:
 
     void UpdateAnimation() override;
 
-    void UpdateWeapons(const float dt) noexcept override;
-
     void UpdatePosition(const float dt) noexcept override;
 
-    void TryAttack() override;
+    [[nodiscard]] Command Decide(const Snapshot& snapshot) const noexcept override;
 
     void OnDeath() override;
     
@@ -60,7 +64,10 @@ private:
 
     void AddWeapons() override;
 
-    bool NeedAttack() const noexcept override;
+    bool NeedAttack(const Snapshot& snapshot) const noexcept override;
+
+    // refill the shells after the cooldown
+    void UpdateShells(const float dt) noexcept;
 
 private:
 
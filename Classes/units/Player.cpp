@@ -5,9 +5,12 @@
 #include "PhysicsHelper.hpp"
 #include "Utils.hpp"
 #include "Core.hpp"
+#include "AssetPaths.hpp"
+#include "FrameSampler.hpp"
+#include "Profiler.hpp"
 #include "Settings.hpp"
 
-#include "components/Weapon.hpp"
+#include "components/WeaponSystem.hpp"
 #include "components/DragonBonesAnimator.hpp"
 #include "components/Movement.hpp"
 #include "components/Dash.hpp"
@@ -38,12 +41,13 @@ Player* Player::create(const cocos2d::Size& contentSize
 Player::Player(const cocos2d::Size& contentSize
     , const json_models::Player *model
 ) 
-    : Unit { core::EntityNames::PLAYER }
+    : Unit { model->dragonbones }
     , m_model { model }
 {
     m_contentSize = contentSize;
     m_physicsBodySize = cocos2d::Size { contentSize.width / 2.f, contentSize.height };
     m_hitBoxSize = contentSize;
+    m_frameCacheRate = static_cast<unsigned>(m_model->frameCache);
 }
 
 bool Player::init() {
@@ -92,8 +96,7 @@ std::string Player::GetStateName(Player::State state) {
 }
 
 void Player::AddAnimator() {
-    std::string chachedArmatureName = m_dragonBonesName;
-    std::string prefix = m_dragonBonesName + "/" + m_dragonBonesName;
+    auto [prefix, chachedArmatureName] = assets::GetNestedSkeleton(m_dragonBonesName);
     m_animator = dragonBones::Animator::create(std::move(prefix), std::move(chachedArmatureName));
     m_animator->setScale(0.1f); // TODO: introduce multi-resolution scaling
     m_animator->InitializeAnimations(std::initializer_list<std::pair<size_t, std::string>> {
@@ -153,6 +156,11 @@ void Player::setPosition(const cocos2d::Vec2& position) {
 void Player::UpdatePosition(const float dt) noexcept {
     if (!IsDead()) {
         m_movement->Update();
+    }
+}
+
+void Player::UpdateCamera(const float dt) noexcept {
+    if (!IsDead()) {
         m_follower->UpdateMapPosition(dt);
     }
 }
@@ -171,9 +179,9 @@ void Player::MoveAlong(Movement::Direction dir) noexcept {
         m_movement->Stop(Movement::Axis::XY);
         m_movement->Push(dir);
         // reset all active weapons
-        std::for_each(m_weapons.begin(), m_weapons.end(), [](std::unique_ptr<Weapon>& weapon) {
-            if (weapon && (weapon->IsPreparing() || weapon->IsAttacking())) {
-                weapon->ForceReload();
+        std::for_each(m_weapons.begin(), m_weapons.end(), [](Weapon& weapon) {
+            if (weapon && (weapon.IsPreparing() || weapon.IsAttacking())) {
+                weapon.ForceReload();
             }
         });
         FinishSpecialAttack();
@@ -196,11 +204,12 @@ void Player::pause() {
 }
 
 void Player::update(float dt) {
+    const bench::ScopedSample sample { bench::Subsystem::UNITS };
+    PROFILE_ZONE("Player::update");
     cocos2d::Node::update(dt);
      
     UpdateDebugLabel();
     if (!IsDead()) {
-        UpdateWeapons(dt);
         UpdatePosition(dt); 
         UpdateCurses(dt);
     }
@@ -248,7 +257,7 @@ void Player::UpdateAnimation() {
 void Player::OnDeath() {
     // remove physics body
     removeComponent(getPhysicsBody());
-    getChildByName("health")->removeFromParent();
+    RemoveHealthBar();
     m_animator->EndWith([this]() {
         // create a death screen
         cocos2d::EventCustom event(DeathScreen::EVENT_NAME);
@@ -287,7 +296,7 @@ void Player::UpdateState(const float dt) noexcept {
     if (!player.intersectsRect(boundary)) { 
         // out of level boundaries
         m_currentState = State::DEAD;
-        m_health = 0;
+        SetHealth(0);
     }
     else if (m_health <= 0) {
         m_currentState = State::DEAD;
@@ -295,25 +304,25 @@ void Player::UpdateState(const float dt) noexcept {
     else if (m_dash->IsRunning()) {
         m_currentState = State::DASH;
     }
-    else if (m_weapons[WeaponClass::RANGE]->IsPreparing()) {
+    else if (m_weapons[WeaponClass::RANGE].IsPreparing()) {
         m_currentState = State::PREPARE_RANGE_ATTACK;
     }
-    else if (m_weapons[WeaponClass::RANGE]->IsAttacking()) {
+    else if (m_weapons[WeaponClass::RANGE].IsAttacking()) {
         m_currentState = State::RANGE_ATTACK;
     }
-    else if (m_weapons[WeaponClass::MELEE]->IsPreparing()) {
+    else if (m_weapons[WeaponClass::MELEE].IsPreparing()) {
         if (std::find(basicSwordAttacks.cbegin(), basicSwordAttacks.cend(), m_currentState) == basicSwordAttacks.cend()) {
             m_currentState = basicSwordAttacks[cocos2d::RandomHelper::random_int(0, 2)];
         }
     }
-    else if (m_weapons[WeaponClass::MELEE]->IsAttacking()) {
+    else if (m_weapons[WeaponClass::MELEE].IsAttacking()) {
         // TODO: no need to update anything
         // m_currentState = State::MELEE_ATTACK;
     }
-    else if (m_weapons[WeaponClass::SPECIAL]->IsPreparing()) {
+    else if (m_weapons[WeaponClass::SPECIAL].IsPreparing()) {
         m_currentState = State::SPECIAL_PHASE_3;
     }
-    else if (m_weapons[WeaponClass::SPECIAL]->IsAttacking()) {
+    else if (m_weapons[WeaponClass::SPECIAL].IsAttacking()) {
         m_currentState = State::SPECIAL_PHASE_3;
     }
     else if (m_scheduleSpecialAttack) {
@@ -361,12 +370,58 @@ void Player::AddWeapons() {
             && helper::IsEqual(animDuration[1], animDuration[2], EPS) 
             && "Sword attack animations have different duration"
         );
-        
+
         const auto attackDuration { 0.5f * animDuration[0] };
         const auto preparationTime { animDuration[0] - attackDuration };
 
-        auto genPos = [this]() -> cocos2d::Rect {
-            auto attackRange { m_weapons.front()->GetRange() };
+        const auto& sword = m_model->weapons.sword;
+        m_weapons[WeaponClass::MELEE] = m_weaponSystem->Add(this
+            , WeaponSystem::Kind::SWORD
+            , WeaponClass::MELEE
+            , sword.damage
+            , sword.range
+            , preparationTime
+            , attackDuration
+            , sword.cooldown
+        );
+    }
+    {
+        const auto preparationTime { 0.f };
+        const auto attackDuration { m_animator->GetDuration(Utils::EnumCast(State::RANGE_ATTACK))  };
+
+        const auto& spell = m_model->weapons.spell;
+        m_weapons[WeaponClass::RANGE] = m_weaponSystem->Add(this
+            , WeaponSystem::Kind::PLAYER_FIREBALL
+            , WeaponClass::RANGE
+            , spell.projectile.damage
+            , spell.range
+            , preparationTime
+            , attackDuration
+            , spell.cooldown
+        );
+    }
+    {
+        const auto animDuration = m_animator->GetDuration(Utils::EnumCast(State::SPECIAL_PHASE_3));
+        const auto attackDuration { 0.75f * animDuration };
+        const auto preparationTime { animDuration - attackDuration };
+
+        const auto& special = m_model->weapons.special;
+        m_weapons[WeaponClass::SPECIAL] = m_weaponSystem->Add(this
+            , WeaponSystem::Kind::PLAYER_SPECIAL
+            , WeaponClass::SPECIAL
+            , special.projectile.damage
+            , special.range
+            , preparationTime
+            , attackDuration
+            , special.cooldown
+        );
+    }
+}
+
+cocos2d::Rect Player::GetAttackArea(size_t weapon) const {
+    switch (weapon) {
+        case WeaponClass::MELEE: {
+            auto attackRange { m_weapons.front().GetRange() };
 
             auto position = getPosition();
             if (m_side == Side::RIGHT) {
@@ -380,27 +435,9 @@ void Player::AddWeapons() {
                 cocos2d::Size{ attackRange, m_contentSize.height * 0.5f }
             };
             return attackedArea;
-        };
-        auto genVel = [this](cocos2d::PhysicsBody* body) {
-            body->setVelocity(getPhysicsBody()->getVelocity());
-        };
-
-        const auto& sword = m_model->weapons.sword;
-        auto& weapon = m_weapons[WeaponClass::MELEE];
-        weapon.reset(new Sword(sword.damage
-            , sword.range
-            , preparationTime
-            , attackDuration
-            , sword.cooldown));
-        weapon->AddPositionGenerator(std::move(genPos));
-        weapon->AddVelocityGenerator(std::move(genVel));
-    }
-    {
-        const auto preparationTime { 0.f };
-        const auto attackDuration { m_animator->GetDuration(Utils::EnumCast(State::RANGE_ATTACK))  };
-
-        auto genPos = [this]() -> cocos2d::Rect {
-            auto attackRange { m_weapons[WeaponClass::RANGE]->GetRange() };
+        }
+        case WeaponClass::RANGE: {
+            auto attackRange { m_weapons[WeaponClass::RANGE].GetRange() };
             cocos2d::Size fireballSize { attackRange, floorf(attackRange * 0.8f) };
 
             auto position = getPosition();
@@ -413,29 +450,9 @@ void Player::AddWeapons() {
             position.y += floorf(m_contentSize.height * 0.3f);
 
             return { position, fireballSize };
-        };
-        auto genVel = [this](cocos2d::PhysicsBody* body) {
-            const auto& velocity = m_model->weapons.spell.projectile.velocity;
-            body->setVelocity({ IsLookingLeft()? -velocity[0]: velocity[0], velocity[1] });
-        };
-
-        const auto& spell = m_model->weapons.spell;
-        auto& weapon = m_weapons[WeaponClass::RANGE];
-        weapon.reset(new PlayerFireball(spell.projectile.damage
-            , spell.range
-            , preparationTime
-            , attackDuration
-            , spell.cooldown));
-        weapon->AddPositionGenerator(std::move(genPos));
-        weapon->AddVelocityGenerator(std::move(genVel));
-    }
-    {
-        const auto animDuration = m_animator->GetDuration(Utils::EnumCast(State::SPECIAL_PHASE_3));
-        const auto attackDuration { 0.75f * animDuration };
-        const auto preparationTime { animDuration - attackDuration };
-
-        auto genPos = [this]() -> cocos2d::Rect {
-            auto attackRange { m_weapons[WeaponClass::SPECIAL]->GetRange() };
+        }
+        case WeaponClass::SPECIAL: {
+            auto attackRange { m_weapons[WeaponClass::SPECIAL].GetRange() };
             cocos2d::Size slashSize { attackRange * 1.8f, attackRange };
 
             auto position = getPosition();
@@ -448,29 +465,34 @@ void Player::AddWeapons() {
             position.y += floorf(m_contentSize.height * 0.1f);
 
             return { position, slashSize };
-        };
-        auto genVel = [this](cocos2d::PhysicsBody* body) {
+        }
+        default: assert(false && "Unknown weapon"); break;
+    }
+    return {};
+}
+
+void Player::PushProjectile(size_t weapon, cocos2d::PhysicsBody * body) const {
+    switch (weapon) {
+        case WeaponClass::MELEE: {
+            body->setVelocity(getPhysicsBody()->getVelocity());
+        } break;
+        case WeaponClass::RANGE: {
+            const auto& velocity = m_model->weapons.spell.projectile.velocity;
+            body->setVelocity({ IsLookingLeft()? -velocity[0]: velocity[0], velocity[1] });
+        } break;
+        case WeaponClass::SPECIAL: {
             const auto& velocity = m_model->weapons.special.projectile.velocity; 
             body->setVelocity({ IsLookingLeft()? -velocity[0]: velocity[0], velocity[1] });
-        };
-
-        const auto& special = m_model->weapons.special;
-        auto& weapon = m_weapons[WeaponClass::SPECIAL];
-        weapon.reset(new PlayerSpecial(special.projectile.damage
-            , special.range
-            , preparationTime
-            , attackDuration
-            , special.cooldown));
-        weapon->AddPositionGenerator(std::move(genPos));
-        weapon->AddVelocityGenerator(std::move(genVel));
+        } break;
+        default: assert(false && "Unknown weapon"); break;
     }
-};
+}
 
 void Player::InitiateDash() {
     float duration { m_animator->GetDuration(Utils::EnumCast(State::DASH)) };
     bool canDash = !m_dash->IsOnCooldown() 
-        && std::none_of(m_weapons.cbegin(), m_weapons.cend(), [](const std::unique_ptr<Weapon>& weapon) {
-            return weapon && (weapon->IsPreparing() || weapon->IsAttacking());
+        && std::none_of(m_weapons.cbegin(), m_weapons.cend(), [](const Weapon& weapon) {
+            return weapon && (weapon.IsPreparing() || weapon.IsAttacking());
     });
 
     if (canDash) {
@@ -480,17 +502,17 @@ void Player::InitiateDash() {
 
 void Player::RangeAttack() {
     bool usingMelee {
-        m_weapons[WeaponClass::MELEE]->IsAttacking() || 
-        m_weapons[WeaponClass::MELEE]->IsPreparing()
+        m_weapons[WeaponClass::MELEE].IsAttacking() || 
+        m_weapons[WeaponClass::MELEE].IsPreparing()
     };
     bool canAttack {
         !usingMelee 
-        && m_weapons[WeaponClass::RANGE]->IsReady() 
+        && m_weapons[WeaponClass::RANGE].IsReady() 
         && !IsDead()
         && m_currentState != State::DASH
     };
     if (canAttack) {
-        m_weapons[WeaponClass::RANGE]->LaunchAttack();
+        m_weapons[WeaponClass::RANGE].LaunchAttack();
     }
 }
 
@@ -498,13 +520,13 @@ void Player::MeleeAttack() {
     assert(m_weapons.front());
 
     bool usingRange {
-        m_weapons[WeaponClass::RANGE]->IsAttacking() || 
-        m_weapons[WeaponClass::RANGE]->IsPreparing()
+        m_weapons[WeaponClass::RANGE].IsAttacking() || 
+        m_weapons[WeaponClass::RANGE].IsPreparing()
     };
     bool canAttack {
         !usingRange 
         && !IsDead()
-        && m_weapons.front()->IsReady()
+        && m_weapons.front().IsReady()
         && m_currentState != State::DASH
     };
     if (canAttack) {
@@ -514,28 +536,28 @@ void Player::MeleeAttack() {
 
 void Player::SpecialAttack() {
     bool canAttack {
-        m_weapons[WeaponClass::SPECIAL]->IsReady()
+        m_weapons[WeaponClass::SPECIAL].IsReady()
         && !IsDead()
         && m_currentState != State::DASH
     };
     if (canAttack) {
-        m_weapons[WeaponClass::SPECIAL]->LaunchAttack();
+        m_weapons[WeaponClass::SPECIAL].LaunchAttack();
     }
 
 }
 
 void Player::StartSpecialAttack() {
     bool usingMelee {
-        m_weapons[WeaponClass::MELEE]->IsAttacking() || 
-        m_weapons[WeaponClass::MELEE]->IsPreparing()
+        m_weapons[WeaponClass::MELEE].IsAttacking() || 
+        m_weapons[WeaponClass::MELEE].IsPreparing()
     };
     bool usingRange {
-        m_weapons[WeaponClass::RANGE]->IsAttacking() || 
-        m_weapons[WeaponClass::RANGE]->IsPreparing()
+        m_weapons[WeaponClass::RANGE].IsAttacking() || 
+        m_weapons[WeaponClass::RANGE].IsPreparing()
     };
     bool usingSpecial {
-        m_weapons[WeaponClass::SPECIAL]->IsAttacking() || 
-        m_weapons[WeaponClass::SPECIAL]->IsPreparing()
+        m_weapons[WeaponClass::SPECIAL].IsAttacking() || 
+        m_weapons[WeaponClass::SPECIAL].IsPreparing()
     };
 
     if (!usingMelee 
@@ -584,7 +606,7 @@ void Player::FinishSpecialAttack() {
 
 void Player::Attack() {
     assert(!IsDead());
-    assert(m_weapons[WeaponClass::MELEE]->IsReady());
+    assert(m_weapons[WeaponClass::MELEE].IsReady());
 
-    m_weapons[WeaponClass::MELEE]->LaunchAttack();
+    m_weapons[WeaponClass::MELEE].LaunchAttack();
 }
\ No newline at end of file
@@ -12,6 +12,7 @@ namespace json_models = json_autogenerated_classes;
 
 class SmoothFollower;
 class Dash;
+class UserInputHandler;
 
 class Player final : public Unit {
 public:
@@ -30,6 +31,22 @@ public:
 
     void RecieveDamage(int damage) noexcept override;
 
+    /**
+     * Move the map after the rendered position of the player.
+     * It's called each frame after the simulation ticks are interpolated.
+     */
+    void UpdateCamera(const float dt) noexcept;
+
+    [[nodiscard]] const UserInputHandler* GetInputHandler() const noexcept {
+        return m_inputHandler.get();
+    }
+
+/// Weapon interface
+
+    [[nodiscard]] cocos2d::Rect GetAttackArea(size_t weapon) const;
+
+    void PushProjectile(size_t weapon, cocos2d::PhysicsBody * body) const;
+
 private:
     enum class State {
         IDLE,
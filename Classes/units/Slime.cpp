@@ -1,7 +1,9 @@
 #include "Slime.hpp"
 #include "Core.hpp"
+#include "FrameSampler.hpp"
+#include "Profiler.hpp"
 
-#include "components/Weapon.hpp"
+#include "components/WeaponSystem.hpp"
 #include "components/DragonBonesAnimator.hpp"
 #include "components/Movement.hpp"
 
@@ -40,23 +42,24 @@ Slime::Slime(size_t id
     , const cocos2d::Size& contentSize
     , const json_models::Slime *slime
 )
-    : Bot { id, core::EntityNames::SLIME }
+    : Bot { id, slime->dragonbones }
     , m_slime { slime }
 {
     m_contentSize = contentSize;
     m_physicsBodySize = contentSize;
     m_hitBoxSize = contentSize;
+    m_frameCacheRate = static_cast<unsigned>(m_slime->frameCache);
 }
 
 void Slime::update(float dt) {
+    const bench::ScopedSample sample { bench::Subsystem::UNITS };
+    PROFILE_ZONE("Slime::update");
     // update components
     cocos2d::Node::update(dt);
     // custom updates
     UpdateDebugLabel();
     if (!IsDead()) {
-        UpdateWeapons(dt);
         UpdatePosition(dt); 
-        TryAttack();
         UpdateCurses(dt);
     }
     UpdateState(dt);
@@ -69,7 +72,7 @@ void Slime::AttachNavigator(Path&& path) {
     for (auto& point: path.m_waypoints) {
         point.y = getPosition().y;
     }
-    m_navigator = std::make_unique<Navigator>(this, std::move(path));
+    m_navigator = std::make_unique<Navigator>(this, std::move(path), NavigationGraph::Find(this));
     Patrol();
 }
 
@@ -92,16 +95,16 @@ void Slime::UpdateState(const float dt) noexcept {
     if (m_health <= 0) {
         m_currentState = State::DEAD;
     }
-    else if (m_weapons[WeaponClass::RANGE]->IsPreparing()) {
+    else if (m_weapons[WeaponClass::RANGE].IsPreparing()) {
         /// TODO: fix this approach which leads to misundestanding
         /// This force to continue the animation which was played before 
         /// Needed to choose the time when the projectile will be created
         m_currentState = State::ATTACK;
     }
-    else if (m_weapons[WeaponClass::RANGE]->IsAttacking()) {
+    else if (m_weapons[WeaponClass::RANGE].IsAttacking()) {
         m_currentState = State::ATTACK;
     }
-    else if (m_weapons[WeaponClass::RANGE]->IsReloading()) {
+    else if (m_weapons[WeaponClass::RANGE].IsReloading()) {
         m_currentState = State::IDLE;
     }
     else {
@@ -138,7 +141,7 @@ void Slime::UpdateAnimation() {
 
 void Slime::OnDeath() {
     removeComponent(getPhysicsBody());
-    getChildByName("health")->removeFromParent();
+    RemoveHealthBar();
     m_animator->EndWith([this]() {
         runAction(cocos2d::RemoveSelf::create(true));
     });
@@ -181,9 +184,9 @@ void Slime::AddPhysicsBody() {
     );
 }
 
-bool Slime::NeedAttack() const noexcept {
+bool Slime::NeedAttack(const Snapshot&) const noexcept {
     assert(!IsDead());
-    return m_detectEnemy && m_weapons[WeaponClass::RANGE]->IsReady();
+    return m_detectEnemy && m_weapons[WeaponClass::RANGE].IsReady();
 }
 
 void Slime::AddAnimator() {
@@ -202,47 +205,49 @@ void Slime::AddAnimator() {
 // =============  WEAPON STUFF ================== //
 
 void Slime::AddWeapons() {
-    
+
     const auto duration { m_animator->GetDuration(Utils::EnumCast(State::ATTACK)) };
     const auto preparationTime { duration * 0.6f }; /// TODO: update animation!
     const auto attackDuration { duration - preparationTime };
-    
-    auto genPos = [this]() -> cocos2d::Rect {
-        auto attackRange { m_weapons[WeaponClass::RANGE]->GetRange() };
-        cocos2d::Size waterballSize { attackRange, floorf(attackRange * 0.8f) };
-
-        auto position = getPosition();
-        if (IsLookingLeft()) {
-            position.x -= m_contentSize.width / 2.f ;
-        }
-        else {
-            position.x += m_contentSize.width / 2.f;
-        }
-        position.y += floorf(m_contentSize.height * 0.3f);
-
-        return { position, waterballSize };
-    };
-    auto genVel = [this](cocos2d::PhysicsBody* body) {
-        const auto& velocity = m_slime->weapons.spell.projectile.velocity;
-        body->setVelocity({ IsLookingLeft()? -velocity[0]: velocity[0], velocity[1] });
-    };
 
     const auto& spell = m_slime->weapons.spell;
-    auto& weapon = m_weapons[WeaponClass::RANGE];
-    weapon.reset(new SlimeShot(spell.projectile.damage
+    m_weapons[WeaponClass::RANGE] = m_weaponSystem->Add(this
+        , WeaponSystem::Kind::SLIME_SHOT
+        , WeaponClass::RANGE
+        , spell.projectile.damage
         , spell.range
         , preparationTime
         , attackDuration
-        , spell.cooldown));
-    weapon->AddPositionGenerator(std::move(genPos));
-    weapon->AddVelocityGenerator(std::move(genVel));
+        , spell.cooldown
+    );
+}
+
+cocos2d::Rect Slime::GetAttackArea(size_t weapon) const {
+    auto attackRange { m_weapons[WeaponClass::RANGE].GetRange() };
+    cocos2d::Size waterballSize { attackRange, floorf(attackRange * 0.8f) };
+
+    auto position = getPosition();
+    if (IsLookingLeft()) {
+        position.x -= m_contentSize.width / 2.f ;
+    }
+    else {
+        position.x += m_contentSize.width / 2.f;
+    }
+    position.y += floorf(m_contentSize.height * 0.3f);
+
+    return { position, waterballSize };
+}
+
+void Slime::PushProjectile(size_t weapon, cocos2d::PhysicsBody * body) const {
+    const auto& velocity = m_slime->weapons.spell.projectile.velocity;
+    body->setVelocity({ IsLookingLeft()? -velocity[0]: velocity[0], velocity[1] });
 }
 
 void Slime::Attack() {
     assert(!IsDead());
-    assert(m_weapons[WeaponClass::RANGE]->IsReady());
+    assert(m_weapons[WeaponClass::RANGE].IsReady());
 
-    m_weapons[WeaponClass::RANGE]->LaunchAttack();
+    m_weapons[WeaponClass::RANGE].LaunchAttack();
 }
 
 }// namespace Enemies
\ No newline at end of file
@@ -35,6 +35,12 @@ public:
 
     void OnEnemyLeave() override;
 
+/// Weapon interface
+
+    [[nodiscard]] cocos2d::Rect GetAttackArea(size_t weapon) const;
+
+    void PushProjectile(size_t weapon, cocos2d::PhysicsBody * body) const;
+
 private:
     enum WeaponClass { RANGE };
 
@@ -60,7 +66,7 @@ private:
 
     void AddAnimator() override;
 
-    bool NeedAttack() const noexcept override;
+    bool NeedAttack(const Snapshot& snapshot) const noexcept override;
     
     void AddWeapons() override;
 
@@ -2,7 +2,7 @@
 #include "Core.hpp"
 
 #include "components/Movement.hpp"
-#include "components/Weapon.hpp"
+#include "components/WeaponSystem.hpp"
 #include "components/DragonBonesAnimator.hpp"
 
 #include "configs/JsonUnits.hpp"
@@ -39,51 +39,54 @@ Spearman::Spearman(size_t id
     , const cocos2d::Size& contentSize
     , const json_models::Spearman *spearman
 )
-    : Warrior{ id, core::EntityNames::SPEARMAN, contentSize }
+    : Warrior{ id, spearman->dragonbones, contentSize }
     , m_spearman { spearman }
 {
     assert(spearman);
+    m_frameCacheRate = static_cast<unsigned>(m_spearman->frameCache);
 }
 
 void Spearman::AddWeapons() {
     const auto attackDuration { 0.2f };
     const auto preparationTime { m_animator->GetDuration(Utils::EnumCast(State::ATTACK)) - attackDuration };
-    
-    auto genPos = [this]() -> cocos2d::Rect {
-        auto attackRange { m_weapons[WeaponClass::MELEE]->GetRange() };
-        cocos2d::Size spearSize { attackRange, attackRange / 4.f };
-
-        auto position = getPosition();
-        if (IsLookingLeft()) {
-            position.x -= m_contentSize.width / 2.f + spearSize.width;
-        }
-        else {
-            position.x += m_contentSize.width / 2.f;
-        }
-        position.y += m_contentSize.height / 3.f - spearSize.height / 2.f;
-
-        return { position, spearSize };
-    };
-    auto genVel = [this](cocos2d::PhysicsBody* body) {
-        body->setVelocity(getPhysicsBody()->getVelocity());
-    };
 
     const auto& spear = m_spearman->weapons.spear;
-    auto& weapon = m_weapons[WeaponClass::MELEE];
-    weapon.reset(new Spear(spear.damage
+    m_weapons[WeaponClass::MELEE] = m_weaponSystem->Add(this
+        , WeaponSystem::Kind::SPEAR
+        , WeaponClass::MELEE
+        , spear.damage
         , spear.range
         , preparationTime
         , attackDuration
-        , spear.cooldown));
-    weapon->AddPositionGenerator(std::move(genPos));
-    weapon->AddVelocityGenerator(std::move(genVel));
+        , spear.cooldown
+    );
+}
+
+cocos2d::Rect Spearman::GetAttackArea(size_t weapon) const {
+    auto attackRange { m_weapons[WeaponClass::MELEE].GetRange() };
+    cocos2d::Size spearSize { attackRange, attackRange / 4.f };
+
+    auto position = getPosition();
+    if (IsLookingLeft()) {
+        position.x -= m_contentSize.width / 2.f + spearSize.width;
+    }
+    else {
+        position.x += m_contentSize.width / 2.f;
+    }
+    position.y += m_contentSize.height / 3.f - spearSize.height / 2.f;
+
+    return { position, spearSize };
+}
+
+void Spearman::PushProjectile(size_t weapon, cocos2d::PhysicsBody * body) const {
+    body->setVelocity(getPhysicsBody()->getVelocity());
 }
 
 void Spearman::Attack() {
     assert(!IsDead());
-    assert(m_weapons[WeaponClass::MELEE]->IsReady());
+    assert(m_weapons[WeaponClass::MELEE].IsReady());
 
-    m_weapons[WeaponClass::MELEE]->LaunchAttack();
+    m_weapons[WeaponClass::MELEE].LaunchAttack();
 }
 
 }// namespace Enemies
\ No newline at end of file
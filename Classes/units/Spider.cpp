@@ -1,10 +1,12 @@
 #include "Spider.hpp"
 #include "Core.hpp"
+#include "FrameSampler.hpp"
+#include "Profiler.hpp"
 
 #include "components/Path.hpp"
 #include "components/Navigator.hpp"
 #include "components/DragonBonesAnimator.hpp"
-#include "components/Weapon.hpp"
+#include "components/WeaponSystem.hpp"
 #include "components/Movement.hpp"
 
 #include "configs/JsonUnits.hpp"
@@ -32,7 +34,7 @@ Spider::Spider(size_t id
     , const cocos2d::Size& contentSize
     , const json_models::Spider *model
 )
-    : Bot { id, core::EntityNames::SPIDER }
+    : Bot { id, model->dragonbones }
     , m_model { model }
 {
     m_contentSize = contentSize;
@@ -44,6 +46,7 @@ Spider::Spider(size_t id
     // define size of the physics body
     // m_physicsBodySize = cocos2d::Size{ 40.f, 40.f };
     // m_hitBoxSize = cocos2d::Size{ 45.f, 45.f };
+    m_frameCacheRate = static_cast<unsigned>(m_model->frameCache);
 }
 
 bool Spider::init() {
@@ -59,12 +62,12 @@ bool Spider::init() {
 };
 
 void Spider::onEnter() {
-    cocos2d::Node::onEnter();
+    Bot::onEnter();
 }
 
 void Spider::onExit() {
     m_web = nullptr;
-    cocos2d::Node::onExit();
+    Bot::onExit();
 }
 
 void Spider::MoveAlong(Movement::Direction dir) noexcept {
@@ -88,6 +91,8 @@ void Spider::UpdateWeb() {
 }
 
 void Spider::update(float dt) {
+    const bench::ScopedSample sample { bench::Subsystem::UNITS };
+    PROFILE_ZONE("Spider::update");
     cocos2d::Node::update(dt);
     // custom updates
     UpdateDebugLabel();
@@ -117,14 +122,9 @@ void Spider::AttachNavigator(Path&& path) {
     m_navigator->FollowPath();
 };
 
-void Spider::TryAttack() {
-    // do nothing as it doens't attack
-    assert(false && "Cannot attack!");
-};
-
-bool Spider::NeedAttack() const noexcept {
-    assert(false && "Cannot attack!");
-    return false; // spider doesn't attack at least for now
+Command Spider::Decide(const Snapshot&) const noexcept {
+    // do nothing as it doesn't attack, at least for now
+    return {};
 };
 
 /// Bot interface
@@ -160,7 +160,7 @@ void Spider::UpdateAnimation() {
 
 void Spider::OnDeath() {
     // Interface
-    getChildByName("health")->removeFromParent();
+    RemoveHealthBar();
     // Physics
     const auto body = getPhysicsBody();
     const auto hitBoxTag { Utils::EnumCast(core::CategoryBits::HITBOX_SENSOR) };
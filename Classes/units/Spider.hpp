@@ -55,9 +55,7 @@ private:
     void UpdateWeb();
     /// Bot interface
     
-    void TryAttack();
-
-    bool NeedAttack() const noexcept;
+    [[nodiscard]] Command Decide(const Snapshot& snapshot) const noexcept override;
    
     void UpdateState(const float dt) noexcept override;
 
@@ -1,9 +1,11 @@
 #include "Stalactite.hpp"
 #include "Player.hpp"
 #include "Core.hpp"
+#include "FrameSampler.hpp"
+#include "Profiler.hpp"
 
 #include "components/DragonBonesAnimator.hpp"
-#include "components/Weapon.hpp"
+#include "components/WeaponSystem.hpp"
 
 #include "configs/JsonUnits.hpp"
 
@@ -21,7 +23,7 @@ Stalactite* Stalactite::create(
     auto pRet = new (std::nothrow) Stalactite(id
         , contentSize
         , scale
-        , cocos2d::RandomHelper::random_int(1, 4)
+        , cocos2d::RandomHelper::random_int(1, static_cast<int>(assets::STALACTITE_LOOKS))
         , model
     );
     if (pRet && pRet->init()) {
@@ -38,7 +40,7 @@ bool Stalactite::init() {
     if (!Bot::init()) {
         return false;
     }
-    getChildByName("health")->removeFromParent();
+    RemoveHealthBar();
     getChildByName("state")->removeFromParent();
 
     m_health = m_model->health;
@@ -46,11 +48,11 @@ bool Stalactite::init() {
 }
 
 void Stalactite::update(float dt) {
+    const bench::ScopedSample sample { bench::Subsystem::UNITS };
+    PROFILE_ZONE("Stalactite::update");
     // update components
     cocos2d::Node::update(dt);
     if (!IsDead()) {
-        UpdateWeapons(dt);
-        TryAttack();
         UpdateCurses(dt);
     }
     UpdateState(dt);
@@ -72,7 +74,7 @@ Stalactite::Stalactite(
     , size_t index
     , const json_models::UnitsStalactite *model
 ) 
-    : Bot { id, std::string(core::EntityNames::STALACTITE) + "_" +  std::to_string(index) }
+    : Bot { id, model->dragonbones }
     , m_scale { scale }
     , m_index { index }
     , m_model { model }
@@ -80,29 +82,31 @@ Stalactite::Stalactite(
     m_contentSize = contentSize;
     m_physicsBodySize = cocos2d::Size { contentSize.width, contentSize.height };
     m_hitBoxSize = m_physicsBodySize;
+    m_frameCacheRate = static_cast<unsigned>(m_model->frameCache);
 }
 
 void Stalactite::Attack() {
     assert(!IsDead());
-    assert(m_weapons[WeaponClass::RANGE]->IsReady());
+    assert(m_weapons[WeaponClass::RANGE].IsReady());
     
-    m_weapons[WeaponClass::RANGE]->LaunchAttack();
+    m_weapons[WeaponClass::RANGE].LaunchAttack();
     m_alreadyAttacked = true;
 }
 
-void Stalactite::TryAttack() {
+Command Stalactite::Decide(const Snapshot& snapshot) const noexcept {
     assert(!IsDead());
-    
-    if (NeedAttack()) { // attack if possible
-        Attack();
-    } 
+    Command command;
+    if (NeedAttack(snapshot)) { // attack if possible
+        command.actions = Command::ATTACK;
+    }
+    return command;
 }
 
-bool Stalactite::NeedAttack() const noexcept {
+bool Stalactite::NeedAttack(const Snapshot&) const noexcept {
     assert(!IsDead());
     return !m_alreadyAttacked 
         && m_detectEnemy 
-        && m_weapons[WeaponClass::RANGE]->IsReady();
+        && m_weapons[WeaponClass::RANGE].IsReady();
 }
 
 void Stalactite::UpdateState(const float dt) noexcept {
@@ -111,10 +115,10 @@ void Stalactite::UpdateState(const float dt) noexcept {
     if (m_health <= 0) {
         m_currentState = State::DEAD;
     }
-    else if (m_weapons[WeaponClass::RANGE]->IsPreparing()) {
+    else if (m_weapons[WeaponClass::RANGE].IsPreparing()) {
         m_currentState = State::PREPARE_ATTACK;
     }
-    else if (m_weapons[WeaponClass::RANGE]->IsAttacking()) {
+    else if (m_weapons[WeaponClass::RANGE].IsAttacking()) {
         m_currentState = State::ATTACK;
     }
     else if (m_currentState != State::ATTACK) {
@@ -141,7 +145,7 @@ void Stalactite::OnDeath() {
     // Just remove physics body. 
     // The base of stalactite will still be visible!
     removeComponent(getPhysicsBody());
-    // getChildByName("health")->removeFromParent();
+    // RemoveHealthBar();
     m_animator->EndWith([this]() {
         runAction(cocos2d::RemoveSelf::create(true));
     });
@@ -179,9 +183,9 @@ void Stalactite::AddPhysicsBody() {
 
 void Stalactite::AddAnimator() {
     // stalactites/stalactite_1/stalactite_1/stalactite_1_tex"
-    std::string name = m_dragonBonesName;
-    std::string prefix = "stalactites/" + m_dragonBonesName + "/" + m_dragonBonesName;
+    auto [prefix, name] = assets::GetStalactiteSkeleton(m_dragonBonesName, m_index);
     m_animator = dragonBones::Animator::create(std::move(prefix), std::move(name));
+    m_animator->EnableFrameCache(m_frameCacheRate);
     addChild(m_animator);
     m_animator->setScale(m_scale); 
     m_animator->InitializeAnimations({
@@ -199,28 +203,29 @@ void Stalactite::AddWeapons() {
     const auto preparationTime { m_animator->GetDuration(Utils::EnumCast(State::PREPARE_ATTACK)) };
     const auto attackDuration { m_animator->GetDuration(Utils::EnumCast(State::ATTACK)) };
 
-    auto genPos = [this]()->cocos2d::Rect {
-        auto attackRange { m_weapons[WeaponClass::RANGE]->GetRange() };
-        cocos2d::Size stalactite { m_contentSize / m_scale };
-        auto position = getPosition();
-        // shift y-axis to avoid collision with the ceiling
-        return { cocos2d::Vec2(position.x, position.y - stalactite.height * 0.05f) , stalactite};
-    };
-    auto genVel = [this](cocos2d::PhysicsBody* body) {
-        const auto& velocity = m_model->weapons.stalactite.velocity;
-        body->setVelocity({ velocity[0], -velocity[1] });
-    };
-
     const auto& stalactite = m_model->weapons.stalactite;
-    auto& weapon = m_weapons[WeaponClass::RANGE];
-    weapon.reset(new StalactitePart(stalactite.damage
+    m_weapons[WeaponClass::RANGE] = m_weaponSystem->Add(this
+        , WeaponSystem::Kind::STALACTITE_PART
+        , WeaponClass::RANGE
+        , stalactite.damage
         , range
         , preparationTime
         , attackDuration
         , stalactite.cooldown
-        , m_index));
-    weapon->AddPositionGenerator(std::move(genPos));
-    weapon->AddVelocityGenerator(std::move(genVel));
+    );
+}
+
+cocos2d::Rect Stalactite::GetAttackArea(size_t weapon) const {
+    auto attackRange { m_weapons[WeaponClass::RANGE].GetRange() };
+    cocos2d::Size stalactite { m_contentSize / m_scale };
+    auto position = getPosition();
+    // shift y-axis to avoid collision with the ceiling
+    return { cocos2d::Vec2(position.x, position.y - stalactite.height * 0.05f) , stalactite};
+}
+
+void Stalactite::PushProjectile(size_t weapon, cocos2d::PhysicsBody * body) const {
+    const auto& velocity = m_model->weapons.stalactite.velocity;
+    body->setVelocity({ velocity[0], -velocity[1] });
 }
 
 
@@ -2,6 +2,7 @@
 #define STALACTITE_HPP
 
 #include "Bot.hpp"
+#include "AssetPaths.hpp"
 
 namespace json_autogenerated_classes {
     struct UnitsStalactite;
@@ -32,6 +33,23 @@ public:
 
     void OnEnemyLeave() override;
 
+/// Weapon interface
+
+    [[nodiscard]] cocos2d::Rect GetAttackArea(size_t weapon) const;
+
+    void PushProjectile(size_t weapon, cocos2d::PhysicsBody * body) const;
+
+    [[nodiscard]] size_t GetIndex() const noexcept {
+        return m_index;
+    }
+
+    /**
+     * Skeleton of the falling part matching the stalactite's look
+     */
+    [[nodiscard]] assets::Skeleton GetPartSkeleton() const {
+        return assets::GetStalactitePartSkeleton(m_dragonBonesName, m_index);
+    }
+
 private: 
     Stalactite(size_t id
         , const cocos2d::Size& contentSize
@@ -42,11 +60,11 @@ private:
 
     /// Bot interface
     
-    void TryAttack();
+    [[nodiscard]] Command Decide(const Snapshot& snapshot) const noexcept override;
 
     void Attack() override;
 
-    bool NeedAttack() const noexcept;
+    bool NeedAttack(const Snapshot& snapshot) const noexcept override;
    
     void UpdateState(const float dt) noexcept override;
 
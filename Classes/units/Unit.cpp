@@ -2,9 +2,12 @@
 #include "PhysicsHelper.hpp" 
 #include "Utils.hpp"
 #include "Core.hpp"
+#include "AssetPaths.hpp"
 
-#include "components/HealthBar.hpp"
-#include "components/Weapon.hpp"
+#include "components/HealthBarRenderer.hpp"
+#include "ActivationRegion.hpp"
+#include "SimulationClock.hpp"
+#include "components/WeaponSystem.hpp"
 #include "components/DragonBonesAnimator.hpp"
 #include "components/Movement.hpp"
 
@@ -26,40 +29,108 @@ bool Unit::init() {
     // At this moment content size should be initialized
     assert(!cocos2d::Vec2{ m_contentSize }.fuzzyEquals({0.f, 0.f}, 0.01f));
 
-    scheduleUpdate();
-
+    // updated by the level's simulation clock on each tick
     AddAnimator();
     AddPhysicsBody();
     setContentSize(m_contentSize); // must be called after `AddPhysicsBody`
     m_movement = std::make_unique<Movement>(getPhysicsBody()
         , LevelScene::GRAVITY
         , LevelScene::JUMP_HEIGHT);
-    AddWeapons();
-
-    /// TODO: move somewhere
-    static constexpr float healthBarShift { 5.f };
-    const auto bar = HealthBar::create(this);
-    const auto shiftY { m_contentSize.height };
-    bar->setName("health");
-    bar->setPosition(-m_contentSize.width / 2.f, shiftY + healthBarShift);
-    addChild(bar);
 
-    // add state lable:
+    // add state lable above the health bar:
     const auto state = cocos2d::Label::createWithTTF("", "fonts/arial.ttf", 15);
     state->setName("state");
-    state->setPosition(0.f, bar->getPositionY() + bar->getContentSize().height + 8.f);
+    state->setPosition(0.f, m_contentSize.height 
+        + HealthBarRenderer::SHIFT 
+        + HealthBarRenderer::HEIGHT 
+        + 8.f
+    );
     addChild(state);    
     return true;
 }
 
+void Unit::onEnter() {
+    cocos2d::Node::onEnter();
+    m_registry = EntityRegistry::Find(this);
+    if (m_registry) {
+        m_handle = m_registry->Register(this);
+    }
+    m_healthBars = HealthBarRenderer::Find(this);
+    if (m_healthBars && m_hasHealthBar) {
+        if (m_maxHealth == 0) {
+            m_maxHealth = m_health;
+        }
+        m_healthBar = m_healthBars->Add(this, m_maxHealth);
+    }
+    m_activation = ActivationRegion::Find(this);
+    if (m_activation) {
+        m_activationId = m_activation->Add(this, ActivationRegion::Kind::UNIT);
+    }
+    m_weaponSystem = WeaponSystem::Find(this);
+    if (m_weaponSystem) {
+        AddWeapons();
+    }
+    m_clock = SimulationClock::Find(this);
+    if (m_clock) {
+        m_clockId = m_clock->Add(this);
+    }
+}
+
+void Unit::onExit() {
+    if (m_registry) {
+        m_registry->Unregister(m_handle);
+        m_registry = nullptr;
+        m_handle = EntityHandle{};
+    }
+    if (m_healthBars) {
+        m_healthBars->Remove(m_healthBar);
+        m_healthBars = nullptr;
+        m_healthBar = HealthBarRenderer::INVALID_BAR;
+    }
+    if (m_activation) {
+        m_activation->Remove(m_activationId);
+        m_activation = nullptr;
+        m_activationId = ActivationRegion::INVALID_ENTITY;
+    }
+    if (m_weaponSystem) {
+        for (auto& weapon: m_weapons) {
+            m_weaponSystem->Remove(weapon);
+            weapon = Weapon{};
+        }
+        m_weaponSystem = nullptr;
+    }
+    if (m_clock) {
+        m_clock->Remove(m_clockId);
+        m_clock = nullptr;
+        m_clockId = SimulationClock::INVALID_ENTITY;
+    }
+    cocos2d::Node::onExit();
+}
+
 void Unit::pause() {
     cocos2d::Node::pause();
     m_animator->pause();
+    if (m_weaponSystem) {
+        for (const auto& weapon: m_weapons) {
+            m_weaponSystem->SetActive(weapon, false);
+        }
+    }
+    if (m_clock) {
+        m_clock->SetActive(m_clockId, false);
+    }
 }
 
 void Unit::resume() {
     cocos2d::Node::resume();
     m_animator->resume();
+    if (m_weaponSystem) {
+        for (const auto& weapon: m_weapons) {
+            m_weaponSystem->SetActive(weapon, true);
+        }
+    }
+    if (m_clock) {
+        m_clock->SetActive(m_clockId, true);
+    }
 }
 
 void Unit::SetMaxSpeed(float speed) noexcept {
@@ -105,16 +176,21 @@ void Unit::LookAt(const cocos2d::Vec2& point) noexcept {
 }
 
 void Unit::RecieveDamage(int damage) noexcept {
-    m_health -= damage;
+    this->SetHealth(m_health - damage);
 }
 
-void Unit::UpdateWeapons(const float dt) noexcept {
-    assert(!IsDead());
-    
-    for (auto& weapon: m_weapons) {
-        if (weapon) {
-            weapon->UpdateState(dt);
-        }
+void Unit::SetHealth(int health) noexcept {
+    m_health = health;
+    if (m_healthBars) {
+        m_healthBars->Invalidate(m_healthBar);
+    }
+}
+
+void Unit::RemoveHealthBar() noexcept {
+    m_hasHealthBar = false;
+    if (m_healthBars) {
+        m_healthBars->Remove(m_healthBar);
+        m_healthBar = HealthBarRenderer::INVALID_BAR;
     }
 }
 
@@ -166,9 +242,9 @@ void Unit::AddPhysicsBody() {
 }
 
 void Unit::AddAnimator() {
-    std::string chachedArmatureName = m_dragonBonesName;
-    std::string prefix = m_dragonBonesName;
+    auto [prefix, chachedArmatureName] = assets::GetUnitSkeleton(m_dragonBonesName);
     m_animator = dragonBones::Animator::create(std::move(prefix), std::move(chachedArmatureName));
+    m_animator->EnableFrameCache(m_frameCacheRate);
     addChild(m_animator);
     m_animator->setScale(0.1f); // TODO: introduce multi-resolution scaling
 }
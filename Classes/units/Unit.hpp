@@ -3,6 +3,8 @@
 
 #include "components/CurseHub.hpp"
 #include "components/Movement.hpp"
+#include "components/WeaponSystem.hpp"
+#include "EntityRegistry.hpp"
 
 #include <memory>
 #include <array>
@@ -12,13 +14,23 @@
 namespace dragonBones {
     class Animator;
 }
-class Weapon;
+class HealthBarRenderer;
+class ActivationRegion;
+class SimulationClock;
 
 class Unit : public cocos2d::Node { 
 public:
 
     [[nodiscard]] bool init() override;
 
+    /**
+     * Register the unit in the level's registry
+     * @note call this method at the begining of the overriden one
+     */
+    void onEnter() override;
+
+    void onExit() override;
+
     void pause() override;
 
     void resume() override;
@@ -72,6 +84,13 @@ public:
 
     void LookAt(const cocos2d::Vec2& point) noexcept;
 
+    /**
+     * @return the player registered in the level or nullptr
+     */
+    [[nodiscard]] inline Unit* FindPlayer() const noexcept;
+
+    [[nodiscard]] inline EntityRegistry* GetRegistry() const noexcept;
+
 protected:
 
     Unit(const std::string& dragonBonesName);
@@ -85,8 +104,6 @@ protected:
      */
     virtual void UpdateAnimation() = 0;
 
-    virtual void UpdateWeapons(const float dt) noexcept;
-
     virtual void UpdatePosition(const float dt) noexcept;
 
     virtual void UpdateCurses(const float dt) noexcept;
@@ -99,6 +116,16 @@ protected:
     
     virtual void OnDeath() = 0;
 
+    /**
+     * Stop drawing the health bar, e.g. on death.
+     */
+    void RemoveHealthBar() noexcept;
+
+    /**
+     * Change the health and redraw the health bar.
+     */
+    void SetHealth(int health) noexcept;
+
     /**
      * Create and add physics body as component to the node.
      * Inheritor need to provide collision&contact masks.
@@ -114,7 +141,7 @@ protected:
     virtual void AddAnimator();
 
     /**
-     * Create a weapon with desired parameters 
+     * Create a weapon with desired parameters in the level's weapon system
      */
     virtual void AddWeapons();
 
@@ -136,7 +163,7 @@ protected:
     // keep all weapons that the unit may use
     // 5 is maximum because the boss has 5 types of attack
     // Note: in this case weapons are equivalent of the skills
-    std::array<std::unique_ptr<Weapon>, 5U> m_weapons;
+    std::array<Weapon, 5U> m_weapons;
 
     // retain when add as child
     dragonBones::Animator *m_animator { nullptr };
@@ -150,6 +177,38 @@ protected:
     cocos2d::Size m_hitBoxSize {};
     
     bool m_hasContactWithGround { false };
+
+    // frame rate of the baked animations, 0 - animations are evaluated every frame.
+    // Must be set before `init`
+    unsigned m_frameCacheRate { 0U };
+
+    // level's registry, available while the unit is running
+    EntityRegistry * m_registry { nullptr };
+
+    EntityHandle m_handle {};
+
+    // level's health bars, available while the unit is running
+    HealthBarRenderer * m_healthBars { nullptr };
+
+    uint32_t m_healthBar { UINT32_MAX };
+
+    // health of the full bar, taken on entering the level
+    int m_maxHealth { 0 };
+
+    bool m_hasHealthBar { true };
+
+    // level's activation region, available while the unit is running
+    ActivationRegion * m_activation { nullptr };
+
+    uint32_t m_activationId { UINT32_MAX };
+
+    // level's weapon system, available while the unit is running
+    WeaponSystem * m_weaponSystem { nullptr };
+
+    // level's simulation clock, available while the unit is running
+    SimulationClock * m_clock { nullptr };
+
+    uint32_t m_clockId { UINT32_MAX };
 };
 
 /// Implementation
@@ -186,5 +245,13 @@ inline cocos2d::Size Unit::GetHitBox() const noexcept {
     return m_hitBoxSize;
 }
 
+inline Unit* Unit::FindPlayer() const noexcept {
+    return m_registry? m_registry->GetPlayer(): nullptr;
+}
+
+inline EntityRegistry* Unit::GetRegistry() const noexcept {
+    return m_registry;
+}
+
 
 #endif // UNIT_HPP
\ No newline at end of file
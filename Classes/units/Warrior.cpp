@@ -1,18 +1,21 @@
 #include "Warrior.hpp"
 #include "Player.hpp"
 #include "Core.hpp"
+#include "FrameSampler.hpp"
+#include "Profiler.hpp"
 
 #include "components/DragonBonesAnimator.hpp"
-#include "components/Weapon.hpp"
+#include "components/WeaponSystem.hpp"
 #include "components/Influence.hpp"
 #include "components/Movement.hpp"
+#include "NavigationGraph.hpp"
 
 #include "cocos2d.h"
 
 namespace Enemies {
 
 Warrior::Warrior(size_t id
-    , const char* dragonBonesName
+    , const std::string& dragonBonesName
     , const cocos2d::Size& contentSize
 )
     : Bot{ id, dragonBonesName }
@@ -32,14 +35,14 @@ bool Warrior::init() {
 }
 
 void Warrior::update(float dt) {
+    const bench::ScopedSample sample { bench::Subsystem::UNITS };
+    PROFILE_ZONE("Warrior::update");
     // update components
     cocos2d::Node::update(dt);
     // custom updates
     UpdateDebugLabel();
     if (!IsDead()) {
-        UpdateWeapons(dt);
         UpdatePosition(dt); 
-        TryAttack();
         UpdateCurses(dt);
     }
     UpdateState(dt);
@@ -53,55 +56,47 @@ void Warrior::AttachNavigator(Path&& path) {
     for (auto& point: path.m_waypoints) {
         point.y = getPosition().y;
     }
-    m_navigator = std::make_unique<Navigator>(this, std::move(path));
+    const auto graph { NavigationGraph::Find(this) };
+    assert(graph && "The warrior walks by the level's graph");
+    m_navigator = std::make_unique<Navigator>(this, std::move(path), graph);
     Patrol();
 }
 
-void Warrior::Pursue(Unit * target) noexcept {
-    if(!IsDead() && target && !target->IsDead()) {
-        const auto shift { floorf(
-            target->GetHitBox().width / 2.f // shift to bottom left\right corner
-            + m_weapons[WeaponClass::MELEE]->GetRange() / 2.f // shift by weapon length (not 1.0f to be able to reach the target by attack!)
-            + m_contentSize.width / 2.f     // shift by size where the weapon's attack will be created
-        )};
-        // possible destinations (bottom middle of this unit)
-        const float xTargets[2] = { 
-            target->getPositionX() + shift,
-            target->getPositionX() - shift,
-        };
-        // choose the closest target in out influence field!
-        const float xDistances[2] = {
-            fabs(xTargets[0] - getPositionX()),
-            fabs(xTargets[1] - getPositionX())
-        };
-        const float xShift { floorf(m_physicsBodySize.width * 0.4f) };
-        // -xShift for left-bottom corner of this unit 
-        // +xShift for right-bottom corner of this unit 
-        // So if influence contains either of these corners than the unit won't fall down for sure!
-        const bool acceptable[2] = {
-            m_influence->ContainsX(xTargets[0] - xShift) || 
-            m_influence->ContainsX(xTargets[0] + xShift),
-
-            m_influence->ContainsX(xTargets[1] - xShift) || 
-            m_influence->ContainsX(xTargets[1] + xShift)
-        };
-        // find the closest point from the ones where unit won't fall down
-        int choosenIndex { -1 };
-        float xDistance { xDistances[0] };
-        for (int i = 0; i < 2; i++) {
-            if (acceptable[i] && xDistances[i] <= xDistance) {
-                choosenIndex = i;
-                xDistance = xDistances[i];
-            }
-        }
-        auto destination = getPosition();
-        if (choosenIndex != -1) { // every target lead to falling down or other shit
-            destination.x = xTargets[choosenIndex];
+cocos2d::Vec2 Warrior::GetPursuitPoint(const Snapshot& snapshot) const noexcept {
+    assert(snapshot.hasTarget && !snapshot.isTargetDead);
+    const auto shift { floorf(
+        snapshot.targetHitBox.width / 2.f // shift to bottom left\right corner
+        + m_weapons[WeaponClass::MELEE].GetRange() / 2.f // shift by weapon length (not 1.0f to be able to reach the target by attack!)
+        + m_contentSize.width / 2.f     // shift by size where the weapon's attack will be created
+    )};
+    // possible destinations (bottom middle of this unit)
+    const cocos2d::Vec2 targets[2] = { 
+        { snapshot.targetPosition.x + shift, snapshot.targetPosition.y },
+        { snapshot.targetPosition.x - shift, snapshot.targetPosition.y }
+    };
+    // choose the closest target
+    const float xDistances[2] = {
+        fabs(targets[0].x - getPositionX()),
+        fabs(targets[1].x - getPositionX())
+    };
+    // the graph's routes (precomputed for the level) know where the unit won't fall down
+    const bool acceptable[2] = {
+        m_navigator->IsReachable(targets[0]),
+        m_navigator->IsReachable(targets[1])
+    };
+    // find the closest point from the ones the unit can walk to
+    int choosenIndex { -1 };
+    float xDistance { xDistances[0] };
+    for (int i = 0; i < 2; i++) {
+        if (acceptable[i] && xDistances[i] <= xDistance) {
+            choosenIndex = i;
+            xDistance = xDistances[i];
         }
-        // move to target along X-axis;
-        // Pass own Y-axis coordinate to not move along Y-axis
-        m_navigator->VisitCustomPoint(destination);
     }
+    if (choosenIndex == -1) { // every target lead to falling down or other shit
+        return getPosition();
+    }
+    return targets[choosenIndex];
 }
 
 void Warrior::Patrol() noexcept {
@@ -111,8 +106,10 @@ void Warrior::Patrol() noexcept {
 /// Bot interface
 void Warrior::OnEnemyIntrusion() {
     m_detectEnemy = true;
-    auto target = getParent()->getChildByName<Unit *>(core::EntityNames::PLAYER);
-    Pursue(target);
+    const auto snapshot { Snapshot::Of(FindPlayer()) };
+    if (!IsDead() && snapshot.hasTarget && !snapshot.isTargetDead) {
+        m_navigator->VisitCustomPoint(GetPursuitPoint(snapshot));
+    }
 }
 
 void Warrior::OnEnemyLeave() {
@@ -120,19 +117,42 @@ void Warrior::OnEnemyLeave() {
     Patrol();
 }
 
+/// Decision interface
+Command Warrior::Decide(const Snapshot& snapshot) const noexcept {
+    if (auto command = Bot::Decide(snapshot); command) {
+        return command;
+    }
+    const auto& melee { m_weapons[WeaponClass::MELEE] };
+    const auto isBusy { melee.IsAttacking() || melee.IsPreparing() || melee.IsReloading() };
+    Command command;
+    if (m_detectEnemy && !isBusy && snapshot.hasTarget && !snapshot.isTargetDead) { 
+        // update target
+        command.actions = Command::VISIT;
+        command.point = GetPursuitPoint(snapshot);
+    }
+    return command;
+}
+
+void Warrior::Apply(const Command& command) {
+    if (command.Has(Command::VISIT)) {
+        m_navigator->VisitCustomPoint(command.point);
+    }
+    Bot::Apply(command);
+}
+
 void Warrior::UpdateState(const float dt) noexcept {
     m_previousState = m_currentState;
 
     if (m_health <= 0) {
         m_currentState = State::DEAD;
     } 
-    else if (m_weapons[WeaponClass::MELEE]->IsPreparing()) {
+    else if (m_weapons[WeaponClass::MELEE].IsPreparing()) {
         m_currentState = State::ATTACK;
     }
-    else if (m_weapons[WeaponClass::MELEE]->IsAttacking()) {
+    else if (m_weapons[WeaponClass::MELEE].IsAttacking()) {
         m_currentState = State::ATTACK;
     }
-    else if (m_weapons[WeaponClass::MELEE]->IsReloading()) {
+    else if (m_weapons[WeaponClass::MELEE].IsReloading()) {
         m_currentState = State::IDLE;
     }
     else if (m_detectEnemy) {
@@ -147,19 +167,15 @@ void Warrior::UpdatePosition(const float dt) noexcept {
     assert(!IsDead());
 
     auto initiateAttack { 
-        m_weapons[WeaponClass::MELEE]->IsAttacking() || 
-        m_weapons[WeaponClass::MELEE]->IsPreparing() 
+        m_weapons[WeaponClass::MELEE].IsAttacking() || 
+        m_weapons[WeaponClass::MELEE].IsPreparing() 
     };
-    if (m_weapons[WeaponClass::MELEE]->IsReloading()) {
+    if (m_weapons[WeaponClass::MELEE].IsReloading()) {
         // stop
         Stop(Movement::Axis::XY);
     }
     else if (!initiateAttack) {
-        if (m_detectEnemy) { // update target
-            auto target = getParent()->getChildByName<Unit *>(core::EntityNames::PLAYER);
-            Pursue(target);
-        }
-        // update
+        // the target is updated by the decided command
         m_navigator->Update(dt);
         m_movement->Update();
     }
@@ -181,7 +197,7 @@ void Warrior::UpdateAnimation() {
 
 void Warrior::OnDeath() {
     removeComponent(getPhysicsBody());
-    getChildByName("health")->removeFromParent();
+    RemoveHealthBar();
     m_animator->EndWith([this](){
         runAction(cocos2d::RemoveSelf::create(true));
     });
@@ -29,15 +29,24 @@ public:
 
     void OnEnemyLeave() override;
 
+/// Decision interface
+
+    [[nodiscard]] Command Decide(const Snapshot& snapshot) const noexcept override;
+
+    void Apply(const Command& command) override;
+
 protected:
 
     enum WeaponClass { MELEE };
 
-    Warrior(size_t id, const char* dragonBonesName, const cocos2d::Size& contentSize);
+    Warrior(size_t id, const std::string& dragonBonesName, const cocos2d::Size& contentSize);
     
 /// Unique to warrior
 
-    virtual void Pursue(Unit * target) noexcept;
+    /**
+     * @return the point to visit to reach the alive target
+     */
+    [[nodiscard]] virtual cocos2d::Vec2 GetPursuitPoint(const Snapshot& snapshot) const noexcept;
 
     virtual void Patrol() noexcept;
     
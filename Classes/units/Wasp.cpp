@@ -1,7 +1,7 @@
 #include "Wasp.hpp"
 #include "Core.hpp"
 
-#include "components/Weapon.hpp"
+#include "components/WeaponSystem.hpp"
 #include "components/DragonBonesAnimator.hpp"
 #include "components/Movement.hpp"
 #include "components/Influence.hpp"
@@ -40,80 +40,78 @@ Wasp::Wasp(size_t id
     , const cocos2d::Size& contentSize
     , const json_models::Wasp *model
 )
-    : Warrior{ id, core::EntityNames::WASP, contentSize }
+    : Warrior{ id, model->dragonbones, contentSize }
     , m_model { model }
 {
     m_physicsBodySize = cocos2d::Size { m_contentSize.width * 0.5f,  m_contentSize.height * 0.8f};
     m_hitBoxSize = cocos2d::Size { m_contentSize.width * 0.6f, m_contentSize.height * 0.9f };
+    m_frameCacheRate = static_cast<unsigned>(m_model->frameCache);
 }
 
 void Wasp::AddWeapons() {
     const auto attackDuration { 0.2f };
     const auto preparationTime { m_animator->GetDuration(Utils::EnumCast(State::ATTACK)) - attackDuration };
 
-    auto genPos = [this]() -> cocos2d::Rect {
-        auto attackRange { m_weapons[WeaponClass::MELEE]->GetRange() };
-        cocos2d::Size stingSize { attackRange, attackRange / 4.f };
-
-        auto position = getPosition();
-        if (IsLookingLeft()) {
-            position.x -= m_hitBoxSize.width / 2.f + stingSize.width;
-        }
-        else {
-            position.x += m_hitBoxSize.width / 2.f;
-        }
-        position.y += m_hitBoxSize.height / 8.f;
-
-        return { position, stingSize };
-    };
-    auto genVel = [this](cocos2d::PhysicsBody* body) {
-        body->setVelocity(getPhysicsBody()->getVelocity());
-    };
-
     const auto& sting = m_model->weapons.sting;
-    auto& weapon = m_weapons[WeaponClass::MELEE];
-    weapon.reset(new Sting(sting.damage
+    m_weapons[WeaponClass::MELEE] = m_weaponSystem->Add(this
+        , WeaponSystem::Kind::STING
+        , WeaponClass::MELEE
+        , sting.damage
         , sting.range
         , preparationTime
         , attackDuration
-        , sting.cooldown));
-    weapon->AddPositionGenerator(std::move(genPos));
-    weapon->AddVelocityGenerator(std::move(genVel));
+        , sting.cooldown
+    );
+}
+
+cocos2d::Rect Wasp::GetAttackArea(size_t weapon) const {
+    auto attackRange { m_weapons[WeaponClass::MELEE].GetRange() };
+    cocos2d::Size stingSize { attackRange, attackRange / 4.f };
+
+    auto position = getPosition();
+    if (IsLookingLeft()) {
+        position.x -= m_hitBoxSize.width / 2.f + stingSize.width;
+    }
+    else {
+        position.x += m_hitBoxSize.width / 2.f;
+    }
+    position.y += m_hitBoxSize.height / 8.f;
+
+    return { position, stingSize };
+}
+
+void Wasp::PushProjectile(size_t weapon, cocos2d::PhysicsBody * body) const {
+    body->setVelocity(getPhysicsBody()->getVelocity());
 }
 
 void Wasp::Attack() {
     assert(!IsDead());
-    assert(m_weapons[WeaponClass::MELEE]->IsReady());
+    assert(m_weapons[WeaponClass::MELEE].IsReady());
 
-    m_weapons[WeaponClass::MELEE]->LaunchAttack();
+    m_weapons[WeaponClass::MELEE].LaunchAttack();
 }
 
-void Wasp::Pursue(Unit * target) noexcept {
-    assert(target);
-    if (!IsDead() && target && !target->IsDead()) {
-        m_navigator->VisitCustomPoint(
-            target->getPosition() + cocos2d::Vec2{0.f, target->GetHitBox().height / 2.f}
-        );
-    }
+cocos2d::Vec2 Wasp::GetPursuitPoint(const Snapshot& snapshot) const noexcept {
+    assert(snapshot.hasTarget && !snapshot.isTargetDead);
+    return snapshot.targetPosition + cocos2d::Vec2{0.f, snapshot.targetHitBox.height / 2.f};
 }
 
-bool Wasp::NeedAttack() const noexcept {
+bool Wasp::NeedAttack(const Snapshot& snapshot) const noexcept {
     assert(!IsDead());
     bool attackIsReady { m_detectEnemy 
-        && m_weapons[WeaponClass::MELEE]->IsReady()
+        && m_weapons[WeaponClass::MELEE].IsReady()
     };
     if (!attackIsReady) {
         return false;
     }
     
     bool enemyIsClose = false;
-    const auto target = getParent()->getChildByName<const Unit*>(core::EntityNames::PLAYER);
     // use some simple algorithm to determine whether a player is close enough to the target
     // to perform an attack
-    if (target && !target->IsDead()) {
+    if (snapshot.hasTarget && !snapshot.isTargetDead) {
         // TODO: this is code replication!!!! (see above Wasp::Attack())
         // calc position of the stinger:
-        const auto attackRange { m_weapons[WeaponClass::MELEE]->GetRange() };
+        const auto attackRange { m_weapons[WeaponClass::MELEE].GetRange() };
         const cocos2d::Size stingSize { attackRange, attackRange / 4.4f };
         auto position = getPosition();
         if (IsLookingLeft()) {
@@ -124,10 +122,10 @@ bool Wasp::NeedAttack() const noexcept {
         }
         position.y += m_hitBoxSize.height / 8.f;
 
-        const auto radius = m_weapons[WeaponClass::MELEE]->GetRange() * 0.75f;
-        const auto targetHitbox = target->GetHitBox();
+        const auto radius = m_weapons[WeaponClass::MELEE].GetRange() * 0.75f;
+        const auto targetHitbox = snapshot.targetHitBox;
         const cocos2d::Rect lhs { 
-            target->getPosition() - cocos2d::Vec2{ targetHitbox.width / 2.f, 0.f },
+            snapshot.targetPosition - cocos2d::Vec2{ targetHitbox.width / 2.f, 0.f },
             targetHitbox
         };
         const cocos2d::Rect rhs { position, stingSize };
@@ -20,6 +20,12 @@ public:
 
     void AttachNavigator(Path&& path) override;
 
+/// Weapon interface
+
+    [[nodiscard]] cocos2d::Rect GetAttackArea(size_t weapon) const;
+
+    void PushProjectile(size_t weapon, cocos2d::PhysicsBody * body) const;
+
 private:
     enum WeaponClass { MELEE };
 
@@ -33,11 +39,11 @@ private:
 
     void OnEnemyLeave() override;
 
-    bool NeedAttack() const noexcept override;
+    bool NeedAttack(const Snapshot& snapshot) const noexcept override;
 
     void Attack() override;
 
-    void Pursue(Unit * target) noexcept override;
+    [[nodiscard]] cocos2d::Vec2 GetPursuitPoint(const Snapshot& snapshot) const noexcept override;
 
     void AddPhysicsBody() override;
 
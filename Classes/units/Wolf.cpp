@@ -1,7 +1,7 @@
 #include "Wolf.hpp"
 #include "Core.hpp"
 
-#include "components/Weapon.hpp"
+#include "components/WeaponSystem.hpp"
 #include "components/DragonBonesAnimator.hpp"
 #include "components/Movement.hpp"
 
@@ -38,13 +38,14 @@ Wolf::Wolf(size_t id
     , const cocos2d::Size& contentSize
     , const json_models::Wolf *model
 )
-    : Warrior{ id, core::EntityNames::WOLF, contentSize }
+    : Warrior{ id, model->dragonbones, contentSize }
     , m_model { model }
 {
     assert(model);
     m_physicsBodySize = cocos2d::Size { m_contentSize.width * 0.9f,  m_contentSize.height };
     m_hitBoxSize = m_physicsBodySize;
     m_health = m_model->health;
+    m_frameCacheRate = static_cast<unsigned>(m_model->frameCache);
 }
 
 void Wolf::AddWeapons() {
@@ -53,42 +54,44 @@ void Wolf::AddWeapons() {
     const auto attackDuration { 0.2f };
     const auto preparationTime { m_animator->GetDuration(Utils::EnumCast(State::ATTACK)) - attackDuration };
 
-    auto genPos = [this]() -> cocos2d::Rect {
-        auto attackRange { m_weapons[WeaponClass::MELEE]->GetRange() };
-        // make maw larger because it's too small and it's not 
-        // enough to cut down a few percents for Warrior::Pursue algorighm 
-        cocos2d::Size mawSize { attackRange * 1.5f, attackRange * 2.f };
-
-        auto position = getPosition();
-        if (IsLookingLeft()) {
-            position.x -= m_hitBoxSize.width / 2.f + mawSize.width;
-        }
-        else {
-            position.x += m_hitBoxSize.width / 2.f;
-        }
-        position.y += m_hitBoxSize.height / 3.f;
-
-        return { position, mawSize };
-    };
-    auto genVel = [this](cocos2d::PhysicsBody* body) {
-        body->setVelocity(getPhysicsBody()->getVelocity());
-    };
-
-    auto& weapon = m_weapons[WeaponClass::MELEE];
-    weapon.reset(new Maw(maw.damage
+    m_weapons[WeaponClass::MELEE] = m_weaponSystem->Add(this
+        , WeaponSystem::Kind::MAW
+        , WeaponClass::MELEE
+        , maw.damage
         , maw.range
         , preparationTime
         , attackDuration
-        , maw.cooldown));
-    weapon->AddPositionGenerator(std::move(genPos));
-    weapon->AddVelocityGenerator(std::move(genVel));
+        , maw.cooldown
+    );
+}
+
+cocos2d::Rect Wolf::GetAttackArea(size_t weapon) const {
+    auto attackRange { m_weapons[WeaponClass::MELEE].GetRange() };
+    // make maw larger because it's too small and it's not 
+    // enough to cut down a few percents for Warrior::Pursue algorighm 
+    cocos2d::Size mawSize { attackRange * 1.5f, attackRange * 2.f };
+
+    auto position = getPosition();
+    if (IsLookingLeft()) {
+        position.x -= m_hitBoxSize.width / 2.f + mawSize.width;
+    }
+    else {
+        position.x += m_hitBoxSize.width / 2.f;
+    }
+    position.y += m_hitBoxSize.height / 3.f;
+
+    return { position, mawSize };
+}
+
+void Wolf::PushProjectile(size_t weapon, cocos2d::PhysicsBody * body) const {
+    body->setVelocity(getPhysicsBody()->getVelocity());
 }
 
 void Wolf::Attack() {
     assert(!IsDead());
-    assert(m_weapons[WeaponClass::MELEE]->IsReady());
+    assert(m_weapons[WeaponClass::MELEE].IsReady());
 
-    m_weapons[WeaponClass::MELEE]->LaunchAttack();
+    m_weapons[WeaponClass::MELEE].LaunchAttack();
 }
 
 void Wolf::OnEnemyIntrusion() {
@@ -101,27 +104,26 @@ void Wolf::OnEnemyLeave() {
     m_movement->SetMaxSpeed(m_model->idleSpeed);
 }
 
-bool Wolf::NeedAttack() const noexcept {
+bool Wolf::NeedAttack(const Snapshot& snapshot) const noexcept {
     assert(!IsDead());
 
     bool attackIsReady {
         m_detectEnemy && 
-        m_weapons[WeaponClass::MELEE]->IsReady()
+        m_weapons[WeaponClass::MELEE].IsReady()
     };
     if (!attackIsReady) {
         return false;
     }
 
     bool enemyIsClose = false;
-    const auto target = getParent()->getChildByName<const Unit*>(core::EntityNames::PLAYER);
     // use some simple algorithm to determine whether a player is close enough to the target
     // to perform an attack
-    if (target && !target->IsDead()) {
+    if (snapshot.hasTarget && !snapshot.isTargetDead) {
         // calc position of the maw:
-        const auto radius = m_weapons[WeaponClass::MELEE]->GetRange();
-        const auto targetHitbox = target->GetHitBox();
+        const auto radius = m_weapons[WeaponClass::MELEE].GetRange();
+        const auto targetHitbox = snapshot.targetHitBox;
         const cocos2d::Rect lhs { 
-            target->getPosition() - cocos2d::Vec2{ targetHitbox.width / 2.f, 0.f },
+            snapshot.targetPosition - cocos2d::Vec2{ targetHitbox.width / 2.f, 0.f },
             targetHitbox
         };
         const cocos2d::Rect rhs { // check attack in both directions
@@ -18,6 +18,12 @@ public:
 
     bool init() override;
 
+/// Weapon interface
+
+    [[nodiscard]] cocos2d::Rect GetAttackArea(size_t weapon) const;
+
+    void PushProjectile(size_t weapon, cocos2d::PhysicsBody * body) const;
+
 private:
     enum WeaponClass { MELEE };
 
@@ -33,7 +39,7 @@ private:
 
     void OnEnemyLeave() override;
 
-    bool NeedAttack() const noexcept override;
+    bool NeedAttack(const Snapshot& snapshot) const noexcept override;
 
 private:
 
@@ -0,0 +1,87 @@
+#include "BonesComparison.hpp"
+#include "Fixtures.hpp"
+
+#include "dragonBones/cocos2dx/CCDragonBonesHeaders.h"
+#include "dragonBones/armature/BoneHierarchy.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+namespace headless {
+
+bool CompareBones(const Options& options) {
+    static constexpr size_t FRAMES_PER_ANIMATION { 60U };
+    // relative to the magnitude of the coordinates (pixels);
+    // the batched sines and cosines differ from `std::sin` and `std::cos` by an ulp
+    static constexpr float TOLERANCE { 1e-4f };
+
+    const auto& path { options.bones };
+    const auto expected { BuildArmature(path) };
+    if (!expected) {
+        return false;
+    }
+    const auto actual { dragonBones::CCFactory::getFactory()->buildArmature(
+        expected->getName(), expected->getArmatureData()->parent->name) };
+    if (!actual) {
+        std::fprintf(stderr, "Failed to build the second armature of %s\n", path.c_str());
+        return false;
+    }
+
+    using Clock = std::chrono::steady_clock;
+    using dragonBones::BoneHierarchy;
+    Clock::duration boneTime {};
+    Clock::duration hierarchyTime {};
+    size_t frames { 0U };
+    float maxError { 0.f };
+    for (const auto& animation: expected->getArmatureData()->animationNames) {
+        expected->getAnimation()->play(animation, 0);
+        actual->getAnimation()->play(animation, 0);
+        for (size_t frame = 0; frame < FRAMES_PER_ANIMATION; frame++) {
+            BoneHierarchy::enabled = false;
+            auto start { Clock::now() };
+            expected->advanceTime(1.f / 60.f);
+            boneTime += Clock::now() - start;
+            BoneHierarchy::enabled = true;
+            start = Clock::now();
+            actual->advanceTime(1.f / 60.f);
+            hierarchyTime += Clock::now() - start;
+            frames++;
+
+            const auto& expectedSlots { expected->getSlots() };
+            const auto& actualSlots { actual->getSlots() };
+            for (size_t i = 0; i < expectedSlots.size(); i++) {
+                const auto& lhs { expectedSlots[i]->globalTransformMatrix };
+                const auto& rhs { actualSlots[i]->globalTransformMatrix };
+                const float values[][2] {
+                    { lhs.a, rhs.a }, { lhs.b, rhs.b }, { lhs.c, rhs.c }, { lhs.d, rhs.d },
+                    { lhs.tx, rhs.tx }, { lhs.ty, rhs.ty }
+                };
+                for (const auto& [lhsValue, rhsValue]: values) {
+                    maxError = std::max(maxError, std::abs(lhsValue - rhsValue) / std::max(1.f, std::abs(lhsValue)));
+                }
+            }
+        }
+    }
+    const auto bones { expected->getBones().size() };
+    expected->dispose();
+    actual->dispose();
+
+    const auto perFrame = [frames](Clock::duration time) {
+        const std::chrono::duration<double, std::micro> us { time };
+        return frames > 0U? us.count() / frames : 0.0;
+    };
+    std::printf("%s: %zu bones, %zu frames over all animations\n", path.c_str(), bones, frames);
+    std::printf("%-10s %16s\n", "update", "us/frame");
+    std::printf("%-10s %16.2f\n", "bones", perFrame(boneTime));
+    std::printf("%-10s %16.2f\n", "hierarchy", perFrame(hierarchyTime));
+    std::printf("max relative error: %g\n", maxError);
+    if (maxError > TOLERANCE) {
+        std::fprintf(stderr, "The bone hierarchy differs from the bone by bone update: %g > %g\n", maxError, TOLERANCE);
+        return false;
+    }
+    return true;
+}
+
+} // namespace headless
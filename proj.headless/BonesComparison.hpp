@@ -0,0 +1,17 @@
+#ifndef HEADLESS_BONES_COMPARISON_HPP
+#define HEADLESS_BONES_COMPARISON_HPP
+
+#include "Options.hpp"
+
+namespace headless {
+
+/**
+ * Play each animation on two instances of the armature, one updated by the flattened
+ * bone hierarchy and the other bone by bone, check that the slots agree and report
+ * the time of both updates.
+ */
+bool CompareBones(const Options& options);
+
+} // namespace headless
+
+#endif // HEADLESS_BONES_COMPARISON_HPP
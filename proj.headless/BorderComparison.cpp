@@ -0,0 +1,317 @@
+#include "BorderComparison.hpp"
+#include "Timing.hpp"
+
+#include "BorderBuilder.hpp"
+#include "TileMapHelper.hpp"
+#include "cocos2d.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+    /**
+     * Model of the border extraction before the marching squares builder:
+     * walk the border tiles turning right into `std::list` chains, then take a point
+     * at the corner tiles by looking at their neighbours.
+     * The number of the free neighbours isn't asserted so the model can't abort the comparison.
+     */
+    class LegacyBorderBuilder final {
+    public:
+        using Property = TileMap::Property;
+
+        explicit LegacyBorderBuilder(const TileMap::Cache& cache)
+            : m_cache { cache }
+        {}
+
+        std::vector<std::vector<cocos2d::Vec2>> Build() const {
+            std::vector<std::vector<char>> isVisited (
+                m_cache.mapHeight,
+                std::vector<char>(m_cache.mapWidth, false)
+            );
+            std::vector<std::list<cocos2d::Vec2>> tiles;
+            for (size_t y = 0; y < m_cache.mapHeight; y++) {
+                for (size_t x = 0; x < m_cache.mapWidth; x++) {
+                    if (isVisited[y][x]) continue;
+                    const cocos2d::Vec2 point { static_cast<float>(x), static_cast<float>(y) };
+                    if (!Utils::HasAny(m_cache.GetProperties(point), Property::BORDER)) continue;
+
+                    tiles.emplace_back();
+                    tiles.back().emplace_back(point);
+                    this->Visit(point, [&tiles = tiles.back()](const cocos2d::Vec2& tile) {
+                        tiles.push_back(tile);
+                    }, isVisited);
+                    this->Visit(point, [&tiles = tiles.back()](const cocos2d::Vec2& tile) {
+                        tiles.push_front(tile);
+                    }, isVisited);
+                }
+            }
+
+            std::vector<std::vector<cocos2d::Vec2>> chains;
+            chains.reserve(tiles.size());
+            for (const auto& chain: tiles) {
+                chains.emplace_back();
+                for (const auto& tile: chain) {
+                    if (const auto point { this->AddPoint(tile) }; point.has_value()) {
+                        chains.back().emplace_back(*point);
+                    }
+                }
+                // if distance between front and back tiles is short enough => connect them
+                const float dx { chain.front().x - chain.back().x };
+                const float dy { chain.front().y - chain.back().y };
+                const bool isSameLine { std::abs(dx) <= 0.1f || std::abs(dy) <= 0.1f };
+                if (!chains.back().empty() && std::abs(dx) + std::abs(dy) <= 10.f && isSameLine) {
+                    chains.back().emplace_back(chains.back().front());
+                }
+            }
+            return chains;
+        }
+
+    private:
+        std::optional<cocos2d::Vec2> AddPoint(const cocos2d::Vec2& point) const {
+            cocos2d::Vec2 shiftsToFree[4] = {};
+            cocos2d::Vec2 shiftsToBorder[4] = {};
+            int borderTileCount { 0 };
+            int freeTileCount { 0 };
+            int countOutsideMap { 0 };
+            for (const auto& delta: HORIZONTAL_DELTA) {
+                const auto mask { m_cache.GetProperties(point + delta) };
+                if (Utils::HasAny(mask, Property::OUTSIDE_MAP)) {
+                    shiftsToFree[freeTileCount++] = delta;
+                    ++countOutsideMap;
+                }
+                else if (!Utils::HasAny(mask, Property::BORDER, Property::SOLID)) {
+                    shiftsToFree[freeTileCount++] = delta;
+                }
+                else if (Utils::HasAny(mask, Property::BORDER)) {
+                    shiftsToBorder[borderTileCount++] = delta;
+                }
+            }
+            const auto freeSum { shiftsToFree[0] + shiftsToFree[1] };
+            const auto borderSum { shiftsToBorder[0] + shiftsToBorder[1] };
+            const bool hasFreeTilesCardinalContinuation { std::abs(std::abs(freeSum.x) + std::abs(freeSum.y) - 2.f) <= 0.01f };
+            const bool hasFreeTilesInMap { freeTileCount != countOutsideMap };
+            const bool hasBorderTilesCardinalContinuation { std::abs(borderSum.x) + std::abs(borderSum.y) > 0.1f };
+
+            // From tile coordinates in Tiled.exe to coordinates in game engine
+            const auto& tileSize { m_cache.tileSize };
+            cocos2d::Vec2 tileMiddle {
+                point.x * tileSize.width + tileSize.width / 2.f,
+                (m_cache.mapHeight - point.y - 1.f) * tileSize.height + tileSize.height / 2.f
+            };
+            if (freeTileCount == 2 && hasFreeTilesCardinalContinuation) {
+                tileMiddle.x +=  freeSum.x * tileSize.width / 2.f;
+                tileMiddle.y += -freeSum.y * tileSize.height / 2.f;
+                return { tileMiddle };
+            }
+            if (!hasFreeTilesInMap && hasBorderTilesCardinalContinuation) {
+                for (const auto& delta: DIAGONAL_DELTA) {
+                    const auto mask { m_cache.GetProperties(point + delta) };
+                    if (!Utils::HasAny(mask, Property::OUTSIDE_MAP, Property::BORDER, Property::SOLID)) {
+                        tileMiddle.x +=  delta.x * tileSize.width / 2.f;
+                        tileMiddle.y += -delta.y * tileSize.height / 2.f;
+                        break;
+                    }
+                }
+                return { tileMiddle };
+            }
+            return std::nullopt;
+        }
+
+        /**
+         * Go from the start through the first met neighbour, turning right when blocked,
+         * until no way is left in all four directions.
+         */
+        void Visit(cocos2d::Vec2 point
+            , std::function<void(const cocos2d::Vec2&)> && add
+            , std::vector<std::vector<char>>& isVisited) const
+        {
+            static const cocos2d::Vec2 SHIFTS[4] = { { 1.f, 0.f }, { 0.f, 1.f }, { -1.f, 0.f }, { 0.f, -1.f } };
+
+            isVisited[static_cast<size_t>(point.y)][static_cast<size_t>(point.x)] = true;
+            for (size_t shift = 0, skips = 0; ; shift = (shift + 1) % 4) {
+                size_t steps { 0 };
+                while (m_cache.IsInMap(point + SHIFTS[shift])) {
+                    const auto next { point + SHIFTS[shift] };
+                    const auto x { static_cast<size_t>(next.x) };
+                    const auto y { static_cast<size_t>(next.y) };
+                    if (isVisited[y][x] || !Utils::HasAny(m_cache.GetProperties(next), Property::BORDER)) {
+                        break;
+                    }
+                    isVisited[y][x] = true;
+                    point = next;
+                    add(point);
+                    steps++;
+                }
+                skips = steps? 0: skips + 1;
+                if (skips >= 4) break;
+            }
+        }
+
+        static inline const cocos2d::Vec2 HORIZONTAL_DELTA[4] = {
+            { -1.f, 0.f }, { 1.f, 0.f }, { 0.f, 1.f }, { 0.f, -1.f }
+        };
+
+        static inline const cocos2d::Vec2 DIAGONAL_DELTA[4] = {
+            { -1.f, -1.f }, { -1.f, 1.f }, { 1.f, 1.f }, { 1.f, -1.f }
+        };
+
+        const TileMap::Cache& m_cache;
+    };
+
+    /**
+     * Sides of the tiles covered by the border chains.
+     */
+    struct BorderSides final {
+        // `2 * corner` for the horizontal side going right from the corner, `2 * corner + 1`
+        // for the vertical side going up; corners are `y * (width + 1) + x` in tiles, y goes up
+        std::vector<uint64_t> sides;
+        // segments which aren't horizontal or vertical
+        size_t diagonals { 0U };
+        size_t points { 0U };
+    };
+
+    BorderSides SplitIntoSides(const std::vector<std::vector<cocos2d::Vec2>>& chains, const TileMap::Cache& cache) {
+        BorderSides result;
+        const auto stride { static_cast<int64_t>(cache.mapWidth + 1U) };
+        const auto ToCorner = [&cache](const cocos2d::Vec2& point) {
+            return std::make_pair(
+                static_cast<int64_t>(std::lround(point.x / cache.tileSize.width)),
+                static_cast<int64_t>(std::lround(point.y / cache.tileSize.height))
+            );
+        };
+        for (const auto& chain: chains) {
+            result.points += chain.size();
+            for (size_t i = 1U; i < chain.size(); i++) {
+                auto [x0, y0] = ToCorner(chain[i - 1U]);
+                auto [x1, y1] = ToCorner(chain[i]);
+                if (x0 != x1 && y0 != y1) {
+                    result.diagonals++;
+                    continue;
+                }
+                const bool isVertical { x0 == x1 };
+                if (std::make_pair(x0, y0) > std::make_pair(x1, y1)) {
+                    std::swap(x0, x1);
+                    std::swap(y0, y1);
+                }
+                for (auto x = x0, y = y0; x != x1 || y != y1; (isVertical? y: x)++) {
+                    result.sides.push_back(2U * static_cast<uint64_t>(y * stride + x) + (isVertical? 1U: 0U));
+                }
+            }
+        }
+        std::sort(result.sides.begin(), result.sides.end());
+        result.sides.erase(std::unique(result.sides.begin(), result.sides.end()), result.sides.end());
+        return result;
+    }
+
+    /**
+     * Sides of the border tiles facing a free tile (neither border nor solid) of the map:
+     * what the chains must cover. Keys are the ones of `BorderSides`.
+     */
+    std::vector<uint64_t> GetExpectedSides(const TileMap::Cache& cache) {
+        using TileMap::Property;
+
+        const auto stride { static_cast<uint64_t>(cache.mapWidth + 1U) };
+        const auto IsFree = [&cache](int64_t col, int64_t row) {
+            const auto mask { cache.GetProperties(static_cast<int>(row), static_cast<int>(col)) };
+            return !Utils::HasAny(mask, Property::OUTSIDE_MAP, Property::BORDER, Property::SOLID);
+        };
+        std::vector<uint64_t> sides;
+        for (size_t row = 0U; row < cache.mapHeight; row++) {
+            for (size_t col = 0U; col < cache.mapWidth; col++) {
+                if (!Utils::HasAny(cache.properties[row * cache.mapWidth + col], Property::BORDER)) continue;
+
+                const auto x { static_cast<int64_t>(col) };
+                const auto y { static_cast<int64_t>(row) };
+                // the bottom left corner of the tile: rows of the map go down, y of the corners goes up
+                const auto corner { (cache.mapHeight - row - 1U) * stride + col };
+                if (IsFree(x, y - 1)) sides.push_back(2U * (corner + stride));
+                if (IsFree(x, y + 1)) sides.push_back(2U * corner);
+                if (IsFree(x - 1, y)) sides.push_back(2U * corner + 1U);
+                if (IsFree(x + 1, y)) sides.push_back(2U * (corner + 1U) + 1U);
+            }
+        }
+        std::sort(sides.begin(), sides.end());
+        return sides;
+    }
+
+} // namespace {
+
+namespace headless {
+
+bool CompareBorders(const Options& options) {
+    static constexpr size_t REPEATS { 3U };
+
+    const auto tileMap { cocos2d::FastTMXTiledMap::create(options.borders) };
+    if (!tileMap || !tileMap->getLayer(TileMap::COLLISION_LAYER_NAME)) {
+        std::fprintf(stderr, "Failed to load %s\n", options.borders.c_str());
+        return false;
+    }
+    const TileMap::Cache cache { tileMap };
+
+    std::vector<details::Form> forms;
+    const auto currentTiming { Measure(REPEATS, [&forms, &cache]() {
+        forms = BorderBuilder{ &cache }.Build();
+    }) };
+    std::vector<std::vector<cocos2d::Vec2>> legacyChains;
+    const auto legacyTiming { Measure(REPEATS, [&legacyChains, &cache]() {
+        legacyChains = ::LegacyBorderBuilder{ cache }.Build();
+    }) };
+
+    std::vector<std::vector<cocos2d::Vec2>> chains;
+    chains.reserve(forms.size());
+    for (auto& form: forms) {
+        chains.emplace_back(std::move(form.m_points));
+    }
+    const auto current { ::SplitIntoSides(chains, cache) };
+    const auto legacy { ::SplitIntoSides(legacyChains, cache) };
+    const auto expected { ::GetExpectedSides(cache) };
+
+    const auto Difference = [](const std::vector<uint64_t>& lhs, const std::vector<uint64_t>& rhs) {
+        std::vector<uint64_t> result;
+        std::set_difference(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend(), std::back_inserter(result));
+        return result;
+    };
+    const auto stride { static_cast<uint64_t>(cache.mapWidth + 1U) };
+    const auto IsOnMapEdge = [&cache, stride](uint64_t side) {
+        const auto corner { side / 2U };
+        const auto x { corner % stride };
+        const auto y { corner / stride };
+        return (side & 1U)? x == 0U || x == cache.mapWidth: y == 0U || y == cache.mapHeight;
+    };
+    const auto currentOnly { Difference(current.sides, legacy.sides) };
+    const auto legacyOnly { Difference(legacy.sides, current.sides) };
+    const auto mapEdge { static_cast<size_t>(std::count_if(legacyOnly.cbegin(), legacyOnly.cend(), IsOnMapEdge)) };
+    const auto missed { Difference(expected, current.sides).size() };
+    const auto extra { Difference(current.sides, expected).size() };
+
+    std::printf("%s %zux%zu, %u hardware threads\n"
+        , options.borders.c_str(), cache.mapWidth, cache.mapHeight, std::thread::hardware_concurrency());
+    std::printf("%-10s %8s %8s %8s %10s\n", "builder", "chains", "points", "sides", "diagonals");
+    std::printf("%-10s %8zu %8zu %8zu %10zu\n", "current"
+        , chains.size(), current.points, current.sides.size(), current.diagonals);
+    std::printf("%-10s %8zu %8zu %8zu %10zu\n", "legacy"
+        , legacyChains.size(), legacy.points, legacy.sides.size(), legacy.diagonals);
+    PrintTimingHeader("builder", "ms");
+    PrintTiming("current", currentTiming);
+    PrintTiming("legacy", legacyTiming);
+    std::printf("sides only in the current chains: %zu\n", currentOnly.size());
+    std::printf("sides only in the legacy chains: %zu on the map's edge, %zu elsewhere\n"
+        , mapEdge, legacyOnly.size() - mapEdge);
+    if (missed > 0U || extra > 0U || current.diagonals > 0U) {
+        std::fprintf(stderr, "The current chains miss %zu and add %zu sides of the border tiles\n", missed, extra);
+        return false;
+    }
+    return true;
+}
+
+} // namespace headless
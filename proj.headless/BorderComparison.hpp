@@ -0,0 +1,21 @@
+#ifndef HEADLESS_BORDER_COMPARISON_HPP
+#define HEADLESS_BORDER_COMPARISON_HPP
+
+#include "Options.hpp"
+
+namespace headless {
+
+/**
+ * Build the border chains of the map by the marching squares builder and by the former
+ * tile walk, report the time of both and where they differ.
+ *
+ * The current chains must cover exactly the border sides facing free tiles.
+ * The former builder also walked the sides lying on the map's edge, which the current one
+ * skips by design (nothing comes from the outside of the map), and could leave or
+ * misroute sides where the borders branch: both are reported apart and don't fail the check.
+ */
+bool CompareBorders(const Options& options);
+
+} // namespace headless
+
+#endif // HEADLESS_BORDER_COMPARISON_HPP
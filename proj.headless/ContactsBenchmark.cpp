@@ -0,0 +1,142 @@
+#include "ContactsBenchmark.hpp"
+#include "Script.hpp"
+#include "Timing.hpp"
+
+#include "ContactHandler.hpp"
+#include "Core.hpp"
+#include "Utils.hpp"
+#include "dragonBones/cocos2dx/CCDragonBonesHeaders.h"
+#include "cocos2d.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+    /**
+     * Category masks of the contact's shapes and their bodies
+     */
+    struct RecordedContact final {
+        std::uint32_t shapes[2];
+        std::uint32_t bodies[2];
+    };
+
+    /**
+     * Model of the contact begin before the dispatch table: the chain of the mask comparisons.
+     * @return index of the matched rule as `contact::MatchBeginRule` numbers them:
+     *  sensor, platform, trap, units, projectiles, projectile and 6 when the contact proceeds
+     */
+    size_t LegacyMatchBeginRule(const RecordedContact& contact) noexcept {
+        using core::CategoryBits;
+        const auto& [shapes, bodies] { contact };
+        const auto sensor { static_cast<std::uint32_t>(Utils::CreateMask(CategoryBits::GROUND_SENSOR)) };
+        if (shapes[0] == sensor || shapes[1] == sensor) {
+            return 0U;
+        }
+        const auto platform { static_cast<std::uint32_t>(Utils::CreateMask(CategoryBits::PLATFORM)) };
+        const auto unit { static_cast<std::uint32_t>(Utils::CreateMask(CategoryBits::PLAYER, CategoryBits::ENEMY)) };
+        if ((bodies[0] == platform || bodies[1] == platform) && ((bodies[0] & unit) > 0U || (bodies[1] & unit) > 0U)) {
+            return 1U;
+        }
+        const auto trap { static_cast<std::uint32_t>(Utils::CreateMask(CategoryBits::TRAP)) };
+        if (bodies[0] == trap || bodies[1] == trap) {
+            return 2U;
+        }
+        if ((bodies[0] & unit) > 0U && (bodies[1] & unit) > 0U) {
+            return 3U;
+        }
+        const auto projectile { static_cast<std::uint32_t>(
+            Utils::CreateMask(CategoryBits::PLAYER_PROJECTILE, CategoryBits::ENEMY_PROJECTILE)) };
+        const bool isProjectile[2] { (bodies[0] & projectile) > 0U, (bodies[1] & projectile) > 0U };
+        if (isProjectile[0] && isProjectile[1]) {
+            return 4U;
+        }
+        if (isProjectile[0] || isProjectile[1]) {
+            return 5U;
+        }
+        return 6U;
+    }
+
+} // namespace {
+
+namespace headless {
+
+bool BenchmarkContacts(const Options& options) {
+    static constexpr size_t REPLAYS { 100U };
+
+    const auto director { cocos2d::Director::getInstance() };
+    const auto dispatcher { director->getEventDispatcher() };
+    const auto scheduler { director->getScheduler() };
+    const auto armatures { dragonBones::CCFactory::getInstance() };
+    scheduler->pauseTarget(dragonBones::CCFactory::getFactory());
+
+    std::vector<RecordedContact> stream;
+    const auto recorder { cocos2d::EventListenerPhysicsContact::create() };
+    recorder->onContactBegin = [&stream](cocos2d::PhysicsContact& contact) {
+        const auto shapeA { contact.getShapeA() };
+        const auto shapeB { contact.getShapeB() };
+        stream.push_back(RecordedContact {
+            { static_cast<std::uint32_t>(shapeA->getCategoryBitmask()), static_cast<std::uint32_t>(shapeB->getCategoryBitmask()) },
+            { static_cast<std::uint32_t>(shapeA->getBody()->getCategoryBitmask()), static_cast<std::uint32_t>(shapeB->getBody()->getCategoryBitmask()) }
+        });
+        return true;
+    };
+    // negative priority: before the scene graph listeners
+    dispatcher->addEventListenerWithFixedPriority(recorder, -1);
+    const auto script { DefaultScript(options.contacts) };
+    auto nextKey { script.cbegin() };
+    for (size_t frame = 0; frame < options.contacts; frame++) {
+        for (; nextKey != script.cend() && nextKey->frame <= frame; ++nextKey) {
+            cocos2d::EventKeyboard event { nextKey->code, nextKey->pressed };
+            dispatcher->dispatchEvent(&event);
+        }
+        scheduler->update(options.dt);
+        armatures->advanceTime(options.dt);
+        cocos2d::PoolManager::getInstance()->getCurrentPool()->clear();
+    }
+    dispatcher->removeEventListener(recorder);
+    if (stream.empty()) {
+        std::fprintf(stderr, "No contacts recorded in %zu frames\n", options.contacts);
+        return false;
+    }
+
+    std::array<size_t, 7U> rules {};
+    size_t mismatches { 0U };
+    for (const auto& contact: stream) {
+        const auto table { contact::MatchBeginRule(contact.shapes[0], contact.bodies[0], contact.shapes[1], contact.bodies[1]) };
+        const auto chain { ::LegacyMatchBeginRule(contact) };
+        mismatches += table != chain? 1U: 0U;
+        rules[std::min(table, rules.size() - 1U)]++;
+    }
+    // the sums keep the matches from being optimized out
+    size_t tableSum { 0U };
+    size_t chainSum { 0U };
+    const auto tableTiming { Measure(REPLAYS, [&stream, &tableSum]() {
+        for (const auto& contact: stream) {
+            tableSum += contact::MatchBeginRule(contact.shapes[0], contact.bodies[0], contact.shapes[1], contact.bodies[1]);
+        }
+    }) };
+    const auto chainTiming { Measure(REPLAYS, [&stream, &chainSum]() {
+        for (const auto& contact: stream) {
+            chainSum += ::LegacyMatchBeginRule(contact);
+        }
+    }) };
+
+    // ms per replay to ns per contact
+    const auto scale { 1e6 / stream.size() };
+    std::printf("%zu contacts in %zu frames; sensor %zu, platform %zu, trap %zu, units %zu, projectiles %zu, projectile %zu, proceed %zu\n"
+        , stream.size(), options.contacts, rules[0], rules[1], rules[2], rules[3], rules[4], rules[5], rules[6]);
+    PrintTimingHeader("dispatch", "ns/contact");
+    PrintTiming("table", tableTiming, scale);
+    PrintTiming("chain", chainTiming, scale);
+    if (mismatches > 0U || tableSum != chainSum) {
+        std::fprintf(stderr, "The table and the chain disagree on %zu contacts\n", mismatches);
+        return false;
+    }
+    return true;
+}
+
+} // namespace headless
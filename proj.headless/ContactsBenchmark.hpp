@@ -0,0 +1,18 @@
+#ifndef HEADLESS_CONTACTS_BENCHMARK_HPP
+#define HEADLESS_CONTACTS_BENCHMARK_HPP
+
+#include "Options.hpp"
+
+namespace headless {
+
+/**
+ * Simulate the level with the default input while recording the masks of the contacts which begin,
+ * then replay the stream through the dispatch table and the former chain.
+ * The recorder runs before the level's listener, so the simulation isn't affected.
+ * @return false if nothing is recorded or the two disagree on any contact
+ */
+bool BenchmarkContacts(const Options& options);
+
+} // namespace headless
+
+#endif // HEADLESS_CONTACTS_BENCHMARK_HPP
@@ -0,0 +1,95 @@
+#include "CurseAllocations.hpp"
+
+#include "scenes/LevelScene.hpp"
+#include "EntityRegistry.hpp"
+#include "components/CurseHub.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+// heap allocations of the process, counted by the replaced `operator new` below
+std::atomic<size_t> allocations { 0U };
+
+} // namespace {
+
+void* operator new(std::size_t size) {
+    allocations.fetch_add(1U, std::memory_order_relaxed);
+    if (size == 0U) {
+        size = 1U;
+    }
+    for (;;) {
+        if (const auto memory { std::malloc(size) }) {
+            return memory;
+        }
+        const auto handler { std::get_new_handler() };
+        if (!handler) {
+            throw std::bad_alloc{};
+        }
+        handler();
+    }
+}
+
+void* operator new[](std::size_t size) {
+    return ::operator new(size);
+}
+
+void operator delete(void * memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void * memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void * memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void * memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+namespace headless {
+
+bool CountCurseAllocations(LevelScene * level, const Options& options) {
+    // capacity of the hub
+    static constexpr size_t CURSES { 16U };
+    // the DPS curses expire too, so both kinds are added all the time
+    static constexpr float DPS_DURATION { 1.f };
+
+    const auto player { level->GetRegistry()->GetPlayer() };
+    if (!player) {
+        std::fprintf(stderr, "Failed to count curse allocations: no player\n");
+        return false;
+    }
+    curses::CurseHub hub { player };
+    size_t added { 0U };
+    const auto before { allocations.load() };
+    for (size_t frame = 0; frame < options.curses; frame++) {
+        while (hub.GetSize() < CURSES) {
+            if (added % 2U == 0U) {
+                hub.AddCurse<curses::CurseClass::INSTANT>(curses::CurseHub::ignored, 0.f);
+            }
+            else {
+                hub.AddCurse<curses::CurseClass::DPS>(added, 0.f, DPS_DURATION);
+            }
+            added++;
+        }
+        hub.Update(options.dt);
+    }
+    const auto heapAllocations { allocations.load() - before };
+    std::printf("%zu curses added, %zu updates of %zu curses, heap allocations: %zu\n"
+        , added, options.curses, CURSES, heapAllocations);
+    if (heapAllocations > 0U) {
+        std::fprintf(stderr, "Curses allocated on the heap\n");
+        return false;
+    }
+    return true;
+}
+
+} // namespace headless
@@ -0,0 +1,20 @@
+#ifndef HEADLESS_CURSE_ALLOCATIONS_HPP
+#define HEADLESS_CURSE_ALLOCATIONS_HPP
+
+#include "Options.hpp"
+
+class LevelScene;
+
+namespace headless {
+
+/**
+ * Keep the player's curse hub full for the requested number of updates:
+ * the expired curses are replaced by the new ones, as spikes and hits do.
+ * The curses deal no damage, so the player is left as is.
+ * @return false if adding or updating the curses allocated on the heap
+ */
+bool CountCurseAllocations(LevelScene * level, const Options& options);
+
+} // namespace headless
+
+#endif // HEADLESS_CURSE_ALLOCATIONS_HPP
@@ -0,0 +1,77 @@
+#include "Fixtures.hpp"
+
+#include "scenes/LevelScene.hpp"
+#include "units/Archer.hpp"
+#include "EntityRegistry.hpp"
+#include "Core.hpp"
+#include "configs/JsonUnits.hpp"
+#include "dragonBones/cocos2dx/CCDragonBonesHeaders.h"
+#include "cocos2d.h"
+
+#include <cstdio>
+#include <memory>
+
+namespace headless {
+
+const json_models::Units* GetUnits() {
+    static const auto units { []() {
+        auto units { std::make_unique<json_models::Units>() };
+        const auto json { cocos2d::FileUtils::getInstance()->getStringFromFile("configuration/units.json") };
+        rapidjson::Document doc;
+        doc.Parse(json.c_str());
+        if (doc.HasParseError() || !doc.HasMember("units")) {
+            return std::unique_ptr<json_models::Units>{};
+        }
+        json_models::FromJson(doc["units"], *units);
+        return units;
+    }() };
+    return units.get();
+}
+
+std::vector<Enemies::Archer*> SpawnArchers(LevelScene * level, size_t count) {
+    const auto units { GetUnits() };
+    std::vector<Enemies::Archer*> bots;
+    const auto map { level->getChildByName("Map") };
+    const auto player { level->GetRegistry()->GetPlayer() };
+    if (!units || !map || !player) {
+        std::fprintf(stderr, "Failed to spawn archers: no units' models, map or player\n");
+        return bots;
+    }
+    // ids of the map's objects are small, so the spawned ones don't clash with them
+    static constexpr size_t FIRST_ID { 1000000U };
+    // same as the level's enemies
+    static constexpr int Z_ORDER { 10 };
+    const auto contentSize { player->getContentSize() };
+    const cocos2d::Rect influence { cocos2d::Vec2::ZERO, map->getContentSize() };
+    bots.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        const auto archer { Enemies::Archer::create(FIRST_ID + i, contentSize, &units->archer) };
+        archer->setName(core::EntityNames::ARCHER);
+        const auto shift { (static_cast<float>(i) - count / 2.f) * contentSize.width };
+        archer->setPosition(player->getPosition() + cocos2d::Vec2{ shift, 0.f });
+        map->addChild(archer, Z_ORDER);
+        archer->AttachInfluenceArea(influence);
+        bots.push_back(archer);
+    }
+    return bots;
+}
+
+dragonBones::Armature* BuildArmature(const std::string& path) {
+    const auto factory { dragonBones::CCFactory::getFactory() };
+    const auto data { factory->loadDragonBonesData(path) };
+    if (!data || data->armatureNames.empty()) {
+        std::fprintf(stderr, "Failed to load %s\n", path.c_str());
+        return nullptr;
+    }
+    const auto texturePath { path.substr(0, path.rfind("_ske")) + "_tex.json" };
+    if (cocos2d::FileUtils::getInstance()->isFileExist(texturePath)) {
+        factory->loadTextureAtlasData(texturePath);
+    }
+    const auto armature { factory->buildArmature(data->armatureNames.front(), data->name) };
+    if (!armature) {
+        std::fprintf(stderr, "Failed to build the armature of %s\n", path.c_str());
+    }
+    return armature;
+}
+
+} // namespace headless
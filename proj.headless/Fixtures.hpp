@@ -0,0 +1,44 @@
+#ifndef HEADLESS_FIXTURES_HPP
+#define HEADLESS_FIXTURES_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace json_autogenerated_classes {
+    struct Units;
+} // namespace json_autogenerated_classes
+namespace json_models = json_autogenerated_classes;
+
+namespace Enemies {
+    class Archer;
+}
+namespace dragonBones {
+    class Armature;
+}
+class LevelScene;
+
+namespace headless {
+
+/**
+ * Models of the units from `configuration/units.json`, loaded once:
+ * the units keep the pointer to their model.
+ * @return nullptr if the configuration can't be loaded
+ */
+const json_models::Units* GetUnits();
+
+/**
+ * Spawn the archers along the player's row of the loaded level.
+ * Their influence covers the whole map, so they are never put to sleep and keep attacking the player.
+ */
+std::vector<Enemies::Archer*> SpawnArchers(LevelScene * level, size_t count);
+
+/**
+ * Load the DragonBones data with its atlas, if any, and build the first armature.
+ * @return nullptr if the data or the armature can't be loaded
+ */
+dragonBones::Armature* BuildArmature(const std::string& path);
+
+} // namespace headless
+
+#endif // HEADLESS_FIXTURES_HPP
@@ -0,0 +1,88 @@
+#include "FrameCacheBenchmark.hpp"
+#include "Fixtures.hpp"
+#include "Timing.hpp"
+
+#include "components/ArmaturePool.hpp"
+#include "components/DragonBonesAnimator.hpp"
+#include "AssetPaths.hpp"
+#include "configs/JsonUnits.hpp"
+#include "dragonBones/cocos2dx/CCDragonBonesHeaders.h"
+#include "cocos2d.h"
+
+#include <array>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace headless {
+
+bool BenchmarkFrameCache(const Options& options) {
+    static constexpr size_t FRAMES { 600U };
+    // frames played before the measurement: the cached pass bakes its frames here
+    static constexpr size_t WARM_UP { 120U };
+    // for the units which don't cache their frames in the game
+    static constexpr unsigned DEFAULT_FRAME_RATE { 24U };
+
+    const auto units { GetUnits() };
+    if (!units) {
+        std::fprintf(stderr, "Failed to load configuration/units.json\n");
+        return false;
+    }
+    struct Kind final {
+        const std::string& name;
+        int frameRate;
+    };
+    const std::array<Kind, 3U> kinds {
+        Kind { units->axWarrior.dragonbones, units->axWarrior.frameCache },
+        Kind { units->slime.dragonbones, units->slime.frameCache },
+        Kind { units->wasp.dragonbones, units->wasp.frameCache }
+    };
+
+    const auto factory { dragonBones::CCFactory::getFactory() };
+    const auto armatures { dragonBones::CCFactory::getInstance() };
+    const auto parent { cocos2d::Node::create() };
+    parent->retain();
+    std::vector<dragonBones::Animator*> animators;
+    animators.reserve(options.frameCache);
+    for (size_t i = 0; i < options.frameCache; i++) {
+        const auto& kind { kinds[i % kinds.size()] };
+        auto [prefix, name] = assets::GetUnitSkeleton(kind.name);
+        const auto animator { dragonBones::Animator::create(std::move(prefix), std::move(name)) };
+        const auto data { factory->getArmatureData(ArmaturePool::ARMATURE_NAME, kind.name) };
+        if (!animator || !data || data->animationNames.empty()) {
+            std::fprintf(stderr, "Failed to build the armature of %s\n", kind.name.c_str());
+            parent->release();
+            return false;
+        }
+        animator->AddAnimation({ 0U, data->animationNames.front() });
+        animator->Play(0U, dragonBones::Animator::INFINITY_LOOP);
+        parent->addChild(animator);
+        animators.push_back(animator);
+    }
+
+    const auto Play = [armatures, &options]() {
+        for (size_t frame = 0; frame < WARM_UP; frame++) {
+            armatures->advanceTime(options.dt);
+        }
+        return Measure(FRAMES, [armatures, &options]() {
+            armatures->advanceTime(options.dt);
+        });
+    };
+    const auto uncachedTiming { Play() };
+    for (size_t i = 0; i < animators.size(); i++) {
+        const auto frameRate { kinds[i % kinds.size()].frameRate };
+        animators[i]->EnableFrameCache(frameRate > 0? static_cast<unsigned>(frameRate): DEFAULT_FRAME_RATE);
+    }
+    const auto cachedTiming { Play() };
+    parent->release();
+
+    std::printf("%zu animators (%s, %s, %s), %zu frames\n"
+        , animators.size(), kinds[0].name.c_str(), kinds[1].name.c_str(), kinds[2].name.c_str(), FRAMES);
+    PrintTimingHeader("cache", "us/frame");
+    PrintTiming("off", uncachedTiming, 1000.0);
+    PrintTiming("on", cachedTiming, 1000.0);
+    return true;
+}
+
+} // namespace headless
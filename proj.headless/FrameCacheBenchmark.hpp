@@ -0,0 +1,17 @@
+#ifndef HEADLESS_FRAME_CACHE_BENCHMARK_HPP
+#define HEADLESS_FRAME_CACHE_BENCHMARK_HPP
+
+#include "Options.hpp"
+
+namespace headless {
+
+/**
+ * Play the looping animation of the regular enemies (warriors, slimes and wasps in turn)
+ * without the frame cache, then enable the cache with the units' rates and play again.
+ * The baked frames are kept by the shared armature data, so the uncached pass goes first.
+ */
+bool BenchmarkFrameCache(const Options& options);
+
+} // namespace headless
+
+#endif // HEADLESS_FRAME_CACHE_BENCHMARK_HPP
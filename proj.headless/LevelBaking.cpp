@@ -0,0 +1,37 @@
+#include "LevelBaking.hpp"
+
+#include "TileMapParser.hpp"
+#include "Core.hpp"
+#include "cocos2d.h"
+
+#include <cstdio>
+
+namespace headless {
+
+bool Bake(const Options& options) {
+    const auto tmxFile { cocos2d::StringUtils::format("Map/level_%d.tmx", options.level) };
+    const auto tileMap { cocos2d::FastTMXTiledMap::create(tmxFile) };
+    if (!tileMap) {
+        std::fprintf(stderr, "Failed to load %s\n", tmxFile.c_str());
+        return false;
+    }
+    TileMapParser parser { tileMap, tmxFile };
+    parser.Parse();
+    if (!parser.Bake(options.bake)) {
+        std::fprintf(stderr, "Failed to write %s\n", options.bake.c_str());
+        return false;
+    }
+    std::printf("%s -> %s\n", tmxFile.c_str(), options.bake.c_str());
+    const auto& stats { parser.GetMergeStats() };
+    std::printf("static bodies: %zu tiles, %zu row runs -> %zu rectangles (platforms %zu, spikes %zu, solid %zu)\n"
+        , stats.tiles
+        , stats.rows
+        , stats.rectangles
+        , parser.Peek(core::CategoryName::PLATFORM).size()
+        , parser.Peek(core::CategoryName::SPIKES).size()
+        , parser.Peek(core::CategoryName::UNDEFINED).size()
+    );
+    return true;
+}
+
+} // namespace headless
@@ -0,0 +1,16 @@
+#ifndef HEADLESS_LEVEL_BAKING_HPP
+#define HEADLESS_LEVEL_BAKING_HPP
+
+#include "Options.hpp"
+
+namespace headless {
+
+/**
+ * Parse the TMX file of the level and write the result as a blob
+ * which is loaded by the LevelScene instead of parsing.
+ */
+bool Bake(const Options& options);
+
+} // namespace headless
+
+#endif // HEADLESS_LEVEL_BAKING_HPP
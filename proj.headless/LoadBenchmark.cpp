@@ -0,0 +1,134 @@
+#include "LoadBenchmark.hpp"
+#include "Timing.hpp"
+
+#include "TileMapHelper.hpp"
+#include "cocos2d.h"
+
+#include <array>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    /**
+     * Write the map of `size`x`size` tiles to the writable path: the collision layer
+     * is filled randomly with the tiles of every category and empty cells.
+     * @return path to the TMX file or an empty string on failure
+     */
+    std::string WriteSyntheticMap(size_t size) {
+        static constexpr int TILE_SIZE { 32 };
+        static constexpr std::array<const char*, 4U> CATEGORIES { "border", "solid", "spikes", "platform" };
+
+        const auto directory { cocos2d::FileUtils::getInstance()->getWritablePath() };
+        // the tileset's image is required by the layer's texture
+        const int imageWidth { TILE_SIZE * static_cast<int>(CATEGORIES.size()) };
+        std::vector<unsigned char> pixels(static_cast<size_t>(imageWidth * TILE_SIZE) * 4U, 0xFF);
+        cocos2d::Image image;
+        if (!image.initWithRawData(pixels.data(), static_cast<ssize_t>(pixels.size()), imageWidth, TILE_SIZE, 8)
+            || !image.saveToFile(directory + "synthetic_tiles.png", false))
+        {
+            return {};
+        }
+
+        std::ostringstream tmx;
+        tmx << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+            << "<map version=\"1.2\" orientation=\"orthogonal\" renderorder=\"right-down\" width=\"" << size
+            << "\" height=\"" << size << "\" tilewidth=\"" << TILE_SIZE << "\" tileheight=\"" << TILE_SIZE << "\">\n"
+            << " <tileset firstgid=\"1\" name=\"synthetic\" tilewidth=\"" << TILE_SIZE << "\" tileheight=\"" << TILE_SIZE
+            << "\" tilecount=\"" << CATEGORIES.size() << "\" columns=\"" << CATEGORIES.size() << "\">\n"
+            << "  <image source=\"synthetic_tiles.png\" width=\"" << imageWidth << "\" height=\"" << TILE_SIZE << "\"/>\n";
+        for (size_t id = 0U; id < CATEGORIES.size(); id++) {
+            tmx << "  <tile id=\"" << id << "\"><properties><property name=\"category-name\" value=\""
+                << CATEGORIES[id] << "\"/></properties></tile>\n";
+        }
+        tmx << " </tileset>\n"
+            << " <layer name=\"" << TileMap::COLLISION_LAYER_NAME << "\" width=\"" << size << "\" height=\"" << size << "\">\n"
+            << "  <data encoding=\"csv\">\n";
+        // fixed seed: the same map for each run; half of the cells are empty
+        std::mt19937 random { 42U };
+        std::uniform_int_distribution<size_t> gids { 0U, 2U * CATEGORIES.size() - 1U };
+        for (size_t i = 0U; i < size * size; i++) {
+            const auto gid { gids(random) };
+            tmx << (gid < CATEGORIES.size()? gid + 1U: 0U) << (i + 1U < size * size? ",": "\n");
+        }
+        tmx << "  </data>\n </layer>\n</map>\n";
+
+        const auto path { directory + "synthetic.tmx" };
+        std::ofstream file { path, std::ios::trunc };
+        file << tmx.str();
+        return file? path: std::string{};
+    }
+
+} // namespace {
+
+namespace headless {
+
+bool BenchmarkLoad(const Options& options) {
+    static constexpr size_t REPEATS { 5U };
+
+    const auto path { ::WriteSyntheticMap(options.load) };
+    const auto tileMap { path.empty()? nullptr: cocos2d::FastTMXTiledMap::create(path) };
+    if (!tileMap || !tileMap->getLayer(TileMap::COLLISION_LAYER_NAME)) {
+        std::fprintf(stderr, "Failed to create the synthetic map\n");
+        return false;
+    }
+
+    std::unique_ptr<TileMap::Cache> cache;
+    const auto cacheTiming { Measure(REPEATS, [&cache, tileMap]() {
+        cache = std::make_unique<TileMap::Cache>(tileMap);
+    }) };
+
+    const auto layer { tileMap->getLayer(TileMap::COLLISION_LAYER_NAME) };
+    const auto FindProperties = [tileMap, layer](const cocos2d::Vec2& pos) {
+        using TileMap::Mask;
+        using TileMap::Property;
+        const auto tileGid = layer->getTileGIDAt(pos);
+        if (!tileGid) {
+            return static_cast<Mask>(Property::EMPTY);
+        }
+        const auto tileProp { tileMap->getPropertiesForGID(tileGid) };
+        const auto& properties { tileProp.asValueMap() };
+        const auto categoryNameIter { properties.find("category-name") };
+        const auto name = categoryNameIter->second.asString();
+        if (name == "border") return static_cast<Mask>(Property::BORDER);
+        if (name == "solid") return static_cast<Mask>(Property::SOLID);
+        if (name == "spikes") return static_cast<Mask>(Property::SPIKE);
+        if (name == "platform") return static_cast<Mask>(Property::PLATFORM);
+        return static_cast<Mask>(Property::UNDEFINED);
+    };
+    std::vector<std::vector<TileMap::Mask>> masks;
+    const auto perTileTiming { Measure(REPEATS, [&masks, &cache, &FindProperties]() {
+        masks.assign(cache->mapHeight, std::vector<TileMap::Mask>(cache->mapWidth, 0U));
+        for (size_t row = 0; row < cache->mapHeight; ++row) {
+            for (size_t col = 0; col < cache->mapWidth; ++col) {
+                masks[row][col] = FindProperties({ static_cast<float>(col), static_cast<float>(row) });
+            }
+        }
+    }) };
+
+    size_t mismatches { 0U };
+    for (size_t row = 0; row < cache->mapHeight; ++row) {
+        for (size_t col = 0; col < cache->mapWidth; ++col) {
+            mismatches += masks[row][col] != cache->GetProperties(static_cast<int>(row), static_cast<int>(col))? 1U: 0U;
+        }
+    }
+
+    std::printf("synthetic map %zux%zu, %u hardware threads\n"
+        , cache->mapWidth, cache->mapHeight, std::thread::hardware_concurrency());
+    PrintTimingHeader("masks", "ms");
+    PrintTiming("cache", cacheTiming);
+    PrintTiming("per-tile", perTileTiming);
+    if (mismatches > 0U) {
+        std::fprintf(stderr, "The cache differs from the per-tile lookup in %zu tiles\n", mismatches);
+        return false;
+    }
+    return true;
+}
+
+} // namespace headless
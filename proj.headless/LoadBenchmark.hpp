@@ -0,0 +1,17 @@
+#ifndef HEADLESS_LOAD_BENCHMARK_HPP
+#define HEADLESS_LOAD_BENCHMARK_HPP
+
+#include "Options.hpp"
+
+namespace headless {
+
+/**
+ * Build the collision masks of the synthetic map by the cache (GID lookup table, bands of rows)
+ * and by the former per-tile lookup: the GID of the tile, the copy of its properties
+ * and the comparison of the category's name. Report the time of both and check they match.
+ */
+bool BenchmarkLoad(const Options& options);
+
+} // namespace headless
+
+#endif // HEADLESS_LOAD_BENCHMARK_HPP
@@ -0,0 +1,42 @@
+#ifndef HEADLESS_OPTIONS_HPP
+#define HEADLESS_OPTIONS_HPP
+
+#include "Settings.hpp"
+#include "FlightRecorder.hpp"
+
+#include <cstddef>
+#include <string>
+
+namespace headless {
+
+/**
+ * Command line options of the runner, see the list in main.cpp.
+ * The modes which don't simulate are chosen by their non-default options.
+ */
+struct Options final {
+    int level { 4 };
+    size_t frames { 3600U };
+    float dt { 1.f / 60.f };
+    float tickRate { settings::Simulation::DEFAULT_TICK_RATE };
+    std::string input;
+    std::string report;
+    std::string bake;
+    std::string skeleton;
+    std::string skinning;
+    std::string bones;
+    std::string borders;
+    size_t paths { 0U };
+    size_t load { 0U };
+    size_t frameCache { 0U };
+    size_t restarts { 0U };
+    size_t targets { 0U };
+    size_t weapons { 0U };
+    size_t curses { 0U };
+    size_t contacts { 0U };
+    double budget { 0.0 };
+    float spike { bench::FlightRecorder::DEFAULT_BUDGET };
+};
+
+} // namespace headless
+
+#endif // HEADLESS_OPTIONS_HPP
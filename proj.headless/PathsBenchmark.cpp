@@ -0,0 +1,95 @@
+#include "PathsBenchmark.hpp"
+#include "Timing.hpp"
+
+#include "scenes/LevelScene.hpp"
+#include "TileMapParser.hpp"
+#include "NavigationGraph.hpp"
+#include "cocos2d.h"
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <optional>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace headless {
+
+bool QueryPaths(const Options& options) {
+    static constexpr size_t REPEATS { 5U };
+
+    const auto tmxFile { cocos2d::StringUtils::format("Map/level_%d.tmx", options.level) };
+    const auto tileMap { cocos2d::FastTMXTiledMap::create(tmxFile) };
+    if (!tileMap) {
+        std::fprintf(stderr, "Failed to load %s\n", tmxFile.c_str());
+        return false;
+    }
+    TileMapParser parser { tileMap, tmxFile };
+    if (!parser.Load()) {
+        parser.Parse();
+    }
+    std::optional<NavigationGraph> graph;
+    const auto build { Measure(1U, [&]() {
+        graph.emplace(parser.GetTileMapCache(), LevelScene::JUMP_HEIGHT);
+    }) };
+    if (graph->GetNodeCount() == 0U) {
+        std::fprintf(stderr, "No walkable surfaces in %s\n", tmxFile.c_str());
+        return false;
+    }
+
+    // fixed seed: the same queries for each run
+    std::mt19937 random { 42U };
+    std::uniform_int_distribution<uint32_t> nodes { 0U, static_cast<uint32_t>(graph->GetNodeCount() - 1U) };
+    std::vector<std::pair<uint32_t, uint32_t>> queries(options.paths);
+    for (auto& [from, to]: queries) {
+        from = nodes(random);
+        to = nodes(random);
+    }
+
+    // reachable pairs of the last run
+    std::array<size_t, 2U> reachable {};
+    const std::array<Timing, 2U> timings {
+        Measure(REPEATS, [&]() {
+            reachable[0] = 0U;
+            for (const auto& [from, to]: queries) {
+                reachable[0] += graph->IsReachable(from, to)? 1U: 0U;
+            }
+        }),
+        Measure(REPEATS, [&]() {
+            reachable[1] = 0U;
+            for (const auto& [from, to]: queries) {
+                auto node { from };
+                // a route never visits a node twice
+                for (size_t steps = 0U; node != to && steps < graph->GetNodeCount(); steps++) {
+                    const auto link { graph->FindNextLink(node, to) };
+                    if (!link) break;
+                    node = link->to;
+                }
+                reachable[1] += node == to? 1U: 0U;
+            }
+        })
+    };
+
+    std::printf("%s: %zu surfaces, %zu links, route table %zu KiB, built in %.3f ms\n"
+        , tmxFile.c_str()
+        , graph->GetNodeCount()
+        , graph->GetLinkCount()
+        , graph->GetRouteTableBytes() / 1024U
+        , build.average);
+    std::printf("%zu queries, %zu runs, reachable: %zu by the next link, %zu by the route\n"
+        , queries.size(), REPEATS, reachable[0], reachable[1]);
+    PrintTimingHeader("pass", "us/query");
+    const std::array<const char*, 2U> names { "next", "route" };
+    for (size_t pass = 0U; pass < names.size(); pass++) {
+        PrintTiming(names[pass], timings[pass], queries.empty()? 0.0: 1000.0 / queries.size());
+    }
+    const auto throughput = [&queries](const Timing& timing) {
+        return timing.average > 0.0? queries.size() / timing.average: 0.0;
+    };
+    std::printf("queries/ms: %.1f by the next link, %.1f by the route\n"
+        , throughput(timings[0]), throughput(timings[1]));
+    return true;
+}
+
+} // namespace headless
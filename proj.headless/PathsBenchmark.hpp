@@ -0,0 +1,17 @@
+#ifndef HEADLESS_PATHS_BENCHMARK_HPP
+#define HEADLESS_PATHS_BENCHMARK_HPP
+
+#include "Options.hpp"
+
+namespace headless {
+
+/**
+ * Query routes between random surfaces of the level twice:
+ * the first link only, as the navigators do, and the whole route link by link.
+ * Each run answers all queries.
+ */
+bool QueryPaths(const Options& options);
+
+} // namespace headless
+
+#endif // HEADLESS_PATHS_BENCHMARK_HPP
@@ -0,0 +1,103 @@
+#include "RestartsBenchmark.hpp"
+#include "Fixtures.hpp"
+#include "Timing.hpp"
+
+#include "scenes/LevelScene.hpp"
+#include "TileMapParser.hpp"
+#include "AssetPreloader.hpp"
+#include "components/ArmaturePool.hpp"
+#include "components/DragonBonesAnimator.hpp"
+#include "configs/JsonUnits.hpp"
+#include "dragonBones/cocos2dx/CCDragonBonesHeaders.h"
+#include "cocos2d.h"
+
+#include <array>
+#include <cstdio>
+#include <utility>
+
+namespace headless {
+
+bool BenchmarkRestarts(LevelScene * level, const Options& options) {
+    static constexpr size_t SPAWNS { 20U };
+
+    const auto tmxFile { cocos2d::StringUtils::format("Map/level_%d.tmx", options.level) };
+    const auto tileMap { cocos2d::FastTMXTiledMap::create(tmxFile) };
+    if (!tileMap) {
+        std::fprintf(stderr, "Failed to load %s\n", tmxFile.c_str());
+        return false;
+    }
+    TileMapParser parser { tileMap, tmxFile };
+    if (!parser.Load()) {
+        parser.Parse();
+    }
+    const auto units { GetUnits() };
+    if (!units) {
+        std::fprintf(stderr, "Failed to load configuration/units.json\n");
+        return false;
+    }
+    const auto manifest { AssetPreloader::Collect(parser, *units) };
+    const auto& skeletons { manifest.skeletons };
+
+    auto& pool { ArmaturePool::GetInstance() };
+    const auto armatures { dragonBones::CCFactory::getInstance() };
+    // destroy the removed nodes and return the disposed armatures to the DragonBones' pools
+    const auto flush = [armatures]() {
+        cocos2d::PoolManager::getInstance()->getCurrentPool()->clear();
+        armatures->advanceTime(0.f);
+    };
+
+    cocos2d::Vector<dragonBones::Animator*> animators;
+    // one animator per call, the skeletons in turn: `spawnRuns` calls spawn `SPAWNS` of each
+    size_t next { 0U };
+    const auto Spawn = [&skeletons, &animators, &next]() {
+        const auto& skeleton { skeletons[next++ % skeletons.size()] };
+        auto prefix { skeleton.prefix };
+        auto name { skeleton.name };
+        if (const auto animator { dragonBones::Animator::create(std::move(prefix), std::move(name)) }) {
+            animators.pushBack(animator);
+        }
+    };
+    const auto spawnRuns { SPAWNS * skeletons.size() };
+
+    std::array<size_t, 2U> spawns {};
+    std::array<Timing, 2U> spawnTimings {};
+    std::array<Timing, 2U> restartTimings {};
+    for (const bool isPooled: { false, true }) {
+        pool.SetEnabled(isPooled);
+        pool.Prewarm(manifest);
+        // the units of the level are released to the pool by the first restart
+        level->Restart();
+        flush();
+
+        // the first batch fills the pool, the second one is measured
+        for (size_t i = 0; i < spawnRuns; i++) {
+            Spawn();
+        }
+        animators.clear();
+        flush();
+        next = 0U;
+        spawnTimings[isPooled] = Measure(spawnRuns, Spawn);
+        spawns[isPooled] = animators.size();
+        animators.clear();
+        flush();
+
+        // the disposed armatures are cleared by the next frame, so it's measured too
+        restartTimings[isPooled] = Measure(options.restarts, [level, &flush]() {
+            level->Restart();
+            flush();
+        });
+    }
+
+    std::printf("%s: %zu skeletons, %zu animators spawned without the pool, %zu with it\n"
+        , tmxFile.c_str(), skeletons.size(), spawns[false], spawns[true]);
+    PrintTimingHeader("spawn", "us");
+    PrintTiming("pool off", spawnTimings[false], 1000.0);
+    PrintTiming("pool on", spawnTimings[true], 1000.0);
+    PrintTimingHeader("restart", "ms");
+    PrintTiming("pool off", restartTimings[false]);
+    PrintTiming("pool on", restartTimings[true]);
+    std::printf("pool hits: %zu, misses: %zu, free: %zu\n", pool.GetHits(), pool.GetMisses(), pool.GetFree());
+    return true;
+}
+
+} // namespace headless
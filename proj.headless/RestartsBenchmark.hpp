@@ -0,0 +1,18 @@
+#ifndef HEADLESS_RESTARTS_BENCHMARK_HPP
+#define HEADLESS_RESTARTS_BENCHMARK_HPP
+
+#include "Options.hpp"
+
+class LevelScene;
+
+namespace headless {
+
+/**
+ * Spawn the animators of the level's units and props, then restart the level,
+ * with the armature pool and without it: report the spawn latency and the restart time of both.
+ */
+bool BenchmarkRestarts(LevelScene * level, const Options& options);
+
+} // namespace headless
+
+#endif // HEADLESS_RESTARTS_BENCHMARK_HPP
@@ -0,0 +1,64 @@
+#include "Script.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+
+namespace {
+
+    using KeyCode = cocos2d::EventKeyboard::KeyCode;
+
+} // namespace {
+
+namespace headless {
+
+std::vector<ScriptedKey> LoadScript(const std::string& path) {
+    static const std::unordered_map<std::string, KeyCode> actions {
+        { "left",       KeyCode::KEY_A },
+        { "right",      KeyCode::KEY_D },
+        { "jump",       KeyCode::KEY_SPACE },
+        { "melee",      KeyCode::KEY_F },
+        { "range",      KeyCode::KEY_G },
+        { "special",    KeyCode::KEY_E },
+        { "dash",       KeyCode::KEY_Q }
+    };
+
+    std::vector<ScriptedKey> script;
+    std::ifstream file { path };
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line.front() == '#') continue;
+
+        std::istringstream stream { line };
+        ScriptedKey key;
+        std::string state, action;
+        if (!(stream >> key.frame >> state >> action)) continue;
+
+        if (auto it = actions.find(action); it != actions.cend()) {
+            key.code = it->second;
+            key.pressed = (state == "press");
+            script.push_back(key);
+        }
+    }
+    std::stable_sort(script.begin(), script.end(), [](const ScriptedKey& lhs, const ScriptedKey& rhs) {
+        return lhs.frame < rhs.frame;
+    });
+    return script;
+}
+
+std::vector<ScriptedKey> DefaultScript(size_t frames) {
+    std::vector<ScriptedKey> script;
+    script.push_back({ 0U, KeyCode::KEY_D, true });
+    for (size_t frame = 30U; frame < frames; frame += 90U) {
+        script.push_back({ frame, KeyCode::KEY_SPACE, true });
+        script.push_back({ frame + 5U, KeyCode::KEY_SPACE, false });
+        script.push_back({ frame + 45U, KeyCode::KEY_F, true });
+        script.push_back({ frame + 50U, KeyCode::KEY_F, false });
+        script.push_back({ frame + 60U, KeyCode::KEY_G, true });
+        script.push_back({ frame + 65U, KeyCode::KEY_G, false });
+    }
+    return script;
+}
+
+} // namespace headless
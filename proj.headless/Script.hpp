@@ -0,0 +1,35 @@
+#ifndef HEADLESS_SCRIPT_HPP
+#define HEADLESS_SCRIPT_HPP
+
+#include "cocos2d.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace headless {
+
+/**
+ * Key event dispatched before the frame is simulated
+ */
+struct ScriptedKey final {
+    size_t frame { 0U };
+    cocos2d::EventKeyboard::KeyCode code { cocos2d::EventKeyboard::KeyCode::KEY_NONE };
+    bool pressed { false };
+};
+
+/**
+ * Each line of the script is `<frame> <press|release> <action>`,
+ * where action is one of: left, right, jump, melee, range, special, dash.
+ * Lines starting with `#` are ignored.
+ */
+std::vector<ScriptedKey> LoadScript(const std::string& path);
+
+/**
+ * Default scenario: run to the right, jump over obstacles and attack periodically.
+ */
+std::vector<ScriptedKey> DefaultScript(size_t frames);
+
+} // namespace headless
+
+#endif // HEADLESS_SCRIPT_HPP
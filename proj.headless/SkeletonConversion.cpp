@@ -0,0 +1,60 @@
+#include "SkeletonConversion.hpp"
+
+#include "SkeletonConverter.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace headless {
+
+bool ConvertSkeleton(const Options& options) {
+    static constexpr size_t PARSE_RUNS { 50U };
+    const std::string jsonSuffix { SkeletonConverter::JSON_SUFFIX };
+    const auto& path { options.skeleton };
+    if (path.size() <= jsonSuffix.size()
+        || path.compare(path.size() - jsonSuffix.size(), jsonSuffix.size(), jsonSuffix) != 0)
+    {
+        std::fprintf(stderr, "Not a skeleton: %s\n", path.c_str());
+        return false;
+    }
+    std::ifstream file { path, std::ios::binary };
+    if (!file) {
+        std::fprintf(stderr, "Failed to open %s\n", path.c_str());
+        return false;
+    }
+    std::stringstream json;
+    json << file.rdbuf();
+
+    SkeletonConverter converter { json.str() };
+    if (!converter.Convert()) {
+        std::fprintf(stderr, "Failed to convert %s\n", path.c_str());
+        return false;
+    }
+    const auto binaryPath { path.substr(0, path.size() - jsonSuffix.size()) + SkeletonConverter::BINARY_SUFFIX };
+    if (!converter.Save(binaryPath)) {
+        std::fprintf(stderr, "Failed to write %s\n", binaryPath.c_str());
+        return false;
+    }
+
+    SkeletonConverter::Report report;
+    if (!converter.Measure(PARSE_RUNS, report)) {
+        std::fprintf(stderr, "Failed to parse the converted %s\n", binaryPath.c_str());
+        return false;
+    }
+    const auto saved { report.jsonParseTime > 0.0?
+        100.0 * (report.jsonParseTime - report.binaryParseTime) / report.jsonParseTime : 0.0 };
+    std::printf("%s -> %s\n", path.c_str(), binaryPath.c_str());
+    std::printf("%-16s %10s %10s %12s %12s %8s\n", "armature", "json, KB", "bin, KB", "json, ms", "bin, ms", "saved");
+    std::printf("%-16s %10.1f %10.1f %12.4f %12.4f %7.1f%%\n"
+        , report.name.c_str()
+        , report.jsonSize / 1024.0
+        , report.binarySize / 1024.0
+        , report.jsonParseTime
+        , report.binaryParseTime
+        , saved);
+    return true;
+}
+
+} // namespace headless
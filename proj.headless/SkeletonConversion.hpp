@@ -0,0 +1,16 @@
+#ifndef HEADLESS_SKELETON_CONVERSION_HPP
+#define HEADLESS_SKELETON_CONVERSION_HPP
+
+#include "Options.hpp"
+
+namespace headless {
+
+/**
+ * Convert the skeleton to the binary format loaded by the Animator
+ * and compare the parse time of the JSON and the binary data.
+ */
+bool ConvertSkeleton(const Options& options);
+
+} // namespace headless
+
+#endif // HEADLESS_SKELETON_CONVERSION_HPP
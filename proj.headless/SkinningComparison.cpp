@@ -0,0 +1,99 @@
+#include "SkinningComparison.hpp"
+#include "Fixtures.hpp"
+
+#include "dragonBones/cocos2dx/CCDragonBonesHeaders.h"
+#include "dragonBones/armature/MeshSkinning.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <iterator>
+#include <vector>
+
+namespace headless {
+
+bool CompareSkinning(const Options& options) {
+    static constexpr size_t FRAMES_PER_ANIMATION { 60U };
+    static constexpr size_t RUNS { 20U };
+    // relative; the scalar path may be contracted into FMA by the compiler
+    static constexpr float TOLERANCE { 1e-5f };
+
+    const auto& path { options.skinning };
+    const auto armature { BuildArmature(path) };
+    if (!armature) {
+        return false;
+    }
+
+    using Clock = std::chrono::steady_clock;
+    using dragonBones::MeshSkinning;
+    Clock::duration scalarTime {};
+    Clock::duration vectorTime {};
+    size_t skinnedVertices { 0U };
+    size_t meshes { 0U };
+    float maxError { 0.f };
+    std::vector<float> expected;
+    std::vector<float> actual;
+    for (const auto& animation: armature->getArmatureData()->animationNames) {
+        armature->getAnimation()->play(animation, 0);
+        for (size_t frame = 0; frame < FRAMES_PER_ANIMATION; frame++) {
+            armature->advanceTime(1.f / 60.f);
+            for (const auto slot: armature->getSlots()) {
+                const auto deform { slot->_deformVertices };
+                if (!deform || !deform->verticesData || !deform->verticesData->weight) {
+                    continue;
+                }
+                const auto& vertices { *deform->verticesData };
+                const auto scale { armature->getArmatureData()->scale };
+                const auto count { MeshSkinning::getVertexCount(vertices) };
+                expected.resize(count * 2U);
+                actual.resize(count * 2U);
+                float expectedBounds[] { FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX };
+                float actualBounds[] { FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+                auto start { Clock::now() };
+                for (size_t run = 0; run < RUNS; run++) {
+                    MeshSkinning::skinScalar(vertices, deform->bones, deform->vertices, scale, expected.data(), expectedBounds);
+                }
+                scalarTime += Clock::now() - start;
+                start = Clock::now();
+                for (size_t run = 0; run < RUNS; run++) {
+                    MeshSkinning::skin(vertices, deform->bones, deform->vertices, scale, actual.data(), actualBounds);
+                }
+                vectorTime += Clock::now() - start;
+
+                const auto error = [](float expected, float actual) {
+                    return std::abs(expected - actual) / std::max(1.f, std::abs(expected));
+                };
+                for (size_t i = 0; i < expected.size(); i++) {
+                    maxError = std::max(maxError, error(expected[i], actual[i]));
+                }
+                for (size_t i = 0; i < std::size(expectedBounds); i++) {
+                    maxError = std::max(maxError, error(expectedBounds[i], actualBounds[i]));
+                }
+                skinnedVertices += count * RUNS;
+                meshes += frame == 0U? 1U: 0U;
+            }
+        }
+    }
+    armature->dispose();
+
+    const auto throughput = [skinnedVertices](Clock::duration time) {
+        const std::chrono::duration<double, std::milli> ms { time };
+        return ms.count() > 0.0? skinnedVertices / ms.count() / 1000.0 : 0.0;
+    };
+    std::printf("%s: %zu weighted meshes over all animations, %zu vertices skinned\n"
+        , path.c_str(), meshes, skinnedVertices);
+    std::printf("%-8s %8s %16s\n", "path", "lanes", "Mvertices/s");
+    std::printf("%-8s %8d %16.2f\n", "scalar", 1, throughput(scalarTime));
+    std::printf("%-8s %8zu %16.2f\n", "vector", MeshSkinning::LANES, throughput(vectorTime));
+    std::printf("max relative error: %g\n", maxError);
+    if (maxError > TOLERANCE) {
+        std::fprintf(stderr, "The vectorized skinning differs from the scalar one: %g > %g\n", maxError, TOLERANCE);
+        return false;
+    }
+    return true;
+}
+
+} // namespace headless
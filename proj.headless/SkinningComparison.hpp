@@ -0,0 +1,16 @@
+#ifndef HEADLESS_SKINNING_COMPARISON_HPP
+#define HEADLESS_SKINNING_COMPARISON_HPP
+
+#include "Options.hpp"
+
+namespace headless {
+
+/**
+ * Skin the weighted meshes of each animation frame by the vectorized and the scalar
+ * paths, check that they agree and report the throughput of both.
+ */
+bool CompareSkinning(const Options& options);
+
+} // namespace headless
+
+#endif // HEADLESS_SKINNING_COMPARISON_HPP
@@ -0,0 +1,79 @@
+#include "TargetsBenchmark.hpp"
+#include "Fixtures.hpp"
+#include "Timing.hpp"
+
+#include "scenes/LevelScene.hpp"
+#include "units/Archer.hpp"
+#include "EntityRegistry.hpp"
+#include "Core.hpp"
+#include "cocos2d.h"
+
+#include <array>
+#include <cstdio>
+#include <vector>
+
+namespace headless {
+
+bool BenchmarkTargets(LevelScene * level, const Options& options) {
+    static constexpr size_t FRAMES { 600U };
+    // half of the zone's width, influence zones span a few screens at most
+    static constexpr float ZONE_EXTENT { 512.f };
+    const auto bots { SpawnArchers(level, options.targets) };
+    if (bots.empty()) {
+        return false;
+    }
+    const auto map { level->getChildByName("Map") };
+    const auto registry { level->GetRegistry() };
+    // the level isn't updated: take the positions of the spawned bots
+    registry->Update();
+
+    std::vector<cocos2d::Rect> zones;
+    zones.reserve(bots.size());
+    for (const auto bot: bots) {
+        zones.emplace_back(bot->getPosition() - cocos2d::Vec2{ ZONE_EXTENT, ZONE_EXTENT }
+            , cocos2d::Size{ 2.f * ZONE_EXTENT, 2.f * ZONE_EXTENT });
+    }
+    const auto IsInside = [](const cocos2d::Node * target, const cocos2d::Rect& zone) {
+        if (!target) {
+            return false;
+        }
+        const auto size { target->getContentSize() };
+        return zone.intersectsRect({ target->getPosition() - cocos2d::Vec2{ size.width / 2.f, 0.f }, size });
+    };
+
+    std::array<size_t, 3U> found {};
+    const std::array<Timing, 3U> timings {
+        Measure(FRAMES, [&]() {
+            for (size_t i = 0U; i < bots.size(); i++) {
+                const auto target { bots[i]->getParent()->getChildByName(core::EntityNames::PLAYER) };
+                found[0] += IsInside(target, zones[i])? 1U: 0U;
+            }
+        }),
+        Measure(FRAMES, [&]() {
+            for (size_t i = 0U; i < bots.size(); i++) {
+                found[1] += IsInside(bots[i]->FindPlayer(), zones[i])? 1U: 0U;
+            }
+        }),
+        Measure(FRAMES, [&]() {
+            for (size_t i = 0U; i < bots.size(); i++) {
+                found[2] += registry->FindPlayer(zones[i]) != nullptr? 1U: 0U;
+            }
+        })
+    };
+
+    std::printf("%zu bots, %zu children of the map, %zu frames, the player is inside %zu zones\n"
+        , bots.size(), map->getChildrenCount(), FRAMES, found[2] / FRAMES);
+    PrintTimingHeader("lookup", "us/frame");
+    const std::array<const char*, 3U> names { "scan", "handle", "grid" };
+    for (size_t pass = 0U; pass < names.size(); pass++) {
+        PrintTiming(names[pass], timings[pass], 1000.0);
+    }
+    // all lookups must agree on the bots seeing the player
+    if (found[0] != found[1] || found[0] != found[2]) {
+        std::fprintf(stderr, "The lookups disagree: %zu, %zu and %zu detections\n", found[0], found[1], found[2]);
+        return false;
+    }
+    return true;
+}
+
+} // namespace headless
@@ -0,0 +1,19 @@
+#ifndef HEADLESS_TARGETS_BENCHMARK_HPP
+#define HEADLESS_TARGETS_BENCHMARK_HPP
+
+#include "Options.hpp"
+
+class LevelScene;
+
+namespace headless {
+
+/**
+ * Spawn the bots and check for each of them once per frame whether the player is in the zone
+ * around the bot, as the influence does: the player found by the name among the tile map's children
+ * (as the units did before the registry), by the registry's handle and by the registry's grid.
+ */
+bool BenchmarkTargets(LevelScene * level, const Options& options);
+
+} // namespace headless
+
+#endif // HEADLESS_TARGETS_BENCHMARK_HPP
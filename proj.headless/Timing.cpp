@@ -0,0 +1,18 @@
+#include "Timing.hpp"
+
+#include <cstdio>
+#include <string>
+
+namespace headless {
+
+void PrintTimingHeader(const char * name, const char * unit) {
+    const auto column { std::string{ name } + ", " + unit };
+    std::printf("%-20s %12s %12s %12s\n", column.c_str(), "min", "avg", "max");
+}
+
+void PrintTiming(const char * name, const Timing& timing, double scale) {
+    std::printf("%-20s %12.3f %12.3f %12.3f\n"
+        , name, timing.min * scale, timing.average * scale, timing.max * scale);
+}
+
+} // namespace headless
@@ -0,0 +1,64 @@
+#ifndef HEADLESS_TIMING_HPP
+#define HEADLESS_TIMING_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <utility>
+
+namespace headless {
+
+/**
+ * Time of the measured runs, ms
+ */
+struct Timing final {
+    double min { 0.0 };
+    double average { 0.0 };
+    double max { 0.0 };
+};
+
+/**
+ * Run `body` `runs` times and time each run.
+ * `reset` is called after each run out of the measured time,
+ * e.g. to drop what the run has created.
+ */
+template<class Body, class Reset>
+Timing Measure(size_t runs, Body&& body, Reset&& reset) {
+    using Clock = std::chrono::steady_clock;
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+    Timing timing;
+    double total { 0.0 };
+    for (size_t i = 0; i < runs; i++) {
+        const auto start { Clock::now() };
+        body();
+        const Milliseconds elapsed { Clock::now() - start };
+        reset();
+        timing.min = i == 0U? elapsed.count(): std::min(timing.min, elapsed.count());
+        timing.max = std::max(timing.max, elapsed.count());
+        total += elapsed.count();
+    }
+    timing.average = runs? total / runs: 0.0;
+    return timing;
+}
+
+template<class Body>
+Timing Measure(size_t runs, Body&& body) {
+    return Measure(runs, std::forward<Body>(body), []() {});
+}
+
+/**
+ * Print the header of the timings' table.
+ * @param unit is the unit of the printed timings, e.g. "us/frame"
+ */
+void PrintTimingHeader(const char * name, const char * unit);
+
+/**
+ * Print the min, average and max time of the runs.
+ * @param scale converts the milliseconds to the table's unit,
+ *  e.g. `1000.0 / FRAMES` for us/frame when a run plays all frames
+ */
+void PrintTiming(const char * name, const Timing& timing, double scale = 1.0);
+
+} // namespace headless
+
+#endif // HEADLESS_TIMING_HPP
@@ -0,0 +1,197 @@
+#include "WeaponsBenchmark.hpp"
+#include "Fixtures.hpp"
+#include "Timing.hpp"
+
+#include "scenes/LevelScene.hpp"
+#include "units/Archer.hpp"
+#include "components/WeaponSystem.hpp"
+#include "components/ProjectilePool.hpp"
+#include "Core.hpp"
+#include "Utils.hpp"
+#include "configs/JsonUnits.hpp"
+#include "cocos2d.h"
+
+#include <array>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace {
+
+    /**
+     * Model of the weapons before the WeaponSystem: each one is allocated by its unit
+     * and ticked by a virtual call from the unit's update, the spawn area
+     * and the push of the projectile are asked from the unit through the callables.
+     */
+    class LegacyWeapon {
+    public:
+        LegacyWeapon(float damage, float preparationTime, float attackTime, float reloadTime)
+            : m_damage { damage }
+            , m_durations { 0.f, preparationTime, attackTime, reloadTime }
+        {}
+
+        virtual ~LegacyWeapon() = default;
+
+        virtual void UpdateState(const float dt) noexcept {
+            if (m_state != WeaponSystem::State::READY) {
+                m_timer -= dt;
+                if (m_timer <= 0.f) {
+                    this->NextState();
+                    if (m_state == WeaponSystem::State::ATTACK) {
+                        this->OnAttack();
+                    }
+                }
+            }
+        }
+
+        void LaunchAttack() noexcept {
+            if (m_state == WeaponSystem::State::READY) {
+                this->NextState();
+            }
+        }
+
+        void AddPositionGenerator(std::function<cocos2d::Rect()> extractor) noexcept {
+            m_extractor = std::move(extractor);
+        }
+
+        void AddVelocityGenerator(std::function<void(cocos2d::PhysicsBody*)> modifier) noexcept {
+            m_modifier = std::move(modifier);
+        }
+
+    protected:
+        virtual void OnAttack() = 0;
+
+        std::function<cocos2d::Rect()> m_extractor;
+
+        std::function<void(cocos2d::PhysicsBody*)> m_modifier;
+
+        const float m_damage { 0.f };
+
+    private:
+        void NextState() noexcept {
+            const auto next = (Utils::EnumCast(m_state) + 1) % Utils::EnumSize<WeaponSystem::State>();
+            m_state = Utils::EnumCast<WeaponSystem::State>(next);
+            m_timer = m_durations[next];
+        }
+
+        const std::array<float, Utils::EnumSize<WeaponSystem::State>()> m_durations;
+
+        WeaponSystem::State m_state { WeaponSystem::State::READY };
+
+        float m_timer { 0.f };
+    };
+
+    /**
+     * Spawns the arrow as the bow of the archer did.
+     */
+    class LegacyBow final : public LegacyWeapon {
+    public:
+        LegacyBow(cocos2d::Node * map, ProjectilePool * projectiles
+            , float damage, float preparationTime, float attackTime, float reloadTime)
+            : LegacyWeapon { damage, preparationTime, attackTime, reloadTime }
+            , m_map { map }
+            , m_projectiles { projectiles }
+        {}
+
+    private:
+        void OnAttack() override {
+            const auto area = m_extractor();
+            const auto proj = m_projectiles->Acquire(ProjectilePool::Archetype::ARROW, m_damage, area.size);
+            const auto body = proj->getPhysicsBody();
+            proj->setPosition(area.origin);
+            proj->setContentSize(area.size);
+            m_modifier(body);
+            if (body->getVelocity().x > 0.f) {
+                proj->FlipX();
+            }
+            body->setCollisionBitmask(Utils::CreateMask(core::CategoryBits::BOUNDARY));
+            proj->SetCategoryBitmask(Utils::CreateMask(core::CategoryBits::ENEMY_PROJECTILE));
+            proj->SetContactTestBitmask(Utils::CreateMask(core::CategoryBits::HITBOX_SENSOR
+                , core::CategoryBits::PROPS
+                , core::CategoryBits::BOUNDARY
+                , core::CategoryBits::PLAYER_PROJECTILE));
+            proj->SetLifetime(3.f);
+            m_map->addChild(proj, 100);
+        }
+
+        cocos2d::Node * const m_map { nullptr };
+
+        ProjectilePool * const m_projectiles { nullptr };
+    };
+
+} // namespace {
+
+namespace headless {
+
+bool BenchmarkWeapons(LevelScene * level, const Options& options) {
+    static constexpr size_t FRAMES { 600U };
+    // roughly the archer's attack animation
+    static constexpr float PREPARATION_TIME { 0.5f };
+    static constexpr float ATTACK_TIME { 0.1f };
+    // same as the units' weapons slots
+    static constexpr size_t WEAPONS_PER_UNIT { 5U };
+
+    const auto bots { SpawnArchers(level, options.weapons) };
+    if (bots.empty()) {
+        return false;
+    }
+    const auto& bow { GetUnits()->archer.weapons.bow };
+    const auto map { level->getChildByName("Map") };
+    const auto projectiles { level->GetProjectilePool() };
+
+    // not the level's system: it isn't ticked here and keeps only the bows of the benchmark
+    WeaponSystem system { map, projectiles };
+    std::vector<Weapon> weapons;
+    std::vector<std::array<std::unique_ptr<LegacyWeapon>, WEAPONS_PER_UNIT>> legacy(bots.size());
+    for (size_t i = 0; i < bots.size(); i++) {
+        const auto archer { bots[i] };
+        weapons.push_back(system.Add(archer, WeaponSystem::Kind::BOW, 0U
+            , bow.projectile.damage, bow.range, PREPARATION_TIME, ATTACK_TIME, bow.cooldown));
+
+        auto weapon { std::make_unique<LegacyBow>(map, projectiles
+            , bow.projectile.damage, PREPARATION_TIME, ATTACK_TIME, bow.cooldown) };
+        weapon->AddPositionGenerator([archer]() {
+            return archer->GetAttackArea(0U);
+        });
+        weapon->AddVelocityGenerator([archer](cocos2d::PhysicsBody * body) {
+            archer->PushProjectile(0U, body);
+        });
+        legacy[i].front() = std::move(weapon);
+    }
+
+    // release the arrows of the frame and drop the autoreleased nodes
+    const auto flush = [map, projectiles]() {
+        projectiles->ReleaseChildren(map);
+        cocos2d::PoolManager::getInstance()->getCurrentPool()->clear();
+    };
+
+    // the pool holds an arrow per bot, so neither pass finds it cold
+    projectiles->Prewarm(ProjectilePool::Archetype::ARROW, bots.size());
+    const auto systemTiming { Measure(FRAMES, [&weapons, &system, &options]() {
+        for (auto& weapon: weapons) {
+            weapon.LaunchAttack();
+        }
+        system.Update(options.dt);
+    }, flush) };
+    const auto legacyTiming { Measure(FRAMES, [&legacy, &options]() {
+        for (auto& unitWeapons: legacy) {
+            for (auto& weapon: unitWeapons) {
+                if (weapon) {
+                    weapon->LaunchAttack();
+                    weapon->UpdateState(options.dt);
+                }
+            }
+        }
+    }, flush) };
+
+    std::printf("%zu armed bots, %zu frames, pool hits: %zu, misses: %zu\n"
+        , bots.size(), FRAMES, projectiles->GetHits(), projectiles->GetMisses());
+    PrintTimingHeader("weapons", "us/frame");
+    PrintTiming("system", systemTiming, 1000.0);
+    PrintTiming("per-unit", legacyTiming, 1000.0);
+    return true;
+}
+
+} // namespace headless
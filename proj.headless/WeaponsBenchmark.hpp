@@ -0,0 +1,19 @@
+#ifndef HEADLESS_WEAPONS_BENCHMARK_HPP
+#define HEADLESS_WEAPONS_BENCHMARK_HPP
+
+#include "Options.hpp"
+
+class LevelScene;
+
+namespace headless {
+
+/**
+ * Spawn the archers and keep their bows attacking: every frame each bot launches the attack
+ * and the weapons are updated by the WeaponSystem's single pass or by the model of the per-unit weapons.
+ * Both spawn the same arrows which are released after every frame, out of the measured time.
+ */
+bool BenchmarkWeapons(LevelScene * level, const Options& options);
+
+} // namespace headless
+
+#endif // HEADLESS_WEAPONS_BENCHMARK_HPP
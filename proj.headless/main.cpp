@@ -0,0 +1,339 @@
+/**
+ * Fixed-step simulation runner.
+ *
+ * Loads `Map/level_<N>.tmx` with `configuration/units.json`, drives the
+ * scheduler and the DragonBones clock with a fixed delta time for the requested
+ * number of frames and never renders the scene. The level consumes the frame time
+ * by simulation ticks (units, influences, projectiles, weapons, physics). Reports per-frame p50/p99 cost split by subsystem.
+ *
+ * The GL context is still required by the texture cache, so on a Linux box
+ * without GPU run it under a virtual framebuffer with the software rasterizer:
+ * @code
+ *  xvfb-run -a ./Platformer-headless --level 4 --frames 3600 --report frame-budget.json
+ * @endcode
+ *
+ * Options:
+ *  --level <id>        level id, default: 4
+ *  --frames <count>    number of simulated frames, default: 3600
+ *  --dt <seconds>      fixed delta time, default: 1/60
+ *  --tick-rate <hz>    simulation ticks per second, default: 60
+ *  --input <path>      scripted input, see `LoadScript`; default: built-in walkthrough
+ *  --report <path>     write results as JSON
+ *  --budget <ms>       exit with failure when p99 frame cost exceeds the budget
+ *  --bake <path>       don't simulate: parse the level and write it as a baked level to the path
+ *  --skeleton <path>   don't simulate: convert the DragonBones `<name>_ske.json` to `<name>_ske.dbbin`
+ *                      next to it and report the parse time of both
+ *  --paths <count>     don't simulate: build the level's navigation graph and report
+ *                      the route queries per millisecond between random surfaces
+ *  --load <size>       don't simulate: write a synthetic `size`x`size` map, build its collision masks
+ *                      from the flat GID lookup table and by the former per-tile lookup, report both
+ *  --skinning <path>   don't simulate: play all animations of the DragonBones `<name>_ske.json` (or `.dbbin`),
+ *                      compare the vectorized mesh skinning with the scalar one and report both
+ *  --bones <path>      don't simulate: play all animations of the DragonBones `<name>_ske.json` (or `.dbbin`),
+ *                      compare the flattened bone hierarchy with the bone by bone update and report both
+ *  --borders <path>    don't simulate: build the border chains of the TMX map by the marching squares builder
+ *                      and by the former tile walk, report both and where they differ; fail if the current
+ *                      chains don't cover exactly the sides of the border tiles facing free tiles
+ *  --frame-cache <enemies>
+ *                      don't simulate: play the looping animation of `enemies` warriors, slimes and wasps
+ *                      without the DragonBones frame cache and with it, report both
+ *  --restarts <count>  don't simulate: load the level, spawn the animators of its units and props
+ *                      and restart it `count` times with and without the armature pool, report both
+ *  --targets <bots>    don't simulate: load the level, spawn `bots` archers and compare the player's lookup
+ *                      in their zones by the scan of the tile map's children with the entity registry's
+ *                      handle and grid, report all of them
+ *  --weapons <bots>    don't simulate: load the level, spawn `bots` archers and compare the update
+ *                      of their bows by the weapon system with the former per-unit weapons, report both
+ *  --curses <frames>   don't simulate: load the level, keep 16 curses on the player for `frames` updates
+ *                      and fail if adding or updating them allocated on the heap
+ *  --contacts <frames> record the contacts of `frames` simulated frames, replay them through the contact
+ *                      dispatch table and the former chain of mask comparisons, report both
+ *  --spike <ms>        update time which makes the flight recorder write `spike-<N>.json`
+ *                      to the writable path, default: 50; 0 disables the captures
+ */
+
+#include "Options.hpp"
+#include "Script.hpp"
+#include "LoadBenchmark.hpp"
+#include "TargetsBenchmark.hpp"
+#include "ContactsBenchmark.hpp"
+#include "FrameCacheBenchmark.hpp"
+#include "BorderComparison.hpp"
+#include "WeaponsBenchmark.hpp"
+#include "LevelBaking.hpp"
+#include "SkeletonConversion.hpp"
+#include "CurseAllocations.hpp"
+#include "PathsBenchmark.hpp"
+#include "SkinningComparison.hpp"
+#include "BonesComparison.hpp"
+#include "RestartsBenchmark.hpp"
+
+#include "scenes/LevelScene.hpp"
+#include "FrameSampler.hpp"
+#include "FlightRecorder.hpp"
+#include "Settings.hpp"
+#include "Utils.hpp"
+
+#include "dragonBones/cocos2dx/CCDragonBonesHeaders.h"
+#include "cocos2d.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+namespace {
+
+using headless::Options;
+
+/**
+ * The cocos2d::Director expects the application to exist.
+ * It's never run: the frame loop is driven manually.
+ */
+class HeadlessApplication final : private cocos2d::Application {
+public:
+    bool applicationDidFinishLaunching() override { return true; }
+
+    void applicationDidEnterBackground() override {}
+
+    void applicationWillEnterForeground() override {}
+};
+
+bool ParseOptions(int argc, char **argv, Options& options) {
+    for (int i = 1; i + 1 < argc; i += 2) {
+        const std::string key { argv[i] };
+        const std::string value { argv[i + 1] };
+        if (key == "--level") {
+            options.level = std::stoi(value);
+        }
+        else if (key == "--frames") {
+            options.frames = std::stoul(value);
+        }
+        else if (key == "--dt") {
+            options.dt = std::stof(value);
+        }
+        else if (key == "--tick-rate") {
+            options.tickRate = std::stof(value);
+        }
+        else if (key == "--input") {
+            options.input = value;
+        }
+        else if (key == "--report") {
+            options.report = value;
+        }
+        else if (key == "--budget") {
+            options.budget = std::stod(value);
+        }
+        else if (key == "--bake") {
+            options.bake = value;
+        }
+        else if (key == "--skeleton") {
+            options.skeleton = value;
+        }
+        else if (key == "--paths") {
+            options.paths = std::stoul(value);
+        }
+        else if (key == "--load") {
+            options.load = std::stoul(value);
+        }
+        else if (key == "--skinning") {
+            options.skinning = value;
+        }
+        else if (key == "--bones") {
+            options.bones = value;
+        }
+        else if (key == "--borders") {
+            options.borders = value;
+        }
+        else if (key == "--frame-cache") {
+            options.frameCache = std::stoul(value);
+        }
+        else if (key == "--restarts") {
+            options.restarts = std::stoul(value);
+        }
+        else if (key == "--targets") {
+            options.targets = std::stoul(value);
+        }
+        else if (key == "--weapons") {
+            options.weapons = std::stoul(value);
+        }
+        else if (key == "--curses") {
+            options.curses = std::stoul(value);
+        }
+        else if (key == "--contacts") {
+            options.contacts = std::stoul(value);
+        }
+        else if (key == "--spike") {
+            options.spike = std::stof(value);
+        }
+        else {
+            std::fprintf(stderr, "Unknown option: %s\n", key.c_str());
+            return false;
+        }
+    }
+    return options.frames > 0U && options.dt > 0.f && options.tickRate > 0.f;
+}
+
+void PrintReport(const bench::FrameSampler& sampler, const Options& options) {
+    std::printf("level %d, %zu frames, dt = %.5f s, %.0f ticks/s\n"
+        , options.level, sampler.GetFrames().size(), options.dt, options.tickRate);
+    std::printf("%-12s %10s %10s\n", "subsystem", "p50, ms", "p99, ms");
+    for (size_t i = 0; i < Utils::EnumSize<bench::Subsystem>(); i++) {
+        const auto subsystem { Utils::EnumCast<bench::Subsystem>(i) };
+        std::printf("%-12s %10.4f %10.4f\n"
+            , bench::GetSubsystemName(subsystem)
+            , sampler.GetPercentile(subsystem, 50.0)
+            , sampler.GetPercentile(subsystem, 99.0));
+    }
+    std::printf("%-12s %10.4f %10.4f\n", "total"
+        , sampler.GetTotalPercentile(50.0)
+        , sampler.GetTotalPercentile(99.0));
+}
+
+bool WriteReport(const bench::FrameSampler& sampler, const Options& options) {
+    std::ofstream file { options.report };
+    if (!file) {
+        return false;
+    }
+    file << "{\n";
+    file << "  \"level\": " << options.level << ",\n";
+    file << "  \"frames\": " << sampler.GetFrames().size() << ",\n";
+    file << "  \"dt\": " << options.dt << ",\n";
+    file << "  \"tickRate\": " << options.tickRate << ",\n";
+    file << "  \"subsystems\": {\n";
+    for (size_t i = 0; i < Utils::EnumSize<bench::Subsystem>(); i++) {
+        const auto subsystem { Utils::EnumCast<bench::Subsystem>(i) };
+        file << "    \"" << bench::GetSubsystemName(subsystem) << "\": { "
+            << "\"p50\": " << sampler.GetPercentile(subsystem, 50.0) << ", "
+            << "\"p99\": " << sampler.GetPercentile(subsystem, 99.0) << " },\n";
+    }
+    file << "    \"total\": { "
+        << "\"p50\": " << sampler.GetTotalPercentile(50.0) << ", "
+        << "\"p99\": " << sampler.GetTotalPercentile(99.0) << " }\n";
+    file << "  }\n";
+    file << "}\n";
+    return static_cast<bool>(file);
+}
+
+} // namespace {
+
+int main(int argc, char **argv) {
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        std::fprintf(stderr, "Usage: %s [--level id] [--frames count] [--dt seconds] [--tick-rate hz] "
+            "[--input path] [--report path] [--budget ms] [--bake path] [--skeleton path] [--paths count] [--load size] [--skinning path] [--bones path] [--borders path] [--frame-cache enemies] [--restarts count] [--targets bots] [--weapons bots] [--curses frames] [--contacts frames] [--spike ms]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    if (!options.skeleton.empty()) {
+        // doesn't need the director
+        return headless::ConvertSkeleton(options)? EXIT_SUCCESS: EXIT_FAILURE;
+    }
+
+    HeadlessApplication app;
+    const auto director = cocos2d::Director::getInstance();
+    const auto glview = cocos2d::GLViewImpl::createWithRect("Platformer (headless)"
+        , cocos2d::Rect(0.f, 0.f, 1024.f, 768.f)
+        , 1.f
+        , false);
+    director->setOpenGLView(glview);
+    director->setDisplayStats(false);
+    glview->setDesignResolutionSize(1024.f, 768.f, ResolutionPolicy::NO_BORDER);
+    cocos2d::FileUtils::getInstance()->addSearchPath("medium");
+
+    if (!options.bake.empty()) {
+        return headless::Bake(options)? EXIT_SUCCESS: EXIT_FAILURE;
+    }
+    if (!options.borders.empty()) {
+        return headless::CompareBorders(options)? EXIT_SUCCESS: EXIT_FAILURE;
+    }
+    if (options.paths > 0U) {
+        return headless::QueryPaths(options)? EXIT_SUCCESS: EXIT_FAILURE;
+    }
+    if (options.load > 0U) {
+        return headless::BenchmarkLoad(options)? EXIT_SUCCESS: EXIT_FAILURE;
+    }
+    if (!options.skinning.empty()) {
+        return headless::CompareSkinning(options)? EXIT_SUCCESS: EXIT_FAILURE;
+    }
+    if (!options.bones.empty()) {
+        return headless::CompareBones(options)? EXIT_SUCCESS: EXIT_FAILURE;
+    }
+    if (options.frameCache > 0U) {
+        return headless::BenchmarkFrameCache(options)? EXIT_SUCCESS: EXIT_FAILURE;
+    }
+
+    settings::Simulation::GetInstance().SetTickRate(options.tickRate);
+    bench::FlightRecorder::GetInstance().SetBudget(options.spike);
+    const auto scene = LevelScene::createRootScene(options.level);
+    if (!scene) {
+        std::fprintf(stderr, "Failed to load level %d\n", options.level);
+        return EXIT_FAILURE;
+    }
+    director->runWithScene(scene);
+    // make the scene running and wait until the level's assets are resident;
+    // these are the only rendered frames
+    const auto level = scene->getChildByName<LevelScene*>("Level");
+    do {
+        director->mainLoop();
+    } while (!level->IsLoaded());
+    if (options.restarts > 0U) {
+        return headless::BenchmarkRestarts(level, options)? EXIT_SUCCESS: EXIT_FAILURE;
+    }
+    if (options.targets > 0U) {
+        return headless::BenchmarkTargets(level, options)? EXIT_SUCCESS: EXIT_FAILURE;
+    }
+    if (options.weapons > 0U) {
+        return headless::BenchmarkWeapons(level, options)? EXIT_SUCCESS: EXIT_FAILURE;
+    }
+    if (options.curses > 0U) {
+        return headless::CountCurseAllocations(level, options)? EXIT_SUCCESS: EXIT_FAILURE;
+    }
+    if (options.contacts > 0U) {
+        return headless::BenchmarkContacts(options)? EXIT_SUCCESS: EXIT_FAILURE;
+    }
+
+    // the DragonBones clock is driven manually with the fixed time step
+    const auto scheduler = director->getScheduler();
+    scheduler->pauseTarget(dragonBones::CCFactory::getFactory());
+    const auto armatures = dragonBones::CCFactory::getInstance();
+    const auto dispatcher = director->getEventDispatcher();
+
+    const auto script = options.input.empty()?
+        headless::DefaultScript(options.frames) : headless::LoadScript(options.input);
+    auto nextKey = script.cbegin();
+
+    auto& sampler = bench::FrameSampler::GetInstance();
+    sampler.Enable(options.frames);
+    for (size_t frame = 0; frame < options.frames; frame++) {
+        for (; nextKey != script.cend() && nextKey->frame <= frame; ++nextKey) {
+            cocos2d::EventKeyboard event { nextKey->code, nextKey->pressed };
+            dispatcher->dispatchEvent(&event);
+        }
+
+        sampler.BeginFrame();
+        scheduler->update(options.dt);
+        {
+            const bench::ScopedSample sample { bench::Subsystem::ANIMATIONS };
+            armatures->advanceTime(options.dt);
+        }
+        sampler.EndFrame();
+
+        cocos2d::PoolManager::getInstance()->getCurrentPool()->clear();
+    }
+
+    PrintReport(sampler, options);
+    if (const auto captures { bench::FlightRecorder::GetInstance().GetCaptureCount() }; captures > 0U) {
+        std::printf("frame spikes captured: %zu\n", captures);
+    }
+    if (!options.report.empty() && !WriteReport(sampler, options)) {
+        std::fprintf(stderr, "Failed to write report: %s\n", options.report.c_str());
+        return EXIT_FAILURE;
+    }
+
+    const auto p99 { sampler.GetTotalPercentile(99.0) };
+    if (options.budget > 0.0 && p99 > options.budget) {
+        std::fprintf(stderr, "Frame budget exceeded: p99 %.4f ms > %.4f ms\n", p99, options.budget);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}